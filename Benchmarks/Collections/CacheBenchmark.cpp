@@ -0,0 +1,304 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Config.h"
+#include "Nuclex/Support/Collections/SequentialSlotCache.h"
+#include "Nuclex/Support/Collections/KeyedArrayCache.h"
+
+#include "CollectionBenchmark.h"
+
+#include <unordered_map> // for std::unordered_map
+#include <list> // for std::list
+#include <algorithm> // for std::shuffle()
+#include <random> // for std::mt19937
+#include <functional> // for std::hash
+#include <utility> // for std::pair
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>LRU cache built from standard containers the usual way</summary>
+  /// <typeparam name="TKey">Type of the keys items are looked up by</typeparam>
+  /// <typeparam name="TValue">Type of the values stored in the cache</typeparam>
+  /// <remarks>
+  ///   This is the textbook design: a linked list ordered by recency of use plus
+  ///   a hash map from keys to list nodes. It serves as the baseline the library's
+  ///   caches are compared against.
+  /// </remarks>
+  template<typename TKey, typename TValue>
+  class StdLruCache {
+
+    /// <summary>Initializes a new LRU cache</summary>
+    /// <param name="capacity">Maximum number of items the cache can hold</param>
+    public: explicit StdLruCache(std::size_t capacity) :
+      capacity(capacity),
+      items(),
+      index() {
+      this->index.reserve(capacity);
+    }
+
+    /// <summary>Stores a value in the cache, evicting the oldest one if full</summary>
+    /// <param name="key">Key under which the value can be looked up later</param>
+    /// <param name="value">Value that will be stored under its key</param>
+    /// <returns>True if the key was new, false if an existing value was replaced</returns>
+    public: bool Insert(const TKey &key, const TValue &value) {
+      typename IndexMap::iterator existing = this->index.find(key);
+      if(existing != this->index.end()) {
+        existing->second->second = value;
+        this->items.splice(this->items.begin(), this->items, existing->second);
+        return false;
+      }
+
+      if(this->index.size() >= this->capacity) {
+        this->index.erase(this->items.back().first);
+        this->items.pop_back();
+      }
+
+      this->items.emplace_front(key, value);
+      this->index.emplace(key, this->items.begin());
+      return true;
+    }
+
+    /// <summary>Looks up a value and marks it as the most recently used one</summary>
+    /// <param name="key">Key of the value that will be looked up</param>
+    /// <param name="value">Receives a copy of the value if it was found</param>
+    /// <returns>True if the value was found, false otherwise</returns>
+    public: bool TryGet(const TKey &key, TValue &value) {
+      typename IndexMap::iterator existing = this->index.find(key);
+      if(existing == this->index.end()) {
+        return false;
+      }
+
+      this->items.splice(this->items.begin(), this->items, existing->second);
+      value = existing->second->second;
+      return true;
+    }
+
+    /// <summary>Removes all items from the cache</summary>
+    public: void Clear() {
+      this->index.clear();
+      this->items.clear();
+    }
+
+    /// <summary>List of key/value pairs, most recently used first</summary>
+    private: typedef std::list<std::pair<TKey, TValue>> ItemList;
+    /// <summary>Map from keys to the nodes in the item list</summary>
+    private: typedef std::unordered_map<TKey, typename ItemList::iterator> IndexMap;
+
+    /// <summary>Maximum number of items the cache will hold</summary>
+    private: std::size_t capacity;
+    /// <summary>Items in the cache, ordered by how recently they were used</summary>
+    private: ItemList items;
+    /// <summary>Looks up the list node holding an item by its key</summary>
+    private: IndexMap index;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Provides a filled cache and shuffled keys for the cache benchmarks</summary>
+  /// <typeparam name="TCache">Type of cache that will be benchmarked</typeparam>
+  /// <typeparam name="TItem">Type of values stored in the cache</typeparam>
+  template<typename TCache, typename TItem>
+  class CacheFixture : public CollectionSizeFixture {
+
+    /// <summary>Called before the benchmark runs to create and fill the cache</summary>
+    /// <param name="experimentValue">Experiment value holding the number of items</param>
+    public: void setUp(const celero::TestFixture::ExperimentValue &experimentValue) override {
+      CollectionSizeFixture::setUp(experimentValue);
+
+      // Keys are visited in random order, otherwise the sequential slot cache would
+      // have an unfair advantage by walking its slots like an array
+      this->keys.reserve(this->problemSize);
+      this->values.reserve(this->problemSize);
+      for(std::size_t index = 0; index < this->problemSize; ++index) {
+        this->keys.push_back(index);
+        this->values.push_back(makeItem<TItem>(index));
+      }
+      std::shuffle(this->keys.begin(), this->keys.end(), std::mt19937(1234));
+
+      this->cache = std::make_unique<TCache>(this->problemSize);
+      for(std::size_t index = 0; index < this->problemSize; ++index) {
+        this->cache->Insert(this->keys[index], this->values[index]);
+      }
+    }
+
+    /// <summary>Called after the benchmark completes to free all memory again</summary>
+    public: void tearDown() override {
+      this->cache.reset();
+      std::vector<TItem>().swap(this->values);
+      std::vector<std::size_t>().swap(this->keys);
+    }
+
+    /// <summary>Looks up every key once and digests the values found</summary>
+    /// <returns>A number depending on all values that were looked up</returns>
+    protected: std::size_t lookUpAll() {
+      std::size_t digest = 0;
+      TItem value = TItem();
+      for(std::size_t key : this->keys) {
+        if(this->cache->TryGet(key, value)) {
+          digest += digestItem(value);
+        }
+      }
+      return digest;
+    }
+
+    /// <summary>Empties the cache and inserts all items again</summary>
+    protected: void reinsertAll() {
+      this->cache->Clear();
+      for(std::size_t index = 0; index < this->problemSize; ++index) {
+        this->cache->Insert(this->keys[index], this->values[index]);
+      }
+    }
+
+    /// <summary>Keys of all items in the cache, in random order</summary>
+    protected: std::vector<std::size_t> keys;
+    /// <summary>Values stored under the keys with the same index</summary>
+    protected: std::vector<TItem> values;
+    /// <summary>Cache whose performance will be measured</summary>
+    protected: std::unique_ptr<TCache> cache;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Cache fixture for the standard LRU cache with trivial items</summary>
+  typedef CacheFixture<StdLruCache<std::size_t, TrivialItem>, TrivialItem> TrivialStdLruFixture;
+
+  /// <summary>Cache fixture for the sequential slot cache with trivial items</summary>
+  typedef CacheFixture<
+    Nuclex::Support::Collections::SequentialSlotCache<std::size_t, TrivialItem>, TrivialItem
+  > TrivialSequentialSlotFixture;
+
+  /// <summary>Cache fixture for the keyed array cache with trivial items</summary>
+  typedef CacheFixture<
+    Nuclex::Support::Collections::KeyedArrayCache<
+      std::size_t, TrivialItem, std::hash<std::size_t>
+    >,
+    TrivialItem
+  > TrivialKeyedArrayFixture;
+
+  /// <summary>Cache fixture for the standard LRU cache with non-trivial items</summary>
+  typedef CacheFixture<
+    StdLruCache<std::size_t, NonTrivialItem>, NonTrivialItem
+  > NonTrivialStdLruFixture;
+
+  /// <summary>Cache fixture for the sequential slot cache with non-trivial items</summary>
+  typedef CacheFixture<
+    Nuclex::Support::Collections::SequentialSlotCache<std::size_t, NonTrivialItem>,
+    NonTrivialItem
+  > NonTrivialSequentialSlotFixture;
+
+  /// <summary>Cache fixture for the keyed array cache with non-trivial items</summary>
+  typedef CacheFixture<
+    Nuclex::Support::Collections::KeyedArrayCache<
+      std::size_t, NonTrivialItem, std::hash<std::size_t>
+    >,
+    NonTrivialItem
+  > NonTrivialKeyedArrayFixture;
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex { namespace Support { namespace Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BASELINE_F(CacheLookupOfTrivialItems, StdLru, TrivialStdLruFixture, 10, 0) {
+    celero::DoNotOptimizeAway(this->lookUpAll());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BENCHMARK_F(CacheLookupOfTrivialItems, SequentialSlotCache, TrivialSequentialSlotFixture, 10, 0) {
+    celero::DoNotOptimizeAway(this->lookUpAll());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BENCHMARK_F(CacheLookupOfTrivialItems, KeyedArrayCache, TrivialKeyedArrayFixture, 10, 0) {
+    celero::DoNotOptimizeAway(this->lookUpAll());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BASELINE_F(CacheLookupOfNonTrivialItems, StdLru, NonTrivialStdLruFixture, 10, 0) {
+    celero::DoNotOptimizeAway(this->lookUpAll());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BENCHMARK_F(
+    CacheLookupOfNonTrivialItems, SequentialSlotCache, NonTrivialSequentialSlotFixture, 10, 0
+  ) {
+    celero::DoNotOptimizeAway(this->lookUpAll());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BENCHMARK_F(CacheLookupOfNonTrivialItems, KeyedArrayCache, NonTrivialKeyedArrayFixture, 10, 0) {
+    celero::DoNotOptimizeAway(this->lookUpAll());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BASELINE_F(CacheInsertOfTrivialItems, StdLru, TrivialStdLruFixture, 10, 0) {
+    this->reinsertAll();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BENCHMARK_F(CacheInsertOfTrivialItems, SequentialSlotCache, TrivialSequentialSlotFixture, 10, 0) {
+    this->reinsertAll();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BENCHMARK_F(CacheInsertOfTrivialItems, KeyedArrayCache, TrivialKeyedArrayFixture, 10, 0) {
+    this->reinsertAll();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BASELINE_F(CacheInsertOfNonTrivialItems, StdLru, NonTrivialStdLruFixture, 10, 0) {
+    this->reinsertAll();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BENCHMARK_F(
+    CacheInsertOfNonTrivialItems, SequentialSlotCache, NonTrivialSequentialSlotFixture, 10, 0
+  ) {
+    this->reinsertAll();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BENCHMARK_F(CacheInsertOfNonTrivialItems, KeyedArrayCache, NonTrivialKeyedArrayFixture, 10, 0) {
+    this->reinsertAll();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+}}} // namespace Nuclex::Support::Collections
@@ -0,0 +1,143 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_SUPPORT_COLLECTIONS_COLLECTIONBENCHMARK_H
+#define NUCLEX_SUPPORT_COLLECTIONS_COLLECTIONBENCHMARK_H
+
+#include "Nuclex/Support/Config.h"
+
+#include <celero/Celero.h>
+
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint32_t, std::int64_t
+#include <string> // for std::string, std::to_string()
+#include <memory> // for std::unique_ptr
+#include <vector> // for std::vector
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Item type that can be copied with std::memcpy()</summary>
+  typedef std::uint32_t TrivialItem;
+
+  /// <summary>Item type with user-provided copy and move constructors</summary>
+  typedef std::string NonTrivialItem;
+
+  /// <summary>Item type that can be moved but not copied</summary>
+  typedef std::unique_ptr<std::uint32_t> MoveOnlyItem;
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Largest number of items any collection benchmark will work with</summary>
+  const std::size_t MaximumProblemSize = 16 * 1024 * 1024;
+
+  /// <summary>Number of item operations each benchmark sample should amount to</summary>
+  /// <remarks>
+  ///   Small collections are run for more iterations and large collections for fewer,
+  ///   so a sample takes roughly the same time regardless of the collection's size.
+  /// </remarks>
+  const std::size_t OperationsPerSample = 1024 * 1024;
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Creates an item that can be told apart from items with other indices</summary>
+  /// <typeparam name="TItem">Type of item that will be created</typeparam>
+  /// <param name="index">Index from which the item's value will be derived</param>
+  /// <returns>The new item</returns>
+  template<typename TItem> TItem makeItem(std::size_t index);
+
+  /// <summary>Creates a trivial item from an index</summary>
+  template<> inline TrivialItem makeItem<TrivialItem>(std::size_t index) {
+    return static_cast<TrivialItem>(index);
+  }
+
+  /// <summary>Creates a non-trivial item from an index</summary>
+  template<> inline NonTrivialItem makeItem<NonTrivialItem>(std::size_t index) {
+    return std::to_string(index); // Short enough for the small string optimization
+  }
+
+  /// <summary>Creates a move-only item from an index</summary>
+  template<> inline MoveOnlyItem makeItem<MoveOnlyItem>(std::size_t index) {
+    return std::make_unique<std::uint32_t>(static_cast<std::uint32_t>(index));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Reduces an item to a number so the compiler can't skip reading it</summary>
+  /// <param name="item">Item that will be reduced to a number</param>
+  /// <returns>A number that depends on the item's contents</returns>
+  inline std::size_t digestItem(const TrivialItem &item) {
+    return static_cast<std::size_t>(item);
+  }
+
+  /// <summary>Reduces an item to a number so the compiler can't skip reading it</summary>
+  /// <param name="item">Item that will be reduced to a number</param>
+  /// <returns>A number that depends on the item's contents</returns>
+  inline std::size_t digestItem(const NonTrivialItem &item) {
+    return item.length();
+  }
+
+  /// <summary>Reduces an item to a number so the compiler can't skip reading it</summary>
+  /// <param name="item">Item that will be reduced to a number</param>
+  /// <returns>A number that depends on the item's contents</returns>
+  inline std::size_t digestItem(const MoveOnlyItem &item) {
+    return static_cast<std::size_t>(*item);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Fixture that runs its benchmarks for collection sizes from 16 to 16M</summary>
+  /// <remarks>
+  ///   The collection size of the current experiment can be looked up in
+  ///   <see cref="problemSize" /> from the derived fixture's setUp() method on.
+  /// </remarks>
+  class CollectionSizeFixture : public celero::TestFixture {
+
+    /// <summary>Provides the collection sizes the benchmarks will be run with</summary>
+    /// <returns>A list of collection sizes and the iterations for each</returns>
+    public: std::vector<celero::TestFixture::ExperimentValue> getExperimentValues(
+    ) const override {
+      std::vector<celero::TestFixture::ExperimentValue> problemSpace;
+      for(std::size_t size = 16; size <= MaximumProblemSize; size *= 16) {
+        std::size_t iterations = OperationsPerSample / size;
+        problemSpace.emplace_back(
+          static_cast<std::int64_t>(size),
+          static_cast<std::int64_t>((iterations > 0) ? iterations : 1)
+        );
+      }
+      return problemSpace;
+    }
+
+    /// <summary>Called before the benchmark runs to record the collection size</summary>
+    /// <param name="experimentValue">Experiment value holding the collection size</param>
+    public: void setUp(const celero::TestFixture::ExperimentValue &experimentValue) override {
+      this->problemSize = static_cast<std::size_t>(experimentValue.Value);
+    }
+
+    /// <summary>Number of items the benchmark should work with</summary>
+    protected: std::size_t problemSize = 0;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+#endif // NUCLEX_SUPPORT_COLLECTIONS_COLLECTIONBENCHMARK_H
@@ -0,0 +1,209 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Config.h"
+#include "Nuclex/Support/Collections/SequentialSlotCache.h"
+#include "Nuclex/Support/Collections/KeyedArrayCache.h"
+#include "Nuclex/Support/Collections/DynamicArray.h"
+
+#include <celero/Celero.h>
+
+#include <cstddef> // for std::size_t
+#include <functional> // for std::hash
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Number of items in each collection and lookups per benchmark iteration</summary>
+  const std::size_t ItemCount = 1024;
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Sets up a filled sequential slot cache and a pointer to its interface</summary>
+  class SequentialSlotCacheFixture : public celero::TestFixture {
+
+    /// <summary>Initializes the fixture with an empty cache</summary>
+    public: SequentialSlotCacheFixture() :
+      cache(ItemCount),
+      map(&this->cache) {}
+
+    /// <summary>Called before the benchmark runs to fill the cache</summary>
+    public: void setUp(const celero::TestFixture::ExperimentValue &) override {
+      for(std::size_t index = 0; index < ItemCount; ++index) {
+        this->cache.Insert(index, static_cast<int>(index));
+      }
+    }
+
+    /// <summary>Called after the benchmark completes to empty the cache again</summary>
+    public: void tearDown() override {
+      this->cache.Clear();
+    }
+
+    /// <summary>Cache the benchmarks will look up items in</summary>
+    protected: Nuclex::Support::Collections::SequentialSlotCache<std::size_t, int> cache;
+    /// <summary>The same cache, accessed through its virtual interface</summary>
+    protected: Nuclex::Support::Collections::Map<std::size_t, int> *map;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Sets up a filled, hash-indexed keyed array cache</summary>
+  class KeyedArrayCacheFixture : public celero::TestFixture {
+
+    /// <summary>Initializes the fixture with an empty cache</summary>
+    public: KeyedArrayCacheFixture() :
+      cache(ItemCount),
+      map(&this->cache) {}
+
+    /// <summary>Called before the benchmark runs to fill the cache</summary>
+    public: void setUp(const celero::TestFixture::ExperimentValue &) override {
+      for(std::size_t index = 0; index < ItemCount; ++index) {
+        this->cache.Insert(index, static_cast<int>(index));
+      }
+    }
+
+    /// <summary>Called after the benchmark completes to empty the cache again</summary>
+    public: void tearDown() override {
+      this->cache.Clear();
+    }
+
+    /// <summary>Cache the benchmarks will look up items in</summary>
+    protected: Nuclex::Support::Collections::KeyedArrayCache<
+      std::size_t, int, std::hash<std::size_t>
+    > cache;
+    /// <summary>The same cache, accessed through its virtual interface</summary>
+    protected: Nuclex::Support::Collections::MultiMap<std::size_t, int> *map;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Sets up a filled dynamic array and a pointer to its interface</summary>
+  class DynamicArrayFixture : public celero::TestFixture {
+
+    /// <summary>Initializes the fixture with an empty array</summary>
+    public: DynamicArrayFixture() :
+      array(),
+      collection(&this->array) {}
+
+    /// <summary>Called before the benchmark runs to fill the array</summary>
+    public: void setUp(const celero::TestFixture::ExperimentValue &) override {
+      for(std::size_t index = 0; index < ItemCount; ++index) {
+        this->array.Add(static_cast<int>(index));
+      }
+    }
+
+    /// <summary>Called after the benchmark completes to empty the array again</summary>
+    public: void tearDown() override {
+      this->array.Clear();
+    }
+
+    /// <summary>Array the benchmarks will read items from</summary>
+    protected: Nuclex::Support::Collections::DynamicArray<int> array;
+    /// <summary>The same array, accessed through its virtual interface</summary>
+    protected: Nuclex::Support::Collections::IndexedCollection<int> *collection;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex { namespace Support { namespace Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BASELINE_F(SequentialSlotCacheTryGet, ThroughInterface, SequentialSlotCacheFixture, 100, 100) {
+    int sum = 0;
+    for(std::size_t index = 0; index < ItemCount; ++index) {
+      int value;
+      if(this->map->TryGet(index, value)) {
+        sum += value;
+      }
+    }
+    celero::DoNotOptimizeAway(sum);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BENCHMARK_F(SequentialSlotCacheTryGet, OnFinalType, SequentialSlotCacheFixture, 100, 100) {
+    int sum = 0;
+    for(std::size_t index = 0; index < ItemCount; ++index) {
+      int value;
+      if(this->cache.TryGet(index, value)) {
+        sum += value;
+      }
+    }
+    celero::DoNotOptimizeAway(sum);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BASELINE_F(KeyedArrayCacheTryGet, ThroughInterface, KeyedArrayCacheFixture, 100, 100) {
+    int sum = 0;
+    for(std::size_t index = 0; index < ItemCount; ++index) {
+      int value;
+      if(this->map->TryGet(index, value)) {
+        sum += value;
+      }
+    }
+    celero::DoNotOptimizeAway(sum);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BENCHMARK_F(KeyedArrayCacheTryGet, OnFinalType, KeyedArrayCacheFixture, 100, 100) {
+    int sum = 0;
+    for(std::size_t index = 0; index < ItemCount; ++index) {
+      int value;
+      if(this->cache.TryGet(index, value)) {
+        sum += value;
+      }
+    }
+    celero::DoNotOptimizeAway(sum);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BASELINE_F(DynamicArrayGetAt, ThroughInterface, DynamicArrayFixture, 100, 100) {
+    int sum = 0;
+    for(std::size_t index = 0; index < ItemCount; ++index) {
+      sum += this->collection->GetAt(index);
+    }
+    celero::DoNotOptimizeAway(sum);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BENCHMARK_F(DynamicArrayGetAt, OnFinalType, DynamicArrayFixture, 100, 100) {
+    int sum = 0;
+    for(std::size_t index = 0; index < ItemCount; ++index) {
+      sum += this->array.GetAt(index);
+    }
+    celero::DoNotOptimizeAway(sum);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+}}} // namespace Nuclex::Support::Collections
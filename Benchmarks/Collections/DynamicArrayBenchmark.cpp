@@ -0,0 +1,225 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Config.h"
+#include "Nuclex/Support/Collections/DynamicArray.h"
+
+#include "CollectionBenchmark.h"
+
+#include <vector> // for std::vector
+#include <memory> // for std::unique_ptr
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Appends an item to a standard vector</summary>
+  /// <param name="array">Vector the item will be appended to</param>
+  /// <param name="item">Item that will be appended</param>
+  template<typename TItem>
+  void append(std::vector<TItem> &array, const TItem &item) {
+    array.push_back(item);
+  }
+
+  /// <summary>Appends an item to a dynamic array</summary>
+  /// <param name="array">Dynamic array the item will be appended to</param>
+  /// <param name="item">Item that will be appended</param>
+  template<typename TItem>
+  void append(Nuclex::Support::Collections::DynamicArray<TItem> &array, const TItem &item) {
+    array.Add(item);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Retrieves an item from a standard vector</summary>
+  /// <param name="array">Vector the item will be retrieved from</param>
+  /// <param name="index">Index of the item that will be retrieved</param>
+  /// <returns>The item at the specified index</returns>
+  template<typename TItem>
+  const TItem &getAt(const std::vector<TItem> &array, std::size_t index) {
+    return array[index];
+  }
+
+  /// <summary>Retrieves an item from a dynamic array</summary>
+  /// <param name="array">Dynamic array the item will be retrieved from</param>
+  /// <param name="index">Index of the item that will be retrieved</param>
+  /// <returns>The item at the specified index</returns>
+  template<typename TItem>
+  const TItem &getAt(
+    const Nuclex::Support::Collections::DynamicArray<TItem> &array, std::size_t index
+  ) {
+    return array.GetAt(index);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Removes all items from a standard vector</summary>
+  /// <param name="array">Vector that will be cleared</param>
+  template<typename TItem>
+  void clear(std::vector<TItem> &array) {
+    array.clear();
+  }
+
+  /// <summary>Removes all items from a dynamic array</summary>
+  /// <param name="array">Dynamic array that will be cleared</param>
+  template<typename TItem>
+  void clear(Nuclex::Support::Collections::DynamicArray<TItem> &array) {
+    array.Clear();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Provides a filled array for the array benchmarks</summary>
+  /// <typeparam name="TArray">Type of array that will be benchmarked</typeparam>
+  /// <typeparam name="TItem">Type of items stored in the array</typeparam>
+  template<typename TArray, typename TItem>
+  class ArrayFixture : public CollectionSizeFixture {
+
+    /// <summary>Called before the benchmark runs to create and fill the array</summary>
+    /// <param name="experimentValue">Experiment value holding the number of items</param>
+    public: void setUp(const celero::TestFixture::ExperimentValue &experimentValue) override {
+      CollectionSizeFixture::setUp(experimentValue);
+
+      this->items.reserve(this->problemSize);
+      for(std::size_t index = 0; index < this->problemSize; ++index) {
+        this->items.push_back(makeItem<TItem>(index));
+      }
+
+      this->array = std::make_unique<TArray>();
+      appendAll();
+    }
+
+    /// <summary>Called after the benchmark completes to free all memory again</summary>
+    public: void tearDown() override {
+      this->array.reset();
+      std::vector<TItem>().swap(this->items);
+    }
+
+    /// <summary>Empties the array and appends all items to it again</summary>
+    /// <remarks>
+    ///   Clearing keeps the array's capacity, so this measures appending without
+    ///   the array having to grow.
+    /// </remarks>
+    protected: void reappendAll() {
+      clear(*this->array);
+      appendAll();
+    }
+
+    /// <summary>Reads all items by their index and digests them</summary>
+    /// <returns>A number depending on all items that were read</returns>
+    protected: std::size_t readAll() const {
+      std::size_t digest = 0;
+      for(std::size_t index = 0; index < this->problemSize; ++index) {
+        digest += digestItem(getAt(*this->array, index));
+      }
+      return digest;
+    }
+
+    /// <summary>Appends all items to the array</summary>
+    private: void appendAll() {
+      for(const TItem &item : this->items) {
+        append(*this->array, item);
+      }
+    }
+
+    /// <summary>Items that will be stored in the array</summary>
+    protected: std::vector<TItem> items;
+    /// <summary>Array whose performance will be measured</summary>
+    protected: std::unique_ptr<TArray> array;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Array fixture for a standard vector with trivial items</summary>
+  typedef ArrayFixture<std::vector<TrivialItem>, TrivialItem> TrivialVectorFixture;
+
+  /// <summary>Array fixture for a dynamic array with trivial items</summary>
+  typedef ArrayFixture<
+    Nuclex::Support::Collections::DynamicArray<TrivialItem>, TrivialItem
+  > TrivialDynamicArrayFixture;
+
+  /// <summary>Array fixture for a standard vector with non-trivial items</summary>
+  typedef ArrayFixture<std::vector<NonTrivialItem>, NonTrivialItem> NonTrivialVectorFixture;
+
+  /// <summary>Array fixture for a dynamic array with non-trivial items</summary>
+  typedef ArrayFixture<
+    Nuclex::Support::Collections::DynamicArray<NonTrivialItem>, NonTrivialItem
+  > NonTrivialDynamicArrayFixture;
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex { namespace Support { namespace Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BASELINE_F(ArrayAppendOfTrivialItems, StdVector, TrivialVectorFixture, 10, 0) {
+    this->reappendAll();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BENCHMARK_F(ArrayAppendOfTrivialItems, DynamicArray, TrivialDynamicArrayFixture, 10, 0) {
+    this->reappendAll();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BASELINE_F(ArrayAppendOfNonTrivialItems, StdVector, NonTrivialVectorFixture, 10, 0) {
+    this->reappendAll();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BENCHMARK_F(ArrayAppendOfNonTrivialItems, DynamicArray, NonTrivialDynamicArrayFixture, 10, 0) {
+    this->reappendAll();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BASELINE_F(ArrayReadOfTrivialItems, StdVector, TrivialVectorFixture, 10, 0) {
+    celero::DoNotOptimizeAway(this->readAll());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BENCHMARK_F(ArrayReadOfTrivialItems, DynamicArray, TrivialDynamicArrayFixture, 10, 0) {
+    celero::DoNotOptimizeAway(this->readAll());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BASELINE_F(ArrayReadOfNonTrivialItems, StdVector, NonTrivialVectorFixture, 10, 0) {
+    celero::DoNotOptimizeAway(this->readAll());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BENCHMARK_F(ArrayReadOfNonTrivialItems, DynamicArray, NonTrivialDynamicArrayFixture, 10, 0) {
+    celero::DoNotOptimizeAway(this->readAll());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+}}} // namespace Nuclex::Support::Collections
@@ -0,0 +1,247 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Config.h"
+#include "Nuclex/Support/Collections/RingQueue.h"
+#include "Nuclex/Support/Collections/ShiftQueue.h"
+
+#include "CollectionBenchmark.h"
+
+#include <deque> // for std::deque
+#include <memory> // for std::unique_ptr
+#include <type_traits> // for std::is_copy_constructible
+#include <utility> // for std::move()
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Appends all items to a standard deque</summary>
+  /// <param name="deque">Deque the items will be appended to</param>
+  /// <param name="items">Items that will be copied or, if move-only, moved</param>
+  template<typename TItem>
+  void writeAll(std::deque<TItem> &deque, std::vector<TItem> &items) {
+    if constexpr(std::is_copy_constructible<TItem>::value) {
+      for(const TItem &item : items) {
+        deque.push_back(item);
+      }
+    } else {
+      for(TItem &item : items) {
+        deque.push_back(std::move(item));
+      }
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Appends all items to a ring queue</summary>
+  /// <param name="queue">Ring queue the items will be appended to</param>
+  /// <param name="items">Items that will be copied or, if move-only, moved</param>
+  template<typename TItem>
+  void writeAll(Nuclex::Support::Collections::RingQueue<TItem> &queue, std::vector<TItem> &items) {
+    if constexpr(std::is_copy_constructible<TItem>::value) {
+      queue.Write(items.data(), items.size());
+    } else {
+      std::pair<std::span<TItem>, std::span<TItem>> space = queue.BeginWrite(items.size());
+      TItem *sourceItem = items.data();
+      for(TItem &targetItem : space.first) {
+        new(&targetItem) TItem(std::move(*sourceItem));
+        ++sourceItem;
+      }
+      for(TItem &targetItem : space.second) {
+        new(&targetItem) TItem(std::move(*sourceItem));
+        ++sourceItem;
+      }
+      queue.CommitWrite(items.size());
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Appends all items to a shift queue</summary>
+  /// <param name="queue">Shift queue the items will be appended to</param>
+  /// <param name="items">Items that will be copied or, if move-only, moved</param>
+  template<typename TItem>
+  void writeAll(Nuclex::Support::Collections::ShiftQueue<TItem> &queue, std::vector<TItem> &items) {
+    if constexpr(std::is_copy_constructible<TItem>::value) {
+      queue.Write(items.data(), items.size());
+    } else {
+      queue.Shove(items.data(), items.size());
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Takes all items out of a standard deque again</summary>
+  /// <param name="deque">Deque the items will be taken from</param>
+  /// <param name="items">Vector the items will be moved into</param>
+  template<typename TItem>
+  void readAll(std::deque<TItem> &deque, std::vector<TItem> &items) {
+    for(TItem &item : items) {
+      item = std::move(deque.front());
+      deque.pop_front();
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Takes all items out of a ring queue or shift queue again</summary>
+  /// <param name="queue">Queue the items will be taken from</param>
+  /// <param name="items">Vector the items will be moved into</param>
+  template<typename TQueue, typename TItem>
+  void readAll(TQueue &queue, std::vector<TItem> &items) {
+    queue.Read(items.data(), items.size());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Provides the items and queues for the queue benchmarks</summary>
+  /// <typeparam name="TItem">Type of items the queues will hold</typeparam>
+  template<typename TItem>
+  class QueueFixture : public CollectionSizeFixture {
+
+    /// <summary>Called before the benchmark runs to create the items and queues</summary>
+    /// <param name="experimentValue">Experiment value holding the number of items</param>
+    public: void setUp(const celero::TestFixture::ExperimentValue &experimentValue) override {
+      CollectionSizeFixture::setUp(experimentValue);
+
+      this->items.reserve(this->problemSize);
+      for(std::size_t index = 0; index < this->problemSize; ++index) {
+        this->items.push_back(makeItem<TItem>(index));
+      }
+
+      this->deque = std::make_unique<std::deque<TItem>>();
+      this->ringQueue = std::make_unique<Nuclex::Support::Collections::RingQueue<TItem>>();
+      this->shiftQueue = std::make_unique<Nuclex::Support::Collections::ShiftQueue<TItem>>();
+    }
+
+    /// <summary>Called after the benchmark completes to free all memory again</summary>
+    public: void tearDown() override {
+      this->shiftQueue.reset();
+      this->ringQueue.reset();
+      this->deque.reset();
+      std::vector<TItem>().swap(this->items);
+    }
+
+    /// <summary>Items that will be passed through the queues</summary>
+    protected: std::vector<TItem> items;
+    /// <summary>Standard deque the other queues are compared against</summary>
+    protected: std::unique_ptr<std::deque<TItem>> deque;
+    /// <summary>Ring queue whose performance will be measured</summary>
+    protected: std::unique_ptr<Nuclex::Support::Collections::RingQueue<TItem>> ringQueue;
+    /// <summary>Shift queue whose performance will be measured</summary>
+    protected: std::unique_ptr<Nuclex::Support::Collections::ShiftQueue<TItem>> shiftQueue;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Queue fixture for items that can be copied with std::memcpy()</summary>
+  typedef QueueFixture<TrivialItem> TrivialQueueFixture;
+
+  /// <summary>Queue fixture for items with user-provided copy and move constructors</summary>
+  typedef QueueFixture<NonTrivialItem> NonTrivialQueueFixture;
+
+  /// <summary>Queue fixture for items that can be moved but not copied</summary>
+  typedef QueueFixture<MoveOnlyItem> MoveOnlyQueueFixture;
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex { namespace Support { namespace Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BASELINE_F(QueueOfTrivialItems, StdDeque, TrivialQueueFixture, 10, 0) {
+    writeAll(*this->deque, this->items);
+    readAll(*this->deque, this->items);
+    celero::DoNotOptimizeAway(digestItem(this->items.back()));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BENCHMARK_F(QueueOfTrivialItems, RingQueue, TrivialQueueFixture, 10, 0) {
+    writeAll(*this->ringQueue, this->items);
+    readAll(*this->ringQueue, this->items);
+    celero::DoNotOptimizeAway(digestItem(this->items.back()));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BENCHMARK_F(QueueOfTrivialItems, ShiftQueue, TrivialQueueFixture, 10, 0) {
+    writeAll(*this->shiftQueue, this->items);
+    readAll(*this->shiftQueue, this->items);
+    celero::DoNotOptimizeAway(digestItem(this->items.back()));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BASELINE_F(QueueOfNonTrivialItems, StdDeque, NonTrivialQueueFixture, 10, 0) {
+    writeAll(*this->deque, this->items);
+    readAll(*this->deque, this->items);
+    celero::DoNotOptimizeAway(digestItem(this->items.back()));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BENCHMARK_F(QueueOfNonTrivialItems, RingQueue, NonTrivialQueueFixture, 10, 0) {
+    writeAll(*this->ringQueue, this->items);
+    readAll(*this->ringQueue, this->items);
+    celero::DoNotOptimizeAway(digestItem(this->items.back()));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BENCHMARK_F(QueueOfNonTrivialItems, ShiftQueue, NonTrivialQueueFixture, 10, 0) {
+    writeAll(*this->shiftQueue, this->items);
+    readAll(*this->shiftQueue, this->items);
+    celero::DoNotOptimizeAway(digestItem(this->items.back()));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BASELINE_F(QueueOfMoveOnlyItems, StdDeque, MoveOnlyQueueFixture, 10, 0) {
+    writeAll(*this->deque, this->items);
+    readAll(*this->deque, this->items);
+    celero::DoNotOptimizeAway(digestItem(this->items.back()));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BENCHMARK_F(QueueOfMoveOnlyItems, RingQueue, MoveOnlyQueueFixture, 10, 0) {
+    writeAll(*this->ringQueue, this->items);
+    readAll(*this->ringQueue, this->items);
+    celero::DoNotOptimizeAway(digestItem(this->items.back()));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BENCHMARK_F(QueueOfMoveOnlyItems, ShiftQueue, MoveOnlyQueueFixture, 10, 0) {
+    writeAll(*this->shiftQueue, this->items);
+    readAll(*this->shiftQueue, this->items);
+    celero::DoNotOptimizeAway(digestItem(this->items.back()));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+}}} // namespace Nuclex::Support::Collections
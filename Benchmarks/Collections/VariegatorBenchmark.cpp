@@ -0,0 +1,187 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Config.h"
+#include "Nuclex/Support/Collections/Variegator.h"
+
+#include "CollectionBenchmark.h"
+
+#include <unordered_map> // for std::unordered_multimap
+#include <algorithm> // for std::shuffle()
+#include <iterator> // for std::distance(), std::next()
+#include <random> // for std::mt19937, std::uniform_int_distribution
+#include <stdexcept> // for std::runtime_error
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Number of different keys the variegators are filled with</summary>
+  const std::size_t VariegatorKeyCount = 64;
+
+  /// <summary>Number of lookups each benchmark sample performs</summary>
+  const std::size_t VariegatorLookupCount = 64 * 1024;
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Picks random values from a standard multimap</summary>
+  /// <typeparam name="TKey">Type of the keys values are looked up by</typeparam>
+  /// <typeparam name="TValue">Type of the values that will be picked from</typeparam>
+  /// <remarks>
+  ///   This is what one would write without the variegator. It doesn't avoid repeating
+  ///   recently returned values, so it only marks the cost of finding a key's values
+  ///   and picking one of them at random.
+  /// </remarks>
+  template<typename TKey, typename TValue>
+  class StdMultimapPicker {
+
+    /// <summary>Adds a value that can be picked when looking up the specified key</summary>
+    /// <param name="key">Key under which the value can be looked up</param>
+    /// <param name="value">Value that will be added under the key</param>
+    public: void Insert(const TKey &key, const TValue &value) {
+      this->values.emplace(key, value);
+    }
+
+    /// <summary>Picks a random value associated with the specified key</summary>
+    /// <param name="key">Key whose values will be picked from</param>
+    /// <returns>A random value associated with the key</returns>
+    public: const TValue &Get(const TKey &key) {
+      std::pair<ConstIterator, ConstIterator> range = this->values.equal_range(key);
+      std::size_t candidateCount = static_cast<std::size_t>(
+        std::distance(range.first, range.second)
+      );
+      if(candidateCount == 0) {
+        throw std::runtime_error(
+          reinterpret_cast<const char *>(u8"No values mapped to specified key")
+        );
+      }
+
+      std::uniform_int_distribution<std::size_t> distributor(0, candidateCount - 1);
+      return std::next(range.first, distributor(this->randomNumberGenerator))->second;
+    }
+
+    /// <summary>Iterator over the values in the multimap</summary>
+    private: typedef typename std::unordered_multimap<TKey, TValue>::const_iterator ConstIterator;
+
+    /// <summary>Values stored under their keys</summary>
+    private: std::unordered_multimap<TKey, TValue> values;
+    /// <summary>Random number generator used to pick values</summary>
+    private: std::mt19937 randomNumberGenerator;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Provides a filled variegator and shuffled keys for the benchmarks</summary>
+  /// <typeparam name="TVariegator">Type of variegator that will be benchmarked</typeparam>
+  /// <remarks>
+  ///   The experiment value is the number of values stored under each key. Each sample
+  ///   performs the same number of lookups so that the results can be compared directly.
+  /// </remarks>
+  template<typename TVariegator>
+  class VariegatorFixture : public celero::TestFixture {
+
+    /// <summary>Provides the numbers of values per key the benchmarks will be run with</summary>
+    /// <returns>A list of values per key and the iterations for each</returns>
+    public: std::vector<celero::TestFixture::ExperimentValue> getExperimentValues(
+    ) const override {
+      std::vector<celero::TestFixture::ExperimentValue> problemSpace;
+      for(std::size_t valuesPerKey = 1; valuesPerKey <= 256; valuesPerKey *= 4) {
+        problemSpace.emplace_back(static_cast<std::int64_t>(valuesPerKey), 1);
+      }
+      return problemSpace;
+    }
+
+    /// <summary>Called before the benchmark runs to fill the variegator</summary>
+    /// <param name="experimentValue">Experiment value holding the values per key</param>
+    public: void setUp(const celero::TestFixture::ExperimentValue &experimentValue) override {
+      std::size_t valuesPerKey = static_cast<std::size_t>(experimentValue.Value);
+
+      this->variegator = std::make_unique<TVariegator>();
+      for(std::size_t key = 0; key < VariegatorKeyCount; ++key) {
+        for(std::size_t index = 0; index < valuesPerKey; ++index) {
+          this->variegator->Insert(key, makeItem<TrivialItem>(key * valuesPerKey + index));
+        }
+      }
+
+      // Visit the keys in random order so neither container can stay on one key
+      this->keys.reserve(VariegatorLookupCount);
+      for(std::size_t index = 0; index < VariegatorLookupCount; ++index) {
+        this->keys.push_back(index % VariegatorKeyCount);
+      }
+      std::shuffle(this->keys.begin(), this->keys.end(), std::mt19937(1234));
+    }
+
+    /// <summary>Called after the benchmark completes to free all memory again</summary>
+    public: void tearDown() override {
+      this->variegator.reset();
+      std::vector<std::size_t>().swap(this->keys);
+    }
+
+    /// <summary>Picks a value for each key and digests the values returned</summary>
+    /// <returns>A number depending on all values that were returned</returns>
+    protected: std::size_t getAll() {
+      std::size_t digest = 0;
+      for(std::size_t key : this->keys) {
+        digest += digestItem(this->variegator->Get(key));
+      }
+      return digest;
+    }
+
+    /// <summary>Keys that will be looked up, in random order</summary>
+    protected: std::vector<std::size_t> keys;
+    /// <summary>Variegator whose performance will be measured</summary>
+    protected: std::unique_ptr<TVariegator> variegator;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Fixture for picking values from a standard multimap</summary>
+  typedef VariegatorFixture<StdMultimapPicker<std::size_t, TrivialItem>> StdMultimapFixture;
+
+  /// <summary>Fixture for picking values from the variegator</summary>
+  typedef VariegatorFixture<
+    Nuclex::Support::Collections::Variegator<std::size_t, TrivialItem>
+  > NuclexVariegatorFixture;
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex { namespace Support { namespace Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BASELINE_F(VariegatorGet, StdUnorderedMultimap, StdMultimapFixture, 10, 0) {
+    celero::DoNotOptimizeAway(this->getAll());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  BENCHMARK_F(VariegatorGet, Variegator, NuclexVariegatorFixture, 10, 0) {
+    celero::DoNotOptimizeAway(this->getAll());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+}}} // namespace Nuclex::Support::Collections
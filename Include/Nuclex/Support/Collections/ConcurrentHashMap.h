@@ -0,0 +1,678 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_SUPPORT_COLLECTIONS_CONCURRENTHASHMAP_H
+#define NUCLEX_SUPPORT_COLLECTIONS_CONCURRENTHASHMAP_H
+
+#include "Nuclex/Support/Config.h"
+#include "Nuclex/Support/Collections/ConcurrentMap.h"
+#include "Nuclex/Support/BitTricks.h" // for BitTricks::GetUpperPowerOfTwo()
+#include "Nuclex/Support/ScopeGuard.h" // for ON_SCOPE_EXIT
+
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint8_t, std::uint32_t
+#include <cstring> // for std::memcpy()
+#include <atomic> // for std::atomic
+#include <memory> // for std::unique_ptr
+#include <vector> // for std::vector
+#include <shared_mutex> // for std::shared_mutex
+#include <mutex> // for std::unique_lock
+#include <functional> // for std::hash, std::equal_to
+#include <new> // for placement new, std::launder()
+#include <type_traits> // for std::is_trivially_copyable
+#include <utility> // for std::move_if_noexcept()
+#include <cassert> // for assert()
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Hash map that can safely be used from multiple threads</summary>
+  /// <typeparam name="TKey">Type of the key the map uses</typeparam>
+  /// <typeparam name="TValue">Type of values that are stored in the map</typeparam>
+  /// <typeparam name="THash">Hash function used to hash the keys</typeparam>
+  /// <typeparam name="TKeyEqual">Comparison function used to check keys for equality</typeparam>
+  /// <remarks>
+  ///   <para>
+  ///     <strong>Thread safety:</strong> any number of threads may access the map
+  ///   </para>
+  ///   <para>
+  ///     <strong>Container type:</strong> striped open-addressing hash table
+  ///   </para>
+  ///   <para>
+  ///     Keys are distributed over a fixed number of stripes by their hash. Each stripe
+  ///     is a small open-addressing hash table with linear probing and its own lock,
+  ///     so threads working on different stripes never block each other. When a stripe
+  ///     fills up, only that stripe is rehashed while the others stay fully usable,
+  ///     spreading the cost of growing the map out over time.
+  ///   </para>
+  ///   <para>
+  ///     If both keys and values are trivially copyable, lookups do not touch the lock
+  ///     at all. Each stripe then also carries a sequence counter which writers
+  ///     increment before and after modifying the stripe. Readers copy the key and value
+  ///     optimistically and retry if the counter changed in the meantime, which means
+  ///     lookups don't write to any shared memory and scale with the number of cores.
+  ///     To keep this safe, tables replaced by a growing rehash are kept alive (in
+  ///     the stripe's table list) until the map is destroyed. A rehash that only clears
+  ///     out deleted slots keeps the capacity and rewrites the current table in place
+  ///     instead, so insert/remove churn does not retire any tables. Since retired tables
+  ///     are each half the size of their successor, they cost at most as much memory as
+  ///     the current tables themselves.
+  ///   </para>
+  ///   <para>
+  ///     For all other types, lookups use a shared lock on the stripe.
+  ///   </para>
+  /// </remarks>
+  template<
+    typename TKey,
+    typename TValue,
+    typename THash = std::hash<TKey>,
+    typename TKeyEqual = std::equal_to<TKey>
+  >
+  class ConcurrentHashMap : public ConcurrentMap<TKey, TValue> {
+
+    /// <summary>Number of stripes the map uses unless specified otherwise</summary>
+    public: static const constexpr std::size_t DefaultStripeCount = 64;
+
+    /// <summary>Whether lookups are done optimistically without locking</summary>
+    public: static const constexpr bool UsesOptimisticReads = (
+      std::is_trivially_copyable<TKey>::value && std::is_trivially_copyable<TValue>::value
+    );
+
+    #pragma region enum SlotState
+
+    /// <summary>States a slot in a stripe's table can be in</summary>
+    private: enum SlotState : std::uint8_t {
+
+      /// <summary>The slot has never been used, ends any probe sequence</summary>
+      Empty = 0,
+      /// <summary>The slot holds a key and its value</summary>
+      Occupied = 1,
+      /// <summary>The slot held an entry that was removed</summary>
+      Deleted = 2
+
+    };
+
+    #pragma endregion // enum SlotState
+
+    #pragma region struct Slot
+
+    /// <summary>Stores a single key-value pair in a stripe's table</summary>
+    private: struct Slot {
+
+      /// <summary>Whether the slot is empty, occupied or deleted</summary>
+      public: std::atomic<std::uint8_t> State;
+      /// <summary>Memory in which the slot's key is constructed</summary>
+      public: alignas(TKey) std::uint8_t KeyStorage[sizeof(TKey)];
+      /// <summary>Memory in which the slot's value is constructed</summary>
+      public: alignas(TValue) std::uint8_t ValueStorage[sizeof(TValue)];
+
+    };
+
+    #pragma endregion // struct Slot
+
+    #pragma region struct Table
+
+    /// <summary>Open-addressing hash table holding the entries of a stripe</summary>
+    private: struct Table {
+
+      /// <summary>Initializes a new table with the specified number of slots</summary>
+      /// <param name="capacity">Number of slots, must be a power of two</param>
+      public: explicit Table(std::size_t capacity) :
+        Capacity(capacity),
+        Slots(new Slot[capacity]) {
+        for(std::size_t index = 0; index < capacity; ++index) {
+          this->Slots[index].State.store(SlotState::Empty, std::memory_order_relaxed);
+        }
+      }
+
+      /// <summary>Number of slots in the table, always a power of two</summary>
+      public: std::size_t Capacity;
+      /// <summary>Slots that store the key-value pairs</summary>
+      public: std::unique_ptr<Slot[]> Slots;
+
+    };
+
+    #pragma endregion // struct Table
+
+    #pragma region struct Stripe
+
+    /// <summary>Independently locked section of the hash map</summary>
+    private: struct alignas(NUCLEX_SUPPORT_CACHE_LINE_SIZE) Stripe {
+
+      /// <summary>Sequence counter that is odd while the stripe is being modified</summary>
+      public: std::atomic<std::uint32_t> Version;
+      /// <summary>Table currently holding the stripe's entries</summary>
+      public: std::atomic<Table *> CurrentTable;
+      /// <summary>Number of entries currently stored in the stripe</summary>
+      public: std::atomic<std::size_t> Count;
+      /// <summary>Number of slots that are either occupied or deleted</summary>
+      public: std::size_t UsedSlotCount;
+      /// <summary>Held exclusively by writers and shared by non-optimistic readers</summary>
+      public: std::shared_mutex Mutex;
+      /// <summary>Current table and, with optimistic reads, all tables it replaced</summary>
+      public: std::vector<std::unique_ptr<Table>> Tables;
+
+    };
+
+    #pragma endregion // struct Stripe
+
+    /// <summary>Initializes a new concurrent hash map</summary>
+    /// <param name="initialCapacity">Number of entries the map can hold without growing</param>
+    /// <param name="stripeCount">
+    ///   Number of independently locked stripes, will be rounded up to a power of two
+    /// </param>
+    public: explicit ConcurrentHashMap(
+      std::size_t initialCapacity = 256, std::size_t stripeCount = DefaultStripeCount
+    ) :
+      stripeCount(
+        static_cast<std::size_t>(
+          BitTricks::GetUpperPowerOfTwo(
+            static_cast<std::uint64_t>((stripeCount < 1) ? 1 : stripeCount)
+          )
+        )
+      ),
+      stripeShift(
+        sizeof(std::size_t) * 8 - BitTricks::GetLogBase2(
+          static_cast<std::uint64_t>(this->stripeCount)
+        )
+      ),
+      stripes(new Stripe[this->stripeCount]) {
+      std::size_t capacityPerStripe = initialCapacity * 4 / 3 / this->stripeCount + 1;
+      capacityPerStripe = static_cast<std::size_t>(
+        BitTricks::GetUpperPowerOfTwo(
+          static_cast<std::uint64_t>((capacityPerStripe < 8) ? 8 : capacityPerStripe)
+        )
+      );
+
+      for(std::size_t index = 0; index < this->stripeCount; ++index) {
+        Stripe &stripe = this->stripes[index];
+        stripe.Version.store(0, std::memory_order_relaxed);
+        stripe.Count.store(0, std::memory_order_relaxed);
+        stripe.UsedSlotCount = 0;
+        stripe.Tables.push_back(std::make_unique<Table>(capacityPerStripe));
+        stripe.CurrentTable.store(stripe.Tables.back().get(), std::memory_order_release);
+      }
+    }
+
+    /// <summary>Frees all memory owned by the concurrent hash map</summary>
+    /// <remarks>
+    ///   The map must not be accessed by any other threads anymore when it is
+    ///   being destroyed.
+    /// </remarks>
+    public: ~ConcurrentHashMap() override {
+      if constexpr(!UsesOptimisticReads) {
+        for(std::size_t index = 0; index < this->stripeCount; ++index) {
+          Table &table = *this->stripes[index].CurrentTable.load(std::memory_order_acquire);
+          for(std::size_t slotIndex = 0; slotIndex < table.Capacity; ++slotIndex) {
+            Slot &slot = table.Slots[slotIndex];
+            if(slot.State.load(std::memory_order_relaxed) == SlotState::Occupied) {
+              getKey(slot)->~TKey();
+              getValue(slot)->~TValue();
+            }
+          }
+        }
+      }
+    }
+
+    /// <summary>Tries to insert an element into the map</summary>
+    /// <param name="key">Key under which the value can be looked up later</param>
+    /// <param name="value">Value that will be stored under its key in the map</param>
+    /// <returns>True if the element was inserted, false if the key already existed</returns>
+    public: bool TryInsert(const TKey &key, const TValue &value) override {
+      std::size_t hash = mixHash(THash()(key));
+      Stripe &stripe = getStripe(hash);
+
+      std::unique_lock<std::shared_mutex> writeLock(stripe.Mutex);
+      if(findSlot(*stripe.CurrentTable.load(std::memory_order_relaxed), hash, key) != nullptr) {
+        return false;
+      }
+
+      beginWrite(stripe);
+      ON_SCOPE_EXIT { endWrite(stripe); };
+
+      // Grow (or just clean out deleted slots) before the table gets too crowded
+      Table *table = stripe.CurrentTable.load(std::memory_order_relaxed);
+      if((stripe.UsedSlotCount + 1) * 4 > table->Capacity * 3) {
+        rehash(stripe);
+        table = stripe.CurrentTable.load(std::memory_order_relaxed);
+      }
+
+      Slot &slot = *findFreeSlot(*table, hash);
+      bool wasDeleted = (slot.State.load(std::memory_order_relaxed) == SlotState::Deleted);
+      new(slot.KeyStorage) TKey(key);
+      {
+        auto destroyKeyScope = ON_SCOPE_EXIT_TRANSACTION { getKey(slot)->~TKey(); };
+        new(slot.ValueStorage) TValue(value);
+        destroyKeyScope.Commit();
+      }
+      slot.State.store(SlotState::Occupied, std::memory_order_release);
+
+      if(!wasDeleted) {
+        ++stripe.UsedSlotCount;
+      }
+      stripe.Count.fetch_add(1, std::memory_order_relaxed);
+
+      return true;
+    }
+
+    /// <summary>Tries to look up an element in the map</summary>
+    /// <param name="key">Key of the element that will be looked up</param>
+    /// <param name="value">Will receive a copy of the value stored in the map</param>
+    /// <returns>True if an element was found, false if the key didn't exist</returns>
+    public: bool TryGet(const TKey &key, TValue &value) const {
+      std::size_t hash = mixHash(THash()(key));
+      Stripe &stripe = getStripe(hash);
+
+      if constexpr(UsesOptimisticReads) {
+        alignas(TValue) std::uint8_t valueCopy[sizeof(TValue)];
+        for(;;) {
+          std::uint32_t version = stripe.Version.load(std::memory_order_acquire);
+          if((version & 1) != 0) {
+            NUCLEX_SUPPORT_CPU_YIELD;
+            continue; // A writer is currently modifying the stripe
+          }
+
+          // Anything we read here may be torn by a concurrent writer, but since both
+          // keys and values are trivially copyable, that's harmless as long as we
+          // throw the result away if the version changed.
+          bool found = false;
+          {
+            const Table &table = *stripe.CurrentTable.load(std::memory_order_acquire);
+            const std::size_t mask = table.Capacity - 1;
+            for(std::size_t probe = 0; probe < table.Capacity; ++probe) {
+              const Slot &slot = table.Slots[(hash + probe) & mask];
+              std::uint8_t state = slot.State.load(std::memory_order_acquire);
+              if(state == SlotState::Empty) {
+                break;
+              } else if(state == SlotState::Occupied) {
+                alignas(TKey) std::uint8_t keyCopy[sizeof(TKey)];
+                std::memcpy(keyCopy, slot.KeyStorage, sizeof(TKey));
+                if(TKeyEqual()(*std::launder(reinterpret_cast<const TKey *>(keyCopy)), key)) {
+                  std::memcpy(valueCopy, slot.ValueStorage, sizeof(TValue));
+                  found = true;
+                  break;
+                }
+              }
+            }
+          }
+
+          std::atomic_thread_fence(std::memory_order_acquire);
+          if(stripe.Version.load(std::memory_order_relaxed) == version) {
+            if(found) {
+              value = *std::launder(reinterpret_cast<const TValue *>(valueCopy));
+            }
+            return found;
+          }
+        }
+      } else {
+        std::shared_lock<std::shared_mutex> readLock(stripe.Mutex);
+        const Slot *slot = findSlot(*stripe.CurrentTable.load(std::memory_order_relaxed), hash, key);
+        if(slot == nullptr) {
+          return false;
+        }
+
+        value = *getValue(*slot);
+        return true;
+      }
+    }
+
+    /// <summary>Checks whether the map contains the specified key</summary>
+    /// <param name="key">Key that will be looked up</param>
+    /// <returns>True if the key was present in the map during the call</returns>
+    public: bool Contains(const TKey &key) const {
+      std::size_t hash = mixHash(THash()(key));
+      Stripe &stripe = getStripe(hash);
+
+      if constexpr(UsesOptimisticReads) {
+        for(;;) {
+          std::uint32_t version = stripe.Version.load(std::memory_order_acquire);
+          if((version & 1) != 0) {
+            NUCLEX_SUPPORT_CPU_YIELD;
+            continue; // A writer is currently modifying the stripe
+          }
+
+          bool found = (
+            findSlot(*stripe.CurrentTable.load(std::memory_order_acquire), hash, key) != nullptr
+          );
+
+          std::atomic_thread_fence(std::memory_order_acquire);
+          if(stripe.Version.load(std::memory_order_relaxed) == version) {
+            return found;
+          }
+        }
+      } else {
+        std::shared_lock<std::shared_mutex> readLock(stripe.Mutex);
+        return (
+          findSlot(*stripe.CurrentTable.load(std::memory_order_relaxed), hash, key) != nullptr
+        );
+      }
+    }
+
+    /// <summary>Tries to take an element from the map (removing it)</summary>
+    /// <param name="key">Key of the element that will be taken from the map</param>
+    /// <param name="value">Will receive the value taken from the map</param>
+    /// <returns>
+    ///   True if an element was taken from the map, false if the key didn't exist
+    /// </returns>
+    public: bool TryTake(const TKey &key, TValue &value) override {
+      std::size_t hash = mixHash(THash()(key));
+      Stripe &stripe = getStripe(hash);
+
+      std::unique_lock<std::shared_mutex> writeLock(stripe.Mutex);
+      Slot *slot = findSlot(*stripe.CurrentTable.load(std::memory_order_relaxed), hash, key);
+      if(slot == nullptr) {
+        return false;
+      }
+
+      beginWrite(stripe);
+      ON_SCOPE_EXIT {
+        removeSlot(stripe, *slot);
+        endWrite(stripe);
+      };
+      value = std::move(*getValue(*slot));
+
+      return true;
+    }
+
+    /// <summary>Removes the specified element from the map if it exists</summary>
+    /// <param name="key">Key of the element that will be removed if present</param>
+    /// <returns>True if the element was found and removed, false otherwise</returns>
+    public: bool TryRemove(const TKey &key) override {
+      std::size_t hash = mixHash(THash()(key));
+      Stripe &stripe = getStripe(hash);
+
+      std::unique_lock<std::shared_mutex> writeLock(stripe.Mutex);
+      Slot *slot = findSlot(*stripe.CurrentTable.load(std::memory_order_relaxed), hash, key);
+      if(slot == nullptr) {
+        return false;
+      }
+
+      beginWrite(stripe);
+      removeSlot(stripe, *slot);
+      endWrite(stripe);
+
+      return true;
+    }
+
+    /// <summary>Counts the number of elements currently in the map</summary>
+    /// <returns>
+    ///   The approximate number of elements that had been in the map during the call
+    /// </returns>
+    public: std::size_t Count() const override {
+      std::size_t count = 0;
+      for(std::size_t index = 0; index < this->stripeCount; ++index) {
+        count += this->stripes[index].Count.load(std::memory_order_relaxed);
+      }
+      return count;
+    }
+
+    /// <summary>Checks if the map is empty</summary>
+    /// <returns>True if the map had been empty during the call</returns>
+    public: bool IsEmpty() const override {
+      for(std::size_t index = 0; index < this->stripeCount; ++index) {
+        if(this->stripes[index].Count.load(std::memory_order_relaxed) != 0) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /// <summary>Scrambles the bits of a hash so that all bits depend on the input</summary>
+    /// <param name="hash">Hash value that will be scrambled</param>
+    /// <returns>The scrambled hash value</returns>
+    /// <remarks>
+    ///   Standard library hashes of integers are often the integer itself. Since the stripe
+    ///   is selected by the upper bits and the slot by the lower bits, we need both ends
+    ///   of the hash to be well distributed.
+    /// </remarks>
+    private: static std::size_t mixHash(std::size_t hash) {
+      if constexpr(sizeof(std::size_t) >= 8) {
+        hash ^= (hash >> 33);
+        hash *= static_cast<std::size_t>(0xFF51AFD7ED558CCDull);
+        hash ^= (hash >> 33);
+      } else {
+        hash ^= (hash >> 16);
+        hash *= static_cast<std::size_t>(0x85EBCA6Bu);
+        hash ^= (hash >> 13);
+      }
+      return hash;
+    }
+
+    /// <summary>Looks up the stripe responsible for the specified hash</summary>
+    /// <param name="hash">Mixed hash of the key whose stripe will be looked up</param>
+    /// <returns>The stripe in which keys with the specified hash are stored</returns>
+    private: Stripe &getStripe(std::size_t hash) const {
+      if(this->stripeCount == 1) {
+        return this->stripes[0]; // Shifting by the full bit width would be undefined
+      } else {
+        return this->stripes[hash >> this->stripeShift];
+      }
+    }
+
+    /// <summary>Looks for the slot holding the specified key</summary>
+    /// <param name="table">Table that will be searched</param>
+    /// <param name="hash">Mixed hash of the key</param>
+    /// <param name="key">Key that will be searched for</param>
+    /// <returns>The slot holding the key or a null pointer if the key wasn't found</returns>
+    private: static Slot *findSlot(const Table &table, std::size_t hash, const TKey &key) {
+      const std::size_t mask = table.Capacity - 1;
+      for(std::size_t probe = 0; probe < table.Capacity; ++probe) {
+        Slot &slot = table.Slots[(hash + probe) & mask];
+        std::uint8_t state = slot.State.load(std::memory_order_acquire);
+        if(state == SlotState::Empty) {
+          return nullptr;
+        } else if(state == SlotState::Occupied) {
+          if(TKeyEqual()(*getKey(slot), key)) {
+            return &slot;
+          }
+        }
+      }
+
+      return nullptr;
+    }
+
+    /// <summary>Looks for the first slot in the key's probe sequence a key can go into</summary>
+    /// <param name="table">Table that will be searched</param>
+    /// <param name="hash">Mixed hash of the key</param>
+    /// <returns>The first empty or deleted slot in the probe sequence</returns>
+    private: static Slot *findFreeSlot(const Table &table, std::size_t hash) {
+      const std::size_t mask = table.Capacity - 1;
+      for(std::size_t probe = 0; probe < table.Capacity; ++probe) {
+        Slot &slot = table.Slots[(hash + probe) & mask];
+        if(slot.State.load(std::memory_order_relaxed) != SlotState::Occupied) {
+          return &slot;
+        }
+      }
+
+      assert(!u8"Stripe table always has at least one free slot");
+      return nullptr;
+    }
+
+    /// <summary>Destroys the entry in a slot and marks the slot as deleted</summary>
+    /// <param name="stripe">Stripe the slot belongs to</param>
+    /// <param name="slot">Slot whose entry will be destroyed</param>
+    private: static void removeSlot(Stripe &stripe, Slot &slot) {
+      slot.State.store(SlotState::Deleted, std::memory_order_release);
+      getValue(slot)->~TValue();
+      getKey(slot)->~TKey();
+      stripe.Count.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /// <summary>Moves all entries of a stripe into a new, appropriately sized table</summary>
+    /// <param name="stripe">Stripe that will be rehashed</param>
+    /// <remarks>
+    ///   Must be called with the stripe's lock held exclusively and inside a write section
+    /// </remarks>
+    private: void rehash(Stripe &stripe) {
+      Table &oldTable = *stripe.CurrentTable.load(std::memory_order_relaxed);
+      std::size_t count = stripe.Count.load(std::memory_order_relaxed);
+
+      // If most of the used slots are deleted ones, reclaiming them is enough
+      std::size_t newCapacity = oldTable.Capacity;
+      if((count + 1) * 2 > oldTable.Capacity) {
+        newCapacity *= 2;
+      }
+
+      // Make room in the table list up front, so that the new table can be handed
+      // over to it without anything that could throw once it has been published
+      stripe.Tables.reserve(stripe.Tables.size() + 1);
+
+      std::unique_ptr<Table> newTable = std::make_unique<Table>(newCapacity);
+      {
+        std::size_t copiedCount = 0;
+        auto rollbackScope = ON_SCOPE_EXIT_TRANSACTION {
+          for(std::size_t index = 0; (index < newCapacity) && (copiedCount > 0); ++index) {
+            Slot &slot = newTable->Slots[index];
+            if(slot.State.load(std::memory_order_relaxed) == SlotState::Occupied) {
+              getValue(slot)->~TValue();
+              getKey(slot)->~TKey();
+              --copiedCount;
+            }
+          }
+        };
+
+        for(std::size_t index = 0; index < oldTable.Capacity; ++index) {
+          Slot &oldSlot = oldTable.Slots[index];
+          if(oldSlot.State.load(std::memory_order_relaxed) == SlotState::Occupied) {
+            TKey *key = getKey(oldSlot);
+            Slot &newSlot = *findFreeSlot(*newTable, mixHash(THash()(*key)));
+            new(newSlot.KeyStorage) TKey(std::move_if_noexcept(*key));
+            {
+              auto destroyKeyScope = ON_SCOPE_EXIT_TRANSACTION { getKey(newSlot)->~TKey(); };
+              new(newSlot.ValueStorage) TValue(std::move_if_noexcept(*getValue(oldSlot)));
+              destroyKeyScope.Commit();
+            }
+            newSlot.State.store(SlotState::Occupied, std::memory_order_relaxed);
+            ++copiedCount;
+          }
+        }
+
+        rollbackScope.Commit();
+      }
+
+      stripe.UsedSlotCount = count;
+
+      // Optimistic readers may still be looking at the old table. Since their types are
+      // trivially copyable, there is nothing to destroy and we just keep the memory alive.
+      // Otherwise, every reader holds the lock and the old table can go right away.
+      if constexpr(UsesOptimisticReads) {
+        if(newCapacity == oldTable.Capacity) {
+          copyTableInPlace(oldTable, *newTable);
+        } else {
+          Table *publishedTable = newTable.get();
+          stripe.Tables.push_back(std::move(newTable)); // Can't throw, room was reserved
+          stripe.CurrentTable.store(publishedTable, std::memory_order_release);
+        }
+      } else {
+        Table *publishedTable = newTable.get();
+        stripe.Tables.push_back(std::move(newTable)); // Can't throw, room was reserved
+        stripe.CurrentTable.store(publishedTable, std::memory_order_release);
+
+        for(std::size_t index = 0; index < oldTable.Capacity; ++index) {
+          Slot &oldSlot = oldTable.Slots[index];
+          if(oldSlot.State.load(std::memory_order_relaxed) == SlotState::Occupied) {
+            getValue(oldSlot)->~TValue();
+            getKey(oldSlot)->~TKey();
+          }
+        }
+        stripe.Tables.erase(stripe.Tables.begin(), stripe.Tables.end() - 1);
+      }
+    }
+
+    /// <summary>Overwrites a table with the contents of another table of equal size</summary>
+    /// <param name="targetTable">Table that will be overwritten</param>
+    /// <param name="sourceTable">Table whose slots will be copied</param>
+    /// <remarks>
+    ///   Only used with optimistic reads, where keys and values are trivially copyable
+    ///   and must be called inside a write section. Readers walking the table while it
+    ///   is being overwritten may see a mix of old and new slots, but they will notice
+    ///   the changed version and retry.
+    /// </remarks>
+    private: static void copyTableInPlace(Table &targetTable, const Table &sourceTable) {
+      assert(
+        (targetTable.Capacity == sourceTable.Capacity) &&
+        u8"In-place table copy requires tables of equal size"
+      );
+      for(std::size_t index = 0; index < targetTable.Capacity; ++index) {
+        Slot &targetSlot = targetTable.Slots[index];
+        const Slot &sourceSlot = sourceTable.Slots[index];
+
+        std::uint8_t state = sourceSlot.State.load(std::memory_order_relaxed);
+        if(state == SlotState::Occupied) {
+          std::memcpy(targetSlot.KeyStorage, sourceSlot.KeyStorage, sizeof(TKey));
+          std::memcpy(targetSlot.ValueStorage, sourceSlot.ValueStorage, sizeof(TValue));
+        }
+        targetSlot.State.store(state, std::memory_order_release);
+      }
+    }
+
+    /// <summary>Marks the beginning of a modification to a stripe</summary>
+    /// <param name="stripe">Stripe that will be modified</param>
+    private: static void beginWrite(Stripe &stripe) {
+      if constexpr(UsesOptimisticReads) {
+        std::uint32_t version = stripe.Version.load(std::memory_order_relaxed);
+        stripe.Version.store(version + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+      } else {
+        (void)stripe;
+      }
+    }
+
+    /// <summary>Marks the end of a modification to a stripe</summary>
+    /// <param name="stripe">Stripe that has been modified</param>
+    private: static void endWrite(Stripe &stripe) {
+      if constexpr(UsesOptimisticReads) {
+        std::uint32_t version = stripe.Version.load(std::memory_order_relaxed);
+        stripe.Version.store(version + 1, std::memory_order_release);
+      } else {
+        (void)stripe;
+      }
+    }
+
+    /// <summary>Retrieves the key stored in a slot</summary>
+    /// <param name="slot">Slot whose key will be retrieved</param>
+    /// <returns>The key stored in the slot</returns>
+    private: static TKey *getKey(const Slot &slot) {
+      return std::launder(reinterpret_cast<TKey *>(const_cast<std::uint8_t *>(slot.KeyStorage)));
+    }
+
+    /// <summary>Retrieves the value stored in a slot</summary>
+    /// <param name="slot">Slot whose value will be retrieved</param>
+    /// <returns>The value stored in the slot</returns>
+    private: static TValue *getValue(const Slot &slot) {
+      return std::launder(
+        reinterpret_cast<TValue *>(const_cast<std::uint8_t *>(slot.ValueStorage))
+      );
+    }
+
+    /// <summary>Number of stripes the map is divided into, always a power of two</summary>
+    private: const std::size_t stripeCount;
+    /// <summary>Number of bits a hash is shifted to the right to obtain the stripe</summary>
+    private: const std::size_t stripeShift;
+    /// <summary>Independently locked sections of the map</summary>
+    private: std::unique_ptr<Stripe[]> stripes;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
+
+#endif // NUCLEX_SUPPORT_COLLECTIONS_CONCURRENTHASHMAP_H
@@ -0,0 +1,759 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_SUPPORT_COLLECTIONS_CONCURRENTHASHSET_H
+#define NUCLEX_SUPPORT_COLLECTIONS_CONCURRENTHASHSET_H
+
+#include "Nuclex/Support/Config.h"
+#include "Nuclex/Support/Collections/ConcurrentSet.h"
+#include "Nuclex/Support/BitTricks.h" // for BitTricks::GetUpperPowerOfTwo()
+#include "Nuclex/Support/ScopeGuard.h" // for ON_SCOPE_EXIT
+
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint8_t, std::uint32_t
+#include <atomic> // for std::atomic
+#include <memory> // for std::unique_ptr
+#include <functional> // for std::hash, std::equal_to
+#include <new> // for placement new, std::launder()
+#include <type_traits> // for std::is_trivially_copyable
+#include <bit> // for std::countr_zero()
+#include <vector> // for std::vector
+#include <thread> // for std::this_thread::yield()
+
+#if defined(NUCLEX_SUPPORT_SSE2_AVAILABLE)
+#include <emmintrin.h> // for _mm_cmpeq_epi8(), _mm_movemask_epi8()
+#elif defined(NUCLEX_SUPPORT_NEON_AVAILABLE)
+#include <arm_neon.h> // for vceqq_u8(), vaddv_u8()
+#endif
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>
+  ///   Hash set for small, trivially copyable keys with lock-free lookups and inserts
+  ///   outside of rebuilds, blocking while the table grows
+  /// </summary>
+  /// <typeparam name="TKey">Type of the keys the set will keep track of</typeparam>
+  /// <typeparam name="THash">Hash function used to hash the keys</typeparam>
+  /// <typeparam name="TKeyEqual">Comparison function used to check keys for equality</typeparam>
+  /// <remarks>
+  ///   <para>
+  ///     <strong>Thread safety:</strong> any number of threads may access the set
+  ///   </para>
+  ///   <para>
+  ///     <strong>Container type:</strong> growing open-addressing hash table
+  ///   </para>
+  ///   <para>
+  ///     The layout follows the design of Swiss tables: keys live in one array and
+  ///     a separate array holds one control byte per key with 7 bits of its hash.
+  ///     Control bytes are examined 16 at a time with SSE2 or NEON, so most lookups
+  ///     only compare the one key that actually matches.
+  ///   </para>
+  ///   <para>
+  ///     Slots are claimed with a compare-and-swap on the control byte. Removing a key
+  ///     only flags its control byte and inserting the same key again clears the flag.
+  ///     This is what makes concurrent insertions and removals safe without locks, but
+  ///     it also means removed slots can't be handed to other keys while other threads
+  ///     are probing the table.
+  ///   </para>
+  ///   <para>
+  ///     Once all usable slots have been claimed, the thread that ran into the limit
+  ///     freezes the table and waits for the operations still running on it to finish.
+  ///     It then either rebuilds the table in place, dropping the removed keys, or, if
+  ///     most slots hold live keys, moves the keys into a table twice the size. Threads
+  ///     arriving during the rebuild wait for it to complete. Each operation announces
+  ///     itself on one of several per-thread counters, so apart from the rare rebuild
+  ///     threads do not contend with each other.
+  ///   </para>
+  ///   <para>
+  ///     The control and key arrays of a table that was replaced are freed right away.
+  ///     Only its small header with the activity counters stays around until the set is
+  ///     destroyed, because late threads may still look at it to notice the table was
+  ///     replaced. Since each replacement doubles the size, there are few of those.
+  ///   </para>
+  /// </remarks>
+  template<
+    typename TKey,
+    typename THash = std::hash<TKey>,
+    typename TKeyEqual = std::equal_to<TKey>
+  >
+  class ConcurrentHashSet : public ConcurrentSet<TKey> {
+
+    static_assert(
+      std::is_trivially_copyable<TKey>::value,
+      u8"ConcurrentHashSet can only store trivially copyable keys"
+    );
+    static_assert(
+      sizeof(std::atomic<std::uint8_t>) == 1,
+      u8"Control bytes can be examined as plain bytes"
+    );
+
+    /// <summary>Number of counters operations are spread over</summary>
+    private: static const constexpr std::size_t ActivityCounterCount = 16;
+
+    #pragma region enum ControlByte
+
+    /// <summary>Special values a control byte can take on</summary>
+    /// <remarks>
+    ///   Slots holding a key have the key's 7 bit hash tag (1 to 126) in their control
+    ///   byte. If the key was removed, the most significant bit is set in addition.
+    /// </remarks>
+    private: enum ControlByte : std::uint8_t {
+
+      /// <summary>The slot has never been used, ends any probe sequence</summary>
+      Empty = 0x80,
+      /// <summary>A thread has claimed the slot and is storing its key</summary>
+      Busy = 0xFF,
+      /// <summary>Flag set in the control byte when a key has been removed</summary>
+      RemovedFlag = 0x80
+
+    };
+
+    #pragma endregion // enum ControlByte
+
+    #pragma region enum InsertResult
+
+    /// <summary>Outcomes of an attempt to insert a key into a table</summary>
+    private: enum class InsertResult {
+
+      /// <summary>The key was inserted</summary>
+      Inserted,
+      /// <summary>The key was already present in the table</summary>
+      AlreadyPresent,
+      /// <summary>The table has no usable slots left and needs to be rebuilt</summary>
+      Full
+
+    };
+
+    #pragma endregion // enum InsertResult
+
+    #pragma region struct Group
+
+    /// <summary>Block of control bytes that is probed in one go</summary>
+    private: struct alignas(16) Group {
+
+      /// <summary>Control bytes of the slots in the group</summary>
+      public: std::atomic<std::uint8_t> Controls[16];
+
+    };
+
+    #pragma endregion // struct Group
+
+    #pragma region struct KeySlot
+
+    /// <summary>Memory in which a key is stored</summary>
+    private: struct KeySlot {
+
+      /// <summary>Memory for the key, written once when the slot is claimed</summary>
+      public: alignas(TKey) std::uint8_t Storage[sizeof(TKey)];
+
+    };
+
+    #pragma endregion // struct KeySlot
+
+    #pragma region struct ActivityCounter
+
+    /// <summary>Counts the operations a group of threads is running on a table</summary>
+    private: struct alignas(NUCLEX_SUPPORT_CACHE_LINE_SIZE) ActivityCounter {
+
+      /// <summary>Number of operations currently running</summary>
+      public: std::atomic<std::size_t> Count;
+
+    };
+
+    #pragma endregion // struct ActivityCounter
+
+    #pragma region struct Table
+
+    /// <summary>Control bytes and keys of all slots plus the state guarding them</summary>
+    private: struct Table {
+
+      /// <summary>Initializes a new table with the specified number of slots</summary>
+      /// <param name="slotCount">Number of slots, must be a power of two of at least 16</param>
+      public: explicit Table(std::size_t slotCount) :
+        SlotCount(slotCount),
+        GroupMask(slotCount / 16 - 1),
+        MaximumUsedSlotCount(slotCount / 8 * 7),
+        Groups(new Group[slotCount / 16]),
+        Keys(new KeySlot[slotCount]),
+        UsedSlotCount(0),
+        IsFrozen(false),
+        Activity(),
+        Replaced() {
+        Clear();
+        for(std::size_t index = 0; index < ActivityCounterCount; ++index) {
+          this->Activity[index].Count.store(0, std::memory_order_relaxed);
+        }
+      }
+
+      /// <summary>Marks all slots of the table as empty</summary>
+      /// <remarks>
+      ///   Must only be called while no other thread can access the table
+      /// </remarks>
+      public: void Clear() {
+        for(std::size_t groupIndex = 0; groupIndex <= this->GroupMask; ++groupIndex) {
+          for(std::size_t lane = 0; lane < 16; ++lane) {
+            this->Groups[groupIndex].Controls[lane].store(
+              ControlByte::Empty, std::memory_order_relaxed
+            );
+          }
+        }
+        this->UsedSlotCount.store(0, std::memory_order_relaxed);
+      }
+
+      /// <summary>Total number of slots, always a power of two and at least 16</summary>
+      public: const std::size_t SlotCount;
+      /// <summary>Bit mask that wraps group indices around</summary>
+      public: const std::size_t GroupMask;
+      /// <summary>Number of slots that can be used before the table is full</summary>
+      public: const std::size_t MaximumUsedSlotCount;
+      /// <summary>Control bytes for all slots, in groups of 16</summary>
+      public: std::unique_ptr<Group[]> Groups;
+      /// <summary>Keys of all slots</summary>
+      public: std::unique_ptr<KeySlot[]> Keys;
+      /// <summary>Number of slots that have been claimed by a key</summary>
+      public: std::atomic<std::size_t> UsedSlotCount;
+      /// <summary>Set while the table is being rebuilt or after it has been replaced</summary>
+      public: alignas(NUCLEX_SUPPORT_CACHE_LINE_SIZE) std::atomic<bool> IsFrozen;
+      /// <summary>Operations currently running on the table, spread over threads</summary>
+      public: ActivityCounter Activity[ActivityCounterCount];
+      /// <summary>Table this one replaced, kept because late threads may look at it</summary>
+      public: std::unique_ptr<Table> Replaced;
+
+    };
+
+    #pragma endregion // struct Table
+
+    /// <summary>Initializes a new concurrent hash set</summary>
+    /// <param name="capacity">Number of keys the set can hold before it has to grow</param>
+    public: explicit ConcurrentHashSet(std::size_t capacity) :
+      currentTable(new Table(getSlotCountForCapacity(capacity))),
+      count(0) {
+      std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    /// <summary>Destroys the concurrent hash set</summary>
+    public: ~ConcurrentHashSet() override {
+      delete this->currentTable.load(std::memory_order_acquire);
+    }
+
+    /// <summary>Tries to insert a key into the set</summary>
+    /// <param name="key">Key that will be inserted into the set</param>
+    /// <returns>True if the key was inserted, false if the key already existed</returns>
+    /// <remarks>
+    ///   If the set is full, it will be rebuilt or grown, so the only way an insertion
+    ///   can fail for other reasons is a std::bad_alloc exception when growing.
+    /// </remarks>
+    public: bool TryInsert(const TKey &key) override {
+      std::size_t hash = mixHash(THash()(key));
+      std::uint8_t tag = getTag(hash);
+
+      for(;;) {
+        Table *table = enterTable();
+        InsertResult result;
+        {
+          ON_SCOPE_EXIT { leaveTable(*table); };
+          result = tryInsert(*table, hash, tag, key);
+        }
+
+        if(result == InsertResult::Inserted) {
+          this->count.fetch_add(1, std::memory_order_relaxed);
+          return true;
+        } else if(result == InsertResult::AlreadyPresent) {
+          return false;
+        }
+
+        rebuild(*table);
+      }
+    }
+
+    /// <summary>Tries to remove a key from the set</summary>
+    /// <param name="key">Key that will be removed from the set</param>
+    /// <returns>
+    ///   True if the key was removed from the set, false if the key didn't exist
+    /// </returns>
+    public: bool TryRemove(const TKey &key) override {
+      std::size_t hash = mixHash(THash()(key));
+      std::uint8_t tag = getTag(hash);
+
+      Table *table = enterTable();
+      ON_SCOPE_EXIT { leaveTable(*table); };
+
+      std::atomic<std::uint8_t> *control = findControl(*table, hash, tag, key);
+      if(control == nullptr) {
+        return false;
+      }
+
+      std::uint8_t expected = tag;
+      bool removed = control->compare_exchange_strong(
+        expected, tag | RemovedFlag, std::memory_order_acq_rel, std::memory_order_relaxed
+      );
+      if(removed) {
+        this->count.fetch_sub(1, std::memory_order_relaxed);
+      }
+
+      return removed;
+    }
+
+    /// <summary>Checks whether the set contains the specified key</summary>
+    /// <param name="key">Key that will be looked up</param>
+    /// <returns>True if the key was present during the call</returns>
+    public: bool Contains(const TKey &key) const {
+      std::size_t hash = mixHash(THash()(key));
+      std::uint8_t tag = getTag(hash);
+
+      Table *table = enterTable();
+      ON_SCOPE_EXIT { leaveTable(*table); };
+
+      const std::atomic<std::uint8_t> *control = findControl(*table, hash, tag, key);
+      return (
+        (control != nullptr) &&
+        (control->load(std::memory_order_acquire) == tag)
+      );
+    }
+
+    /// <summary>Counts the number of keys currently in the set</summary>
+    /// <returns>
+    ///   The approximate number of keys that had been in the set during the call
+    /// </returns>
+    public: std::size_t Count() const override {
+      return this->count.load(std::memory_order_relaxed);
+    }
+
+    /// <summary>Checks if the set is empty</summary>
+    /// <returns>True if the set had been empty during the call</returns>
+    public: bool IsEmpty() const override {
+      return (this->count.load(std::memory_order_relaxed) == 0);
+    }
+
+    /// <summary>Returns the number of keys the set can hold before it has to grow</summary>
+    /// <returns>The number of keys that fit into the set's current table</returns>
+    /// <remarks>
+    ///   Removed keys keep occupying their slot until the table is next rebuilt, so this
+    ///   is the number of insertions of new keys that can happen before a rebuild.
+    /// </remarks>
+    public: std::size_t GetCapacity() const {
+      return this->currentTable.load(std::memory_order_acquire)->MaximumUsedSlotCount;
+    }
+
+    /// <summary>Calculates the number of slots needed to hold the specified keys</summary>
+    /// <param name="capacity">Number of keys the table should be able to hold</param>
+    /// <returns>The number of slots the table should have</returns>
+    private: static std::size_t getSlotCountForCapacity(std::size_t capacity) {
+      return static_cast<std::size_t>(
+        BitTricks::GetUpperPowerOfTwo(
+          static_cast<std::uint64_t>((capacity < 14) ? 16 : (capacity + capacity / 7 + 1))
+        )
+      );
+    }
+
+    /// <summary>Announces an operation on the current table</summary>
+    /// <returns>The table the operation can safely work on</returns>
+    /// <remarks>
+    ///   If the table is being rebuilt, this waits until the rebuild is complete.
+    ///   Each call must be paired with a call to <see cref="leaveTable" />.
+    /// </remarks>
+    private: Table *enterTable() const {
+      std::size_t counterIndex = getActivityCounterIndex();
+      for(;;) {
+        Table *table = this->currentTable.load(std::memory_order_acquire);
+
+        // Sequential consistency on both sides makes sure that either we see the table
+        // being frozen or the rebuilding thread sees our counter increment
+        table->Activity[counterIndex].Count.fetch_add(1, std::memory_order_seq_cst);
+        if(!table->IsFrozen.load(std::memory_order_seq_cst)) [[likely]] {
+          return table;
+        }
+        table->Activity[counterIndex].Count.fetch_sub(1, std::memory_order_release);
+
+        // Wait until the table was either rebuilt in place or replaced
+        while(
+          table->IsFrozen.load(std::memory_order_acquire) &&
+          (this->currentTable.load(std::memory_order_acquire) == table)
+        ) {
+          std::this_thread::yield();
+        }
+      }
+    }
+
+    /// <summary>Announces that an operation on a table has finished</summary>
+    /// <param name="table">Table that was returned by <see cref="enterTable" /></param>
+    private: static void leaveTable(Table &table) {
+      table.Activity[getActivityCounterIndex()].Count.fetch_sub(1, std::memory_order_release);
+    }
+
+    /// <summary>Looks up the activity counter the calling thread should use</summary>
+    /// <returns>The index of the activity counter for the calling thread</returns>
+    private: static std::size_t getActivityCounterIndex() {
+      static std::atomic<std::size_t> nextIndex(0);
+      thread_local std::size_t index = (
+        nextIndex.fetch_add(1, std::memory_order_relaxed) % ActivityCounterCount
+      );
+      return index;
+    }
+
+    /// <summary>Cleans out or grows a table that has run out of usable slots</summary>
+    /// <param name="table">Table that was found to be full</param>
+    /// <remarks>
+    ///   If another thread is already rebuilding the table, this returns immediately
+    ///   and the caller will wait for the rebuild when it enters the table again.
+    /// </remarks>
+    private: void rebuild(Table &table) {
+      bool wasFrozen = false;
+      if(!table.IsFrozen.compare_exchange_strong(wasFrozen, true, std::memory_order_seq_cst)) {
+        return;
+      }
+      auto unfreezeScope = ON_SCOPE_EXIT_TRANSACTION {
+        table.IsFrozen.store(false, std::memory_order_release);
+      };
+
+      // Wait for all operations still running on the table to finish
+      for(std::size_t index = 0; index < ActivityCounterCount; ++index) {
+        while(table.Activity[index].Count.load(std::memory_order_seq_cst) != 0) {
+          std::this_thread::yield();
+        }
+      }
+
+      // Another thread may have completed a rebuild between our caller finding the table
+      // full and us freezing it, in which case there's nothing left to do
+      if(table.UsedSlotCount.load(std::memory_order_relaxed) < table.MaximumUsedSlotCount) {
+        return; // Scope guard unfreezes the table
+      }
+
+      // Collect the live keys, this is the only step that can throw while the table
+      // is still untouched
+      std::vector<TKey> liveKeys;
+      liveKeys.reserve(this->count.load(std::memory_order_relaxed));
+      for(std::size_t index = 0; index < table.SlotCount; ++index) {
+        std::uint8_t control = table.Groups[index / 16].Controls[index % 16].load(
+          std::memory_order_relaxed
+        );
+        if((control & RemovedFlag) == 0) {
+          liveKeys.push_back(*getKey(table.Keys[index]));
+        }
+      }
+
+      // If at least half the slots would be free after dropping the removed keys,
+      // rebuilding in place is enough. Otherwise, the set has to grow.
+      if(liveKeys.size() * 2 <= table.MaximumUsedSlotCount) {
+        table.Clear();
+        reinsertKeys(table, liveKeys);
+      } else {
+        std::unique_ptr<Table> newTable(new Table(table.SlotCount * 2));
+        reinsertKeys(*newTable, liveKeys);
+
+        // Threads can only touch the control and key arrays after entering the table,
+        // which they will never be able to do again, so the arrays can go right away
+        unfreezeScope.Commit();
+        newTable->Replaced.reset(&table);
+        this->currentTable.store(newTable.release(), std::memory_order_release);
+        table.Groups.reset();
+        table.Keys.reset();
+      }
+    }
+
+    /// <summary>Inserts keys known to be unique into a table nobody else accesses</summary>
+    /// <param name="table">Table the keys will be inserted into</param>
+    /// <param name="keys">Keys that will be inserted</param>
+    private: static void reinsertKeys(Table &table, const std::vector<TKey> &keys) {
+      for(const TKey &key : keys) {
+        std::size_t hash = mixHash(THash()(key));
+        std::uint8_t tag = getTag(hash);
+
+        std::size_t groupIndex = hash & table.GroupMask;
+        for(std::size_t step = 1; ; ++step) {
+          Group &group = table.Groups[groupIndex];
+          std::uint32_t empties;
+          findCandidates(group, tag, empties);
+          if(empties != 0) {
+            int lane = std::countr_zero(empties);
+            new(table.Keys[groupIndex * 16 + lane].Storage) TKey(key);
+            group.Controls[lane].store(tag, std::memory_order_relaxed);
+            table.UsedSlotCount.fetch_add(1, std::memory_order_relaxed);
+            break;
+          }
+
+          groupIndex = (groupIndex + step) & table.GroupMask; // triangular probing
+        }
+      }
+    }
+
+    /// <summary>Tries to insert a key into the specified table</summary>
+    /// <param name="table">Table the key will be inserted into</param>
+    /// <param name="hash">Mixed hash of the key</param>
+    /// <param name="tag">7 bit tag derived from the hash</param>
+    /// <param name="key">Key that will be inserted</param>
+    /// <returns>Whether the key was inserted, already present or the table is full</returns>
+    private: static InsertResult tryInsert(
+      Table &table, std::size_t hash, std::uint8_t tag, const TKey &key
+    ) {
+      std::size_t groupIndex = hash & table.GroupMask;
+      for(std::size_t step = 1; step <= table.GroupMask + 1; ++step) {
+        Group &group = table.Groups[groupIndex];
+        KeySlot *groupKeys = &table.Keys[groupIndex * 16];
+
+        for(;;) {
+          std::uint32_t empties;
+          std::uint32_t candidates = findCandidates(group, tag, empties);
+
+          // Look for the key in all lanes before the first empty one. Lanes behind
+          // an empty lane can't contain our key as the empty lane would have been used.
+          while(candidates != 0) {
+            int lane = std::countr_zero(candidates);
+            candidates &= candidates - 1;
+
+            std::uint8_t control = waitWhileBusy(group.Controls[lane]);
+            if((control | RemovedFlag) != (tag | RemovedFlag)) {
+              continue;
+            }
+            if(!TKeyEqual()(*getKey(groupKeys[lane]), key)) {
+              continue;
+            }
+
+            // The key was in the set before. If it was removed, revive it.
+            while(control != tag) {
+              bool revived = group.Controls[lane].compare_exchange_weak(
+                control, tag, std::memory_order_acq_rel, std::memory_order_acquire
+              );
+              if(revived) {
+                return InsertResult::Inserted;
+              }
+            }
+
+            return InsertResult::AlreadyPresent;
+          }
+
+          if(empties == 0) {
+            break; // Group is full, move on to the next group in the probe sequence
+          }
+
+          // Key isn't in the set, so try to claim the first empty slot for it
+          std::size_t usedSlotCount = table.UsedSlotCount.load(std::memory_order_relaxed);
+          if(usedSlotCount >= table.MaximumUsedSlotCount) {
+            return InsertResult::Full;
+          }
+
+          int lane = std::countr_zero(empties);
+          std::uint8_t expected = ControlByte::Empty;
+          bool claimed = group.Controls[lane].compare_exchange_strong(
+            expected, ControlByte::Busy, std::memory_order_acq_rel, std::memory_order_relaxed
+          );
+          if(claimed) {
+            new(groupKeys[lane].Storage) TKey(key);
+            group.Controls[lane].store(tag, std::memory_order_release);
+            table.UsedSlotCount.fetch_add(1, std::memory_order_relaxed);
+            return InsertResult::Inserted;
+          }
+
+          // Another thread claimed the slot first. It might have inserted the same key,
+          // so look at the group again.
+        }
+
+        groupIndex = (groupIndex + step) & table.GroupMask; // triangular probing
+      }
+
+      return InsertResult::Full;
+    }
+
+    /// <summary>Looks up the control byte of the slot holding the specified key</summary>
+    /// <param name="table">Table in which the key will be looked up</param>
+    /// <param name="hash">Mixed hash of the key</param>
+    /// <param name="tag">7 bit tag derived from the hash</param>
+    /// <param name="key">Key that will be looked up</param>
+    /// <returns>
+    ///   The control byte of the key's slot or a null pointer if the key was never inserted
+    /// </returns>
+    private: static std::atomic<std::uint8_t> *findControl(
+      const Table &table, std::size_t hash, std::uint8_t tag, const TKey &key
+    ) {
+      std::size_t groupIndex = hash & table.GroupMask;
+      for(std::size_t step = 1; step <= table.GroupMask + 1; ++step) {
+        Group &group = table.Groups[groupIndex];
+        const KeySlot *groupKeys = &table.Keys[groupIndex * 16];
+
+        std::uint32_t empties;
+        std::uint32_t candidates = findCandidates(group, tag, empties);
+        while(candidates != 0) {
+          int lane = std::countr_zero(candidates);
+          candidates &= candidates - 1;
+
+          std::uint8_t control = waitWhileBusy(group.Controls[lane]);
+          if((control | RemovedFlag) == (tag | RemovedFlag)) {
+            if(TKeyEqual()(*getKey(groupKeys[lane]), key)) {
+              return &group.Controls[lane];
+            }
+          }
+        }
+
+        if(empties != 0) {
+          return nullptr; // An empty slot ends the probe sequence
+        }
+
+        groupIndex = (groupIndex + step) & table.GroupMask; // triangular probing
+      }
+
+      return nullptr;
+    }
+
+    /// <summary>
+    ///   Finds the lanes in a group that may hold the key with the specified tag
+    /// </summary>
+    /// <param name="group">Group whose lanes will be checked</param>
+    /// <param name="tag">7 bit tag of the key that is being searched</param>
+    /// <param name="empties">Receives a bit mask of the empty lanes in the group</param>
+    /// <returns>
+    ///   A bit mask of all lanes before the first empty lane that either carry the key's
+    ///   tag (present or removed) or are currently being filled by another thread
+    /// </returns>
+    private: static std::uint32_t findCandidates(
+      const Group &group, std::uint8_t tag, std::uint32_t &empties
+    ) {
+#if defined(NUCLEX_SUPPORT_SSE2_AVAILABLE)
+      __m128i controls = _mm_load_si128(reinterpret_cast<const __m128i *>(group.Controls));
+      std::uint32_t candidates = static_cast<std::uint32_t>(
+        _mm_movemask_epi8(
+          _mm_or_si128(
+            _mm_or_si128(
+              _mm_cmpeq_epi8(controls, _mm_set1_epi8(static_cast<char>(tag))),
+              _mm_cmpeq_epi8(controls, _mm_set1_epi8(static_cast<char>(tag | RemovedFlag)))
+            ),
+            _mm_cmpeq_epi8(controls, _mm_set1_epi8(static_cast<char>(ControlByte::Busy)))
+          )
+        )
+      );
+      empties = static_cast<std::uint32_t>(
+        _mm_movemask_epi8(
+          _mm_cmpeq_epi8(controls, _mm_set1_epi8(static_cast<char>(ControlByte::Empty)))
+        )
+      );
+#elif defined(NUCLEX_SUPPORT_NEON_AVAILABLE)
+      static const std::uint8_t laneBits[16] = {
+        1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128
+      };
+      uint8x16_t bits = vld1q_u8(laneBits);
+      uint8x16_t controls = vld1q_u8(reinterpret_cast<const std::uint8_t *>(group.Controls));
+      uint8x16_t matches = vandq_u8(
+        vorrq_u8(
+          vorrq_u8(
+            vceqq_u8(controls, vdupq_n_u8(tag)),
+            vceqq_u8(controls, vdupq_n_u8(static_cast<std::uint8_t>(tag | RemovedFlag)))
+          ),
+          vceqq_u8(controls, vdupq_n_u8(ControlByte::Busy))
+        ),
+        bits
+      );
+      std::uint32_t candidates = (
+        static_cast<std::uint32_t>(vaddv_u8(vget_low_u8(matches))) |
+        (static_cast<std::uint32_t>(vaddv_u8(vget_high_u8(matches))) << 8)
+      );
+      uint8x16_t emptyMatches = vandq_u8(
+        vceqq_u8(controls, vdupq_n_u8(ControlByte::Empty)), bits
+      );
+      empties = (
+        static_cast<std::uint32_t>(vaddv_u8(vget_low_u8(emptyMatches))) |
+        (static_cast<std::uint32_t>(vaddv_u8(vget_high_u8(emptyMatches))) << 8)
+      );
+#else
+      std::uint32_t candidates = 0;
+      empties = 0;
+      for(std::size_t lane = 0; lane < 16; ++lane) {
+        std::uint8_t control = group.Controls[lane].load(std::memory_order_relaxed);
+        if(control == ControlByte::Empty) {
+          empties |= (std::uint32_t(1) << lane);
+        } else if(
+          ((control | RemovedFlag) == (tag | RemovedFlag)) || (control == ControlByte::Busy)
+        ) {
+          candidates |= (std::uint32_t(1) << lane);
+        }
+      }
+#endif
+
+      // Only lanes before the first empty lane are relevant
+      if(empties != 0) {
+        candidates &= (empties & (0 - empties)) - 1;
+      }
+
+      // The vector load isn't an atomic operation, so order it with the key reads
+      std::atomic_thread_fence(std::memory_order_acquire);
+
+      return candidates;
+    }
+
+    /// <summary>Waits until a slot being filled by another thread holds its key</summary>
+    /// <param name="control">Control byte of the slot</param>
+    /// <returns>The control byte's final value</returns>
+    private: static std::uint8_t waitWhileBusy(const std::atomic<std::uint8_t> &control) {
+      std::uint8_t value = control.load(std::memory_order_acquire);
+      while(value == ControlByte::Busy) {
+        NUCLEX_SUPPORT_CPU_YIELD;
+        value = control.load(std::memory_order_acquire);
+      }
+      return value;
+    }
+
+    /// <summary>Scrambles the bits of a hash so that all bits depend on the input</summary>
+    /// <param name="hash">Hash value that will be scrambled</param>
+    /// <returns>The scrambled hash value</returns>
+    private: static std::size_t mixHash(std::size_t hash) {
+      if constexpr(sizeof(std::size_t) >= 8) {
+        hash ^= (hash >> 33);
+        hash *= static_cast<std::size_t>(0xFF51AFD7ED558CCDull);
+        hash ^= (hash >> 33);
+      } else {
+        hash ^= (hash >> 16);
+        hash *= static_cast<std::size_t>(0x85EBCA6Bu);
+        hash ^= (hash >> 13);
+      }
+      return hash;
+    }
+
+    /// <summary>Forms the 7 bit tag stored in a key's control byte</summary>
+    /// <param name="hash">Mixed hash of the key</param>
+    /// <returns>The tag, which lies in the range from 1 to 126</returns>
+    private: static std::uint8_t getTag(std::size_t hash) {
+      std::uint8_t tag = static_cast<std::uint8_t>(hash >> (sizeof(std::size_t) * 8 - 7));
+      if(tag == 0) {
+        return 1; // 0x80 with the removed flag would be the Empty value
+      } else if(tag == 0x7F) {
+        return 0x7E; // 0xFF with the removed flag would be the Busy value
+      } else {
+        return tag;
+      }
+    }
+
+    /// <summary>Retrieves the key stored in a slot</summary>
+    /// <param name="slot">Slot whose key will be retrieved</param>
+    /// <returns>The key stored in the slot</returns>
+    private: static const TKey *getKey(const KeySlot &slot) {
+      return std::launder(reinterpret_cast<const TKey *>(slot.Storage));
+    }
+
+    /// <summary>Table currently holding the keys</summary>
+    private: std::atomic<Table *> currentTable;
+    /// <summary>Number of keys currently in the set</summary>
+    private: alignas(NUCLEX_SUPPORT_CACHE_LINE_SIZE) std::atomic<std::size_t> count;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
+
+#endif // NUCLEX_SUPPORT_COLLECTIONS_CONCURRENTHASHSET_H
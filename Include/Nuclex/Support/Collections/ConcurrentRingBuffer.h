@@ -0,0 +1,85 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_SUPPORT_COLLECTIONS_CONCURRENTRINGBUFFER_H
+#define NUCLEX_SUPPORT_COLLECTIONS_CONCURRENTRINGBUFFER_H
+
+#include "Nuclex/Support/Config.h"
+#include "Nuclex/Support/Collections/ConcurrentCollection.h"
+#include "Nuclex/Support/BitTricks.h" // for BitTricks::GetUpperPowerOfTwo()
+#include "Nuclex/Support/ScopeGuard.h" // for ON_SCOPE_EXIT
+
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint8_t, std::intptr_t
+#include <atomic> // for std::atomic
+#include <memory> // for std::unique_ptr
+#include <new> // for placement new, std::launder()
+#include <type_traits> // for std::is_trivially_destructible
+#include <cassert> // for assert()
+#include <cstring> // for std::memcpy()
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Fixed-size lock-free ring buffer that can safely be used from multiple threads</summary>
+  /// <typeparam name="TElement">Type of elements stored in the ring buffer</typeparam>
+  /// <typeparam name="accessBehavior">How the ring buffer will be accessed by threads</typeparam>
+  /// <remarks>
+  ///   <para>
+  ///     <strong>Thread safety:</strong> depends on the chosen access behavior
+  ///   </para>
+  ///   <para>
+  ///     <strong>Container type:</strong> bounded ring buffer
+  ///   </para>
+  ///   <para>
+  ///     The ring buffer allocates all of its memory up front and never grows. Appending
+  ///     to a full ring buffer fails rather than blocking or allocating. Its capacity is
+  ///     always rounded up to the next power of two so that indices can be wrapped via
+  ///     a bit mask instead of a division.
+  ///   </para>
+  ///   <para>
+  ///     There is one specialization for each access behavior. The single producer,
+  ///     single consumer variant needs no read-modify-write atomics at all, the single
+  ///     consumer variant lets its consumer advance without compare-and-swap and only
+  ///     the multiple producers, multiple consumers variant pays for contention on both
+  ///     ends. Pick the most restrictive behavior that fits your use case.
+  ///   </para>
+  ///   <para>
+  ///     Both indices live in their own cache lines, so producers and consumers do not
+  ///     invalidate each other's cache lines except when handing over an element.
+  ///   </para>
+  /// </remarks>
+  template<
+    typename TElement,
+    ConcurrentAccessBehavior accessBehavior = (
+      ConcurrentAccessBehavior::MultipleProducersMultipleConsumers
+    )
+  >
+  class ConcurrentRingBuffer;
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
+
+#include "Nuclex/Support/Collections/Private/ConcurrentRingBuffer.SPSC.inl"
+#include "Nuclex/Support/Collections/Private/ConcurrentRingBuffer.MPSC.inl"
+#include "Nuclex/Support/Collections/Private/ConcurrentRingBuffer.MPMC.inl"
+
+#endif // NUCLEX_SUPPORT_COLLECTIONS_CONCURRENTRINGBUFFER_H
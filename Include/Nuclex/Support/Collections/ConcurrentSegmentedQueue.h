@@ -0,0 +1,600 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_SUPPORT_COLLECTIONS_CONCURRENTSEGMENTEDQUEUE_H
+#define NUCLEX_SUPPORT_COLLECTIONS_CONCURRENTSEGMENTEDQUEUE_H
+
+#include "Nuclex/Support/Config.h"
+#include "Nuclex/Support/Collections/ConcurrentCollection.h"
+#include "Nuclex/Support/ScopeGuard.h" // for ON_SCOPE_EXIT
+
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint8_t
+#include <atomic> // for std::atomic
+#include <memory> // for std::unique_ptr
+#include <new> // for placement new, std::launder(), std::bad_alloc
+#include <type_traits> // for std::is_trivially_destructible
+#include <algorithm> // for std::min()
+#include <thread> // for std::this_thread::yield()
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Unbounded lock-free queue that can safely be used from multiple threads</summary>
+  /// <typeparam name="TElement">Type of elements stored in the queue</typeparam>
+  /// <typeparam name="accessBehavior">How the queue will be accessed by threads</typeparam>
+  /// <remarks>
+  ///   <para>
+  ///     <strong>Thread safety:</strong> any number of producers and consumers
+  ///   </para>
+  ///   <para>
+  ///     <strong>Container type:</strong> linked list of fixed-size segments
+  ///   </para>
+  ///   <para>
+  ///     Elements are stored in segments holding a fixed number of slots each. Producers
+  ///     and consumers claim slots with a single fetch-and-add on the segment's write or
+  ///     read index, so a bulk append or take of N elements costs one atomic operation
+  ///     on the shared index instead of N. When the last segment is full, a new one is
+  ///     linked in, when the first segment has been drained, it is unlinked.
+  ///   </para>
+  ///   <para>
+  ///     Drained segments are not freed but go onto a free list from which new segments
+  ///     are taken, so once the queue has grown to its working size it does not allocate
+  ///     anymore and it never holds more segments than it needed at its fullest.
+  ///     Segment memory is only returned to the system when the queue is destroyed.
+  ///     This is what makes it safe for a thread to look at a segment that was unlinked
+  ///     under its feet: each thread holds a reference on the segment it is working on
+  ///     and a segment only goes onto the free list when that reference count drops
+  ///     to zero.
+  ///   </para>
+  ///   <para>
+  ///     The same algorithm is used for all access behaviors. The access behavior only
+  ///     decides which <see cref="ConcurrentCollection" /> interface the queue exposes.
+  ///   </para>
+  /// </remarks>
+  template<
+    typename TElement,
+    ConcurrentAccessBehavior accessBehavior = (
+      ConcurrentAccessBehavior::MultipleProducersMultipleConsumers
+    )
+  >
+  class ConcurrentSegmentedQueue : public ConcurrentCollection<TElement, accessBehavior> {
+
+    /// <summary>Number of slots in each segment unless specified otherwise</summary>
+    public: static const constexpr std::size_t DefaultSegmentCapacity = 64;
+
+    #pragma region enum SlotState
+
+    /// <summary>States a slot can be in</summary>
+    private: enum SlotState : std::uint8_t {
+
+      /// <summary>The slot is unused and a producer can fill it</summary>
+      Empty = 0,
+      /// <summary>The slot holds an element that can be taken by a consumer</summary>
+      Filled = 1,
+      /// <summary>The slot was taken or given up and must not be touched anymore</summary>
+      Abandoned = 2
+
+    };
+
+    #pragma endregion // enum SlotState
+
+    #pragma region struct Slot
+
+    /// <summary>Stores a single element inside a segment</summary>
+    private: struct Slot {
+
+      /// <summary>Whether the slot is empty, filled or abandoned</summary>
+      public: std::atomic<std::uint8_t> State;
+      /// <summary>Memory in which the slot's element is constructed</summary>
+      public: alignas(TElement) std::uint8_t Storage[sizeof(TElement)];
+
+    };
+
+    #pragma endregion // struct Slot
+
+    #pragma region struct Segment
+
+    /// <summary>Fixed-size block of slots that is part of the queue's linked list</summary>
+    private: struct Segment {
+
+      /// <summary>Index of the next slot a consumer will claim</summary>
+      public: alignas(NUCLEX_SUPPORT_CACHE_LINE_SIZE) std::atomic<std::size_t> ReadIndex;
+      /// <summary>Index of the next slot a producer will claim</summary>
+      public: alignas(NUCLEX_SUPPORT_CACHE_LINE_SIZE) std::atomic<std::size_t> WriteIndex;
+      /// <summary>Number of threads and queue pointers referencing the segment</summary>
+      public: alignas(NUCLEX_SUPPORT_CACHE_LINE_SIZE) std::atomic<std::size_t> ReferenceCount;
+      /// <summary>Segment that follows this one in the queue</summary>
+      public: std::atomic<Segment *> Next;
+      /// <summary>Next segment in the list of all segments ever allocated</summary>
+      public: Segment *NextAllocated;
+      /// <summary>Next segment on the free list while this segment is unused</summary>
+      public: Segment *NextFree;
+      /// <summary>Slots that store the elements</summary>
+      public: std::unique_ptr<Slot[]> Slots;
+
+    };
+
+    #pragma endregion // struct Segment
+
+    /// <summary>Initializes a new concurrent segmented queue</summary>
+    /// <param name="segmentCapacity">Number of elements each segment can hold</param>
+    public: explicit ConcurrentSegmentedQueue(
+      std::size_t segmentCapacity = DefaultSegmentCapacity
+    ) :
+      segmentCapacity((segmentCapacity < 2) ? 2 : segmentCapacity),
+      freeSegments(nullptr),
+      isTakingFreeSegment(false),
+      allocatedSegments(nullptr),
+      head(nullptr),
+      tail(nullptr) {
+      Segment *initialSegment = allocateSegment();
+      initialSegment->ReferenceCount.store(2, std::memory_order_relaxed); // list + tail
+      this->head.store(initialSegment, std::memory_order_relaxed);
+      this->tail.store(initialSegment, std::memory_order_release);
+    }
+
+    /// <summary>Frees all memory owned by the concurrent segmented queue</summary>
+    /// <remarks>
+    ///   The queue must not be accessed by any other threads anymore when it is
+    ///   being destroyed. Any elements still in the queue will be destroyed.
+    /// </remarks>
+    public: ~ConcurrentSegmentedQueue() override {
+      Segment *segment = this->allocatedSegments.load(std::memory_order_acquire);
+      while(segment != nullptr) {
+        if constexpr(!std::is_trivially_destructible<TElement>::value) {
+          for(std::size_t index = 0; index < this->segmentCapacity; ++index) {
+            Slot &slot = segment->Slots[index];
+            if(slot.State.load(std::memory_order_relaxed) == SlotState::Filled) {
+              std::launder(reinterpret_cast<TElement *>(slot.Storage))->~TElement();
+            }
+          }
+        }
+
+        Segment *nextSegment = segment->NextAllocated;
+        delete segment;
+        segment = nextSegment;
+      }
+    }
+
+    /// <summary>Tries to append an element to the queue</summary>
+    /// <param name="element">Element that will be appended to the queue</param>
+    /// <returns>
+    ///   True if the element was appended, false if no memory for a new segment
+    ///   could be allocated
+    /// </returns>
+    public: bool TryAppend(const TElement &element) override {
+      return (TryAppend(&element, 1) == 1);
+    }
+
+    /// <summary>Tries to append multiple elements to the queue</summary>
+    /// <param name="elements">Elements that will be appended to the queue</param>
+    /// <param name="count">Number of elements that will be appended</param>
+    /// <returns>
+    ///   The number of elements that were appended, which can only be less than
+    ///   the requested count if no memory for a new segment could be allocated
+    /// </returns>
+    /// <remarks>
+    ///   Elements appended in one call are claimed in batches of up to one segment
+    ///   and remain in order relative to each other, but elements appended by other
+    ///   threads at the same time may end up between the batches.
+    /// </remarks>
+    public: std::size_t TryAppend(const TElement *elements, std::size_t count) {
+      std::size_t appendedCount = 0;
+      while(appendedCount < count) {
+        Segment *segment = acquireSegment(this->tail);
+        ON_SCOPE_EXIT { releaseSegment(segment); };
+
+        // Claim as many slots as we need in one go. If this overshoots the end of
+        // the segment, the excess indices simply do not refer to any slot.
+        std::size_t firstIndex = segment->WriteIndex.fetch_add(
+          count - appendedCount, std::memory_order_acq_rel
+        );
+        if(firstIndex < this->segmentCapacity) {
+          std::size_t endIndex = std::min(
+            firstIndex + (count - appendedCount), this->segmentCapacity
+          );
+          appendedCount += fillSlots(*segment, firstIndex, endIndex, elements + appendedCount);
+        } else if(!advanceTail(segment)) {
+          break; // Out of memory
+        }
+      }
+
+      return appendedCount;
+    }
+
+    /// <summary>Tries to take an element from the queue</summary>
+    /// <param name="element">Will receive the element taken from the queue</param>
+    /// <returns>
+    ///   True if an element was taken from the queue, false if the queue was empty
+    /// </returns>
+    public: bool TryTake(TElement &element) override {
+      return (TryTake(&element, 1) == 1);
+    }
+
+    /// <summary>Tries to take multiple elements from the queue</summary>
+    /// <param name="elements">Will receive the elements taken from the queue</param>
+    /// <param name="maximumCount">Maximum number of elements that will be taken</param>
+    /// <returns>The number of elements that were taken from the queue</returns>
+    public: std::size_t TryTake(TElement *elements, std::size_t maximumCount) {
+      std::size_t takenCount = 0;
+      while(takenCount < maximumCount) {
+        Segment *segment = acquireSegment(this->head);
+        ON_SCOPE_EXIT { releaseSegment(segment); };
+
+        // Only claim slots that a producer has claimed already. If we blindly claimed
+        // slots on an empty queue, they would be lost to producers for no reason.
+        std::size_t readIndex = segment->ReadIndex.load(std::memory_order_acquire);
+        std::size_t writeIndex = std::min(
+          segment->WriteIndex.load(std::memory_order_acquire), this->segmentCapacity
+        );
+        if(readIndex >= writeIndex) {
+          if(readIndex < this->segmentCapacity) {
+            break; // Queue is empty
+          }
+
+          Segment *next = segment->Next.load(std::memory_order_acquire);
+          if(next == nullptr) {
+            break; // Queue is empty, producers have not linked a new segment yet
+          }
+
+          advanceHead(segment, next);
+          continue;
+        }
+
+        std::size_t claimCount = std::min(writeIndex - readIndex, maximumCount - takenCount);
+        std::size_t firstIndex = segment->ReadIndex.fetch_add(
+          claimCount, std::memory_order_acq_rel
+        );
+        if(firstIndex < this->segmentCapacity) {
+          std::size_t endIndex = std::min(firstIndex + claimCount, this->segmentCapacity);
+          takenCount += drainSlots(*segment, firstIndex, endIndex, elements + takenCount);
+        }
+      }
+
+      return takenCount;
+    }
+
+    /// <summary>Counts the number of elements currently in the queue</summary>
+    /// <returns>
+    ///   The approximate number of elements that had been in the queue during the call
+    /// </returns>
+    public: std::size_t Count() const override {
+      std::size_t count = 0;
+
+      Segment *segment = acquireSegment(this->head);
+      while(segment != nullptr) {
+        std::size_t readIndex = std::min(
+          segment->ReadIndex.load(std::memory_order_acquire), this->segmentCapacity
+        );
+        std::size_t writeIndex = std::min(
+          segment->WriteIndex.load(std::memory_order_acquire), this->segmentCapacity
+        );
+        if(writeIndex > readIndex) {
+          count += writeIndex - readIndex;
+        }
+
+        // If the next segment got drained and recycled while we were looking,
+        // we simply stop counting. The result is approximate anyway.
+        Segment *next = segment->Next.load(std::memory_order_acquire);
+        if((next != nullptr) && !tryAddReference(next)) {
+          next = nullptr;
+        }
+        releaseSegment(segment);
+        segment = next;
+      }
+
+      return count;
+    }
+
+    /// <summary>Checks if the queue is empty</summary>
+    /// <returns>True if the queue had been empty during the call</returns>
+    public: bool IsEmpty() const override {
+      return (Count() == 0);
+    }
+
+    /// <summary>Returns the number of elements that fit into a single segment</summary>
+    /// <returns>The number of elements each segment can hold</returns>
+    public: std::size_t GetSegmentCapacity() const { return this->segmentCapacity; }
+
+    /// <summary>Constructs elements in the specified range of claimed slots</summary>
+    /// <param name="segment">Segment that contains the slots</param>
+    /// <param name="firstIndex">Index of the first slot that will be filled</param>
+    /// <param name="endIndex">Index one past the last slot that will be filled</param>
+    /// <param name="elements">Elements that will be copied into the slots</param>
+    /// <returns>The number of elements that have been published</returns>
+    private: std::size_t fillSlots(
+      Segment &segment, std::size_t firstIndex, std::size_t endIndex, const TElement *elements
+    ) {
+      std::size_t publishedCount = 0;
+
+      // If a copy constructor throws, consumers must not wait for the remaining slots
+      std::size_t index = firstIndex;
+      auto abandonRemainingSlotsScope = ON_SCOPE_EXIT_TRANSACTION {
+        while(index < endIndex) {
+          segment.Slots[index].State.store(SlotState::Abandoned, std::memory_order_release);
+          ++index;
+        }
+      };
+
+      while(index < endIndex) {
+        Slot &slot = segment.Slots[index];
+        TElement *item = new(slot.Storage) TElement(*elements);
+
+        std::uint8_t expected = SlotState::Empty;
+        bool published = slot.State.compare_exchange_strong(
+          expected, SlotState::Filled, std::memory_order_release, std::memory_order_relaxed
+        );
+        if(published) {
+          ++publishedCount;
+          ++elements;
+        } else {
+          item->~TElement(); // A consumer gave up waiting for the slot, try the next one
+        }
+
+        ++index;
+      }
+
+      abandonRemainingSlotsScope.Commit();
+      return publishedCount;
+    }
+
+    /// <summary>Moves elements out of the specified range of claimed slots</summary>
+    /// <param name="segment">Segment that contains the slots</param>
+    /// <param name="firstIndex">Index of the first slot that will be drained</param>
+    /// <param name="endIndex">Index one past the last slot that will be drained</param>
+    /// <param name="elements">Receives the elements moved out of the slots</param>
+    /// <returns>The number of elements that have been taken</returns>
+    private: std::size_t drainSlots(
+      Segment &segment, std::size_t firstIndex, std::size_t endIndex, TElement *elements
+    ) {
+      std::size_t takenCount = 0;
+
+      // Every claimed slot has to be marked as abandoned, even if a move assignment
+      // throws. Otherwise the producer would consider its element delivered.
+      std::size_t index = firstIndex;
+      auto abandonRemainingSlotsScope = ON_SCOPE_EXIT_TRANSACTION {
+        while(index < endIndex) {
+          std::uint8_t previousState = segment.Slots[index].State.exchange(
+            SlotState::Abandoned, std::memory_order_acq_rel
+          );
+          if(previousState == SlotState::Filled) {
+            std::launder(
+              reinterpret_cast<TElement *>(segment.Slots[index].Storage)
+            )->~TElement();
+          }
+          ++index;
+        }
+      };
+
+      while(index < endIndex) {
+        Slot &slot = segment.Slots[index];
+        ++index;
+
+        // If the producer hasn't finished filling the slot, we don't wait for it
+        // and it will have to try again with another slot.
+        std::uint8_t previousState = slot.State.exchange(
+          SlotState::Abandoned, std::memory_order_acq_rel
+        );
+        if(previousState == SlotState::Filled) {
+          TElement *item = std::launder(reinterpret_cast<TElement *>(slot.Storage));
+          ON_SCOPE_EXIT { item->~TElement(); };
+          elements[takenCount] = std::move(*item);
+          ++takenCount;
+        }
+      }
+
+      abandonRemainingSlotsScope.Commit();
+      return takenCount;
+    }
+
+    /// <summary>Makes the queue's tail point to the segment following the specified one</summary>
+    /// <param name="segment">Segment that was found to be full</param>
+    /// <returns>True if the tail was advanced, false if memory ran out</returns>
+    private: bool advanceTail(Segment *segment) {
+      Segment *next = segment->Next.load(std::memory_order_acquire);
+      if(next == nullptr) {
+        Segment *freshSegment;
+        try {
+          freshSegment = obtainSegment();
+        }
+        catch(const std::bad_alloc &) {
+          return false;
+        }
+
+        if(segment->Next.compare_exchange_strong(next, freshSegment, std::memory_order_acq_rel)) {
+          next = freshSegment;
+        } else { // Another producer was faster, the fresh segment was never visible
+          freshSegment->ReferenceCount.store(0, std::memory_order_relaxed);
+          recycleSegment(freshSegment);
+        }
+      }
+
+      // The tail holds its own reference because it can lag behind the head
+      if(tryAddReference(next)) {
+        if(this->tail.compare_exchange_strong(segment, next, std::memory_order_acq_rel)) {
+          releaseSegment(segment);
+        } else {
+          releaseSegment(next);
+        }
+      }
+
+      return true;
+    }
+
+    /// <summary>Makes the queue's head point to the next segment</summary>
+    /// <param name="segment">Segment that has been drained completely</param>
+    /// <param name="next">Segment following the drained segment</param>
+    private: void advanceHead(Segment *segment, Segment *next) {
+      if(this->head.compare_exchange_strong(segment, next, std::memory_order_acq_rel)) {
+        releaseSegment(segment); // Drop the reference the linked list held
+      }
+    }
+
+    /// <summary>Looks up the segment pointed to and adds a reference to it</summary>
+    /// <param name="segmentPointer">Head or tail pointer of the queue</param>
+    /// <returns>The segment the pointer is referencing</returns>
+    private: Segment *acquireSegment(std::atomic<Segment *> &segmentPointer) const {
+      for(;;) {
+        Segment *segment = segmentPointer.load(std::memory_order_acquire);
+        if(tryAddReference(segment)) {
+          if(segmentPointer.load(std::memory_order_acquire) == segment) {
+            return segment;
+          }
+          releaseSegment(segment);
+        }
+      }
+    }
+
+    /// <summary>Adds a reference to a segment unless it has already been recycled</summary>
+    /// <param name="segment">Segment to which a reference will be added</param>
+    /// <returns>True if the reference was added, false if the segment was recycled</returns>
+    /// <remarks>
+    ///   Segments are never freed while the queue exists, so touching the reference
+    ///   counter of a recycled segment is safe.
+    /// </remarks>
+    private: static bool tryAddReference(Segment *segment) {
+      std::size_t referenceCount = segment->ReferenceCount.load(std::memory_order_relaxed);
+      while(referenceCount != 0) {
+        bool added = segment->ReferenceCount.compare_exchange_weak(
+          referenceCount, referenceCount + 1, std::memory_order_acquire
+        );
+        if(added) {
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    /// <summary>Removes a reference from a segment, recycling it if it was the last</summary>
+    /// <param name="segment">Segment from which a reference will be removed</param>
+    private: void releaseSegment(Segment *segment) const {
+      if(segment->ReferenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        recycleSegment(segment);
+      }
+    }
+
+    /// <summary>Places a no longer used segment on the free list for later reuse</summary>
+    /// <param name="segment">Segment that will be placed on the free list</param>
+    private: void recycleSegment(Segment *segment) const {
+      Segment *firstFreeSegment = this->freeSegments.load(std::memory_order_relaxed);
+      do {
+        segment->NextFree = firstFreeSegment;
+      } while(
+        !this->freeSegments.compare_exchange_weak(
+          firstFreeSegment, segment, std::memory_order_release, std::memory_order_relaxed
+        )
+      );
+    }
+
+    /// <summary>Takes a segment from the free list</summary>
+    /// <returns>The segment taken from the free list or a null pointer if it was empty</returns>
+    /// <remarks>
+    ///   Any number of threads can push onto the free list, but only one thread at
+    ///   a time may pop from it. With a single popper, the first segment cannot be
+    ///   taken and put back while the popper is looking at it, which rules out
+    ///   the ABA problem a lock-free stack would otherwise have. Popping happens
+    ///   once per segment the queue advances by and only takes a few instructions,
+    ///   so contention on the flag is rare and short.
+    /// </remarks>
+    private: Segment *tryTakeFreeSegment() {
+      while(this->isTakingFreeSegment.exchange(true, std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+      ON_SCOPE_EXIT { this->isTakingFreeSegment.store(false, std::memory_order_release); };
+
+      Segment *segment = this->freeSegments.load(std::memory_order_acquire);
+      while(segment != nullptr) {
+        bool wasTaken = this->freeSegments.compare_exchange_weak(
+          segment, segment->NextFree, std::memory_order_acquire, std::memory_order_acquire
+        );
+        if(wasTaken) {
+          break;
+        }
+      }
+
+      return segment;
+    }
+
+    /// <summary>Takes a segment from the free list or allocates a new one</summary>
+    /// <returns>A segment that is ready to be linked into the queue</returns>
+    private: Segment *obtainSegment() {
+      Segment *segment = tryTakeFreeSegment();
+      if(segment == nullptr) {
+        segment = allocateSegment();
+      } else {
+        for(std::size_t index = 0; index < this->segmentCapacity; ++index) {
+          segment->Slots[index].State.store(SlotState::Empty, std::memory_order_relaxed);
+        }
+        segment->ReadIndex.store(0, std::memory_order_relaxed);
+        segment->WriteIndex.store(0, std::memory_order_relaxed);
+        segment->Next.store(nullptr, std::memory_order_relaxed);
+      }
+
+      segment->ReferenceCount.store(1, std::memory_order_release); // list reference
+      return segment;
+    }
+
+    /// <summary>Allocates a new segment and adds it to the list of allocated segments</summary>
+    /// <returns>The newly allocated segment</returns>
+    private: Segment *allocateSegment() {
+      std::unique_ptr<Segment> segment(new Segment());
+      segment->Slots.reset(new Slot[this->segmentCapacity]);
+      for(std::size_t index = 0; index < this->segmentCapacity; ++index) {
+        segment->Slots[index].State.store(SlotState::Empty, std::memory_order_relaxed);
+      }
+      segment->ReadIndex.store(0, std::memory_order_relaxed);
+      segment->WriteIndex.store(0, std::memory_order_relaxed);
+      segment->ReferenceCount.store(0, std::memory_order_relaxed);
+      segment->Next.store(nullptr, std::memory_order_relaxed);
+      segment->NextFree = nullptr;
+
+      // Push-only list, so there's no ABA problem to worry about here
+      segment->NextAllocated = this->allocatedSegments.load(std::memory_order_relaxed);
+      while(
+        !this->allocatedSegments.compare_exchange_weak(
+          segment->NextAllocated, segment.get(), std::memory_order_release
+        )
+      ) {}
+
+      return segment.release();
+    }
+
+    /// <summary>Number of elements each segment can hold</summary>
+    private: const std::size_t segmentCapacity;
+    /// <summary>Drained segments that can be reused, linked through their NextFree field</summary>
+    private: mutable std::atomic<Segment *> freeSegments;
+    /// <summary>Set while a thread is taking a segment from the free list</summary>
+    private: std::atomic<bool> isTakingFreeSegment;
+    /// <summary>All segments ever allocated, so they can be freed at the end</summary>
+    private: std::atomic<Segment *> allocatedSegments;
+    /// <summary>Segment from which consumers take elements</summary>
+    private: alignas(NUCLEX_SUPPORT_CACHE_LINE_SIZE) mutable std::atomic<Segment *> head;
+    /// <summary>Segment to which producers append elements</summary>
+    private: alignas(NUCLEX_SUPPORT_CACHE_LINE_SIZE) mutable std::atomic<Segment *> tail;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
+
+#endif // NUCLEX_SUPPORT_COLLECTIONS_CONCURRENTSEGMENTEDQUEUE_H
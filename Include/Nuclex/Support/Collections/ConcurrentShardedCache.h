@@ -0,0 +1,762 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_SUPPORT_COLLECTIONS_CONCURRENTSHARDEDCACHE_H
+#define NUCLEX_SUPPORT_COLLECTIONS_CONCURRENTSHARDEDCACHE_H
+
+#include "Nuclex/Support/Config.h"
+#include "Nuclex/Support/Collections/ConcurrentMap.h"
+#include "Nuclex/Support/Collections/EvictionPolicies.h" // for LruEvictionPolicy
+#include "Nuclex/Support/BitTricks.h" // for BitTricks::GetUpperPowerOfTwo()
+#include "Nuclex/Support/ScopeGuard.h" // for ON_SCOPE_EXIT
+
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint8_t, std::uint32_t
+#include <cstring> // for std::memcpy()
+#include <atomic> // for std::atomic
+#include <memory> // for std::unique_ptr
+#include <shared_mutex> // for std::shared_mutex
+#include <mutex> // for std::unique_lock
+#include <functional> // for std::hash, std::equal_to
+#include <new> // for placement new, std::launder()
+#include <type_traits> // for std::is_trivially_copyable
+#include <cassert> // for assert()
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Fixed-capacity cache that can safely be used from multiple threads</summary>
+  /// <typeparam name="TKey">Type of the key the cache uses</typeparam>
+  /// <typeparam name="TValue">Type of values that are stored in the cache</typeparam>
+  /// <typeparam name="THash">Hash function used to hash the keys</typeparam>
+  /// <typeparam name="TKeyEqual">Comparison function used to check keys for equality</typeparam>
+  /// <typeparam name="TEvictionPolicy">
+  ///   Policy that decides which items each shard evicts, see EvictionPolicies.h
+  /// </typeparam>
+  /// <remarks>
+  ///   <para>
+  ///     <strong>Thread safety:</strong> any number of threads may access the cache
+  ///   </para>
+  ///   <para>
+  ///     <strong>Container type:</strong> sharded array of slots with hash indices
+  ///   </para>
+  ///   <para>
+  ///     Keys are distributed over a fixed number of shards by their hash. Each shard
+  ///     owns an equal part of the cache's capacity, its own lock and its own instance
+  ///     of the eviction policy, so threads working on different shards never block each
+  ///     other. When a shard is full, it evicts one of its own items, which means the
+  ///     cache as a whole only approximates the eviction policy.
+  ///   </para>
+  ///   <para>
+  ///     Lookups never modify the eviction policy directly. Instead, they note the slot
+  ///     they accessed in a small, lossy buffer belonging to the shard. Whenever a thread
+  ///     modifies the shard or the buffer fills up, the noted accesses are applied to
+  ///     the policy in one batch. Should the buffer overflow because nobody could take
+  ///     the lock in time, further accesses are simply dropped, which only makes
+  ///     the recency information a little less accurate.
+  ///   </para>
+  ///   <para>
+  ///     If both keys and values are trivially copyable, lookups do not touch the lock
+  ///     at all. Each shard then carries a sequence counter which writers increment
+  ///     before and after modifying the shard. Readers copy the key and value
+  ///     optimistically and retry if the counter changed in the meantime. For all other
+  ///     types, lookups use a shared lock on the shard.
+  ///   </para>
+  /// </remarks>
+  template<
+    typename TKey,
+    typename TValue,
+    typename THash = std::hash<TKey>,
+    typename TKeyEqual = std::equal_to<TKey>,
+    typename TEvictionPolicy = LruEvictionPolicy<>
+  >
+  class ConcurrentShardedCache : public ConcurrentMap<TKey, TValue> {
+
+    /// <summary>Number of shards the cache uses unless specified otherwise</summary>
+    public: static const constexpr std::size_t DefaultShardCount = 16;
+
+    /// <summary>Whether lookups are done optimistically without locking</summary>
+    public: static const constexpr bool UsesOptimisticReads = (
+      std::is_trivially_copyable<TKey>::value && std::is_trivially_copyable<TValue>::value
+    );
+
+    /// <summary>Number of accesses each shard buffers before applying them</summary>
+    private: static const constexpr std::size_t AccessBufferSize = 32;
+
+    #pragma region struct Slot
+
+    /// <summary>Stores a single key-value pair in a shard</summary>
+    private: struct Slot {
+
+      /// <summary>Mixed hash of the key, needed to relocate entries in the index</summary>
+      public: std::size_t Hash;
+      /// <summary>Memory in which the slot's key is constructed</summary>
+      public: alignas(TKey) std::uint8_t KeyStorage[sizeof(TKey)];
+      /// <summary>Memory in which the slot's value is constructed</summary>
+      public: alignas(TValue) std::uint8_t ValueStorage[sizeof(TValue)];
+
+    };
+
+    #pragma endregion // struct Slot
+
+    #pragma region struct Shard
+
+    /// <summary>Independently locked section of the cache</summary>
+    private: struct alignas(NUCLEX_SUPPORT_CACHE_LINE_SIZE) Shard {
+
+      /// <summary>Sequence counter that is odd while the shard is being modified</summary>
+      public: std::atomic<std::uint32_t> Version;
+      /// <summary>Number of entries currently stored in the shard</summary>
+      public: std::atomic<std::size_t> Count;
+      /// <summary>Held exclusively by writers and shared by non-optimistic readers</summary>
+      public: std::shared_mutex Mutex;
+      /// <summary>Open-addressed index holding slot index + 1 for each key, 0 is empty</summary>
+      public: std::unique_ptr<std::atomic<std::size_t>[]> Index;
+      /// <summary>Slots that store the key-value pairs</summary>
+      public: std::unique_ptr<Slot[]> Slots;
+      /// <summary>Indices of the slots that are currently unused</summary>
+      public: std::unique_ptr<std::size_t[]> FreeSlots;
+      /// <summary>Number of entries in the free slot list</summary>
+      public: std::size_t FreeSlotCount;
+      /// <summary>Tracks which slots are occupied and decides which to evict</summary>
+      public: std::unique_ptr<TEvictionPolicy> Policy;
+      /// <summary>Number of accesses that have been noted since the last batch</summary>
+      public: alignas(NUCLEX_SUPPORT_CACHE_LINE_SIZE) std::atomic<std::size_t> AccessCount;
+      /// <summary>Slot index + 1 of each noted access, 0 if the entry is unused</summary>
+      public: std::atomic<std::size_t> Accesses[AccessBufferSize];
+
+    };
+
+    #pragma endregion // struct Shard
+
+    /// <summary>Initializes a new concurrent sharded cache</summary>
+    /// <param name="capacity">
+    ///   Number of entries the cache can hold, will be rounded up to a multiple of
+    ///   the shard count
+    /// </param>
+    /// <param name="shardCount">
+    ///   Number of independently locked shards, will be rounded up to a power of two
+    /// </param>
+    public: explicit ConcurrentShardedCache(
+      std::size_t capacity, std::size_t shardCount = DefaultShardCount
+    ) :
+      shardCount(
+        static_cast<std::size_t>(
+          BitTricks::GetUpperPowerOfTwo(
+            static_cast<std::uint64_t>((shardCount < 1) ? 1 : shardCount)
+          )
+        )
+      ),
+      shardShift(
+        sizeof(std::size_t) * 8 - BitTricks::GetLogBase2(
+          static_cast<std::uint64_t>(this->shardCount)
+        )
+      ),
+      shardCapacity((capacity + this->shardCount - 1) / this->shardCount),
+      indexMask(0),
+      shards(new Shard[this->shardCount]) {
+      if(this->shardCapacity < 1) {
+        this->shardCapacity = 1;
+      }
+
+      // Keep each shard's index at most half full so probe sequences remain short
+      std::size_t indexBucketCount = static_cast<std::size_t>(
+        BitTricks::GetUpperPowerOfTwo(static_cast<std::uint64_t>(this->shardCapacity * 2))
+      );
+      if(indexBucketCount < 4) {
+        indexBucketCount = 4;
+      }
+      this->indexMask = indexBucketCount - 1;
+
+      for(std::size_t index = 0; index < this->shardCount; ++index) {
+        Shard &shard = this->shards[index];
+        shard.Version.store(0, std::memory_order_relaxed);
+        shard.Count.store(0, std::memory_order_relaxed);
+        shard.Policy.reset(new TEvictionPolicy(this->shardCapacity));
+        shard.Index.reset(new std::atomic<std::size_t>[indexBucketCount]);
+        for(std::size_t bucket = 0; bucket < indexBucketCount; ++bucket) {
+          shard.Index[bucket].store(0, std::memory_order_relaxed);
+        }
+        shard.Slots.reset(new Slot[this->shardCapacity]);
+        shard.FreeSlots.reset(new std::size_t[this->shardCapacity]);
+        resetFreeSlots(shard);
+        shard.AccessCount.store(0, std::memory_order_relaxed);
+        for(std::size_t access = 0; access < AccessBufferSize; ++access) {
+          shard.Accesses[access].store(0, std::memory_order_relaxed);
+        }
+      }
+    }
+
+    /// <summary>Frees all memory owned by the concurrent sharded cache</summary>
+    /// <remarks>
+    ///   The cache must not be accessed by any other threads anymore when it is
+    ///   being destroyed.
+    /// </remarks>
+    public: ~ConcurrentShardedCache() override {
+      for(std::size_t index = 0; index < this->shardCount; ++index) {
+        destroyAllSlots(this->shards[index]);
+      }
+    }
+
+    /// <summary>Returns the number of entries the cache can hold</summary>
+    /// <returns>The maximum number of entries the cache will hold</returns>
+    public: std::size_t GetCapacity() const {
+      return this->shardCapacity * this->shardCount;
+    }
+
+    /// <summary>Stores a value in the cache, replacing any existing value</summary>
+    /// <param name="key">Key under which the value can be looked up later</param>
+    /// <param name="value">Value that will be stored under its key</param>
+    /// <returns>
+    ///   True if the key did not exist before and was inserted,
+    ///   false if the key already existed and its value was replaced
+    /// </returns>
+    /// <remarks>
+    ///   If the shard responsible for the key is full, the item chosen by the shard's
+    ///   eviction policy is evicted to make room
+    /// </remarks>
+    public: bool Insert(const TKey &key, const TValue &value) {
+      std::size_t hash = mixHash(THash()(key));
+      Shard &shard = getShard(hash);
+
+      std::unique_lock<std::shared_mutex> writeLock(shard.Mutex);
+      applyAccesses(shard);
+
+      std::size_t slotIndex = findSlot(shard, hash, key);
+      if(slotIndex != NoSlot) {
+        beginWrite(shard);
+        ON_SCOPE_EXIT { endWrite(shard); };
+        *getValue(shard.Slots[slotIndex]) = value;
+        shard.Policy->Touch(slotIndex);
+        return false;
+      }
+
+      insertNew(shard, hash, key, value);
+      return true;
+    }
+
+    /// <summary>Stores a value in the cache if its key isn't present yet</summary>
+    /// <param name="key">Key under which the value can be looked up later</param>
+    /// <param name="value">Value that will be stored under its key</param>
+    /// <returns>True if the element was inserted, false if the key already existed</returns>
+    /// <remarks>
+    ///   If the shard responsible for the key is full, the item chosen by the shard's
+    ///   eviction policy is evicted to make room
+    /// </remarks>
+    public: bool TryInsert(const TKey &key, const TValue &value) override {
+      std::size_t hash = mixHash(THash()(key));
+      Shard &shard = getShard(hash);
+
+      std::unique_lock<std::shared_mutex> writeLock(shard.Mutex);
+      applyAccesses(shard);
+
+      if(findSlot(shard, hash, key) != NoSlot) {
+        return false;
+      }
+
+      insertNew(shard, hash, key, value);
+      return true;
+    }
+
+    /// <summary>Tries to look up an element in the cache</summary>
+    /// <param name="key">Key of the element that will be looked up</param>
+    /// <param name="value">Will receive a copy of the value stored in the cache</param>
+    /// <returns>True if an element was found, false if the key didn't exist</returns>
+    public: bool TryGet(const TKey &key, TValue &value) const {
+      std::size_t hash = mixHash(THash()(key));
+      Shard &shard = getShard(hash);
+
+      std::size_t slotIndex;
+      if constexpr(UsesOptimisticReads) {
+        alignas(TValue) std::uint8_t valueCopy[sizeof(TValue)];
+        for(;;) {
+          std::uint32_t version = shard.Version.load(std::memory_order_acquire);
+          if((version & 1) != 0) {
+            NUCLEX_SUPPORT_CPU_YIELD;
+            continue; // A writer is currently modifying the shard
+          }
+
+          // Anything we read here may be torn by a concurrent writer, but since both
+          // keys and values are trivially copyable, that's harmless as long as we
+          // throw the result away if the version changed.
+          slotIndex = findSlotOptimistically(shard, hash, key);
+          if(slotIndex != NoSlot) {
+            std::memcpy(valueCopy, shard.Slots[slotIndex].ValueStorage, sizeof(TValue));
+          }
+
+          std::atomic_thread_fence(std::memory_order_acquire);
+          if(shard.Version.load(std::memory_order_relaxed) == version) {
+            break;
+          }
+        }
+
+        if(slotIndex == NoSlot) {
+          return false;
+        }
+        value = *std::launder(reinterpret_cast<const TValue *>(valueCopy));
+      } else {
+        std::shared_lock<std::shared_mutex> readLock(shard.Mutex);
+        slotIndex = findSlot(shard, hash, key);
+        if(slotIndex == NoSlot) {
+          return false;
+        }
+        value = *getValue(shard.Slots[slotIndex]);
+      }
+
+      // Only note the access after the shared lock has been released, so that the thread
+      // filling the access buffer can take the exclusive lock and apply the batch
+      noteAccess(shard, slotIndex);
+      return true;
+    }
+
+    /// <summary>Checks whether the cache contains the specified key</summary>
+    /// <param name="key">Key that will be looked up</param>
+    /// <returns>True if the key was present in the cache during the call</returns>
+    /// <remarks>This does not count as an access for the eviction policy</remarks>
+    public: bool Contains(const TKey &key) const {
+      std::size_t hash = mixHash(THash()(key));
+      Shard &shard = getShard(hash);
+
+      if constexpr(UsesOptimisticReads) {
+        for(;;) {
+          std::uint32_t version = shard.Version.load(std::memory_order_acquire);
+          if((version & 1) != 0) {
+            NUCLEX_SUPPORT_CPU_YIELD;
+            continue; // A writer is currently modifying the shard
+          }
+
+          bool found = (findSlotOptimistically(shard, hash, key) != NoSlot);
+
+          std::atomic_thread_fence(std::memory_order_acquire);
+          if(shard.Version.load(std::memory_order_relaxed) == version) {
+            return found;
+          }
+        }
+      } else {
+        std::shared_lock<std::shared_mutex> readLock(shard.Mutex);
+        return (findSlot(shard, hash, key) != NoSlot);
+      }
+    }
+
+    /// <summary>Tries to take an element from the cache (removing it)</summary>
+    /// <param name="key">Key of the element that will be taken from the cache</param>
+    /// <param name="value">Will receive the value taken from the cache</param>
+    /// <returns>
+    ///   True if an element was taken from the cache, false if the key didn't exist
+    /// </returns>
+    public: bool TryTake(const TKey &key, TValue &value) override {
+      std::size_t hash = mixHash(THash()(key));
+      Shard &shard = getShard(hash);
+
+      std::unique_lock<std::shared_mutex> writeLock(shard.Mutex);
+      applyAccesses(shard);
+
+      std::size_t slotIndex = findSlot(shard, hash, key);
+      if(slotIndex == NoSlot) {
+        return false;
+      }
+
+      shard.Policy->Remove(slotIndex);
+
+      beginWrite(shard);
+      ON_SCOPE_EXIT {
+        removeSlot(shard, slotIndex);
+        shard.FreeSlots[shard.FreeSlotCount++] = slotIndex;
+        endWrite(shard);
+      };
+      value = std::move(*getValue(shard.Slots[slotIndex]));
+
+      return true;
+    }
+
+    /// <summary>Removes the specified element from the cache if it exists</summary>
+    /// <param name="key">Key of the element that will be removed if present</param>
+    /// <returns>True if the element was found and removed, false otherwise</returns>
+    public: bool TryRemove(const TKey &key) override {
+      std::size_t hash = mixHash(THash()(key));
+      Shard &shard = getShard(hash);
+
+      std::unique_lock<std::shared_mutex> writeLock(shard.Mutex);
+      applyAccesses(shard);
+
+      std::size_t slotIndex = findSlot(shard, hash, key);
+      if(slotIndex == NoSlot) {
+        return false;
+      }
+
+      shard.Policy->Remove(slotIndex);
+
+      beginWrite(shard);
+      removeSlot(shard, slotIndex);
+      shard.FreeSlots[shard.FreeSlotCount++] = slotIndex;
+      endWrite(shard);
+
+      return true;
+    }
+
+    /// <summary>Removes all items from the cache</summary>
+    /// <remarks>
+    ///   Shards are cleared one after another, so items inserted by other threads
+    ///   while this method runs may or may not survive
+    /// </remarks>
+    public: void Clear() {
+      for(std::size_t index = 0; index < this->shardCount; ++index) {
+        Shard &shard = this->shards[index];
+
+        std::unique_lock<std::shared_mutex> writeLock(shard.Mutex);
+        applyAccesses(shard);
+
+        beginWrite(shard);
+        destroyAllSlots(shard);
+        shard.Policy->Clear();
+        for(std::size_t bucket = 0; bucket <= this->indexMask; ++bucket) {
+          shard.Index[bucket].store(0, std::memory_order_relaxed);
+        }
+        resetFreeSlots(shard);
+        shard.Count.store(0, std::memory_order_relaxed);
+        endWrite(shard);
+      }
+    }
+
+    /// <summary>Counts the number of elements currently in the cache</summary>
+    /// <returns>
+    ///   The approximate number of elements that had been in the cache during the call
+    /// </returns>
+    public: std::size_t Count() const override {
+      std::size_t count = 0;
+      for(std::size_t index = 0; index < this->shardCount; ++index) {
+        count += this->shards[index].Count.load(std::memory_order_relaxed);
+      }
+      return count;
+    }
+
+    /// <summary>Checks if the cache is empty</summary>
+    /// <returns>True if the cache had been empty during the call</returns>
+    public: bool IsEmpty() const override {
+      for(std::size_t index = 0; index < this->shardCount; ++index) {
+        if(this->shards[index].Count.load(std::memory_order_relaxed) != 0) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /// <summary>Slot index returned by lookups if the key was not found</summary>
+    private: static const constexpr std::size_t NoSlot = static_cast<std::size_t>(-1);
+
+    /// <summary>Scrambles the bits of a hash so that all bits depend on the input</summary>
+    /// <param name="hash">Hash value that will be scrambled</param>
+    /// <returns>The scrambled hash value</returns>
+    /// <remarks>
+    ///   Standard library hashes of integers are often the integer itself. Since the shard
+    ///   is selected by the upper bits and the index bucket by the lower bits, we need both
+    ///   ends of the hash to be well distributed.
+    /// </remarks>
+    private: static std::size_t mixHash(std::size_t hash) {
+      if constexpr(sizeof(std::size_t) >= 8) {
+        hash ^= (hash >> 33);
+        hash *= static_cast<std::size_t>(0xFF51AFD7ED558CCDull);
+        hash ^= (hash >> 33);
+      } else {
+        hash ^= (hash >> 16);
+        hash *= static_cast<std::size_t>(0x85EBCA6Bu);
+        hash ^= (hash >> 13);
+      }
+      return hash;
+    }
+
+    /// <summary>Looks up the shard responsible for the specified hash</summary>
+    /// <param name="hash">Mixed hash of the key whose shard will be looked up</param>
+    /// <returns>The shard in which keys with the specified hash are stored</returns>
+    private: Shard &getShard(std::size_t hash) const {
+      if(this->shardCount == 1) {
+        return this->shards[0]; // Shifting by the full bit width would be undefined
+      } else {
+        return this->shards[hash >> this->shardShift];
+      }
+    }
+
+    /// <summary>Looks for the slot holding the specified key</summary>
+    /// <param name="shard">Shard that will be searched</param>
+    /// <param name="hash">Mixed hash of the key</param>
+    /// <param name="key">Key that will be searched for</param>
+    /// <returns>The index of the slot holding the key or NoSlot if it wasn't found</returns>
+    /// <remarks>Must be called with the shard's lock held (shared or exclusively)</remarks>
+    private: std::size_t findSlot(
+      const Shard &shard, std::size_t hash, const TKey &key
+    ) const {
+      for(std::size_t bucket = hash & this->indexMask; ; bucket = (bucket + 1) & this->indexMask) {
+        std::size_t entry = shard.Index[bucket].load(std::memory_order_relaxed);
+        if(entry == 0) {
+          return NoSlot;
+        }
+
+        const Slot &slot = shard.Slots[entry - 1];
+        if((slot.Hash == hash) && TKeyEqual()(*getKey(slot), key)) {
+          return entry - 1;
+        }
+      }
+    }
+
+    /// <summary>Looks for the slot holding the specified key without locking</summary>
+    /// <param name="shard">Shard that will be searched</param>
+    /// <param name="hash">Mixed hash of the key</param>
+    /// <param name="key">Key that will be searched for</param>
+    /// <returns>The index of the slot holding the key or NoSlot if it wasn't found</returns>
+    /// <remarks>
+    ///   The result is only valid if the shard's version did not change during the call.
+    ///   Since a concurrent writer may leave the index in any state, probing is bounded
+    ///   and keys are copied before they are compared.
+    /// </remarks>
+    private: std::size_t findSlotOptimistically(
+      const Shard &shard, std::size_t hash, const TKey &key
+    ) const {
+      std::size_t bucket = hash & this->indexMask;
+      for(std::size_t probe = 0; probe <= this->indexMask; ++probe) {
+        std::size_t entry = shard.Index[bucket].load(std::memory_order_acquire);
+        if(entry == 0) {
+          return NoSlot;
+        }
+        if(entry <= this->shardCapacity) {
+          const Slot &slot = shard.Slots[entry - 1];
+          alignas(TKey) std::uint8_t keyCopy[sizeof(TKey)];
+          std::memcpy(keyCopy, slot.KeyStorage, sizeof(TKey));
+          if(TKeyEqual()(*std::launder(reinterpret_cast<const TKey *>(keyCopy)), key)) {
+            return entry - 1;
+          }
+        }
+        bucket = (bucket + 1) & this->indexMask;
+      }
+
+      return NoSlot;
+    }
+
+    /// <summary>Stores a new key-value pair in a shard, evicting an item if needed</summary>
+    /// <param name="shard">Shard in which the key-value pair will be stored</param>
+    /// <param name="hash">Mixed hash of the key</param>
+    /// <param name="key">Key under which the value will be stored</param>
+    /// <param name="value">Value that will be stored</param>
+    /// <remarks>Must be called with the shard's lock held exclusively</remarks>
+    private: void insertNew(
+      Shard &shard, std::size_t hash, const TKey &key, const TValue &value
+    ) {
+      beginWrite(shard);
+      ON_SCOPE_EXIT { endWrite(shard); };
+
+      std::size_t slotIndex;
+      if(shard.FreeSlotCount > 0) {
+        slotIndex = shard.FreeSlots[--shard.FreeSlotCount];
+      } else {
+        slotIndex = shard.Policy->Evict();
+        removeSlot(shard, slotIndex);
+      }
+
+      // If constructing the key or value fails, the slot goes back into the free list
+      Slot &slot = shard.Slots[slotIndex];
+      {
+        auto releaseSlotScope = ON_SCOPE_EXIT_TRANSACTION {
+          shard.FreeSlots[shard.FreeSlotCount++] = slotIndex;
+        };
+        new(slot.KeyStorage) TKey(key);
+        {
+          auto destroyKeyScope = ON_SCOPE_EXIT_TRANSACTION { getKey(slot)->~TKey(); };
+          new(slot.ValueStorage) TValue(value);
+          destroyKeyScope.Commit();
+        }
+        releaseSlotScope.Commit();
+      }
+      slot.Hash = hash;
+
+      std::size_t bucket = hash & this->indexMask;
+      while(shard.Index[bucket].load(std::memory_order_relaxed) != 0) {
+        bucket = (bucket + 1) & this->indexMask;
+      }
+      shard.Index[bucket].store(slotIndex + 1, std::memory_order_release);
+
+      shard.Policy->Insert(slotIndex, hash);
+      shard.Count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// <summary>Removes a slot from the index and destroys its key and value</summary>
+    /// <param name="shard">Shard the slot belongs to</param>
+    /// <param name="slotIndex">Index of the slot that will be freed</param>
+    /// <remarks>
+    ///   Must be called with the shard's lock held exclusively and inside a write section.
+    ///   The eviction policy must already have stopped tracking the slot and the caller
+    ///   is responsible for reusing the slot or putting it into the free list.
+    /// </remarks>
+    private: void removeSlot(Shard &shard, std::size_t slotIndex) {
+      Slot &slot = shard.Slots[slotIndex];
+
+      std::size_t hole = slot.Hash & this->indexMask;
+      while(shard.Index[hole].load(std::memory_order_relaxed) != slotIndex + 1) {
+        hole = (hole + 1) & this->indexMask;
+      }
+
+      // Instead of leaving a tombstone, shift back any following entries that would
+      // become unreachable through the hole (same as in KeyedArrayCache)
+      std::size_t bucket = (hole + 1) & this->indexMask;
+      for(;;) {
+        std::size_t entry = shard.Index[bucket].load(std::memory_order_relaxed);
+        if(entry == 0) {
+          break;
+        }
+
+        std::size_t preferredBucket = shard.Slots[entry - 1].Hash & this->indexMask;
+        if(
+          ((bucket - preferredBucket) & this->indexMask) >= ((bucket - hole) & this->indexMask)
+        ) {
+          shard.Index[hole].store(entry, std::memory_order_relaxed);
+          hole = bucket;
+        }
+
+        bucket = (bucket + 1) & this->indexMask;
+      }
+      shard.Index[hole].store(0, std::memory_order_relaxed);
+
+      getValue(slot)->~TValue();
+      getKey(slot)->~TKey();
+      shard.Count.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /// <summary>Destroys the keys and values in all occupied slots of a shard</summary>
+    /// <param name="shard">Shard whose slots will be destroyed</param>
+    private: static void destroyAllSlots(Shard &shard) {
+      Slot *slots = shard.Slots.get();
+      shard.Policy->ForEach(
+        [slots](std::size_t slotIndex) {
+          getValue(slots[slotIndex])->~TValue();
+          getKey(slots[slotIndex])->~TKey();
+        }
+      );
+    }
+
+    /// <summary>Puts all slots of a shard into its free list</summary>
+    /// <param name="shard">Shard whose free list will be reset</param>
+    private: void resetFreeSlots(Shard &shard) const {
+      for(std::size_t index = 0; index < this->shardCapacity; ++index) {
+        shard.FreeSlots[index] = this->shardCapacity - index - 1; // lowest slots used first
+      }
+      shard.FreeSlotCount = this->shardCapacity;
+    }
+
+    /// <summary>Notes that a slot has been accessed for the eviction policy</summary>
+    /// <param name="shard">Shard the slot belongs to</param>
+    /// <param name="slotIndex">Index of the slot that has been accessed</param>
+    /// <remarks>Must be called without holding the shard's lock</remarks>
+    private: static void noteAccess(Shard &shard, std::size_t slotIndex) {
+      std::size_t position = shard.AccessCount.fetch_add(1, std::memory_order_relaxed);
+      if(position < AccessBufferSize) {
+        shard.Accesses[position].store(slotIndex + 1, std::memory_order_release);
+      }
+
+      // The thread that fills the buffer applies the batch. If it can't get the lock,
+      // retry only now and then, so a busy shard doesn't see a stampede on its lock.
+      if((position % AccessBufferSize) == AccessBufferSize - 1) {
+        std::unique_lock<std::shared_mutex> writeLock(shard.Mutex, std::try_to_lock);
+        if(writeLock.owns_lock()) {
+          applyAccesses(shard);
+        }
+      }
+    }
+
+    /// <summary>Applies all accesses noted in a shard's buffer to its eviction policy</summary>
+    /// <param name="shard">Shard whose noted accesses will be applied</param>
+    /// <remarks>
+    ///   Must be called with the shard's lock held exclusively. Slots may have been freed
+    ///   or even reused since their access was noted, the former are skipped and the latter
+    ///   merely receive a little undeserved recency.
+    /// </remarks>
+    private: static void applyAccesses(Shard &shard) {
+      std::size_t count = shard.AccessCount.load(std::memory_order_relaxed);
+      if(count == 0) {
+        return;
+      }
+      if(count > AccessBufferSize) {
+        count = AccessBufferSize;
+      }
+
+      for(std::size_t index = 0; index < count; ++index) {
+        std::size_t entry = shard.Accesses[index].exchange(0, std::memory_order_acquire);
+        if((entry != 0) && shard.Policy->Contains(entry - 1)) {
+          shard.Policy->Touch(entry - 1);
+        }
+      }
+
+      shard.AccessCount.store(0, std::memory_order_relaxed);
+    }
+
+    /// <summary>Marks the beginning of a modification to a shard</summary>
+    /// <param name="shard">Shard that will be modified</param>
+    private: static void beginWrite(Shard &shard) {
+      if constexpr(UsesOptimisticReads) {
+        std::uint32_t version = shard.Version.load(std::memory_order_relaxed);
+        shard.Version.store(version + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+      } else {
+        (void)shard;
+      }
+    }
+
+    /// <summary>Marks the end of a modification to a shard</summary>
+    /// <param name="shard">Shard that has been modified</param>
+    private: static void endWrite(Shard &shard) {
+      if constexpr(UsesOptimisticReads) {
+        std::uint32_t version = shard.Version.load(std::memory_order_relaxed);
+        shard.Version.store(version + 1, std::memory_order_release);
+      } else {
+        (void)shard;
+      }
+    }
+
+    /// <summary>Retrieves the key stored in a slot</summary>
+    /// <param name="slot">Slot whose key will be retrieved</param>
+    /// <returns>The key stored in the slot</returns>
+    private: static TKey *getKey(const Slot &slot) {
+      return std::launder(reinterpret_cast<TKey *>(const_cast<std::uint8_t *>(slot.KeyStorage)));
+    }
+
+    /// <summary>Retrieves the value stored in a slot</summary>
+    /// <param name="slot">Slot whose value will be retrieved</param>
+    /// <returns>The value stored in the slot</returns>
+    private: static TValue *getValue(const Slot &slot) {
+      return std::launder(
+        reinterpret_cast<TValue *>(const_cast<std::uint8_t *>(slot.ValueStorage))
+      );
+    }
+
+    /// <summary>Number of shards the cache is divided into, always a power of two</summary>
+    private: const std::size_t shardCount;
+    /// <summary>Number of bits a hash is shifted to the right to obtain the shard</summary>
+    private: const std::size_t shardShift;
+    /// <summary>Number of entries each shard can hold</summary>
+    private: std::size_t shardCapacity;
+    /// <summary>Number of buckets in each shard's index minus one</summary>
+    private: std::size_t indexMask;
+    /// <summary>Independently locked sections of the cache</summary>
+    private: std::unique_ptr<Shard[]> shards;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
+
+#endif // NUCLEX_SUPPORT_COLLECTIONS_CONCURRENTSHARDEDCACHE_H
@@ -0,0 +1,167 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_SUPPORT_COLLECTIONS_COUNTMINSKETCH_H
+#define NUCLEX_SUPPORT_COLLECTIONS_COUNTMINSKETCH_H
+
+#include "Nuclex/Support/Config.h"
+
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint64_t, std::uint8_t
+#include <memory> // for std::unique_ptr
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Estimates how often items have been seen in a fixed amount of memory</summary>
+  /// <remarks>
+  ///   <para>
+  ///     A count-min sketch keeps several rows of small counters. Each item increments
+  ///     one counter per row, chosen by a different hash for each row. Because unrelated
+  ///     items may share counters, each counter can only overestimate, so the smallest
+  ///     counter across all rows is the best available estimate of the item's frequency.
+  ///   </para>
+  ///   <para>
+  ///     This implementation uses 4 rows of 4 bit counters (16 counters per 64 bit word),
+  ///     so it needs just two bytes per expected item. Once the number of increments
+  ///     reaches ten times the width of the sketch, all counters are halved. This lets
+  ///     the sketch follow changing access patterns instead of remembering items that
+  ///     were popular a long time ago.
+  ///   </para>
+  ///   <para>
+  ///     It is used by the W-TinyLFU eviction policy to decide whether a newly cached
+  ///     item is more valuable than the item it would displace.
+  ///   </para>
+  /// </remarks>
+  class NUCLEX_SUPPORT_TYPE CountMinSketch {
+
+    /// <summary>Highest value a single counter can reach</summary>
+    public: constexpr static std::uint8_t MaximumCount = 15;
+
+    /// <summary>Initializes a new count-min sketch</summary>
+    /// <param name="expectedItemCount">
+    ///   Number of distinct items whose frequencies should be tracked
+    /// </param>
+    public: NUCLEX_SUPPORT_API CountMinSketch(std::size_t expectedItemCount);
+
+    /// <summary>Frees all memory used by the count-min sketch</summary>
+    public: NUCLEX_SUPPORT_API ~CountMinSketch();
+
+    /// <summary>Records an occurrence of the item with the specified hash</summary>
+    /// <param name="hash">Hash of the item that occurred</param>
+    public: void Increment(std::size_t hash);
+
+    /// <summary>Estimates how often the item with the specified hash occurred</summary>
+    /// <param name="hash">Hash of the item whose frequency will be estimated</param>
+    /// <returns>The estimated number of occurrences, up to <see cref="MaximumCount" /></returns>
+    public: std::uint8_t Estimate(std::size_t hash) const;
+
+    /// <summary>Resets all counters to zero</summary>
+    public: NUCLEX_SUPPORT_API void Clear();
+
+    /// <summary>Halves all counters so older occurrences lose their weight</summary>
+    private: NUCLEX_SUPPORT_API void age();
+
+    /// <summary>Mixes the bits of a hash so each row can use a different part of it</summary>
+    /// <param name="hash">Hash that will be mixed</param>
+    /// <returns>A 64 bit value with the hash's entropy spread over all bits</returns>
+    private: static std::uint64_t mixHash(std::size_t hash) {
+      std::uint64_t mixed = static_cast<std::uint64_t>(hash);
+      mixed ^= (mixed >> 33);
+      mixed *= 0xFF51AFD7ED558CCDull;
+      mixed ^= (mixed >> 33);
+      mixed *= 0xC4CEB9FE1A85EC53ull;
+      mixed ^= (mixed >> 33);
+      return mixed;
+    }
+
+    /// <summary>Number of rows, each using a different hash of the item</summary>
+    private: constexpr static std::size_t RowCount = 4;
+    /// <summary>Number of 4 bit counters stored in each 64 bit word</summary>
+    private: constexpr static std::size_t CountersPerWord = 16;
+
+    /// <summary>Number of counters in each row minus one, used to mask indices</summary>
+    private: std::size_t columnMask;
+    /// <summary>Number of 64 bit words each row occupies</summary>
+    private: std::size_t wordsPerRow;
+    /// <summary>Number of increments after which all counters are halved</summary>
+    private: std::size_t sampleSize;
+    /// <summary>Number of increments since the counters were last halved</summary>
+    private: std::size_t incrementCount;
+    /// <summary>Words holding the 4 bit counters of all rows</summary>
+    private: std::unique_ptr<std::uint64_t[]> counters;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline void CountMinSketch::Increment(std::size_t hash) {
+    std::uint64_t mixed = mixHash(hash);
+    std::size_t step = static_cast<std::size_t>(mixed >> 32) | 1;
+
+    bool anyIncremented = false;
+    for(std::size_t row = 0; row < RowCount; ++row) {
+      std::size_t column = (static_cast<std::size_t>(mixed) + row * step) & this->columnMask;
+      std::uint64_t &word = this->counters[
+        row * this->wordsPerRow + column / CountersPerWord
+      ];
+      unsigned int shift = static_cast<unsigned int>(column % CountersPerWord) * 4;
+      if(((word >> shift) & 0xF) < MaximumCount) {
+        word += (std::uint64_t(1) << shift);
+        anyIncremented = true;
+      }
+    }
+
+    // Saturated items do not count towards the sample, otherwise a single very popular
+    // item could keep triggering the aging process all by itself.
+    if(anyIncremented) {
+      ++this->incrementCount;
+      if(this->incrementCount >= this->sampleSize) {
+        age();
+      }
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline std::uint8_t CountMinSketch::Estimate(std::size_t hash) const {
+    std::uint64_t mixed = mixHash(hash);
+    std::size_t step = static_cast<std::size_t>(mixed >> 32) | 1;
+
+    std::uint8_t minimum = MaximumCount;
+    for(std::size_t row = 0; row < RowCount; ++row) {
+      std::size_t column = (static_cast<std::size_t>(mixed) + row * step) & this->columnMask;
+      std::uint64_t word = this->counters[row * this->wordsPerRow + column / CountersPerWord];
+      unsigned int shift = static_cast<unsigned int>(column % CountersPerWord) * 4;
+
+      std::uint8_t count = static_cast<std::uint8_t>((word >> shift) & 0xF);
+      if(count < minimum) {
+        minimum = count;
+      }
+    }
+
+    return minimum;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
+
+#endif // NUCLEX_SUPPORT_COLLECTIONS_COUNTMINSKETCH_H
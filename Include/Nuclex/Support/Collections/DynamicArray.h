@@ -36,10 +36,11 @@ namespace Nuclex::Support::Collections {
   ///   Use std::vector&lt;&gt; directly for library-internal data. This wrapper is intended
   ///   for when you want to expose a collection of items across DLL boundaries or if you
   ///   need to hide the actual container used from a public interface in order to stay
-  ///   flexible in its implementation.
+  ///   flexible in its implementation. The class is final, so calls made on a DynamicArray
+  ///   itself rather than through its interface need no virtual dispatch and can be inlined.
   /// </remarks>
   template<typename TValue>
-  class DynamicArray : public IndexedCollection<TValue> {
+  class DynamicArray final : public IndexedCollection<TValue> {
 
     public: using IndexedCollection<TValue>::InvalidIndex;
 
@@ -0,0 +1,63 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_SUPPORT_COLLECTIONS_EVICTIONPOLICIES_H
+#define NUCLEX_SUPPORT_COLLECTIONS_EVICTIONPOLICIES_H
+
+#include "Nuclex/Support/Config.h"
+#include "Nuclex/Support/BitTricks.h" // for BitTricks::GetUpperPowerOfTwo()
+#include "Nuclex/Support/Collections/CountMinSketch.h" // for CountMinSketch
+
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint8_t, std::uint32_t, std::uint64_t
+#include <memory> // for std::unique_ptr
+#include <cassert> // for assert()
+#include <stdexcept> // for std::invalid_argument
+#include <type_traits> // for std::is_unsigned, std::is_same
+#include <algorithm> // for std::fill_n()
+
+// Eviction policies decide which slot of a fixed-capacity cache gets recycled when
+// the cache is full. The slot caches (SequentialSlotCache, KeyedArrayCache) take
+// the policy as a template parameter, so any class providing these members can be
+// plugged in:
+//
+//   typedef ... SlotIndexType;                   integer type used to link slots
+//   constexpr static bool UsesKeyHash;           whether Insert() needs a key hash
+//   explicit Policy(std::size_t slotCount);      sets up tracking for the slots
+//   bool Contains(std::size_t slot) const;       whether the slot is occupied
+//   void Prefetch(std::size_t slot) const;       fetches what Contains()/Touch() read
+//   void Insert(std::size_t slot, std::size_t keyHash);  slot was occupied
+//   void Touch(std::size_t slot);                slot was accessed
+//   void Remove(std::size_t slot);               slot was freed by the cache
+//   std::size_t Evict();                         picks a slot and stops tracking it
+//   void Clear();                                stops tracking all slots
+//   void ForEach(TCallback &&callback) const;    visits slots, eviction order first
+//
+// All policies store their links as slot indices of SlotIndexType. Choosing a smaller
+// integer type saves memory in large caches but limits the number of slots to two
+// less than the range of the type.
+
+#include "Nuclex/Support/Collections/Private/EvictionPolicies.Shared.inl"
+#include "Nuclex/Support/Collections/Private/EvictionPolicies.LRU.inl"
+#include "Nuclex/Support/Collections/Private/EvictionPolicies.CLOCK.inl"
+#include "Nuclex/Support/Collections/Private/EvictionPolicies.TwoQueue.inl"
+#include "Nuclex/Support/Collections/Private/EvictionPolicies.S3FIFO.inl"
+#include "Nuclex/Support/Collections/Private/EvictionPolicies.WTinyLFU.inl"
+
+#endif // NUCLEX_SUPPORT_COLLECTIONS_EVICTIONPOLICIES_H
@@ -0,0 +1,225 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_SUPPORT_COLLECTIONS_HUGEPAGEALLOCATOR_H
+#define NUCLEX_SUPPORT_COLLECTIONS_HUGEPAGEALLOCATOR_H
+
+#include "Nuclex/Support/Config.h"
+
+#include <cstddef> // for std::size_t
+#include <new> // for std::bad_array_new_length, __STDCPP_DEFAULT_NEW_ALIGNMENT__
+#include <limits> // for std::numeric_limits
+#include <type_traits> // for std::is_trivially_copyable
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>How memory handed out by the huge page allocator is backed</summary>
+  enum class HugePageMode {
+
+    /// <summary>
+    ///   Normal pages that the operating system is asked to merge into huge pages
+    /// </summary>
+    /// <remarks>
+    ///   On Linux, this uses madvise(MADV_HUGEPAGE) on a 2 MiB-aligned mapping, which
+    ///   works without any system configuration as long as transparent huge pages are
+    ///   not disabled outright. Windows has no equivalent, so there the memory is
+    ///   simply allocated via VirtualAlloc().
+    /// </remarks>
+    Transparent,
+
+    /// <summary>Pages from the system's pool of reserved huge pages</summary>
+    /// <remarks>
+    ///   On Linux, this uses MAP_HUGETLB and requires huge pages to have been reserved
+    ///   (vm.nr_hugepages), on Windows it uses MEM_LARGE_PAGES and requires the process
+    ///   to hold the SeLockMemoryPrivilege. If no such pages can be obtained, the memory
+    ///   is allocated as if <see cref="Transparent" /> had been chosen.
+    /// </remarks>
+    Reserved
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Allocates large memory blocks backed by huge pages</summary>
+  /// <remarks>
+  ///   <para>
+  ///     These are the untyped allocation functions behind <see cref="HugePageAllocator" />.
+  ///     Blocks smaller than <see cref="HugePageSize" /> would only waste memory if they
+  ///     were given their own huge page, so they are served by the normal heap. Whether
+  ///     a block came from the heap or was mapped is decided by its size alone, which is
+  ///     why the size needs to be passed back when the block is freed.
+  ///   </para>
+  ///   <para>
+  ///     Mapped blocks always start at a huge page boundary on Linux (and at least at
+  ///     the 64 KiB allocation granularity on Windows). Blocks from the heap honor
+  ///     the requested alignment, which then also has to be passed back when the block
+  ///     is resized or freed.
+  ///   </para>
+  ///   <para>
+  ///     Failure to obtain memory is reported with std::bad_alloc, like it would be
+  ///     from operator new.
+  ///   </para>
+  /// </remarks>
+  class NUCLEX_SUPPORT_TYPE HugePageMemory {
+
+    /// <summary>Size of the huge pages the allocator tries to use</summary>
+    public: static const constexpr std::size_t HugePageSize = 2 * 1024 * 1024;
+
+    /// <summary>Alignment blocks have if no alignment is specified</summary>
+    public: static const constexpr std::size_t DefaultAlignment = (
+      __STDCPP_DEFAULT_NEW_ALIGNMENT__
+    );
+
+    /// <summary>Allocates a block of memory</summary>
+    /// <param name="byteCount">Number of bytes that will be allocated</param>
+    /// <param name="mode">Which kind of huge pages the block should use</param>
+    /// <param name="alignment">Alignment the block needs, a power of two</param>
+    /// <returns>The address of the newly allocated memory block</returns>
+    public: NUCLEX_SUPPORT_API static void *Allocate(
+      std::size_t byteCount,
+      HugePageMode mode = HugePageMode::Transparent,
+      std::size_t alignment = DefaultAlignment
+    );
+
+    /// <summary>Changes the size of a memory block, keeping its contents</summary>
+    /// <param name="memory">Memory block whose size will be changed</param>
+    /// <param name="oldByteCount">Size the memory block was allocated with</param>
+    /// <param name="newByteCount">Size the memory block should have</param>
+    /// <param name="mode">Which kind of huge pages the block should use</param>
+    /// <param name="alignment">Alignment the memory block was allocated with</param>
+    /// <returns>The new address of the memory block</returns>
+    /// <remarks>
+    ///   The memory block's contents are moved bitwise, so this must only be used for
+    ///   blocks holding trivially copyable data. On Linux, mapped blocks are grown with
+    ///   mremap(), which moves the pages by changing the page tables rather than copying
+    ///   them. If the block has to move, it is moved to another huge page boundary.
+    ///   If this method throws, the original memory block remains valid.
+    /// </remarks>
+    public: NUCLEX_SUPPORT_API static void *Reallocate(
+      void *memory,
+      std::size_t oldByteCount,
+      std::size_t newByteCount,
+      HugePageMode mode = HugePageMode::Transparent,
+      std::size_t alignment = DefaultAlignment
+    );
+
+    /// <summary>Frees a memory block</summary>
+    /// <param name="memory">Memory block that will be freed</param>
+    /// <param name="byteCount">Size the memory block was allocated with</param>
+    /// <param name="alignment">Alignment the memory block was allocated with</param>
+    public: NUCLEX_SUPPORT_API static void Free(
+      void *memory, std::size_t byteCount, std::size_t alignment = DefaultAlignment
+    ) noexcept;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Standard allocator that places large allocations in huge pages</summary>
+  /// <typeparam name="T">Type of items the allocator will allocate memory for</typeparam>
+  /// <remarks>
+  ///   <para>
+  ///     Containers holding gigabytes of data touch far more pages than the CPU's TLB
+  ///     can cover with normal 4 KiB pages. Backing them with 2 MiB pages cuts the number
+  ///     of TLB entries needed by a factor of 512.
+  ///   </para>
+  ///   <para>
+  ///     Besides the usual allocate() and deallocate() methods, this allocator provides
+  ///     reallocate(), which <see cref="RingQueue" /> and <see cref="ShiftQueue" /> use
+  ///     to grow their storage in place when the items are trivially copyable.
+  ///   </para>
+  /// </remarks>
+  template<typename T>
+  class HugePageAllocator {
+
+    /// <summary>Type of values the allocator allocates memory for</summary>
+    public: typedef T value_type;
+
+    /// <summary>Initializes a new huge page allocator</summary>
+    /// <param name="mode">Which kind of huge pages the allocator should use</param>
+    public: explicit HugePageAllocator(HugePageMode mode = HugePageMode::Transparent) noexcept :
+      mode(mode) {}
+
+    /// <summary>Initializes a huge page allocator as a copy of another allocator</summary>
+    /// <param name="other">Allocator for another type whose settings will be copied</param>
+    public: template<typename TOther>
+    HugePageAllocator(const HugePageAllocator<TOther> &other) noexcept :
+      mode(other.GetMode()) {}
+
+    /// <summary>Returns which kind of huge pages the allocator is using</summary>
+    /// <returns>The kind of huge pages used by the allocator</returns>
+    public: HugePageMode GetMode() const noexcept { return this->mode; }
+
+    /// <summary>Allocates memory for the specified number of items</summary>
+    /// <param name="count">Number of items memory will be allocated for</param>
+    /// <returns>The address of the allocated memory</returns>
+    public: T *allocate(std::size_t count) {
+      if(count > std::numeric_limits<std::size_t>::max() / sizeof(T)) [[unlikely]] {
+        throw std::bad_array_new_length();
+      }
+      return static_cast<T *>(
+        HugePageMemory::Allocate(count * sizeof(T), this->mode, alignof(T))
+      );
+    }
+
+    /// <summary>Changes the number of items an allocated memory block can hold</summary>
+    /// <param name="items">Memory block that will be resized</param>
+    /// <param name="oldCount">Number of items the memory block was allocated for</param>
+    /// <param name="newCount">Number of items the memory block should hold</param>
+    /// <returns>The new address of the memory block</returns>
+    public: T *reallocate(T *items, std::size_t oldCount, std::size_t newCount) {
+      static_assert(
+        std::is_trivially_copyable<T>::value,
+        "Only memory holding trivially copyable items can be reallocated"
+      );
+      if(newCount > std::numeric_limits<std::size_t>::max() / sizeof(T)) [[unlikely]] {
+        throw std::bad_array_new_length();
+      }
+      return static_cast<T *>(
+        HugePageMemory::Reallocate(
+          items, oldCount * sizeof(T), newCount * sizeof(T), this->mode, alignof(T)
+        )
+      );
+    }
+
+    /// <summary>Frees memory that was allocated by the allocator</summary>
+    /// <param name="items">Memory that will be freed</param>
+    /// <param name="count">Number of items the memory was allocated for</param>
+    public: void deallocate(T *items, std::size_t count) noexcept {
+      HugePageMemory::Free(items, count * sizeof(T), alignof(T));
+    }
+
+    /// <summary>Checks whether two allocators can free each other's memory</summary>
+    /// <param name="other">Other allocator that will be compared</param>
+    /// <returns>Always true, any instance can free memory allocated by another</returns>
+    public: template<typename TOther>
+    bool operator ==(const HugePageAllocator<TOther> &) const noexcept { return true; }
+
+    /// <summary>Which kind of huge pages will be used for new allocations</summary>
+    private: HugePageMode mode;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
+
+#endif // NUCLEX_SUPPORT_COLLECTIONS_HUGEPAGEALLOCATOR_H
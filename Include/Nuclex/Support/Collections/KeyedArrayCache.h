@@ -23,10 +23,27 @@ limitations under the License.
 #include "Nuclex/Support/Config.h"
 
 #include "Nuclex/Support/Collections/MultiCache.h" // for MultiCache
+#include "Nuclex/Support/Collections/EvictionPolicies.h" // for LruEvictionPolicy
+#include "Nuclex/Support/Collections/TimerWheel.h" // for TimerWheel
 #include "Nuclex/Support/Errors/KeyNotFoundError.h" // for KeyNotFoundError
+#include "Nuclex/Support/BitTricks.h" // for BitTricks::GetUpperPowerOfTwo()
+#include "Nuclex/Support/ScopeGuard.h" // for ON_SCOPE_EXIT_TRANSACTION
 
 #include <cstddef> // for std::byte
+#include <cstdint> // for std::uint64_t
 #include <optional> // for std::optional<>
+#include <cassert> // for assert()
+#include <type_traits> // for std::is_void
+#include <algorithm> // for std::fill_n()
+#include <functional> // for std::hash
+#include <bit> // for std::countr_zero()
+#include <limits> // for std::numeric_limits
+#include <memory> // for std::unique_ptr
+#include <chrono> // for std::chrono::steady_clock, std::chrono::milliseconds
+#include <utility> // for std::move(), std::forward()
+#include <span> // for std::span
+
+#include "Nuclex/Support/Collections/Private/ArithmeticKeyScanner.inl"
 
 namespace Nuclex::Support::Collections {
 
@@ -35,6 +52,13 @@ namespace Nuclex::Support::Collections {
   /// <summary>Caches items that can be addressed through a linear, zero-based index</summary>
   /// <typeparam name="TKey">Type of the key the cache uses, must be an integer</typeparam>
   /// <typeparam name="TValue">Type of values that are stored in the cache</typeparam>
+  /// <typeparam name="THash">
+  ///   Hash functor used to maintain an index from keys to slots, or void to look up keys
+  ///   by scanning through the slot array
+  /// </typeparam>
+  /// <typeparam name="TEvictionPolicy">
+  ///   Policy that decides which items get evicted, see EvictionPolicies.h
+  /// </typeparam>
   /// <remarks>
   ///   <para>
   ///     This type of cache is ideal if you have a fixed number of items (for example,
@@ -43,18 +67,60 @@ namespace Nuclex::Support::Collections {
   ///   </para>
   ///   <para>
   ///     It keeps these items in a linear array (wherein &quot;slots&quot; can be either
-  ///     occupied or empty, just like <see cref="std.vector" />, but also maintains
-  ///     a doubly-linked MRU list between those items, preventing memory fragmentation from
-  ///     micro allocations, enabling cache-friendly searches through linear memory whilst
-  ///     offering cheap MRU functionality like evict, bring to top, get oldest).
+  ///     occupied or empty, just like <see cref="std.vector" />), preventing memory
+  ///     fragmentation from micro allocations and enabling cache-friendly searches through
+  ///     linear memory. Which item is replaced when the cache is full is decided by
+  ///     the eviction policy, which defaults to plain LRU but can be CLOCK, 2Q, S3-FIFO
+  ///     or W-TinyLFU as well. Policies that need to recognize returning keys are given
+  ///     the key's hash, produced by THash or, if no hash functor was specified,
+  ///     by std::hash&lt;TKey&gt;.
+  ///   </para>
+  ///   <para>
+  ///     By default, looking up a key scans all slots of the cache, which is fastest for
+  ///     small caches. For larger caches, provide a hash functor (i.e. std::hash&lt;TKey&gt;)
+  ///     as the third template argument and the cache will maintain an open-addressed index
+  ///     from keys to slots, making lookups, takes and removals O(1) on average.
+  ///   </para>
+  ///   <para>
+  ///     If the key is an integer or floating point type, keys are not stored alongside
+  ///     the values but in a separate, contiguous array with an occupancy bit mask.
+  ///     The linear scan then compares a full SIMD register of keys (AVX2, SSE2 or NEON)
+  ///     at once and skips over empty ranges of slots, so small caches with plain
+  ///     numeric keys get fast lookups without needing a hash index.
+  ///   </para>
+  ///   <para>
+  ///     The eviction policy links slots by their index. If the cache will never hold
+  ///     more than 4 billion (or 65534) items, specify std::uint32_t (or std::uint16_t)
+  ///     as the policy's slot index type, i.e. <c>LruEvictionPolicy&lt;std::uint16_t&gt;</c>,
+  ///     to shrink the links accordingly.
+  ///   </para>
+  ///   <para>
+  ///     If the cached values vary in size, each item can be inserted with a cost (such as
+  ///     its size in bytes). The cache then keeps the total cost of its items within
+  ///     a cost budget in addition to its capacity, evicting as many items as needed to
+  ///     make room for a new one. Items inserted without a cost count as a cost of 1.
+  ///   </para>
+  ///   <para>
+  ///     Items can also be given a time to live, optionally renewed whenever they are
+  ///     accessed. Expired items are never returned by lookups. Their deadlines are kept
+  ///     in a hierarchical timer wheel, so removing them costs O(1) per item and happens
+  ///     automatically during inserts and takes. Lookups are const and only skip over
+  ///     expired items, which keep counting towards <see cref="Count" /> until they are
+  ///     removed. Call <see cref="EvictExpired" /> to remove expired items at other times.
   ///   </para>
   /// </remarks>
-  template<typename TKey, typename TValue>
-  class KeyedArrayCache : public MultiCache<TKey, TValue> {
+  template<
+    typename TKey, typename TValue,
+    typename THash = void, typename TEvictionPolicy = LruEvictionPolicy<>
+  >
+  class KeyedArrayCache final : public MultiCache<TKey, TValue> {
 
     /// <summary>Initializes a new array cache with the specified size</summary>
     /// <param name="capacity">Maximum number of entries the cache may hold</param>
-    public: KeyedArrayCache(std::size_t capacity);
+    /// <param name="costBudget">Maximum total cost of all entries in the cache</param>
+    public: KeyedArrayCache(
+      std::size_t capacity, std::size_t costBudget = std::numeric_limits<std::size_t>::max()
+    );
 
     /// <summary>Frees all memory used by the array cache</summary>
     public: virtual ~KeyedArrayCache();
@@ -65,6 +131,64 @@ namespace Nuclex::Support::Collections {
     /// <returns>True in all cases</returns>
     public: bool Insert(const TKey &key, const TValue &value) override;
 
+    /// <summary>Moves a value into the cache</summary>
+    /// <param name="key">Key under which the value can be looked up later</param>
+    /// <param name="value">Value that will be moved into the cache under its key</param>
+    /// <returns>True in all cases</returns>
+    public: bool Insert(const TKey &key, TValue &&value) override;
+
+    /// <summary>Constructs a value directly inside the cache's slot</summary>
+    /// <typeparam name="TArguments">Types of the arguments for the value's constructor</typeparam>
+    /// <param name="key">Key under which the value can be looked up later</param>
+    /// <param name="arguments">Arguments that will be passed to the value's constructor</param>
+    /// <returns>True in all cases</returns>
+    public: template<typename... TArguments>
+    bool Emplace(const TKey &key, TArguments &&... arguments);
+
+    /// <summary>Stores a value with the specified cost in the cache</summary>
+    /// <param name="key">Key under which the value can be looked up later</param>
+    /// <param name="value">Value that will be stored under its key</param>
+    /// <param name="cost">Cost of the value, for example its size in bytes</param>
+    /// <returns>
+    ///   True if the value was stored, false if its cost exceeds the whole cost budget
+    /// </returns>
+    /// <remarks>
+    ///   Other items are evicted until both the item count and the total cost of
+    ///   the cache leave enough room for the new item.
+    /// </remarks>
+    public: bool Insert(const TKey &key, const TValue &value, std::size_t cost);
+
+    /// <summary>Moves a value with the specified cost into the cache</summary>
+    /// <param name="key">Key under which the value can be looked up later</param>
+    /// <param name="value">Value that will be moved into the cache under its key</param>
+    /// <param name="cost">Cost of the value, for example its size in bytes</param>
+    /// <returns>
+    ///   True if the value was stored, false if its cost exceeds the whole cost budget
+    ///   (in which case the value is left untouched)
+    /// </returns>
+    public: bool Insert(const TKey &key, TValue &&value, std::size_t cost);
+
+    /// <summary>Stores many values in the cache at once</summary>
+    /// <param name="keys">Keys under which the values can be looked up later</param>
+    /// <param name="values">
+    ///   Values that will be stored under their keys, must have the same length as
+    ///   <paramref name="keys" />
+    /// </param>
+    /// <returns>The number of values that were stored</returns>
+    /// <remarks>
+    ///   <para>
+    ///     This is a convenience wrapper that stores the values one after another. If
+    ///     the key index is used, the index buckets of all keys are prefetched up front
+    ///     so their cache misses overlap, but each insert still hashes its key again and
+    ///     probes on its own because evictions change the index between the inserts.
+    ///   </para>
+    ///   <para>
+    ///     If the batch holds more values than the cache's capacity, values from earlier
+    ///     in the batch will be evicted to make room for later ones.
+    ///   </para>
+    /// </remarks>
+    public: std::size_t InsertMany(std::span<const TKey> keys, std::span<const TValue> values);
+
     /// <summary>Returns the value of the specified element in the map</summary>
     /// <param name="key">Key of the element that will be looked up</param>
     public: const TValue &Get(const TKey &key) const override;
@@ -77,6 +201,34 @@ namespace Nuclex::Support::Collections {
     /// </returns>
     public: bool TryGet(const TKey &key, TValue &value) const override;
 
+    /// <summary>Looks up an element in the map without copying its value</summary>
+    /// <param name="key">Key of the element that will be looked up</param>
+    /// <returns>
+    ///   A pointer to the element's value or a null pointer if the key didn't exist
+    /// </returns>
+    public: const TValue *TryGetPointer(const TKey &key) const override;
+
+    /// <summary>Looks up many elements in the cache at once</summary>
+    /// <param name="keys">Keys of the elements that will be looked up</param>
+    /// <param name="values">
+    ///   Receives a pointer to each element's value or a null pointer if the key didn't
+    ///   exist, must have the same length as <paramref name="keys" />
+    /// </param>
+    /// <returns>The number of keys that were found</returns>
+    /// <remarks>
+    ///   If the key index is used, the index buckets of all keys are prefetched before any
+    ///   of them is probed and while a key is being probed, the stored key and eviction
+    ///   tracking of the next key's slot are prefetched, so the cache misses of the lookups
+    ///   overlap. Recency is updated in one pass after all lookups are done, with the
+    ///   eviction tracking of each found slot prefetched when it is found. Expired items
+    ///   are skipped as if they were missing, but keep counting towards
+    ///   <see cref="Count" /> until inserts, takes or <see cref="EvictExpired" /> remove
+    ///   them. The pointers remain valid until the cache is modified.
+    /// </remarks>
+    public: std::size_t TryGetMany(
+      std::span<const TKey> keys, std::span<const TValue *> values
+    ) const;
+
     /// <summary>Tries to take an element from the map (removing it)</summary>
     /// <param name="key">Key of the element that will be taken from the map</param>
     /// <param name="value">Will receive the value taken from the map</param>
@@ -102,6 +254,13 @@ namespace Nuclex::Support::Collections {
     /// <param name="itemCount">Maximum number of items that will be left behind</param>
     public: void EvictDownTo(std::size_t itemCount) override;
 
+    /// <summary>
+    ///   Evicts items from the cache until their total cost is at most
+    ///   <see cref="totalCost" />
+    /// </summary>
+    /// <param name="totalCost">Maximum total cost of the items that will be left behind</param>
+    public: void EvictDownToCost(std::size_t totalCost);
+
     /// <summary>Evicts items from the cache matching a user-defined criterion</summary>
     /// <param name="policyCallback">Callback that decides whether to evict an entry</param>
     public: void EvictWhere(
@@ -118,41 +277,260 @@ namespace Nuclex::Support::Collections {
     /// <returns>True if the map had been empty during the call</returns>
     public: bool IsEmpty() const override;
 
+    /// <summary>Sums up the costs of all items currently in the cache</summary>
+    /// <returns>The total cost of the items in the cache</returns>
+    public: std::size_t GetTotalCost() const { return this->totalCost; }
+
+    /// <summary>Retrieves the maximum total cost the items in the cache may have</summary>
+    /// <returns>The cache's current cost budget</returns>
+    public: std::size_t GetCostBudget() const { return this->costBudget; }
+
+    /// <summary>Changes the maximum total cost the items in the cache may have</summary>
+    /// <param name="costBudget">New cost budget for the cache</param>
+    /// <remarks>
+    ///   If the items in the cache exceed the new budget, they are evicted immediately
+    /// </remarks>
+    public: void SetCostBudget(std::size_t costBudget);
+
+    /// <summary>Sets how long items remain in the cache before they expire</summary>
+    /// <param name="timeToLive">
+    ///   Time after which items expire, zero to let items live until they are evicted
+    /// </param>
+    /// <param name="renewOnAccess">
+    ///   Whether looking up an item restarts its time to live (expire-after-access)
+    ///   rather than counting from when it was inserted (expire-after-write)
+    /// </param>
+    /// <remarks>
+    ///   Items already in the cache are given the new time to live starting now.
+    ///   Time is tracked with millisecond resolution.
+    /// </remarks>
+    public: void SetTimeToLive(std::chrono::milliseconds timeToLive, bool renewOnAccess = false);
+
+    /// <summary>Removes all items whose time to live has run out</summary>
+    /// <returns>The number of items that were removed</returns>
+    public: std::size_t EvictExpired() {
+      return EvictExpired(std::chrono::steady_clock::now());
+    }
+
+    /// <summary>Removes all items that have expired by the specified time</summary>
+    /// <param name="now">Time that will be considered the current time</param>
+    /// <returns>The number of items that were removed</returns>
+    public: std::size_t EvictExpired(std::chrono::steady_clock::time_point now);
+
     //private: Cache(const Cache &) = delete;
     //private: Cache &operator =(const Cache &) = delete;
 
+    /// <summary>Whether keys are stored in a separate array that is scanned via SIMD</summary>
+    private: constexpr static bool StoresKeysSeparately = (
+      Private::ArithmeticKeyScanner<TKey>::IsSupported
+    );
+
     #pragma region struct SlotState
 
-    /// <summary>Status of a slot, including its place in the MRU list</summary>
+    /// <summary>Status of a slot if keys are stored alongside the values</summary>
     private: struct SlotState {
 
-      /// <summary>Initializes a new slot state</summary>
-      public: SlotState() : Key() {} // leave LessRecentlyUsed and MoreRecentlyUsed alone
+      /// <summary>Initializes a new slot state as empty</summary>
+      public: SlotState() : Key() {}
 
       /// <summary>Whether this slot is occupied and if so, its key</summary>
       public: std::optional<TKey> Key;
-      /// <summary>Link to the previous element in the MRU doubly linked list</summary>
-      public: SlotState *LessRecentlyUsed;
-      /// <summary>Link to the next element in the MRU doubly linked list</summary>
-      public: SlotState *MoreRecentlyUsed;
 
     };
 
     #pragma endregion // struct SlotState
 
-    /// <summary>
-    ///   Moves the specified slot state to the top of the most recently used list
-    /// </summary>
-    /// <param name="slotState">Slot that will become the most recently used</param>
-    private: void makeMostRecentlyUsed(SlotState &slotState) const; // <- in mutable state
+    /// <summary>Checks whether the specified slot is occupied</summary>
+    /// <param name="slotIndex">Index of the slot that will be checked</param>
+    /// <returns>True if the slot holds a key and a value, false otherwise</returns>
+    private: bool isOccupied(std::size_t slotIndex) const {
+      if constexpr(StoresKeysSeparately) {
+        return ((this->occupancy[slotIndex / 64] >> (slotIndex % 64)) & 1) != 0;
+      } else {
+        return this->states[slotIndex].Key.has_value();
+      }
+    }
+
+    /// <summary>Retrieves the key stored in an occupied slot</summary>
+    /// <param name="slotIndex">Index of the slot whose key will be returned</param>
+    /// <returns>The key stored in the specified slot</returns>
+    private: const TKey &getKey(std::size_t slotIndex) const {
+      if constexpr(StoresKeysSeparately) {
+        return this->keys[slotIndex];
+      } else {
+        return *this->states[slotIndex].Key;
+      }
+    }
+
+    /// <summary>Stores a key in the specified slot and marks it as occupied</summary>
+    /// <param name="slotIndex">Index of the slot in which the key will be stored</param>
+    /// <param name="key">Key that will be stored in the slot</param>
+    private: void assignKey(std::size_t slotIndex, const TKey &key) {
+      if constexpr(StoresKeysSeparately) {
+        this->keys[slotIndex] = key;
+        this->occupancy[slotIndex / 64] |= (std::uint64_t(1) << (slotIndex % 64));
+      } else {
+        this->states[slotIndex].Key = key;
+      }
+    }
+
+    /// <summary>Removes the key from the specified slot and marks it as free</summary>
+    /// <param name="slotIndex">Index of the slot whose key will be removed</param>
+    private: void resetKey(std::size_t slotIndex) {
+      if constexpr(StoresKeysSeparately) {
+        this->occupancy[slotIndex / 64] &= ~(std::uint64_t(1) << (slotIndex % 64));
+      } else {
+        this->states[slotIndex].Key.reset(); // = std::optional<TKey>();
+      }
+    }
+
+    /// <summary>Asks the CPU to fetch the key of a slot into its cache</summary>
+    /// <param name="slotIndex">Index of the slot whose key will be fetched</param>
+    private: void prefetchKey(std::size_t slotIndex) const {
+      if constexpr(StoresKeysSeparately) {
+        NUCLEX_SUPPORT_PREFETCH(this->keys + slotIndex);
+      } else {
+        NUCLEX_SUPPORT_PREFETCH(this->states + slotIndex);
+      }
+    }
+
+    /// <summary>Checks whether the item in an occupied slot has not expired yet</summary>
+    /// <param name="slotIndex">Index of the slot that will be checked</param>
+    /// <param name="now">Tick that will be considered the current time</param>
+    /// <returns>True if the item is still alive at the specified tick</returns>
+    private: bool isLive(std::size_t slotIndex, std::uint64_t now) const {
+      return (!this->expirations || (this->expirations->GetDeadline(slotIndex) > now));
+    }
+
+    /// <summary>Finds the slot in which the specified key is stored</summary>
+    /// <param name="key">Key that will be looked up</param>
+    /// <returns>The index of the slot holding the key or the capacity if not found</returns>
+    private: std::size_t findSlot(const TKey &key) const {
+      return findSlot(key, [](std::size_t) { return true; });
+    }
 
-    /// <summary>Integrates the specified slot state into the most recently used list</summary>
-    /// <param name="slotState">Slot state that will be integratedf into the MRU list</param>
-    private: void linkMostRecentlyUsed(SlotState &slotState) const; // <- in mutable state
+    /// <summary>Finds the first slot storing the specified key that is accepted</summary>
+    /// <typeparam name="TAcceptor">Callable that receives the index of a slot</typeparam>
+    /// <param name="key">Key that will be looked up</param>
+    /// <param name="accept">Decides whether a slot holding the key will be returned</param>
+    /// <returns>The index of the slot holding the key or the capacity if not found</returns>
+    private: template<typename TAcceptor>
+    std::size_t findSlot(const TKey &key, TAcceptor &&accept) const;
+
+    /// <summary>Probes the key index for a key, starting at the specified bucket</summary>
+    /// <typeparam name="TAcceptor">Callable that receives the index of a slot</typeparam>
+    /// <param name="key">Key that will be looked up</param>
+    /// <param name="bucket">Preferred index bucket of the key</param>
+    /// <param name="accept">Decides whether a slot holding the key will be returned</param>
+    /// <returns>The index of the slot holding the key or the capacity if not found</returns>
+    /// <remarks>Must only be called if the key index is enabled</remarks>
+    private: template<typename TAcceptor>
+    std::size_t probeIndex(const TKey &key, std::size_t bucket, TAcceptor &&accept) const;
+
+    /// <summary>Adds the specified slot to the key index</summary>
+    /// <param name="slotIndex">Slot whose key has just been assigned</param>
+    /// <remarks>Does nothing unless the key index is enabled</remarks>
+    private: void addToIndex(std::size_t slotIndex);
+
+    /// <summary>Removes the specified slot from the key index</summary>
+    /// <param name="slotIndex">Slot whose key is about to be reset</param>
+    /// <remarks>
+    ///   Does nothing unless the key index is enabled. The slot still has to hold its key
+    ///   when this method is called because the key is needed to locate the index entry.
+    /// </remarks>
+    private: void removeFromIndex(std::size_t slotIndex);
+
+    /// <summary>Calculates the preferred index bucket for the specified key</summary>
+    /// <param name="key">Key whose preferred index bucket will be calculated</param>
+    /// <returns>The index bucket at which probing for the key begins</returns>
+    private: std::size_t getIndexBucket(const TKey &key) const {
+      std::size_t hash = static_cast<std::size_t>(THash()(key));
+
+      // Identity hashes (like std::hash for integers) put sequential keys into sequential
+      // buckets, which makes linear probing degrade badly, so mix the bits a little.
+      if constexpr(sizeof(std::size_t) >= 8) {
+        hash ^= (hash >> 33);
+        hash *= static_cast<std::size_t>(0xFF51AFD7ED558CCDull);
+        hash ^= (hash >> 33);
+      } else {
+        hash ^= (hash >> 16);
+        hash *= static_cast<std::size_t>(0x85EBCA6Bu);
+        hash ^= (hash >> 13);
+      }
 
-    /// <summary>Removes the specified slot state from the most recently used list</summary>
-    /// <param name="slotState">Slot state that will be removed from the MRU list</param>
-    private: void unlinkMostRecentlyUsed(SlotState &slotState) const; // <- in mutable state
+      return hash & (this->indexBucketCount - 1);
+    }
+
+    /// <summary>Calculates the hash the eviction policy is given for a key</summary>
+    /// <param name="key">Key whose hash will be calculated</param>
+    /// <returns>The key hash if the policy uses it, otherwise zero</returns>
+    private: static std::size_t getPolicyHash(const TKey &key) {
+      if constexpr(!TEvictionPolicy::UsesKeyHash) {
+        (void)key;
+        return 0;
+      } else if constexpr(UsesIndex) {
+        return static_cast<std::size_t>(THash()(key));
+      } else {
+        return static_cast<std::size_t>(std::hash<TKey>()(key));
+      }
+    }
+
+    /// <summary>Prepares the cache to store an item with the specified cost</summary>
+    /// <param name="cost">Cost of the item that is about to be stored</param>
+    /// <returns>False if the cost exceeds the whole cost budget, true otherwise</returns>
+    private: bool prepareForCost(std::size_t cost);
+
+    /// <summary>Constructs a value with the specified cost in a free or evicted slot</summary>
+    /// <typeparam name="TArguments">Types of the arguments for the value's constructor</typeparam>
+    /// <param name="cost">Cost of the value, must not exceed the cost budget</param>
+    /// <param name="key">Key under which the value can be looked up later</param>
+    /// <param name="arguments">Arguments that will be passed to the value's constructor</param>
+    private: template<typename... TArguments>
+    void emplace(std::size_t cost, const TKey &key, TArguments &&... arguments);
+
+    /// <summary>Finds a slot holding the specified key whose item hasn't expired</summary>
+    /// <param name="key">Key that will be looked up</param>
+    /// <returns>The index of the slot holding the key or the capacity if not found</returns>
+    /// <remarks>
+    ///   Expired items are skipped but left in place. If items are renewed on access,
+    ///   the time to live of the item that was found is restarted.
+    /// </remarks>
+    private: std::size_t findLiveSlot(const TKey &key) const;
+
+    /// <summary>Converts a point in time into the ticks used for expiration</summary>
+    /// <param name="time">Point in time that will be converted</param>
+    /// <returns>The number of milliseconds since the steady clock's epoch</returns>
+    private: static std::uint64_t toTick(std::chrono::steady_clock::time_point time) {
+      return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count()
+      );
+    }
+
+    /// <summary>Removes all items whose deadline is at or before the specified tick</summary>
+    /// <param name="tick">Tick up to which items will be expired</param>
+    /// <returns>The number of items that were removed</returns>
+    private: std::size_t evictExpired(std::uint64_t tick);
+
+    /// <summary>Looks up the cost of the item in an occupied slot</summary>
+    /// <param name="slotIndex">Index of the slot whose cost will be returned</param>
+    /// <returns>The cost of the item stored in the slot</returns>
+    private: std::size_t getCost(std::size_t slotIndex) const {
+      return (this->costs == nullptr) ? 1 : this->costs[slotIndex];
+    }
+
+    /// <summary>Destroys the value in an occupied slot and marks the slot as free</summary>
+    /// <param name="slotIndex">Index of the slot that will be freed</param>
+    /// <remarks>The eviction policy must already have stopped tracking the slot</remarks>
+    private: void freeSlot(std::size_t slotIndex) {
+      this->totalCost -= getCost(slotIndex);
+      if(this->expirations) {
+        this->expirations->Cancel(slotIndex);
+      }
+      this->values[slotIndex].~TValue();
+      removeFromIndex(slotIndex);
+      resetKey(slotIndex);
+      --this->count;
+    }
 
     /// <summary>
     ///   Calculates the amount of memory needed for buffer holding both the slot states
@@ -160,9 +538,13 @@ namespace Nuclex::Support::Collections {
     /// </summary>
     /// <param name="slotCount">Number of slots for which the memory is calculated</param>
     /// <returns>The required memory to store slots and values with alignment</returns>
+    /// <remarks>
+    ///   If keys are stored separately, no slot states are needed and the memory only
+    ///   holds the values
+    /// </remarks>
     private: constexpr static std::size_t getRequiredMemory(std::size_t slotCount) {
       return (
-        (sizeof(SlotState[2]) * slotCount / 2) +
+        (StoresKeysSeparately ? 0 : (sizeof(SlotState[2]) * slotCount / 2)) +
         (sizeof(TValue[2]) * slotCount / 2) +
         (alignof(SlotState) - 1) + // for initial alignment padding if needed
         (
@@ -176,30 +558,71 @@ namespace Nuclex::Support::Collections {
     private: std::size_t count;
     /// <summary>Number of entries the cache can hold</summary>
     private: std::size_t capacity;
+    /// <summary>Decides which slot is recycled when the cache is full</summary>
+    private: mutable TEvictionPolicy policy;
     /// <summary>Memory allocated to store the slot states and values</summary>
     private: std::byte *memory;
     /// <summary>Values stored in each of the slots</summary>
     private: TValue *values;
-    /// <summary>Keeps track of the state of each individual slot</summary>
-    private: mutable SlotState *states;
-    /// <summary>Pointer to the state of the most recently used slot</summary>
-    private: mutable SlotState *mostRecentlyUsed;
-    /// <summary>Pointer to the state of the least recently used slot</summary>
-    private: mutable SlotState *leastRecentlyUsed;
+    /// <summary>Keys of the slots if keys are stored alongside the values</summary>
+    private: SlotState *states;
+    /// <summary>Keys of all slots if keys are stored separately, padded to full vectors</summary>
+    private: TKey *keys;
+    /// <summary>One bit per slot that is set if the slot is occupied</summary>
+    private: std::uint64_t *occupancy;
+    /// <summary>Whether a hash functor was provided and the key index is used</summary>
+    private: constexpr static bool UsesIndex = !std::is_void<THash>::value;
+    /// <summary>Number of buckets in the key index, always a power of two</summary>
+    private: std::size_t indexBucketCount;
+    /// <summary>Index buckets holding slot index + 1 for each key, 0 means empty</summary>
+    private: std::size_t *index;
+    /// <summary>Total cost of all items currently stored in the cache</summary>
+    private: std::size_t totalCost;
+    /// <summary>Maximum total cost the items in the cache may have</summary>
+    private: std::size_t costBudget;
+    /// <summary>Cost of each slot's item, only allocated once a cost is specified</summary>
+    private: std::size_t *costs;
+    /// <summary>Deadlines of the items, only created once a time to live is set</summary>
+    /// <remarks>
+    ///   Like the eviction policy, this is updated by const lookups when they renew
+    ///   an item's time to live, but only non-const methods remove expired items
+    /// </remarks>
+    private: std::unique_ptr<TimerWheel> expirations;
+    /// <summary>Milliseconds items live for, only meaningful with expirations</summary>
+    private: std::uint64_t timeToLiveTicks;
+    /// <summary>Whether the time to live restarts each time an item is accessed</summary>
+    private: bool renewOnAccess;
 
   };
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  KeyedArrayCache<TKey, TValue>::KeyedArrayCache(std::size_t capacity) :
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::KeyedArrayCache(
+    std::size_t capacity, std::size_t costBudget
+  ) :
     count(0),
     capacity(capacity),
+    policy(capacity),
     memory(new std::byte[getRequiredMemory(capacity)]),
     values(),
     states(),
-    mostRecentlyUsed(nullptr),
-    leastRecentlyUsed(nullptr) {
+    keys(nullptr),
+    occupancy(nullptr),
+    indexBucketCount(0),
+    index(nullptr),
+    totalCost(0),
+    costBudget(costBudget),
+    costs(nullptr),
+    expirations(),
+    timeToLiveTicks(0),
+    renewOnAccess(false) {
+    auto freeMemoryScope = ON_SCOPE_EXIT_TRANSACTION {
+      delete[] this->index;
+      delete[] this->occupancy;
+      delete[] this->keys;
+      delete[] this->memory;
+    };
 
     // Calculate the aligned memory address where slot states will be stored
     {
@@ -217,11 +640,12 @@ namespace Nuclex::Support::Collections {
 
     // Place the values directly behind the slot state array, with alignment padding
     // if the end of the slot state array doesn't meet the value's alignment needs.
+    // If keys are stored separately, the slot state array is empty.
     {
-      std::uintptr_t valueMemory = (
-        reinterpret_cast<std::uintptr_t>(this->states) +
-        (sizeof(SlotState[2]) * capacity / 2)
-      );
+      std::uintptr_t valueMemory = reinterpret_cast<std::uintptr_t>(this->states);
+      if constexpr(!StoresKeysSeparately) {
+        valueMemory += (sizeof(SlotState[2]) * capacity / 2);
+      }
       std::size_t misalignment = valueMemory % alignof(TValue);
 
       if(misalignment > 0) {
@@ -233,26 +657,183 @@ namespace Nuclex::Support::Collections {
       }
     }
 
-    // Initialize all IsOccupied values to false so we don't accidentally try to destroy
-    // values that weren't present (but where the uninitialized memory in which we built
-    // the slot state array happened to have the appropriate bits set to make IsOccupied true).
-    for(std::size_t index = 0; index < capacity; ++index) {
-      new(&this->states[index]) SlotState();
+    // Initialize all keys to empty so we don't accidentally try to destroy values
+    // that weren't present (but where the uninitialized memory in which we built
+    // the slot state array happened to look like an occupied std::optional).
+    if constexpr(!StoresKeysSeparately) {
+      for(std::size_t index = 0; index < capacity; ++index) {
+        new(&this->states[index]) SlotState();
+      }
+    }
+
+    // Arithmetic keys are stored in their own array for fast scanning. The array is
+    // padded to full vectors so the scan never has to deal with a partial vector.
+    if constexpr(StoresKeysSeparately) {
+      constexpr std::size_t keysPerVector = Private::ArithmeticKeyScanner<TKey>::KeysPerVector;
+      std::size_t paddedSlotCount = (
+        (capacity + keysPerVector - 1) / keysPerVector * keysPerVector
+      );
+
+      this->keys = new TKey[paddedSlotCount](); // zeroed so SIMD never reads garbage
+      this->occupancy = new std::uint64_t[(paddedSlotCount + 63) / 64]();
+    }
+
+    // If the key index is used, set up a table at least twice the size of the cache,
+    // keeping the load factor at 50% or less so that linear probing remains short.
+    if constexpr(UsesIndex) {
+      this->indexBucketCount = static_cast<std::size_t>(
+        BitTricks::GetUpperPowerOfTwo(static_cast<std::uint64_t>(capacity * 2))
+      );
+      if(this->indexBucketCount < 4) {
+        this->indexBucketCount = 4;
+      }
+
+      this->index = new std::size_t[this->indexBucketCount];
+      std::fill_n(this->index, this->indexBucketCount, std::size_t(0));
     }
+
+    freeMemoryScope.Commit();
   }
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  KeyedArrayCache<TKey, TValue>::~KeyedArrayCache() {
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::~KeyedArrayCache() {
     Clear();
+    delete[] this->costs;
+    delete[] this->index;
+    delete[] this->occupancy;
+    delete[] this->keys;
     delete[] this->memory;
   }
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  bool KeyedArrayCache<TKey, TValue>::Insert(const TKey &key, const TValue &value) {
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  bool KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::Insert(
+    const TKey &key, const TValue &value
+  ) {
+    return Emplace(key, value);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  bool KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::Insert(
+    const TKey &key, TValue &&value
+  ) {
+    return Emplace(key, std::move(value));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  template<typename... TArguments>
+  bool KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::Emplace(
+    const TKey &key, TArguments &&... arguments
+  ) {
+    if(this->costBudget < 1) {
+      return false;
+    }
+
+    emplace(1, key, std::forward<TArguments>(arguments)...);
+    return true; // it was inserted (inheriting Map<K, T> requires this pointless result)
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  bool KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::Insert(
+    const TKey &key, const TValue &value, std::size_t cost
+  ) {
+    if(!prepareForCost(cost)) {
+      return false;
+    }
+
+    emplace(cost, key, value);
+    return true;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  bool KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::Insert(
+    const TKey &key, TValue &&value, std::size_t cost
+  ) {
+    if(!prepareForCost(cost)) {
+      return false;
+    }
+
+    emplace(cost, key, std::move(value));
+    return true;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  std::size_t KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::InsertMany(
+    std::span<const TKey> keys, std::span<const TValue> values
+  ) {
+    assert((keys.size() == values.size()) && u8"Each key must have a value");
+
+    std::size_t itemCount = keys.size();
+    if(this->costBudget < 1) {
+      return 0;
+    }
+
+    if constexpr(UsesIndex) {
+      for(std::size_t index = 0; index < itemCount; ++index) {
+        NUCLEX_SUPPORT_PREFETCH(this->index + getIndexBucket(keys[index]));
+      }
+    }
+
+    for(std::size_t index = 0; index < itemCount; ++index) {
+      emplace(1, keys[index], values[index]);
+    }
+
+    return itemCount;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  bool KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::prepareForCost(
+    std::size_t cost
+  ) {
+    if(cost > this->costBudget) {
+      return false;
+    }
+
+    // Caches that are never given a cost don't need to track costs per slot. Once
+    // the first cost is specified, all items inserted before it are given a cost of 1.
+    if(this->costs == nullptr) {
+      this->costs = new std::size_t[this->capacity];
+      std::fill_n(this->costs, this->capacity, std::size_t(1));
+    }
+
+    return true;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  template<typename... TArguments>
+  void KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::emplace(
+    std::size_t cost, const TKey &key, TArguments &&... arguments
+  ) {
+    std::size_t index;
+
+    // Get rid of expired items first, they may free up enough room for the new item
+    std::uint64_t now = 0;
+    if(this->expirations) {
+      now = toTick(std::chrono::steady_clock::now());
+      evictExpired(now);
+    }
+
+    // Make room for the new item's cost first. This may free up slots, too.
+    while(this->costBudget - this->totalCost < cost) {
+      freeSlot(this->policy.Evict());
+    }
 
     // If there is still space left in the cache, do not overwrite an existing
     // entry but find a space for a new entry to be inserted.
@@ -261,61 +842,58 @@ namespace Nuclex::Support::Collections {
       // Shortcut: most caches will be constructed empty, fill up and stay full,
       // evicting the oldest items as needed. Thus, it is a good guess to check
       // the array index that matches the current item count first.
-      if(!this->states[this->count].Key.has_value()) {
-        new(this->values + this->count) TValue(value);
-        this->states[this->count].Key = key;
+      index = this->count;
+
+      // If the array index matching the item count was not empty, probably because
+      // items were evicted manually, we have to scan the entire array for a free index.
+      if(isOccupied(index)) {
+        for(index = 0; index < this->capacity; ++index) {
+          if(!isOccupied(index)) {
+            break;
+          }
+        }
 
-        linkMostRecentlyUsed(this->states[this->count]);
-        ++this->count;
-        return true;
+        // If this point is reached, we failed as basic bookkeeping and it's a bug!
+        assert(
+          (index < this->capacity) &&
+          u8"Item count says entries should be available, but cache is full."
+        );
       }
 
-      // The array index matching the item count was not empty, probably because
-      // items were evicted manually, so now we have to scan the entire array for
-      // a free index.
-      for(std::size_t index = 0; index < this->capacity; ++index) {
-        if(!this->states[index].Key.has_value()) {
-          new(this->values + index) TValue(value);
-          this->states[index].Key = key;
-
-          ++this->count;
-          linkMostRecentlyUsed(this->states[index]);
-          return true;
-        }
-      }
+    } else {
 
-      // If this point is reached, we failed as basic bookkeeping and it's a bug!
-      assert(!u8"Item count says entries should be available, but cache is full.");
+      // There is no free array index in the cache, so let the eviction policy pick
+      // the entry that has to make room and recycle its slot for the new one.
+      index = this->policy.Evict();
+      freeSlot(index);
 
     }
 
-    // There was no free array index in the cache, so we'll directly pick the least recently
-    // used entry and overwrite it with the new one.
-    {
-      std::ptrdiff_t index = this->leastRecentlyUsed - this->states;
-      //std::size_t index = static_cast<std::uintptr_t>(this->leastRecentlyUsed - this->states);
-      //index /= sizeof(SlotState[2]) / 2;
+    new(this->values + index) TValue(std::forward<TArguments>(arguments)...);
+    assignKey(index, key);
+    addToIndex(index);
 
-      this->leastRecentlyUsed->Key = key;
+    this->policy.Insert(index, getPolicyHash(key));
+    ++this->count;
 
-      TValue *address = this->values + index;
-      address->~TValue();
-      new(address) TValue(value);
-      makeMostRecentlyUsed(*this->leastRecentlyUsed);
+    if(this->costs != nullptr) {
+      this->costs[index] = cost;
     }
+    this->totalCost += cost;
 
-    return true; // it was inserted (inheriting Map<K, T> requires this pointless result)
+    if(this->expirations) {
+      this->expirations->Schedule(index, now + this->timeToLiveTicks);
+    }
   }
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  const TValue &KeyedArrayCache<TKey, TValue>::Get(const TKey &key) const {
-    for(std::size_t index = 0; index < this->capacity; ++index) {
-      if(this->states[index].Key == key) { // empty Keys will not compare as equal
-        makeMostRecentlyUsed(this->states[index]);
-        return this->values[index];
-      }
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  const TValue &KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::Get(const TKey &key) const {
+    std::size_t index = findLiveSlot(key);
+    if(index < this->capacity) {
+      this->policy.Touch(index);
+      return this->values[index];
     }
     throw Errors::KeyNotFoundError(
       reinterpret_cast<const char *>(u8"Requested key not found in cache")
@@ -324,14 +902,15 @@ namespace Nuclex::Support::Collections {
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  bool KeyedArrayCache<TKey, TValue>::TryGet(const TKey &key, TValue &value) const {
-    for(std::size_t index = 0; index < this->capacity; ++index) {
-      if(this->states[index].Key == key) { // empty Keys will not compare as equal
-        value = this->values[index];
-        makeMostRecentlyUsed(this->states[index]);
-        return true;
-      }
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  bool KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::TryGet(
+    const TKey &key, TValue &value
+  ) const {
+    std::size_t index = findLiveSlot(key);
+    if(index < this->capacity) {
+      value = this->values[index];
+      this->policy.Touch(index);
+      return true;
     }
 
     return false;
@@ -339,38 +918,139 @@ namespace Nuclex::Support::Collections {
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  bool KeyedArrayCache<TKey, TValue>::TryTake(const TKey &key, TValue &value) {
-    for(std::size_t index = 0; index < this->capacity; ++index) {
-      if(this->states[index].Key == key) { // empty Keys will not compare as equal
-        TValue *address = this->values + index;
-        value = std::move(*address);
-        address->~TValue();
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  const TValue *KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::TryGetPointer(
+    const TKey &key
+  ) const {
+    std::size_t index = findLiveSlot(key);
+    if(index < this->capacity) {
+      this->policy.Touch(index);
+      return this->values + index;
+    }
+
+    return nullptr;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  std::size_t KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::TryGetMany(
+    std::span<const TKey> keys, std::span<const TValue *> values
+  ) const {
+    assert((keys.size() == values.size()) && u8"Each key must have a value pointer");
+
+    std::size_t itemCount = keys.size();
+    if constexpr(UsesIndex) {
+      for(std::size_t index = 0; index < itemCount; ++index) {
+        NUCLEX_SUPPORT_PREFETCH(this->index + getIndexBucket(keys[index]));
+      }
+    }
 
-        this->states[index].Key.reset(); // = std::optional<TKey>();
-        --this->count;
-        unlinkMostRecentlyUsed(this->states[index]);
-        return true;
+    // Judge all items by the same time so the batch gives consistent results.
+    // Expired items are skipped, but only non-const methods may remove them.
+    std::uint64_t now = 0;
+    if(this->expirations) {
+      now = toTick(std::chrono::steady_clock::now());
+    }
+    auto isAlive = [this, now](std::size_t slotIndex) { return isLive(slotIndex, now); };
+
+    // Stay one key ahead: while a key is probed, the next key's bucket (prefetched above)
+    // is read and the slot it points to is prefetched, which is usually the slot holding
+    // that key, so comparing the key and touching the slot won't have to wait on memory.
+    std::size_t nextBucket = 0;
+    if constexpr(UsesIndex) {
+      if(itemCount >= 1) {
+        nextBucket = getIndexBucket(keys[0]);
+      }
+    }
+
+    std::size_t foundCount = 0;
+    for(std::size_t index = 0; index < itemCount; ++index) {
+      std::size_t slotIndex;
+      if constexpr(UsesIndex) {
+        std::size_t bucket = nextBucket;
+        if(index + 1 < itemCount) {
+          nextBucket = getIndexBucket(keys[index + 1]);
+
+          std::size_t entry = this->index[nextBucket];
+          if(entry != 0) {
+            prefetchKey(entry - 1);
+            this->policy.Prefetch(entry - 1);
+          }
+        }
+
+        slotIndex = probeIndex(keys[index], bucket, isAlive);
+      } else {
+        slotIndex = findSlot(keys[index], isAlive);
+      }
+
+      if(slotIndex < this->capacity) {
+        if constexpr(!UsesIndex) {
+          this->policy.Prefetch(slotIndex); // for the recency update below
+        }
+        values[index] = this->values + slotIndex;
+        ++foundCount;
+      } else {
+        values[index] = nullptr;
       }
     }
 
+    for(std::size_t index = 0; index < itemCount; ++index) {
+      if(values[index] != nullptr) {
+        std::size_t slotIndex = static_cast<std::size_t>(values[index] - this->values);
+        this->policy.Touch(slotIndex);
+        if(this->expirations && this->renewOnAccess) {
+          this->expirations->Schedule(slotIndex, now + this->timeToLiveTicks);
+        }
+      }
+    }
+
+    return foundCount;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  bool KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::TryTake(
+    const TKey &key, TValue &value
+  ) {
+    if(this->expirations) {
+      evictExpired(toTick(std::chrono::steady_clock::now()));
+    }
+
+    std::size_t index = findLiveSlot(key);
+    if(index < this->capacity) {
+      value = std::move(this->values[index]);
+
+      this->policy.Remove(index);
+      freeSlot(index);
+      return true;
+    }
+
     return false;
   }
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  std::size_t KeyedArrayCache<TKey, TValue>::TryRemove(const TKey &key) {
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  std::size_t KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::TryRemove(const TKey &key) {
     std::size_t removedElementCount = 0;
 
-    for(std::size_t index = 0; index < this->capacity; ++index) {
-      if(this->states[index].Key == key) { // empty Keys will not compare as equal
-        TValue *address = this->values + index;
-        address->~TValue();
+    // With the key index, each duplicate of the key can be looked up directly
+    if constexpr(UsesIndex) {
+      for(std::size_t index = findSlot(key); index < this->capacity; index = findSlot(key)) {
+        this->policy.Remove(index);
+        freeSlot(index);
+        ++removedElementCount;
+      }
+
+      return removedElementCount;
+    }
 
-        this->states[index].Key.reset(); // = std::optional<TKey>();
-        --this->count;
-        unlinkMostRecentlyUsed(this->states[index]);
+    for(std::size_t index = 0; index < this->capacity; ++index) {
+      if(isOccupied(index) && (getKey(index) == key)) {
+        this->policy.Remove(index);
+        freeSlot(index);
         ++removedElementCount;
       }
     }
@@ -380,135 +1060,297 @@ namespace Nuclex::Support::Collections {
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  void KeyedArrayCache<TKey, TValue>::Clear() {
-    SlotState *current = this->mostRecentlyUsed;
-    while(current != nullptr) {
-      std::ptrdiff_t index = current - this->states;
-
-      this->values[index].~TValue();
-      current->Key.reset();
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  void KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::Clear() {
+    this->policy.ForEach(
+      [this](std::size_t slotIndex) {
+        this->values[slotIndex].~TValue();
+        resetKey(slotIndex);
+      }
+    );
+    this->policy.Clear();
 
-      current = current->LessRecentlyUsed;
+    if constexpr(UsesIndex) {
+      std::fill_n(this->index, this->indexBucketCount, std::size_t(0));
+    }
+    if(this->expirations) {
+      this->expirations->Clear();
     }
 
     this->count = 0;
-    this->leastRecentlyUsed = this->mostRecentlyUsed = nullptr;
+    this->totalCost = 0;
   }
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  void KeyedArrayCache<TKey, TValue>::EvictDownTo(std::size_t itemCount) {
-    SlotState *current = this->leastRecentlyUsed;
-    while(current != nullptr) {
-      if(itemCount >= this->count) {
-        break;
-      }
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  void KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::EvictDownTo(std::size_t itemCount) {
+    while(this->count > itemCount) {
+      freeSlot(this->policy.Evict());
+    }
+  }
 
-      std::ptrdiff_t index = current - this->states;
-      this->values[index].~TValue();
-      current->Key.reset();
-      --this->count;
+  // ------------------------------------------------------------------------------------------- //
 
-      current = current->MoreRecentlyUsed;
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  void KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::EvictDownToCost(
+    std::size_t totalCost
+  ) {
+    while(this->totalCost > totalCost) {
+      freeSlot(this->policy.Evict());
     }
+  }
 
-    if(current == nullptr) {
-      this->leastRecentlyUsed = this->mostRecentlyUsed = nullptr;
-    } else {
-      current->LessRecentlyUsed = nullptr;
-      this->leastRecentlyUsed = current;
-    }
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  void KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::SetCostBudget(
+    std::size_t costBudget
+  ) {
+    EvictDownToCost(costBudget);
+    this->costBudget = costBudget;
   }
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  void KeyedArrayCache<TKey, TValue>::EvictWhere(
-    const Events::Delegate<bool(const TValue &)> &policyCallback
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  void KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::SetTimeToLive(
+    std::chrono::milliseconds timeToLive, bool renewOnAccess /* = false */
   ) {
-    SlotState *current = this->leastRecentlyUsed;
-    while(current != nullptr) {
-      std::ptrdiff_t index = current - this->states;
+    if(timeToLive.count() <= 0) {
+      this->expirations.reset();
+      this->timeToLiveTicks = 0;
+      this->renewOnAccess = false;
+      return;
+    }
 
-      bool evict = policyCallback(this->values[index]);
-      if(evict) {
-        unlinkMostRecentlyUsed(*current);
-        this->values[index].~TValue();
-        current->Key.reset();
-        --this->count;
+    std::uint64_t now = toTick(std::chrono::steady_clock::now());
+    if(!this->expirations) {
+      this->expirations.reset(new TimerWheel(this->capacity, now));
+    }
+
+    this->timeToLiveTicks = static_cast<std::uint64_t>(timeToLive.count());
+    this->renewOnAccess = renewOnAccess;
+
+    this->policy.ForEach(
+      [this, now](std::size_t slotIndex) {
+        this->expirations->Schedule(slotIndex, now + this->timeToLiveTicks);
       }
+    );
+  }
 
-      current = current->MoreRecentlyUsed;
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  std::size_t KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::EvictExpired(
+    std::chrono::steady_clock::time_point now
+  ) {
+    if(!this->expirations) {
+      return 0;
     }
+
+    return evictExpired(toTick(now));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  void KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::EvictWhere(
+    const Events::Delegate<bool(const TValue &)> &policyCallback
+  ) {
+    this->policy.ForEach(
+      [this, &policyCallback](std::size_t slotIndex) {
+        bool evict = policyCallback(this->values[slotIndex]);
+        if(evict) {
+          this->policy.Remove(slotIndex);
+          freeSlot(slotIndex);
+        }
+      }
+    );
   }
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  std::size_t KeyedArrayCache<TKey, TValue>::Count() const {
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  std::size_t KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::Count() const {
     return this->count;
   }
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  bool KeyedArrayCache<TKey, TValue>::IsEmpty() const {
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  bool KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::IsEmpty() const {
     return (this->count == 0);
   }
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  void KeyedArrayCache<TKey, TValue>::makeMostRecentlyUsed(SlotState &slotState) const {
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  template<typename TAcceptor>
+  std::size_t KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::findSlot(
+    const TKey &key, TAcceptor &&accept
+  ) const {
+    if constexpr(UsesIndex) {
+      return probeIndex(key, getIndexBucket(key), accept);
+    } else if constexpr(StoresKeysSeparately) {
+      typedef Private::ArithmeticKeyScanner<TKey> Scanner;
+
+      // The key array is padded to a multiple of the vector size and since the number
+      // of keys per vector is a power of two no larger than 64, the occupancy bits
+      // of each vector of keys always sit within a single 64 bit word.
+      for(std::size_t first = 0; first < this->capacity; first += Scanner::KeysPerVector) {
+        std::uint64_t occupied = this->occupancy[first / 64] >> (first % 64);
+        if constexpr(Scanner::KeysPerVector < 64) {
+          occupied &= (std::uint64_t(1) << Scanner::KeysPerVector) - 1;
+        }
+        if(occupied != 0) {
+          std::uint64_t matches = Scanner::CompareVector(this->keys + first, key) & occupied;
+          while(matches != 0) {
+            std::size_t index = first + static_cast<std::size_t>(std::countr_zero(matches));
+            if(accept(index)) {
+              return index;
+            }
+            matches &= (matches - 1);
+          }
+        }
+      }
 
-    // Only do something if the slot in question isn't already the most recent used one
-    if(slotState.MoreRecentlyUsed != nullptr) {
-      slotState.MoreRecentlyUsed->LessRecentlyUsed = slotState.LessRecentlyUsed;
-      if(slotState.LessRecentlyUsed == nullptr) {
-        this->leastRecentlyUsed = slotState.MoreRecentlyUsed;
-      } else {
-        slotState.LessRecentlyUsed->MoreRecentlyUsed = slotState.MoreRecentlyUsed;
+      return this->capacity;
+    } else {
+      for(std::size_t index = 0; index < this->capacity; ++index) {
+        if(this->states[index].Key == key) { // empty Keys will not compare as equal
+          if(accept(index)) {
+            return index;
+          }
+        }
       }
 
-      slotState.LessRecentlyUsed = this->mostRecentlyUsed;
-      slotState.MoreRecentlyUsed = nullptr;
-      this->mostRecentlyUsed->MoreRecentlyUsed = &slotState;
-      this->mostRecentlyUsed = &slotState;
+      return this->capacity;
     }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
 
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  template<typename TAcceptor>
+  std::size_t KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::probeIndex(
+    const TKey &key, std::size_t bucket, TAcceptor &&accept
+  ) const {
+    std::size_t mask = this->indexBucketCount - 1;
+
+    // The index is never more than half full, so probing will always hit
+    // an empty bucket eventually if the key isn't present. Duplicates of a key
+    // all sit in the same probe sequence, so rejected slots are simply skipped.
+    for(;;) {
+      std::size_t entry = this->index[bucket];
+      if(entry == 0) {
+        return this->capacity;
+      }
+      if((getKey(entry - 1) == key) && accept(entry - 1)) {
+        return entry - 1;
+      }
+      bucket = (bucket + 1) & mask;
+    }
   }
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  void KeyedArrayCache<TKey, TValue>::linkMostRecentlyUsed(SlotState &slotState) const {
-    if(this->mostRecentlyUsed == nullptr) {
-      slotState.LessRecentlyUsed = slotState.MoreRecentlyUsed = nullptr;
-      this->leastRecentlyUsed = this->mostRecentlyUsed = &slotState;
-    } else {
-      slotState.LessRecentlyUsed = this->mostRecentlyUsed;
-      slotState.MoreRecentlyUsed = nullptr;
-      this->mostRecentlyUsed->MoreRecentlyUsed = &slotState;
-      this->mostRecentlyUsed = &slotState;
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  std::size_t KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::findLiveSlot(
+    const TKey &key
+  ) const {
+    if(!this->expirations) {
+      return findSlot(key);
     }
+
+    // If an item has expired, there may still be a live duplicate of its key further
+    // down the line, so expired items are skipped rather than ending the search.
+    std::uint64_t now = toTick(std::chrono::steady_clock::now());
+    std::size_t index = findSlot(
+      key, [this, now](std::size_t slotIndex) { return isLive(slotIndex, now); }
+    );
+    if((index < this->capacity) && this->renewOnAccess) {
+      this->expirations->Schedule(index, now + this->timeToLiveTicks);
+    }
+
+    return index;
   }
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  void KeyedArrayCache<TKey, TValue>::unlinkMostRecentlyUsed(SlotState &slotState) const {
-    if(slotState.LessRecentlyUsed == nullptr) {
-      this->leastRecentlyUsed = slotState.MoreRecentlyUsed;
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  std::size_t KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::evictExpired(
+    std::uint64_t tick
+  ) {
+    std::size_t evictedCount = 0;
+    this->expirations->Advance(
+      tick,
+      [this, &evictedCount](std::size_t slotIndex) {
+        this->policy.Remove(slotIndex);
+        freeSlot(slotIndex);
+        ++evictedCount;
+      }
+    );
+
+    return evictedCount;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  void KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::addToIndex(std::size_t slotIndex) {
+    if constexpr(UsesIndex) {
+      std::size_t mask = this->indexBucketCount - 1;
+      std::size_t bucket = getIndexBucket(getKey(slotIndex));
+      while(this->index[bucket] != 0) {
+        bucket = (bucket + 1) & mask;
+      }
+
+      this->index[bucket] = slotIndex + 1;
     } else {
-      slotState.LessRecentlyUsed->MoreRecentlyUsed = slotState.MoreRecentlyUsed;
+      (void)slotIndex;
     }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  void KeyedArrayCache<TKey, TValue, THash, TEvictionPolicy>::removeFromIndex(
+    std::size_t slotIndex
+  ) {
+    if constexpr(UsesIndex) {
+      std::size_t mask = this->indexBucketCount - 1;
+
+      // Locate the bucket referencing the slot. Duplicate keys may be stored in the index,
+      // so we have to compare the slot index rather than the key here.
+      std::size_t hole = getIndexBucket(getKey(slotIndex));
+      while(this->index[hole] != slotIndex + 1) {
+        assert((this->index[hole] != 0) && u8"Slot being removed must be in the key index");
+        hole = (hole + 1) & mask;
+      }
+
+      // Instead of leaving a tombstone, shift back any following entries that would
+      // become unreachable through the hole. This keeps probe sequences short no matter
+      // how many insertions and evictions the cache goes through.
+      std::size_t bucket = (hole + 1) & mask;
+      for(;;) {
+        std::size_t entry = this->index[bucket];
+        if(entry == 0) {
+          break;
+        }
+
+        std::size_t preferredBucket = getIndexBucket(getKey(entry - 1));
+        if(((bucket - preferredBucket) & mask) >= ((bucket - hole) & mask)) {
+          this->index[hole] = entry;
+          hole = bucket;
+        }
+
+        bucket = (bucket + 1) & mask;
+      }
 
-    if(slotState.MoreRecentlyUsed == nullptr) {
-      this->mostRecentlyUsed = slotState.LessRecentlyUsed;
+      this->index[hole] = 0;
     } else {
-      slotState.MoreRecentlyUsed->LessRecentlyUsed = slotState.LessRecentlyUsed;
+      (void)slotIndex;
     }
   }
 
@@ -0,0 +1,718 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_SUPPORT_COLLECTIONS_LOADINGCACHE_H
+#define NUCLEX_SUPPORT_COLLECTIONS_LOADINGCACHE_H
+
+#include "Nuclex/Support/Config.h"
+
+// The loading cache runs its loaders on the thread pool, which is only
+// available on the platforms the thread pool has been implemented for
+#if defined(NUCLEX_SUPPORT_LINUX) || defined(NUCLEX_SUPPORT_WINDOWS)
+
+#include "Nuclex/Support/Events/Delegate.h" // for Delegate
+#include "Nuclex/Support/Collections/KeyedArrayCache.h" // for KeyedArrayCache
+#include "Nuclex/Support/Threading/ThreadPool.h" // for ThreadPool
+#include "Nuclex/Support/Errors/KeyNotFoundError.h" // for KeyNotFoundError
+#include "Nuclex/Support/ScopeGuard.h" // for ON_SCOPE_EXIT
+
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint64_t
+#include <future> // for std::promise, std::shared_future
+#include <memory> // for std::shared_ptr
+#include <mutex> // for std::mutex, std::unique_lock
+#include <condition_variable> // for std::condition_variable
+#include <chrono> // for std::chrono::seconds, std::chrono::milliseconds
+#include <exception> // for std::current_exception()
+#include <functional> // for std::hash
+#include <utility> // for std::move(), std::forward()
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Cache that loads missing items on a thread pool, once per key</summary>
+  /// <typeparam name="TKey">Type of the key the cache uses</typeparam>
+  /// <typeparam name="TValue">Type of values that are stored in the cache</typeparam>
+  /// <typeparam name="THash">Hash function used to index the keys</typeparam>
+  /// <typeparam name="TEvictionPolicy">
+  ///   Policy that decides which items are evicted, see EvictionPolicies.h
+  /// </typeparam>
+  /// <remarks>
+  ///   <para>
+  ///     <strong>Thread safety:</strong> any number of threads may access the cache
+  ///   </para>
+  ///   <para>
+  ///     <strong>Container type:</strong> hash-indexed array of slots behind a mutex
+  ///   </para>
+  ///   <para>
+  ///     When an item is requested via <see cref="GetOrLoad" /> that is not in the cache,
+  ///     the provided loader is scheduled on the thread pool and a shared future for its
+  ///     result is stored in the cache right away. Any other thread requesting the same key
+  ///     while the load is still running receives the same future, so no matter how many
+  ///     threads ask for a missing item at once, its loader runs only a single time.
+  ///   </para>
+  ///   <para>
+  ///     If the loader throws an exception, the exception is delivered to all waiting
+  ///     requesters and the key is removed from the cache again, so the next request will
+  ///     retry the load. Loads still in progress count towards the cache's capacity and
+  ///     may be evicted like any other item, in which case the requesters still receive
+  ///     the loaded value, but it will not be kept in the cache.
+  ///   </para>
+  ///   <para>
+  ///     Keep in mind that the thread pool's default thread limits are geared towards
+  ///     number crunching. If your loaders wait for disk or network I/O, give the thread
+  ///     pool a generous maximum thread count. The thread pool has to outlive the cache;
+  ///     when the cache is destroyed, it waits for any loads still in progress.
+  ///   </para>
+  ///   <para>
+  ///     The cache mirrors the <see cref="Cache" /> interface, but does not implement it:
+  ///     another thread can remove or evict an item at any time, so lookups hand out
+  ///     copies or shared pointers instead of references into the cache.
+  ///   </para>
+  /// </remarks>
+  template<
+    typename TKey, typename TValue,
+    typename THash = std::hash<TKey>, typename TEvictionPolicy = LruEvictionPolicy<>
+  >
+  class LoadingCache {
+
+    /// <summary>Initializes a new loading cache</summary>
+    /// <param name="threadPool">Thread pool on which the loaders will be run</param>
+    /// <param name="capacity">Maximum number of entries the cache may hold</param>
+    public: LoadingCache(Threading::ThreadPool &threadPool, std::size_t capacity);
+
+    /// <summary>Waits for any loads still in progress and destroys the cache</summary>
+    public: virtual ~LoadingCache();
+
+    /// <summary>Looks up an item or starts loading it if it isn't in the cache</summary>
+    /// <typeparam name="TLoader">
+    ///   Callable that receives a key and returns the value to store under it
+    /// </typeparam>
+    /// <param name="key">Key of the item that will be looked up or loaded</param>
+    /// <param name="loader">
+    ///   Loader that will be invoked on the thread pool if the item is missing
+    /// </param>
+    /// <returns>A shared future that will provide the item once it is loaded</returns>
+    /// <remarks>
+    ///   The loader is only run if neither the item nor a load for it is present in
+    ///   the cache, otherwise it is discarded without being called.
+    /// </remarks>
+    public: template<typename TLoader>
+    std::shared_future<TValue> GetOrLoad(const TKey &key, TLoader &&loader);
+
+    /// <summary>Stores a value in the cache</summary>
+    /// <param name="key">Key under which the value can be looked up later</param>
+    /// <param name="value">Value that will be stored under its key in the cache</param>
+    /// <returns>
+    ///   True if the key did not exist before and was inserted,
+    ///   false if the key already existed and its value or load was replaced.
+    /// </returns>
+    public: bool Insert(const TKey &key, const TValue &value);
+
+    /// <summary>Moves a value into the cache</summary>
+    /// <param name="key">Key under which the value can be looked up later</param>
+    /// <param name="value">Value that will be moved into the cache under its key</param>
+    /// <returns>
+    ///   True if the key did not exist before and was inserted,
+    ///   false if the key already existed and its value or load was replaced.
+    /// </returns>
+    public: bool Insert(const TKey &key, TValue &&value);
+
+    /// <summary>Stores a value in the cache if it doesn't exist yet</summary>
+    /// <param name="key">Key under which the value can be looked up later</param>
+    /// <param name="value">Value that will be stored under its key in the cache</param>
+    /// <returns>
+    ///   True if the key did not exist before and was inserted,
+    ///   false if the key already existed or is being loaded and was left unchanged
+    /// </returns>
+    public: bool TryInsert(const TKey &key, const TValue &value);
+
+    /// <summary>Moves a value into the cache if it doesn't exist yet</summary>
+    /// <param name="key">Key under which the value can be looked up later</param>
+    /// <param name="value">Value that will be moved into the cache under its key</param>
+    /// <returns>
+    ///   True if the key did not exist before and was inserted,
+    ///   false if the key already existed or is being loaded and was left unchanged
+    /// </returns>
+    public: bool TryInsert(const TKey &key, TValue &&value);
+
+    /// <summary>Returns the value of the specified item in the cache</summary>
+    /// <param name="key">Key of the item that will be looked up</param>
+    /// <returns>The value of the item</returns>
+    /// <remarks>
+    ///   If the item is still being loaded, this waits for the load to finish and rethrows
+    ///   the loader's exception if it fails.
+    /// </remarks>
+    public: TValue Get(const TKey &key) const;
+
+    /// <summary>Tries to look up an item in the cache</summary>
+    /// <param name="key">Key of the item that will be looked up</param>
+    /// <param name="value">Will receive the value if the item was found</param>
+    /// <returns>
+    ///   True if the item was returned, false if the key didn't exist or
+    ///   if the item was still being loaded
+    /// </returns>
+    public: bool TryGet(const TKey &key, TValue &value) const;
+
+    /// <summary>Looks up an item in the cache without copying its value</summary>
+    /// <param name="key">Key of the item that will be looked up</param>
+    /// <returns>
+    ///   A shared pointer to the item's value or an empty pointer if the key didn't exist
+    ///   or if the item was still being loaded
+    /// </returns>
+    /// <remarks>
+    ///   The shared pointer keeps the value alive even if the item is removed or evicted
+    ///   from the cache in the meantime.
+    /// </remarks>
+    public: std::shared_ptr<const TValue> TryGetPointer(const TKey &key) const;
+
+    /// <summary>Tries to take an item from the cache (removing it)</summary>
+    /// <param name="key">Key of the item that will be taken from the cache</param>
+    /// <param name="value">Will receive the value taken from the cache</param>
+    /// <returns>
+    ///   True if the item was found and removed from the cache, false if the key didn't
+    ///   exist or if the item was still being loaded (in which case it is left in place)
+    /// </returns>
+    public: bool TryTake(const TKey &key, TValue &value);
+
+    /// <summary>Removes the specified item from the cache if it exists</summary>
+    /// <param name="key">Key of the item that will be removed if present</param>
+    /// <returns>True if the item was found and removed, false otherwise</returns>
+    /// <remarks>
+    ///   If the item was still being loaded, the load completes for anyone waiting on it,
+    ///   but its result will not be stored in the cache.
+    /// </remarks>
+    public: bool TryRemove(const TKey &key);
+
+    /// <summary>Removes all items from the cache</summary>
+    public: void Clear();
+
+    /// <summary>
+    ///   Evicts items from the cache until at most <see cref="itemCount" /> items remain
+    /// </summary>
+    /// <param name="itemCount">Maximum number of items that will be left behind</param>
+    public: void EvictDownTo(std::size_t itemCount);
+
+    /// <summary>Evicts items from the cache that fit a user-defined criterion</summary>
+    /// <param name="policyCallback">Callback that decides whether to evict an item</param>
+    /// <remarks>
+    ///   Items that are still being loaded are not presented to the callback.
+    /// </remarks>
+    public: void EvictWhere(
+      const Events::Delegate<bool(const TValue &)> &policyCallback
+    );
+
+    /// <summary>Counts the number of items currently in the cache</summary>
+    /// <returns>The number of items in the cache, including those still being loaded</returns>
+    public: std::size_t Count() const;
+
+    /// <summary>Checks if the cache is empty</summary>
+    /// <returns>True if the cache had been empty during the call</returns>
+    public: bool IsEmpty() const;
+
+    /// <summary>Sets how long items remain in the cache before they expire</summary>
+    /// <param name="timeToLive">
+    ///   Time after which items expire, zero to let items live until they are evicted
+    /// </param>
+    /// <param name="renewOnAccess">
+    ///   Whether looking up an item restarts its time to live
+    /// </param>
+    /// <remarks>
+    ///   The time to live of an item that is being loaded starts when the load begins.
+    ///   If it expires before the load completes, the load's result is not cached.
+    /// </remarks>
+    public: void SetTimeToLive(std::chrono::milliseconds timeToLive, bool renewOnAccess = false);
+
+    /// <summary>Removes all items whose time to live has run out</summary>
+    /// <returns>The number of items that were removed</returns>
+    public: std::size_t EvictExpired();
+
+    #pragma region struct Entry
+
+    /// <summary>Item stored in the cache, either loaded or still being loaded</summary>
+    private: struct Entry {
+
+      /// <summary>Future that provides the item's value</summary>
+      public: std::shared_future<TValue> Value;
+      /// <summary>Identifies the load that produced the item, 0 if it was inserted</summary>
+      public: std::uint64_t LoadId;
+
+    };
+
+    #pragma endregion // struct Entry
+
+    #pragma region class PendingLoad
+
+    /// <summary>Tracks a load from when it is scheduled until it is completed</summary>
+    /// <remarks>
+    ///   This is carried along with the task scheduled on the thread pool. If the task
+    ///   is destroyed without running (because the thread pool shuts down), the promise
+    ///   is broken and the load is forgotten just like a failed one.
+    /// </remarks>
+    private: class PendingLoad {
+
+      /// <summary>Initializes a new pending load</summary>
+      /// <param name="cache">Cache that will be notified when the load ends</param>
+      /// <param name="key">Key of the item being loaded</param>
+      /// <param name="loadId">Unique id of the load</param>
+      /// <param name="promise">Promise through which the loaded value is provided</param>
+      public: PendingLoad(
+        LoadingCache *cache, const TKey &key, std::uint64_t loadId,
+        std::promise<TValue> &&promise
+      ) :
+        cache(cache),
+        key(key),
+        loadId(loadId),
+        promise(std::move(promise)),
+        completed(false) {}
+
+      /// <summary>Takes over the load from another instance</summary>
+      /// <param name="other">Pending load that will be taken over</param>
+      public: PendingLoad(PendingLoad &&other) :
+        cache(other.cache),
+        key(std::move(other.key)),
+        loadId(other.loadId),
+        promise(std::move(other.promise)),
+        completed(other.completed) {
+        other.cache = nullptr;
+      }
+
+      /// <summary>Informs the cache that the load has ended</summary>
+      public: ~PendingLoad() {
+        if(this->cache != nullptr) {
+          if(!this->completed) {
+            this->cache->forgetLoad(this->key, this->loadId);
+          }
+          this->cache->endLoad();
+        }
+      }
+
+      /// <summary>Runs the loader and provides its result to the promise</summary>
+      /// <param name="loader">Loader that will be invoked to load the item</param>
+      public: template<typename TLoader>
+      void Run(TLoader &loader) {
+        try {
+          this->promise.set_value(loader(const_cast<const TKey &>(this->key)));
+          this->completed = true;
+        }
+        catch(...) {
+          this->cache->forgetLoad(this->key, this->loadId);
+          this->completed = true;
+          this->promise.set_exception(std::current_exception());
+        }
+      }
+
+      private: PendingLoad(const PendingLoad &) = delete;
+      private: PendingLoad &operator =(const PendingLoad &) = delete;
+      private: PendingLoad &operator =(PendingLoad &&) = delete;
+
+      /// <summary>Cache that will be notified when the load ends</summary>
+      private: LoadingCache *cache;
+      /// <summary>Key of the item being loaded</summary>
+      private: TKey key;
+      /// <summary>Unique id of the load, used to recognize its cache entry</summary>
+      private: std::uint64_t loadId;
+      /// <summary>Promise through which the loaded value will be provided</summary>
+      private: std::promise<TValue> promise;
+      /// <summary>Whether the promise has been fulfilled with a value or an error</summary>
+      private: bool completed;
+
+    };
+
+    #pragma endregion // class PendingLoad
+
+    /// <summary>Checks whether the future of a cache entry has been fulfilled</summary>
+    /// <param name="entry">Entry that will be checked</param>
+    /// <returns>True if the entry's value has been loaded</returns>
+    private: static bool isLoaded(const Entry &entry);
+
+    /// <summary>Removes the entry of a failed or abandoned load from the cache</summary>
+    /// <param name="key">Key of the item that was being loaded</param>
+    /// <param name="loadId">Id of the load, so a newer entry is not removed</param>
+    private: void forgetLoad(const TKey &key, std::uint64_t loadId);
+
+    /// <summary>Notes that a load has ended, allowing the destructor to proceed</summary>
+    private: void endLoad();
+
+    /// <summary>Forwards loaded entries to the user-provided eviction callback</summary>
+    /// <param name="entry">Entry for which eviction will be decided</param>
+    /// <returns>True if the entry should be evicted</returns>
+    private: bool shouldEvict(const Entry &entry);
+
+    /// <summary>Thread pool on which the loaders are run</summary>
+    private: Threading::ThreadPool &threadPool;
+    /// <summary>Must be held by anyone accessing the entries or counters</summary>
+    private: mutable std::mutex mutex;
+    /// <summary>Signalled when the last pending load ends</summary>
+    private: std::condition_variable loadsEndedCondition;
+    /// <summary>Items in the cache, including those still being loaded</summary>
+    private: KeyedArrayCache<TKey, Entry, THash, TEvictionPolicy> entries;
+    /// <summary>Id that was given to the most recently started load</summary>
+    private: std::uint64_t lastLoadId;
+    /// <summary>Number of loads that have been scheduled but not ended yet</summary>
+    private: std::size_t pendingLoadCount;
+    /// <summary>Callback being invoked by EvictWhere(), only valid during the call</summary>
+    private: const Events::Delegate<bool(const TValue &)> *evictionCallback;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  LoadingCache<TKey, TValue, THash, TEvictionPolicy>::LoadingCache(
+    Threading::ThreadPool &threadPool, std::size_t capacity
+  ) :
+    threadPool(threadPool),
+    mutex(),
+    loadsEndedCondition(),
+    entries(capacity),
+    lastLoadId(0),
+    pendingLoadCount(0),
+    evictionCallback(nullptr) {}
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  LoadingCache<TKey, TValue, THash, TEvictionPolicy>::~LoadingCache() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->loadsEndedCondition.wait(
+      lock, [this]() { return (this->pendingLoadCount == 0); }
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  template<typename TLoader>
+  std::shared_future<TValue> LoadingCache<TKey, TValue, THash, TEvictionPolicy>::GetOrLoad(
+    const TKey &key, TLoader &&loader
+  ) {
+    std::promise<TValue> promise;
+    Entry entry;
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      if(this->entries.TryGet(key, entry)) {
+        return entry.Value;
+      }
+
+      // Publish the future before the load is scheduled so that any other thread
+      // asking for the same key from here on will wait on this load
+      entry.Value = promise.get_future().share();
+      entry.LoadId = ++this->lastLoadId;
+      this->entries.Insert(key, entry);
+      ++this->pendingLoadCount;
+    }
+
+    // The pending load is constructed before anything else can throw. Should scheduling
+    // fail, its destructor will forget the load and break the promise.
+    this->threadPool.Schedule(
+      [
+        load = PendingLoad(this, key, entry.LoadId, std::move(promise)),
+        loader = std::forward<TLoader>(loader)
+      ]() mutable { load.Run(loader); }
+    );
+
+    return entry.Value;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  bool LoadingCache<TKey, TValue, THash, TEvictionPolicy>::Insert(
+    const TKey &key, const TValue &value
+  ) {
+    return Insert(key, TValue(value));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  bool LoadingCache<TKey, TValue, THash, TEvictionPolicy>::Insert(
+    const TKey &key, TValue &&value
+  ) {
+    std::promise<TValue> promise;
+    promise.set_value(std::move(value));
+
+    Entry entry;
+    entry.Value = promise.get_future().share();
+    entry.LoadId = 0;
+
+    std::unique_lock<std::mutex> lock(this->mutex);
+    bool existed = (this->entries.TryRemove(key) >= 1);
+    this->entries.Insert(key, std::move(entry));
+    return !existed;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  bool LoadingCache<TKey, TValue, THash, TEvictionPolicy>::TryInsert(
+    const TKey &key, const TValue &value
+  ) {
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      if(this->entries.TryGetPointer(key) != nullptr) {
+        return false; // avoid copying the value if it won't be inserted
+      }
+    }
+
+    return TryInsert(key, TValue(value));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  bool LoadingCache<TKey, TValue, THash, TEvictionPolicy>::TryInsert(
+    const TKey &key, TValue &&value
+  ) {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    if(this->entries.TryGetPointer(key) != nullptr) {
+      return false;
+    }
+
+    std::promise<TValue> promise;
+    promise.set_value(std::move(value));
+
+    Entry entry;
+    entry.Value = promise.get_future().share();
+    entry.LoadId = 0;
+
+    this->entries.Insert(key, std::move(entry));
+    return true;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  TValue LoadingCache<TKey, TValue, THash, TEvictionPolicy>::Get(
+    const TKey &key
+  ) const {
+    Entry entry;
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      if(!this->entries.TryGet(key, entry)) {
+        throw Errors::KeyNotFoundError(
+          reinterpret_cast<const char *>(u8"Key not found in cache")
+        );
+      }
+    }
+
+    // The value is copied out because our copy of the future may be the last owner
+    // of the shared state if another thread removes the item from the cache
+    return entry.Value.get();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  bool LoadingCache<TKey, TValue, THash, TEvictionPolicy>::TryGet(
+    const TKey &key, TValue &value
+  ) const {
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    // Failed loads remove their entry before the exception is delivered, so while
+    // the lock is held, any loaded entry found in the cache is guaranteed to carry
+    // a value. Once the lock is released, the load could fail in between.
+    const Entry *entry = this->entries.TryGetPointer(key);
+    if((entry == nullptr) || !isLoaded(*entry)) {
+      return false;
+    }
+
+    value = entry->Value.get();
+    return true;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  std::shared_ptr<const TValue> LoadingCache<
+    TKey, TValue, THash, TEvictionPolicy
+  >::TryGetPointer(const TKey &key) const {
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    // See TryGet(), only while the lock is held is a loaded entry sure to carry a value
+    const Entry *entry = this->entries.TryGetPointer(key);
+    if((entry == nullptr) || !isLoaded(*entry)) {
+      return std::shared_ptr<const TValue>();
+    }
+
+    // Hand out an aliasing pointer that owns a copy of the future, thereby keeping
+    // the shared state holding the value alive for as long as the pointer exists
+    std::shared_ptr<std::shared_future<TValue>> owner = (
+      std::make_shared<std::shared_future<TValue>>(entry->Value)
+    );
+    return std::shared_ptr<const TValue>(owner, &owner->get());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  bool LoadingCache<TKey, TValue, THash, TEvictionPolicy>::TryTake(
+    const TKey &key, TValue &value
+  ) {
+    Entry entry;
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      if(!this->entries.TryGet(key, entry)) {
+        return false;
+      }
+      if(!isLoaded(entry)) {
+        return false;
+      }
+
+      this->entries.TryRemove(key);
+    }
+
+    value = entry.Value.get();
+    return true;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  bool LoadingCache<TKey, TValue, THash, TEvictionPolicy>::TryRemove(const TKey &key) {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    return (this->entries.TryRemove(key) >= 1);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  void LoadingCache<TKey, TValue, THash, TEvictionPolicy>::Clear() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->entries.Clear();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  void LoadingCache<TKey, TValue, THash, TEvictionPolicy>::EvictDownTo(std::size_t itemCount) {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->entries.EvictDownTo(itemCount);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  void LoadingCache<TKey, TValue, THash, TEvictionPolicy>::EvictWhere(
+    const Events::Delegate<bool(const TValue &)> &policyCallback
+  ) {
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    this->evictionCallback = &policyCallback;
+    ON_SCOPE_EXIT { this->evictionCallback = nullptr; };
+
+    this->entries.EvictWhere(
+      Events::Delegate<bool(const Entry &)>::template Create<
+        LoadingCache, &LoadingCache::shouldEvict
+      >(this)
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  std::size_t LoadingCache<TKey, TValue, THash, TEvictionPolicy>::Count() const {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    return this->entries.Count();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  bool LoadingCache<TKey, TValue, THash, TEvictionPolicy>::IsEmpty() const {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    return this->entries.IsEmpty();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  void LoadingCache<TKey, TValue, THash, TEvictionPolicy>::SetTimeToLive(
+    std::chrono::milliseconds timeToLive, bool renewOnAccess /* = false */
+  ) {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->entries.SetTimeToLive(timeToLive, renewOnAccess);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  std::size_t LoadingCache<TKey, TValue, THash, TEvictionPolicy>::EvictExpired() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    return this->entries.EvictExpired();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  bool LoadingCache<TKey, TValue, THash, TEvictionPolicy>::isLoaded(const Entry &entry) {
+    return (
+      entry.Value.wait_for(std::chrono::seconds(0)) == std::future_status::ready
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  void LoadingCache<TKey, TValue, THash, TEvictionPolicy>::forgetLoad(
+    const TKey &key, std::uint64_t loadId
+  ) {
+    std::unique_lock<std::mutex> lock(this->mutex);
+
+    // The entry may have been evicted or replaced since the load was started,
+    // in which case the key now belongs to someone else and must be left alone
+    Entry entry;
+    if(this->entries.TryGet(key, entry)) {
+      if(entry.LoadId == loadId) {
+        this->entries.TryRemove(key);
+      }
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  void LoadingCache<TKey, TValue, THash, TEvictionPolicy>::endLoad() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    --this->pendingLoadCount;
+    if(this->pendingLoadCount == 0) {
+      this->loadsEndedCondition.notify_all();
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename THash, typename TEvictionPolicy>
+  bool LoadingCache<TKey, TValue, THash, TEvictionPolicy>::shouldEvict(const Entry &entry) {
+    if(!isLoaded(entry)) {
+      return false;
+    }
+
+    return (*this->evictionCallback)(entry.Value.get());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
+
+#endif // defined(NUCLEX_SUPPORT_LINUX) || defined(NUCLEX_SUPPORT_WINDOWS)
+
+#endif // NUCLEX_SUPPORT_COLLECTIONS_LOADINGCACHE_H
@@ -46,6 +46,15 @@ namespace Nuclex::Support::Collections {
     /// </returns>
     public: virtual bool Insert(const TKey &key, const TValue &value) = 0;
 
+    /// <summary>Moves a value into the map</summary>
+    /// <param name="key">Key under which the value can be looked up later</param>
+    /// <param name="value">Value that will be moved into the map under its key</param>
+    /// <returns>
+    ///   True if the key did not exist before and was inserted,
+    ///   false if the key already existed and its value was replaced.
+    /// </returns>
+    public: virtual bool Insert(const TKey &key, TValue &&value) = 0;
+
     /// <summary>Stores a value in the map if it doesn't exist yet</summary>
     /// <param name="key">Key under which the value can be looked up later</param>
     /// <param name="value">Value that will be stored under its key in the map</param>
@@ -55,6 +64,18 @@ namespace Nuclex::Support::Collections {
     /// </returns>
     public: virtual bool TryInsert(const TKey &key, const TValue &value) = 0;
 
+    /// <summary>Moves a value into the map if it doesn't exist yet</summary>
+    /// <param name="key">Key under which the value can be looked up later</param>
+    /// <param name="value">Value that will be moved into the map under its key</param>
+    /// <returns>
+    ///   True if the key did not exist before and was inserted,
+    ///   false if the key already existed and left unchanged
+    /// </returns>
+    /// <remarks>
+    ///   If the key already existed, the value is left untouched.
+    /// </remarks>
+    public: virtual bool TryInsert(const TKey &key, TValue &&value) = 0;
+
     /// <summary>Returns the value of the specified element in the map</summary>
     /// <param name="key">Key of the element that will be looked up</param>
     public: virtual const TValue &Get(const TKey &key) const = 0;
@@ -71,6 +92,16 @@ namespace Nuclex::Support::Collections {
     /// </returns>
     public: virtual bool TryGet(const TKey &key, TValue &value) const = 0;
 
+    /// <summary>Looks up an element in the map without copying its value</summary>
+    /// <param name="key">Key of the element that will be looked up</param>
+    /// <returns>
+    ///   A pointer to the element's value or a null pointer if the key didn't exist
+    /// </returns>
+    /// <remarks>
+    ///   The pointer remains valid until the map is modified.
+    /// </remarks>
+    public: virtual const TValue *TryGetPointer(const TKey &key) const = 0;
+
     /// <summary>Tries to take an element from the map (removing it)</summary>
     /// <param name="key">Key of the element that will be taken from the map</param>
     /// <param name="value">Will receive the value taken from the map</param>
@@ -0,0 +1,204 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_SUPPORT_COLLECTIONS_MIRROREDRINGBUFFER_H
+#define NUCLEX_SUPPORT_COLLECTIONS_MIRROREDRINGBUFFER_H
+
+#include "Nuclex/Support/Config.h"
+
+#if defined(NUCLEX_SUPPORT_LINUX) || defined(NUCLEX_SUPPORT_WINDOWS)
+
+#include <cstddef> // for std::size_t, std::byte
+#include <span> // for std::span
+#include <cstring> // for std::memcpy()
+#include <cassert> // for assert()
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Byte ring buffer whose contents are always contiguous in memory</summary>
+  /// <remarks>
+  ///   <para>
+  ///     <strong>Thread safety:</strong> each instance should be accessed by a single thread
+  ///   </para>
+  ///   <para>
+  ///     <strong>Container type:</strong> unbounded ring buffer of bytes
+  ///   </para>
+  ///   <para>
+  ///     The buffer's memory is mapped into the address space twice, back to back, so
+  ///     the byte following the last byte of the buffer is the buffer's first byte again.
+  ///     Any range of up to <see cref="GetCapacity" /> bytes is thus contiguous, no matter
+  ///     where it wraps around, and <see cref="Peek" /> and <see cref="BeginWrite" /> can
+  ///     always hand out a single span. This lets decompressors and parsers that require
+  ///     contiguous input work directly on the buffer without a bounce copy.
+  ///   </para>
+  ///   <para>
+  ///     The capacity is a multiple of the system's page size (or the allocation
+  ///     granularity on Windows, which is 64 KiB), so this is meant for streams of data,
+  ///     not for many small buffers. Like <see cref="RingQueue" />, the buffer grows
+  ///     when more data is written than it can hold.
+  ///   </para>
+  /// </remarks>
+  class NUCLEX_SUPPORT_TYPE MirroredRingBuffer {
+
+    /// <summary>Initializes a new mirrored ring buffer</summary>
+    /// <param name="capacity">
+    ///   Number of bytes the ring buffer should be able to hold at the beginning,
+    ///   will be rounded up to the system's page size
+    /// </param>
+    public: NUCLEX_SUPPORT_API explicit MirroredRingBuffer(std::size_t capacity = 65536);
+
+    /// <summary>Initializes a ring buffer taking over another ring buffer</summary>
+    /// <param name="other">Other ring buffer that will be taken over</param>
+    public: NUCLEX_SUPPORT_API MirroredRingBuffer(MirroredRingBuffer &&other) noexcept;
+
+    /// <summary>Mirrored memory can not be copied cheaply, so copying is not allowed</summary>
+    public: MirroredRingBuffer(const MirroredRingBuffer &other) = delete;
+
+    /// <summary>Unmaps the memory of the ring buffer</summary>
+    public: NUCLEX_SUPPORT_API ~MirroredRingBuffer();
+
+    /// <summary>Looks up the number of bytes the ring buffer has mapped memory for</summary>
+    /// <returns>The number of bytes the ring buffer can hold before it needs to grow</returns>
+    public: std::size_t GetCapacity() const {
+      return this->capacity;
+    }
+
+    /// <summary>Counts the number of bytes currently stored in the ring buffer</summary>
+    /// <returns>The number of bytes in the ring buffer</returns>
+    public: std::size_t Count() const {
+      return this->count;
+    }
+
+    /// <summary>Provides direct read access to the bytes stored in the buffer</summary>
+    /// <returns>A span holding all bytes in the buffer, oldest first</returns>
+    /// <remarks>
+    ///   The span remains valid until the next call to any non-const method.
+    /// </remarks>
+    public: std::span<const std::byte> Peek() const {
+      return std::span<const std::byte>(this->memory + this->startIndex, this->count);
+    }
+
+    /// <summary>Removes bytes from the beginning of the buffer without reading them</summary>
+    /// <param name="byteCount">Number of bytes that will be removed</param>
+    public: void Skip(std::size_t byteCount) {
+      assert(
+        (byteCount <= this->count) &&
+        u8"Amount of data skipped must be less or equal to the amount of data in the buffer"
+      );
+      this->count -= byteCount;
+      this->startIndex += byteCount;
+      if(this->startIndex >= this->capacity) {
+        this->startIndex -= this->capacity;
+      }
+    }
+
+    /// <summary>Provides memory into which the specified number of bytes can be written</summary>
+    /// <param name="byteCount">Number of bytes the caller wishes to write</param>
+    /// <returns>A span of the requested length at which the bytes can be written</returns>
+    /// <remarks>
+    ///   The ring buffer grows if it cannot fit the requested number of bytes. After
+    ///   writing, call <see cref="CommitWrite" /> with the number of bytes that were
+    ///   actually written before calling any other non-const method.
+    /// </remarks>
+    public: std::span<std::byte> BeginWrite(std::size_t byteCount) {
+      if(this->capacity - this->count < byteCount) [[unlikely]] {
+        reallocate(this->count + byteCount);
+      }
+
+      std::size_t endIndex = this->startIndex + this->count;
+      if(endIndex >= this->capacity) {
+        endIndex -= this->capacity;
+      }
+
+      return std::span<std::byte>(this->memory + endIndex, byteCount);
+    }
+
+    /// <summary>Appends bytes written via <see cref="BeginWrite" /> to the buffer</summary>
+    /// <param name="byteCount">
+    ///   Number of bytes that were written into the span provided by
+    ///   <see cref="BeginWrite" />, must not exceed the number of bytes requested
+    /// </param>
+    public: void CommitWrite(std::size_t byteCount) {
+      assert(
+        (byteCount <= this->capacity - this->count) &&
+        u8"Committed bytes must fit into the memory provided by BeginWrite()"
+      );
+      this->count += byteCount;
+    }
+
+    /// <summary>Appends bytes to the end of the ring buffer</summary>
+    /// <param name="bytes">Bytes that will be added to the ring buffer</param>
+    /// <param name="byteCount">Number of bytes that will be added</param>
+    public: void Write(const std::byte *bytes, std::size_t byteCount) {
+      std::span<std::byte> target = BeginWrite(byteCount);
+      std::memcpy(target.data(), bytes, byteCount);
+      this->count += byteCount;
+    }
+
+    /// <summary>Removes bytes from the beginning of the ring buffer</summary>
+    /// <param name="bytes">Buffer in which the removed bytes will be stored</param>
+    /// <param name="byteCount">Number of bytes that will be removed</param>
+    public: void Read(std::byte *bytes, std::size_t byteCount) {
+      assert(
+        (byteCount <= this->count) &&
+        u8"Ring buffer must contain at least the requested number of bytes"
+      );
+      std::memcpy(bytes, this->memory + this->startIndex, byteCount);
+      Skip(byteCount);
+    }
+
+    /// <summary>Moves the buffer's contents into a larger mirrored memory block</summary>
+    /// <param name="requiredCapacity">Number of bytes the buffer needs to hold</param>
+    private: NUCLEX_SUPPORT_API void reallocate(std::size_t requiredCapacity);
+
+    /// <summary>Rounds a capacity up to the size at which memory can be mapped</summary>
+    /// <param name="capacity">Capacity that will be rounded up</param>
+    /// <returns>The smallest mappable size that can hold the specified capacity</returns>
+    private: static std::size_t roundUpToMappableSize(std::size_t capacity);
+
+    /// <summary>Maps the same block of memory twice into adjacent address ranges</summary>
+    /// <param name="size">Size of the memory block, must be a mappable size</param>
+    /// <returns>The address of the first mapping, followed by the second one</returns>
+    private: static std::byte *mapMirroredMemory(std::size_t size);
+
+    /// <summary>Unmaps memory that was mapped by <see cref="mapMirroredMemory" /></summary>
+    /// <param name="memory">Address returned by <see cref="mapMirroredMemory" /></param>
+    /// <param name="size">Size that was passed to <see cref="mapMirroredMemory" /></param>
+    private: static void unmapMirroredMemory(std::byte *memory, std::size_t size) noexcept;
+
+    /// <summary>Start of the memory, mapped twice in a row</summary>
+    private: std::byte *memory;
+    /// <summary>Number of bytes the ring buffer can hold (the size of one mapping)</summary>
+    private: std::size_t capacity;
+    /// <summary>Index of the first byte in the ring buffer</summary>
+    private: std::size_t startIndex;
+    /// <summary>Number of bytes stored in the ring buffer</summary>
+    private: std::size_t count;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
+
+#endif // defined(NUCLEX_SUPPORT_LINUX) || defined(NUCLEX_SUPPORT_WINDOWS)
+
+#endif // NUCLEX_SUPPORT_COLLECTIONS_MIRROREDRINGBUFFER_H
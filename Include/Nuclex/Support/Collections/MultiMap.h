@@ -46,6 +46,15 @@ namespace Nuclex::Support::Collections {
     /// </returns>
     public: virtual bool Insert(const TKey &key, const TValue &value) = 0;
 
+    /// <summary>Moves a value into the map</summary>
+    /// <param name="key">Key under which the value can be looked up later</param>
+    /// <param name="value">Value that will be moved into the map under its key</param>
+    /// <returns>
+    ///   True if the key did not exist before and was inserted,
+    ///   false if the key already existed and its value was replaced.
+    /// </returns>
+    public: virtual bool Insert(const TKey &key, TValue &&value) = 0;
+
     /// <summary>Returns the value of the specified element in the map</summary>
     /// <param name="key">Key of the element that will be looked up</param>
     /// <remarks>
@@ -76,6 +85,18 @@ namespace Nuclex::Support::Collections {
     /// </remarks>
     public: virtual bool TryGet(const TKey &key, TValue &value) const = 0;
 
+    /// <summary>Looks up an element in the map without copying its value</summary>
+    /// <param name="key">Key of the element that will be looked up</param>
+    /// <returns>
+    ///   A pointer to the element's value or a null pointer if the key didn't exist
+    /// </returns>
+    /// <remarks>
+    ///   If the multi-map contains the key more than once, the value of an arbitrary
+    ///   key will be returned, just like with <see cref="TryGet" />. The pointer
+    ///   remains valid until the map is modified.
+    /// </remarks>
+    public: virtual const TValue *TryGetPointer(const TKey &key) const = 0;
+
     /// <summary>Tries to take an element from the map (removing it)</summary>
     /// <param name="key">Key of the element that will be taken from the map</param>
     /// <param name="value">Will receive the value taken from the map</param>
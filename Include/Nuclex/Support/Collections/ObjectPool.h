@@ -0,0 +1,156 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_SUPPORT_COLLECTIONS_OBJECTPOOL_H
+#define NUCLEX_SUPPORT_COLLECTIONS_OBJECTPOOL_H
+
+#include "Nuclex/Support/Config.h"
+#include "Nuclex/Support/Collections/SlabAllocator.h"
+#include "Nuclex/Support/Collections/ConcurrentSegmentedQueue.h"
+
+#include <cstddef> // for std::size_t
+#include <atomic> // for std::atomic
+#include <new> // for placement new
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Keeps objects around for reuse instead of destroying them</summary>
+  /// <typeparam name="T">Type of objects the pool manages</typeparam>
+  /// <remarks>
+  ///   <para>
+  ///     <strong>Thread safety:</strong> any number of threads can get and return objects
+  ///   </para>
+  ///   <para>
+  ///     Objects that are returned to the pool are not destroyed, but handed out again
+  ///     by the next call to <see cref="Get" />. This saves both the memory allocation and
+  ///     whatever work the object's constructor does - including any memory its members
+  ///     allocated, such as the capacity of a std::vector, which is kept, too. It is up
+  ///     to the caller to bring a recycled object back into a usable state.
+  ///   </para>
+  ///   <para>
+  ///     New objects are default-constructed in memory from the <see cref="SlabMemory" />,
+  ///     so even when the pool runs dry, the general-purpose heap is avoided. At most
+  ///     the number of objects specified as the pool's capacity are kept, any additional
+  ///     objects returned to the pool are destroyed.
+  ///   </para>
+  /// </remarks>
+  template<typename T>
+  class ObjectPool {
+
+    /// <summary>Initializes a new object pool</summary>
+    /// <param name="capacity">Maximum number of objects the pool will keep for reuse</param>
+    public: explicit ObjectPool(std::size_t capacity = 64) :
+      capacity(capacity),
+      retainedCount(0),
+      retainedObjects() {}
+
+    /// <summary>Destroys all objects kept by the pool</summary>
+    /// <remarks>
+    ///   Objects that have not been returned to the pool at this point are not affected
+    ///   and must be freed via <see cref="Delete" /> by their owners.
+    /// </remarks>
+    public: ~ObjectPool() {
+      Clear();
+    }
+
+    /// <summary>Returns the maximum number of objects the pool will keep</summary>
+    /// <returns>The number of objects the pool will keep for reuse at most</returns>
+    public: std::size_t GetCapacity() const {
+      return this->capacity;
+    }
+
+    /// <summary>Counts the number of objects currently waiting for reuse</summary>
+    /// <returns>The approximate number of objects in the pool</returns>
+    public: std::size_t CountRetainedObjects() const {
+      return this->retainedCount.load(std::memory_order_relaxed);
+    }
+
+    /// <summary>Hands out a recycled object or, if there are none, a new one</summary>
+    /// <returns>An object that should be returned to the pool when no longer needed</returns>
+    public: T *Get() {
+      T *object;
+      if(this->retainedObjects.TryTake(object)) {
+        this->retainedCount.fetch_sub(1, std::memory_order_relaxed);
+        return object;
+      }
+
+      return New();
+    }
+
+    /// <summary>Returns an object to the pool so it can be handed out again</summary>
+    /// <param name="object">Object that will be returned to the pool</param>
+    public: void Return(T *object) {
+      std::size_t previousCount = this->retainedCount.fetch_add(1, std::memory_order_relaxed);
+      if((previousCount < this->capacity) && this->retainedObjects.TryAppend(object)) {
+        return;
+      }
+
+      this->retainedCount.fetch_sub(1, std::memory_order_relaxed);
+      Delete(object);
+    }
+
+    /// <summary>Destroys all objects waiting for reuse</summary>
+    public: void Clear() {
+      T *object;
+      while(this->retainedObjects.TryTake(object)) {
+        this->retainedCount.fetch_sub(1, std::memory_order_relaxed);
+        Delete(object);
+      }
+    }
+
+    /// <summary>Creates a new object in slab memory, bypassing the pool</summary>
+    /// <returns>The new object</returns>
+    public: static T *New() {
+      SlabAllocator<T> allocator;
+      T *object = allocator.allocate(1);
+      try {
+        return new(object) T();
+      }
+      catch(...) {
+        allocator.deallocate(object, 1);
+        throw;
+      }
+    }
+
+    /// <summary>Destroys an object handed out by the pool, bypassing the pool</summary>
+    /// <param name="object">Object that will be destroyed</param>
+    public: static void Delete(T *object) {
+      object->~T();
+      SlabAllocator<T>().deallocate(object, 1);
+    }
+
+    private: ObjectPool(const ObjectPool &) = delete;
+    private: ObjectPool &operator =(const ObjectPool &) = delete;
+
+    /// <summary>Maximum number of objects the pool will keep</summary>
+    private: std::size_t capacity;
+    /// <summary>Number of objects currently waiting for reuse</summary>
+    private: std::atomic<std::size_t> retainedCount;
+    /// <summary>Objects that have been returned and are waiting for reuse</summary>
+    private: ConcurrentSegmentedQueue<T *> retainedObjects;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
+
+#endif // NUCLEX_SUPPORT_COLLECTIONS_OBJECTPOOL_H
@@ -45,6 +45,12 @@ namespace Nuclex::Support::Collections {
     /// <summary>Fired when an item has beenremoved from the collection</summary>
     /// <param name="value">Item that has been removed from the collection</param>
     public: mutable Events::Event<void(const TValue &value)> ItemRemoved;
+    /// <summary>Fired once after many items have been added or removed together</summary>
+    /// <remarks>
+    ///   Bulk changes to the collection fire this event instead of one ItemAdded or
+    ///   ItemRemoved per item. Subscribers should re-read the collection's contents.
+    /// </remarks>
+    public: mutable Events::Event<void()> ItemsChanged;
 
     // public: mutable Event Clearing();
     // public: mutable Event Cleared();
@@ -25,6 +25,8 @@ limitations under the License.
 #include "ObservableIndexedCollection.h"
 
 #include <vector> // for std::vector
+#include <cassert> // for assert()
+#include <utility> // for std::move()
 
 namespace Nuclex::Support::Collections {
 
@@ -52,6 +54,41 @@ namespace Nuclex::Support::Collections {
     /// <summary>Invalid index used to indicate when a requested item wasn't found</summary>
     public: using IndexedCollection<TValue>::InvalidIndex;
 
+    #pragma region class NotificationDeferral
+
+    /// <summary>Holds back change notifications while it exists</summary>
+    /// <remarks>
+    ///   Obtained via <see cref="ObservableDynamicArray.DeferNotifications" />. When the last
+    ///   deferral on an array goes out of scope, all changes made in the meantime are
+    ///   reported through a single ItemsReplaced and ItemsChanged notification.
+    /// </remarks>
+    public: class NotificationDeferral {
+
+      /// <summary>Begins deferring the notifications of the specified array</summary>
+      /// <param name="array">Array whose notifications will be deferred</param>
+      public: explicit NotificationDeferral(ObservableDynamicArray &array) :
+        array(array) {
+        ++array.deferralDepth;
+      }
+
+      /// <summary>Ends the deferral and sends the summary if it was the last one</summary>
+      /// <remarks>
+      ///   The summary notification is sent from here, so subscribers must not throw.
+      /// </remarks>
+      public: ~NotificationDeferral() {
+        this->array.endDeferral();
+      }
+
+      private: NotificationDeferral(const NotificationDeferral &) = delete;
+      private: NotificationDeferral &operator =(const NotificationDeferral &) = delete;
+
+      /// <summary>Array whose notifications are being deferred</summary>
+      private: ObservableDynamicArray &array;
+
+    };
+
+    #pragma endregion // class NotificationDeferral
+
     /// <summary>Initializes a new dynamic array</summary>
     public: ObservableDynamicArray() = default;
 
@@ -64,6 +101,32 @@ namespace Nuclex::Support::Collections {
       this->items.reserve(capacity);
     }
 
+    /// <summary>Holds back change notifications until the returned scope ends</summary>
+    /// <returns>A scope that sends a single summary of all changes when it ends</returns>
+    /// <remarks>
+    ///   <para>
+    ///     Use this when making many individual changes to the array. Instead of one
+    ///     notification per change, subscribers receive one ItemsReplaced notification
+    ///     covering the range of indices that was touched and one ItemsChanged notification.
+    ///   </para>
+    ///   <para>
+    ///     <code>
+    ///       {
+    ///         auto deferral = array.DeferNotifications();
+    ///         for(int index = 0; index &lt; 10000; ++index) {
+    ///           array.Add(index);
+    ///         }
+    ///       } // Subscribers are notified here
+    ///     </code>
+    ///   </para>
+    ///   <para>
+    ///     Deferrals can be nested, the summary is sent when the outermost one ends.
+    ///   </para>
+    /// </remarks>
+    public: [[nodiscard]] NotificationDeferral DeferNotifications() {
+      return NotificationDeferral(*this);
+    }
+
     /// <summary>Determines the index of the specified item in the collection</summary>
     /// <param name="value">Item whose index will be determined</param>
     /// <returns>The index of the specified item</returns>
@@ -97,6 +160,12 @@ namespace Nuclex::Support::Collections {
     /// <param name="value">Item that will be stored at the specified index</param>
     public: void SetAt(std::size_t index, const TValue &value) override {
       if(index < this->items.size()) {
+        if(this->deferralDepth > 0) {
+          this->items[index] = value;
+          recordChange(index, 1, 1);
+          return;
+        }
+
         bool removedItemNeeded = (
           (ObservableIndexedCollection<TValue>::ItemReplaced.CountSubscribers() > 0) ||
           (ObservableCollection<TValue>::ItemRemoved.CountSubscribers() > 0)
@@ -104,12 +173,12 @@ namespace Nuclex::Support::Collections {
         if(removedItemNeeded) {
           TValue old = this->items[index];
           this->items[index] = value;
-          ObservableIndexedCollection<TValue>::ItemReplaced(index, old, value);
-          ObservableCollection<TValue>::ItemRemoved(old);
-          ObservableCollection<TValue>::ItemAdded(value);
+          ObservableIndexedCollection<TValue>::ItemReplaced.Emit(index, old, value);
+          ObservableCollection<TValue>::ItemRemoved.Emit(old);
+          ObservableCollection<TValue>::ItemAdded.Emit(value);
         } else {
           this->items[index] = value;
-          ObservableCollection<TValue>::ItemAdded(value);
+          ObservableCollection<TValue>::ItemAdded.Emit(value);
         }
       } else { // Let .at() throw the appropriate out-of-bounds exception
         this->items.at(index) = value;
@@ -122,25 +191,32 @@ namespace Nuclex::Support::Collections {
     public: void InsertAt(std::size_t index, const TValue &value) override {
       typename std::vector<TValue>::iterator where = this->items.begin() + index;
       this->items.insert(where, value);
-      ObservableIndexedCollection<TValue>::ItemAdded(index, value);
-      ObservableCollection<TValue>::ItemAdded(value);
+      if(this->deferralDepth > 0) {
+        recordChange(index, 0, 1);
+      } else {
+        ObservableIndexedCollection<TValue>::ItemAdded.Emit(index, this->items[index]);
+        ObservableCollection<TValue>::ItemAdded.Emit(this->items[index]);
+      }
     }
 
     /// <summary>Removes the item at the specified index from the collection</summary>
     /// <param name="index">Index at which the item will be removed</param>
     public: void RemoveAt(std::size_t index) override {
       typename std::vector<TValue>::iterator where = this->items.begin() + index;
-      bool erasedItemNeeded = (
+      bool erasedItemNeeded = (this->deferralDepth == 0) && (
         (ObservableIndexedCollection<TValue>::ItemRemoved.CountSubscribers() > 0) ||
         (ObservableCollection<TValue>::ItemRemoved.CountSubscribers() > 0)
       );
       if(erasedItemNeeded) {
-        TValue value = *where;
+        TValue value = std::move(*where);
         this->items.erase(where);
-        ObservableIndexedCollection<TValue>::ItemRemoved(index, value);
-        ObservableCollection<TValue>::ItemRemoved(value);
+        ObservableIndexedCollection<TValue>::ItemRemoved.Emit(index, value);
+        ObservableCollection<TValue>::ItemRemoved.Emit(value);
       } else {
         this->items.erase(where);
+        if(this->deferralDepth > 0) {
+          recordChange(index, 1, 0);
+        }
       }
     }
 
@@ -148,33 +224,97 @@ namespace Nuclex::Support::Collections {
     /// <param name="item">Item that will be added to the collection</param>
     public: void Add(const TValue &item) override {
       this->items.push_back(item);
-      ObservableIndexedCollection<TValue>::ItemAdded(this->items.size() - 1, item);
-      ObservableCollection<TValue>::ItemAdded(item);
+      if(this->deferralDepth > 0) {
+        recordChange(this->items.size() - 1, 0, 1);
+      } else {
+        ObservableIndexedCollection<TValue>::ItemAdded.Emit(
+          this->items.size() - 1, this->items.back()
+        );
+        ObservableCollection<TValue>::ItemAdded.Emit(this->items.back());
+      }
+    }
+
+    /// <summary>Adds a range of items to the end of the collection</summary>
+    /// <param name="items">Items that will be added to the collection</param>
+    /// <param name="count">Number of items that will be added</param>
+    /// <remarks>
+    ///   Sends a single ItemsAdded and ItemsChanged notification rather than one
+    ///   notification per item. The items must not be taken from this array itself.
+    /// </remarks>
+    public: void AddRange(const TValue *items, std::size_t count) {
+      InsertRange(this->items.size(), items, count);
+    }
+
+    /// <summary>Inserts a range of items at the specified index</summary>
+    /// <param name="index">Index at which the first item will be inserted</param>
+    /// <param name="items">Items that will be inserted into the collection</param>
+    /// <param name="count">Number of items that will be inserted</param>
+    /// <remarks>
+    ///   Sends a single ItemsAdded and ItemsChanged notification rather than one
+    ///   notification per item. The items must not be taken from this array itself.
+    /// </remarks>
+    public: void InsertRange(std::size_t index, const TValue *items, std::size_t count) {
+      assert((index <= this->items.size()) && u8"Insertion index must be within the array");
+      if(count == 0) {
+        return;
+      }
+
+      this->items.insert(this->items.begin() + index, items, items + count);
+      if(this->deferralDepth > 0) {
+        recordChange(index, 0, count);
+      } else {
+        ObservableIndexedCollection<TValue>::ItemsAdded.Emit(index, count);
+        ObservableCollection<TValue>::ItemsChanged.Emit();
+      }
+    }
+
+    /// <summary>Removes a range of items from the collection</summary>
+    /// <param name="index">Index of the first item that will be removed</param>
+    /// <param name="count">Number of items that will be removed</param>
+    /// <remarks>
+    ///   Sends a single ItemsRemoved and ItemsChanged notification rather than one
+    ///   notification per item.
+    /// </remarks>
+    public: void RemoveRange(std::size_t index, std::size_t count) {
+      assert((index + count <= this->items.size()) && u8"Removed range must be within the array");
+      if(count == 0) {
+        return;
+      }
+
+      typename std::vector<TValue>::iterator where = this->items.begin() + index;
+      this->items.erase(where, where + count);
+      if(this->deferralDepth > 0) {
+        recordChange(index, count, 0);
+      } else {
+        ObservableIndexedCollection<TValue>::ItemsRemoved.Emit(index, count);
+        ObservableCollection<TValue>::ItemsChanged.Emit();
+      }
     }
 
     /// <summary>Removes the specified item from the collection</summary>
     /// <param name="item">Item that will be removed from the collection</param>
     /// <returns>True if the item existed in the collection and was removed</returns>
     public: bool Remove(const TValue &item) override {
-      for(
-        typename std::vector<TValue>::iterator iterator = this->items.begin();
-        iterator != this->items.end();
-        ++iterator
-      ) {
-        if(*iterator == item) {
-          this->items.erase(iterator);
-          ObservableIndexedCollection<TValue>::ItemRemoved(iterator - this->items.begin, item);
-          ObservableCollection<TValue>::ItemRemoved(item);
-          return true;
-        }
+      std::size_t index = GetIndexOf(item);
+      if(index == InvalidIndex) {
+        return false;
       }
 
-      return false;
+      RemoveAt(index);
+      return true;
     }
 
     /// <summary>Removes all items from the collection</summary>
     public: void Clear() override {
       std::size_t count = this->items.size();
+      if(this->deferralDepth > 0) {
+        this->items.clear();
+        if(count > 0) {
+          recordChange(0, count, 0);
+        }
+        return;
+      }
+
       bool erasedItemNeeded = (
         (ObservableIndexedCollection<TValue>::ItemRemoved.CountSubscribers() > 0) ||
         (ObservableCollection<TValue>::ItemRemoved.CountSubscribers() > 0)
@@ -185,8 +325,8 @@ namespace Nuclex::Support::Collections {
         removed.swap(this->items);
         while(count > 0) {
           --count;
-          ObservableIndexedCollection<TValue>::ItemRemoved(count, removed[count]);
-          ObservableCollection<TValue>::ItemRemoved(removed[count]);
+          ObservableIndexedCollection<TValue>::ItemRemoved.Emit(count, removed[count]);
+          ObservableCollection<TValue>::ItemRemoved.Emit(removed[count]);
         }
       } else {
         this->items.clear();
@@ -219,8 +359,70 @@ namespace Nuclex::Support::Collections {
       return this->items.empty();
     }
 
+    /// <summary>Merges a change into the summary of changes made while deferring</summary>
+    /// <param name="index">Index at which the change took place</param>
+    /// <param name="removedCount">Number of items removed at the index</param>
+    /// <param name="addedCount">Number of items added at the index</param>
+    /// <remarks>
+    ///   The summary is kept as a single range that, in terms of the array's contents
+    ///   before the deferral, spans from changeStartIndex to changeOldEndIndex and now
+    ///   spans from changeStartIndex to changeNewEndIndex. Everything outside of it is
+    ///   unchanged, so merging a change just means widening the range to cover it.
+    /// </remarks>
+    private: void recordChange(
+      std::size_t index, std::size_t removedCount, std::size_t addedCount
+    ) {
+      std::size_t endIndex = index + removedCount;
+      if(!this->hasDeferredChanges) {
+        this->changeStartIndex = index;
+        this->changeOldEndIndex = endIndex;
+        this->changeNewEndIndex = index + addedCount;
+        this->hasDeferredChanges = true;
+        return;
+      }
+
+      if(index < this->changeStartIndex) {
+        this->changeStartIndex = index;
+      }
+
+      // Items behind the changed range have only been shifted, so an end beyond it
+      // can be translated back to the index it had before the deferral began
+      if(endIndex > this->changeNewEndIndex) {
+        this->changeOldEndIndex += endIndex - this->changeNewEndIndex;
+        this->changeNewEndIndex = endIndex;
+      }
+
+      this->changeNewEndIndex = this->changeNewEndIndex + addedCount - removedCount;
+    }
+
+    /// <summary>Ends a deferral, sending the summary when the last one ends</summary>
+    private: void endDeferral() {
+      assert((this->deferralDepth > 0) && u8"Notifications must be deferred when ending deferral");
+
+      --this->deferralDepth;
+      if((this->deferralDepth == 0) && this->hasDeferredChanges) {
+        this->hasDeferredChanges = false;
+        ObservableIndexedCollection<TValue>::ItemsReplaced.Emit(
+          this->changeStartIndex,
+          this->changeOldEndIndex - this->changeStartIndex,
+          this->changeNewEndIndex - this->changeStartIndex
+        );
+        ObservableCollection<TValue>::ItemsChanged.Emit();
+      }
+    }
+
     /// <summary>Items stored in the dynamic array</summary>
     private: std::vector<TValue> items;
+    /// <summary>Number of notification deferrals currently active</summary>
+    private: std::size_t deferralDepth = 0;
+    /// <summary>Whether any changes were made since notifications were deferred</summary>
+    private: bool hasDeferredChanges = false;
+    /// <summary>Index of the first item touched while notifications were deferred</summary>
+    private: std::size_t changeStartIndex = 0;
+    /// <summary>End of the touched range in terms of the contents before deferral</summary>
+    private: std::size_t changeOldEndIndex = 0;
+    /// <summary>End of the touched range in terms of the current contents</summary>
+    private: std::size_t changeNewEndIndex = 0;
 
   };
 
@@ -61,6 +61,36 @@ namespace Nuclex::Support::Collections {
       void(std::size_t index, const TValue &oldValue, const TValue &newValue)
     > ItemReplaced;
 
+    /// <summary>Fired when a range of items has been added to the collection</summary>
+    /// <param name="index">Index at which the first item has been added</param>
+    /// <param name="count">Number of items that have been added</param>
+    /// <remarks>
+    ///   The added items are not passed along, they can be looked up in the collection.
+    /// </remarks>
+    public: mutable Events::Event<
+      void(std::size_t index, std::size_t count)
+    > ItemsAdded;
+
+    /// <summary>Fired when a range of items has been removed from the collection</summary>
+    /// <param name="index">Index at which the first item has been removed</param>
+    /// <param name="count">Number of items that have been removed</param>
+    public: mutable Events::Event<
+      void(std::size_t index, std::size_t count)
+    > ItemsRemoved;
+
+    /// <summary>Fired when a range of items has been replaced by a different range</summary>
+    /// <param name="index">Index at which the replaced range begins</param>
+    /// <param name="removedCount">Number of items that were in the range before</param>
+    /// <param name="addedCount">Number of items that are in the range now</param>
+    /// <remarks>
+    ///   This summarizes any number of changes made to the collection in one go: items
+    ///   before <paramref name="index" /> are unchanged and the items following the range
+    ///   are the same as before, but may have shifted by the difference in counts.
+    /// </remarks>
+    public: mutable Events::Event<
+      void(std::size_t index, std::size_t removedCount, std::size_t addedCount)
+    > ItemsReplaced;
+
     // public: mutable Event Clearing();
     // public: mutable Event Cleared();
 
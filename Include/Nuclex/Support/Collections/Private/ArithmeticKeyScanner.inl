@@ -0,0 +1,248 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#if !defined(NUCLEX_SUPPORT_COLLECTIONS_KEYEDARRAYCACHE_H)
+#error This header must be included via KeyedArrayCache.h
+#endif
+
+#include <bit> // for std::bit_cast(), std::countr_zero()
+
+#if defined(NUCLEX_SUPPORT_AVX2_AVAILABLE)
+#include <immintrin.h> // for _mm256_cmpeq_epi8(), _mm256_movemask_epi8()
+#elif defined(NUCLEX_SUPPORT_SSE2_AVAILABLE)
+#include <emmintrin.h> // for _mm_cmpeq_epi8(), _mm_movemask_epi8()
+#elif defined(NUCLEX_SUPPORT_NEON_AVAILABLE)
+#include <arm_neon.h> // for vceqq_u8(), vaddvq_u8()
+#endif
+
+namespace Nuclex::Support::Collections::Private {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Compares a vector's worth of arithmetic keys against a searched key</summary>
+  /// <typeparam name="TKey">Type of the keys that will be compared</typeparam>
+  /// <remarks>
+  ///   <para>
+  ///     Caches with integral or floating point keys store their keys in a contiguous
+  ///     array, so instead of comparing one key at a time, the cache can load a whole
+  ///     SIMD register full of keys and compare them against the searched key in a single
+  ///     instruction. With AVX2, a 256 slot cache with 32 bit integer keys is searched in
+  ///     32 compares, with SSE2 or NEON it takes 64.
+  ///   </para>
+  ///   <para>
+  ///     Floating point keys are compared with floating point instructions, so they have
+  ///     the same semantics as operator == (NaN never matches, -0.0 matches 0.0).
+  ///   </para>
+  /// </remarks>
+  template<typename TKey>
+  class ArithmeticKeyScanner {
+
+    /// <summary>Whether the key type can be scanned with this scanner</summary>
+    public: constexpr static bool IsSupported = (
+      (std::is_integral<TKey>::value && (
+        (sizeof(TKey) == 1) || (sizeof(TKey) == 2) || (sizeof(TKey) == 4) || (sizeof(TKey) == 8)
+      )) ||
+      std::is_same<TKey, float>::value ||
+      std::is_same<TKey, double>::value
+    );
+
+#if defined(NUCLEX_SUPPORT_AVX2_AVAILABLE)
+    /// <summary>Number of bytes compared in a single step</summary>
+    public: constexpr static std::size_t VectorSize = 32;
+#else
+    /// <summary>Number of bytes compared in a single step</summary>
+    public: constexpr static std::size_t VectorSize = 16;
+#endif
+
+    /// <summary>Number of keys compared in a single step</summary>
+    public: constexpr static std::size_t KeysPerVector = VectorSize / sizeof(TKey);
+
+    /// <summary>Compares a vector of keys against the searched key</summary>
+    /// <param name="keys">
+    ///   Keys that will be compared, must provide <see cref="KeysPerVector" /> keys
+    /// </param>
+    /// <param name="key">Key that is being searched for</param>
+    /// <returns>A bit mask with one bit set for each matching key</returns>
+    public: static std::uint32_t CompareVector(const TKey *keys, const TKey &key);
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey>
+  std::uint32_t ArithmeticKeyScanner<TKey>::CompareVector(const TKey *keys, const TKey &key) {
+#if defined(NUCLEX_SUPPORT_AVX2_AVAILABLE)
+    const __m256i *keyVector = reinterpret_cast<const __m256i *>(keys);
+    if constexpr(std::is_same<TKey, float>::value) {
+      return static_cast<std::uint32_t>(
+        _mm256_movemask_ps(
+          _mm256_cmp_ps(
+            _mm256_loadu_ps(keys), _mm256_set1_ps(key), _CMP_EQ_OQ
+          )
+        )
+      );
+    } else if constexpr(std::is_same<TKey, double>::value) {
+      return static_cast<std::uint32_t>(
+        _mm256_movemask_pd(
+          _mm256_cmp_pd(
+            _mm256_loadu_pd(keys), _mm256_set1_pd(key), _CMP_EQ_OQ
+          )
+        )
+      );
+    } else if constexpr(sizeof(TKey) == 1) {
+      return static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(
+          _mm256_cmpeq_epi8(
+            _mm256_loadu_si256(keyVector),
+            _mm256_set1_epi8(std::bit_cast<char>(key))
+          )
+        )
+      );
+    } else if constexpr(sizeof(TKey) == 2) {
+      __m256i matches = _mm256_cmpeq_epi16(
+        _mm256_loadu_si256(keyVector), _mm256_set1_epi16(std::bit_cast<short>(key))
+      );
+
+      // Packing works within each 128 bit lane, so the match bytes for keys 0-7
+      // end up in bits 0-7 and the match bytes for keys 8-15 in bits 16-23
+      std::uint32_t mask = static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_packs_epi16(matches, _mm256_setzero_si256()))
+      );
+      return (mask & 0xFFu) | ((mask >> 8) & 0xFF00u);
+    } else if constexpr(sizeof(TKey) == 4) {
+      return static_cast<std::uint32_t>(
+        _mm256_movemask_ps(
+          _mm256_castsi256_ps(
+            _mm256_cmpeq_epi32(
+              _mm256_loadu_si256(keyVector),
+              _mm256_set1_epi32(std::bit_cast<int>(key))
+            )
+          )
+        )
+      );
+    } else {
+      return static_cast<std::uint32_t>(
+        _mm256_movemask_pd(
+          _mm256_castsi256_pd(
+            _mm256_cmpeq_epi64(
+              _mm256_loadu_si256(keyVector),
+              _mm256_set1_epi64x(std::bit_cast<long long>(key))
+            )
+          )
+        )
+      );
+    }
+#elif defined(NUCLEX_SUPPORT_SSE2_AVAILABLE)
+    const __m128i *keyVector = reinterpret_cast<const __m128i *>(keys);
+    if constexpr(std::is_same<TKey, float>::value) {
+      return static_cast<std::uint32_t>(
+        _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(keys), _mm_set1_ps(key)))
+      );
+    } else if constexpr(std::is_same<TKey, double>::value) {
+      return static_cast<std::uint32_t>(
+        _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(keys), _mm_set1_pd(key)))
+      );
+    } else if constexpr(sizeof(TKey) == 1) {
+      return static_cast<std::uint32_t>(
+        _mm_movemask_epi8(
+          _mm_cmpeq_epi8(_mm_loadu_si128(keyVector), _mm_set1_epi8(std::bit_cast<char>(key)))
+        )
+      );
+    } else if constexpr(sizeof(TKey) == 2) {
+      __m128i matches = _mm_cmpeq_epi16(
+        _mm_loadu_si128(keyVector), _mm_set1_epi16(std::bit_cast<short>(key))
+      );
+      return static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_packs_epi16(matches, _mm_setzero_si128()))
+      );
+    } else if constexpr(sizeof(TKey) == 4) {
+      return static_cast<std::uint32_t>(
+        _mm_movemask_ps(
+          _mm_castsi128_ps(
+            _mm_cmpeq_epi32(_mm_loadu_si128(keyVector), _mm_set1_epi32(std::bit_cast<int>(key)))
+          )
+        )
+      );
+    } else {
+      // SSE2 has no 64 bit integer compare, so compare both 32 bit halves and require
+      // that each half and its neighbour matched
+      __m128i matches = _mm_cmpeq_epi32(
+        _mm_loadu_si128(keyVector), _mm_set1_epi64x(std::bit_cast<long long>(key))
+      );
+      matches = _mm_and_si128(matches, _mm_shuffle_epi32(matches, _MM_SHUFFLE(2, 3, 0, 1)));
+      return static_cast<std::uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(matches)));
+    }
+#elif defined(NUCLEX_SUPPORT_NEON_AVAILABLE)
+    // NEON has no movemask instruction, so each lane is masked with its own bit
+    // and the lanes are then summed up horizontally to form the bit mask
+    if constexpr(std::is_same<TKey, float>::value) {
+      static const std::uint32_t laneBits[4] = { 1, 2, 4, 8 };
+      uint32x4_t matches = vceqq_f32(vld1q_f32(keys), vdupq_n_f32(key));
+      return vaddvq_u32(vandq_u32(matches, vld1q_u32(laneBits)));
+    } else if constexpr(std::is_same<TKey, double>::value) {
+      static const std::uint64_t laneBits[2] = { 1, 2 };
+      uint64x2_t matches = vceqq_f64(vld1q_f64(keys), vdupq_n_f64(key));
+      return static_cast<std::uint32_t>(vaddvq_u64(vandq_u64(matches, vld1q_u64(laneBits))));
+    } else if constexpr(sizeof(TKey) == 1) {
+      static const std::uint8_t laneBits[8] = { 1, 2, 4, 8, 16, 32, 64, 128 };
+      uint8x16_t matches = vceqq_u8(
+        vld1q_u8(reinterpret_cast<const std::uint8_t *>(keys)),
+        vdupq_n_u8(std::bit_cast<std::uint8_t>(key))
+      );
+      uint8x8_t bits = vld1_u8(laneBits);
+      return (
+        static_cast<std::uint32_t>(vaddv_u8(vand_u8(vget_low_u8(matches), bits))) |
+        (static_cast<std::uint32_t>(vaddv_u8(vand_u8(vget_high_u8(matches), bits))) << 8)
+      );
+    } else if constexpr(sizeof(TKey) == 2) {
+      static const std::uint16_t laneBits[8] = { 1, 2, 4, 8, 16, 32, 64, 128 };
+      uint16x8_t matches = vceqq_u16(
+        vld1q_u16(reinterpret_cast<const std::uint16_t *>(keys)),
+        vdupq_n_u16(std::bit_cast<std::uint16_t>(key))
+      );
+      return vaddvq_u16(vandq_u16(matches, vld1q_u16(laneBits)));
+    } else if constexpr(sizeof(TKey) == 4) {
+      static const std::uint32_t laneBits[4] = { 1, 2, 4, 8 };
+      uint32x4_t matches = vceqq_u32(
+        vld1q_u32(reinterpret_cast<const std::uint32_t *>(keys)),
+        vdupq_n_u32(std::bit_cast<std::uint32_t>(key))
+      );
+      return vaddvq_u32(vandq_u32(matches, vld1q_u32(laneBits)));
+    } else {
+      static const std::uint64_t laneBits[2] = { 1, 2 };
+      uint64x2_t matches = vceqq_u64(
+        vld1q_u64(reinterpret_cast<const std::uint64_t *>(keys)),
+        vdupq_n_u64(std::bit_cast<std::uint64_t>(key))
+      );
+      return static_cast<std::uint32_t>(vaddvq_u64(vandq_u64(matches, vld1q_u64(laneBits))));
+    }
+#else
+    std::uint32_t mask = 0;
+    for(std::size_t index = 0; index < KeysPerVector; ++index) {
+      if(keys[index] == key) {
+        mask |= (std::uint32_t(1) << index);
+      }
+    }
+    return mask;
+#endif
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections::Private
@@ -0,0 +1,224 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#if !defined(NUCLEX_SUPPORT_COLLECTIONS_CONCURRENTRINGBUFFER_H)
+#error This header must be included via ConcurrentRingBuffer.h
+#endif
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>
+  ///   Fixed-size lock-free ring buffer for any number of producing threads and
+  ///   a single consuming thread
+  /// </summary>
+  /// <typeparam name="TElement">Type of elements stored in the ring buffer</typeparam>
+  /// <remarks>
+  ///   <para>
+  ///     Producers work exactly like in the multiple producers, multiple consumers
+  ///     variant (claiming slots via compare-and-swap and publishing them through
+  ///     the slot's sequence number). Since there is only one consumer, it owns the read
+  ///     index and can advance it with a plain store instead of compare-and-swap.
+  ///   </para>
+  ///   <para>
+  ///     If an element's copy constructor throws, the claimed slot is published as
+  ///     a tombstone which consumers silently skip, so the ring buffer stays usable.
+  ///   </para>
+  /// </remarks>
+  template<typename TElement>
+  class ConcurrentRingBuffer<
+    TElement, ConcurrentAccessBehavior::MultipleProducersSingleConsumer
+  > : public ConcurrentCollection<
+    TElement, ConcurrentAccessBehavior::MultipleProducersSingleConsumer
+  > {
+
+    #pragma region struct Cell
+
+    /// <summary>Slot in the ring buffer that can hold a single element</summary>
+    private: struct Cell {
+
+      /// <summary>Lap-dependent number indicating whether the cell is full or empty</summary>
+      public: std::atomic<std::size_t> Sequence;
+      /// <summary>Whether the cell was claimed by a producer that failed</summary>
+      public: bool IsTombstone;
+      /// <summary>Memory in which the cell's element is constructed</summary>
+      public: alignas(TElement) std::uint8_t Storage[sizeof(TElement)];
+
+    };
+
+    #pragma endregion // struct Cell
+
+    /// <summary>Initializes a new concurrent ring buffer</summary>
+    /// <param name="capacity">
+    ///   Minimum number of elements the ring buffer can hold, will be rounded up
+    ///   to the next power of two
+    /// </param>
+    public: explicit ConcurrentRingBuffer(std::size_t capacity) :
+      capacity(
+        static_cast<std::size_t>(
+          BitTricks::GetUpperPowerOfTwo(
+            static_cast<std::uint64_t>((capacity < 2) ? 2 : capacity)
+          )
+        )
+      ),
+      cells(new Cell[this->capacity]),
+      readIndex(0),
+      writeIndex(0) {
+      for(std::size_t index = 0; index < this->capacity; ++index) {
+        this->cells[index].Sequence.store(index, std::memory_order_relaxed);
+        this->cells[index].IsTombstone = false;
+      }
+    }
+
+    /// <summary>Frees all memory owned by the concurrent ring buffer</summary>
+    /// <remarks>
+    ///   The ring buffer must not be accessed by any other threads anymore when it is
+    ///   being destroyed. Any elements still in the buffer will be destroyed.
+    /// </remarks>
+    public: ~ConcurrentRingBuffer() override {
+      if constexpr(!std::is_trivially_destructible<TElement>::value) {
+        std::size_t read = this->readIndex.load(std::memory_order_acquire);
+        std::size_t write = this->writeIndex.load(std::memory_order_acquire);
+        while(read != write) {
+          Cell &cell = this->cells[read & (this->capacity - 1)];
+          if(!cell.IsTombstone) {
+            std::launder(reinterpret_cast<TElement *>(cell.Storage))->~TElement();
+          }
+          ++read;
+        }
+      }
+    }
+
+    /// <summary>Tries to append an element to the ring buffer</summary>
+    /// <param name="element">Element that will be appended to the ring buffer</param>
+    /// <returns>True if the element was appended, false if the ring buffer was full</returns>
+    public: bool TryAppend(const TElement &element) override {
+      std::size_t write = this->writeIndex.load(std::memory_order_relaxed);
+      Cell *cell;
+      for(;;) {
+        cell = &this->cells[write & (this->capacity - 1)];
+        std::size_t sequence = cell->Sequence.load(std::memory_order_acquire);
+        std::intptr_t difference = (
+          static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(write)
+        );
+        if(difference == 0) {
+          bool claimed = this->writeIndex.compare_exchange_weak(
+            write, write + 1, std::memory_order_relaxed
+          );
+          if(claimed) {
+            break;
+          }
+        } else if(difference < 0) {
+          return false; // Cell still holds the element from the previous lap, buffer full
+        } else {
+          write = this->writeIndex.load(std::memory_order_relaxed);
+        }
+      }
+
+      // The slot is ours now. Should the copy constructor throw, we still have to hand
+      // the slot to the consumers (who wait for it in order), so we mark it as empty.
+      {
+        auto publishTombstoneScope = ON_SCOPE_EXIT_TRANSACTION {
+          cell->IsTombstone = true;
+          cell->Sequence.store(write + 1, std::memory_order_release);
+        };
+        new(cell->Storage) TElement(element);
+        publishTombstoneScope.Commit();
+      }
+
+      cell->IsTombstone = false;
+      cell->Sequence.store(write + 1, std::memory_order_release);
+
+      return true;
+    }
+
+    /// <summary>Tries to take an element from the ring buffer</summary>
+    /// <param name="element">Will receive the element taken from the ring buffer</param>
+    /// <returns>
+    ///   True if an element was taken from the ring buffer, false if it was empty
+    /// </returns>
+    /// <remarks>
+    ///   Must only be called by the consuming thread.
+    /// </remarks>
+    public: bool TryTake(TElement &element) override {
+      std::size_t read = this->readIndex.load(std::memory_order_relaxed);
+      for(;;) {
+        Cell &cell = this->cells[read & (this->capacity - 1)];
+        std::size_t sequence = cell.Sequence.load(std::memory_order_acquire);
+        if(sequence != read + 1) {
+          return false; // Cell has not been filled for this lap yet, buffer empty
+        }
+
+        // We are the only consumer, so nobody can race us for the read index
+        this->readIndex.store(read + 1, std::memory_order_relaxed);
+
+        if(cell.IsTombstone) {
+          cell.Sequence.store(read + this->capacity, std::memory_order_release);
+          ++read;
+          continue;
+        }
+
+        TElement *item = std::launder(reinterpret_cast<TElement *>(cell.Storage));
+        ON_SCOPE_EXIT {
+          item->~TElement();
+          cell.Sequence.store(read + this->capacity, std::memory_order_release);
+        };
+        element = std::move(*item);
+
+        return true;
+      }
+    }
+
+    /// <summary>Counts the number of elements currently in the ring buffer</summary>
+    /// <returns>
+    ///   The approximate number of elements that had been in the ring buffer during the call
+    /// </returns>
+    public: std::size_t Count() const override {
+      std::size_t read = this->readIndex.load(std::memory_order_acquire);
+      std::size_t write = this->writeIndex.load(std::memory_order_acquire);
+      std::size_t count = write - read;
+      return (count < this->capacity) ? count : this->capacity;
+    }
+
+    /// <summary>Checks if the ring buffer is empty</summary>
+    /// <returns>True if the ring buffer had been empty during the call</returns>
+    public: bool IsEmpty() const override {
+      return (Count() == 0);
+    }
+
+    /// <summary>Returns the maximum number of elements the ring buffer can hold</summary>
+    /// <returns>The number of elements the ring buffer can hold at most</returns>
+    public: std::size_t GetCapacity() const { return this->capacity; }
+
+    /// <summary>Number of items the ring buffer can hold, always a power of two</summary>
+    private: const std::size_t capacity;
+    /// <summary>Slots that hold the elements and their sequence numbers</summary>
+    private: std::unique_ptr<Cell[]> cells;
+
+    /// <summary>Index from which the consumer will take the next element</summary>
+    private: alignas(NUCLEX_SUPPORT_CACHE_LINE_SIZE) std::atomic<std::size_t> readIndex;
+    /// <summary>Index at which the next producer will store an element</summary>
+    private: alignas(NUCLEX_SUPPORT_CACHE_LINE_SIZE) std::atomic<std::size_t> writeIndex;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
@@ -0,0 +1,300 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#if !defined(NUCLEX_SUPPORT_COLLECTIONS_CONCURRENTRINGBUFFER_H)
+#error This header must be included via ConcurrentRingBuffer.h
+#endif
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>
+  ///   Fixed-size lock-free ring buffer for one producing and one consuming thread
+  /// </summary>
+  /// <typeparam name="TElement">Type of elements stored in the ring buffer</typeparam>
+  /// <remarks>
+  ///   <para>
+  ///     Because each index only ever has one thread modifying it, no compare-and-swap
+  ///     or other read-modify-write operations are needed. The producer publishes new
+  ///     elements with a release store on the write index and the consumer hands back
+  ///     slots with a release store on the read index.
+  ///   </para>
+  ///   <para>
+  ///     Each side furthermore remembers the last index it saw from the other side and
+  ///     only looks at the other side's cache line again when that stale copy claims
+  ///     the buffer to be full (producer) or empty (consumer).
+  ///   </para>
+  ///   <para>
+  ///     For bulk transfers, <see cref="TryAppendMany" /> and <see cref="TryTakeMany" />
+  ///     move as many elements as fit in one go and publish them with a single release
+  ///     store, so the other side sees one index update per batch rather than per element.
+  ///   </para>
+  /// </remarks>
+  template<typename TElement>
+  class ConcurrentRingBuffer<
+    TElement, ConcurrentAccessBehavior::SingleProducerSingleConsumer
+  > : public ConcurrentCollection<
+    TElement, ConcurrentAccessBehavior::SingleProducerSingleConsumer
+  > {
+
+    /// <summary>Initializes a new concurrent ring buffer</summary>
+    /// <param name="capacity">
+    ///   Minimum number of elements the ring buffer can hold, will be rounded up
+    ///   to the next power of two
+    /// </param>
+    public: explicit ConcurrentRingBuffer(std::size_t capacity) :
+      capacity(
+        static_cast<std::size_t>(
+          BitTricks::GetUpperPowerOfTwo(
+            static_cast<std::uint64_t>((capacity < 2) ? 2 : capacity)
+          )
+        )
+      ),
+      itemMemory(new std::uint8_t[sizeof(TElement) * this->capacity]),
+      readIndex(0),
+      cachedWriteIndex(0),
+      writeIndex(0),
+      cachedReadIndex(0) {}
+
+    /// <summary>Frees all memory owned by the concurrent ring buffer</summary>
+    /// <remarks>
+    ///   The ring buffer must not be accessed by any other threads anymore when it is
+    ///   being destroyed. Any elements still in the buffer will be destroyed.
+    /// </remarks>
+    public: ~ConcurrentRingBuffer() override {
+      if constexpr(!std::is_trivially_destructible<TElement>::value) {
+        std::size_t read = this->readIndex.load(std::memory_order_acquire);
+        std::size_t write = this->writeIndex.load(std::memory_order_acquire);
+        while(read != write) {
+          getItemAddress(read)->~TElement();
+          ++read;
+        }
+      }
+    }
+
+    /// <summary>Tries to append an element to the ring buffer</summary>
+    /// <param name="element">Element that will be appended to the ring buffer</param>
+    /// <returns>True if the element was appended, false if the ring buffer was full</returns>
+    /// <remarks>
+    ///   Must only be called by the producing thread.
+    /// </remarks>
+    public: bool TryAppend(const TElement &element) override {
+      std::size_t write = this->writeIndex.load(std::memory_order_relaxed);
+      if(write - this->cachedReadIndex >= this->capacity) {
+        this->cachedReadIndex = this->readIndex.load(std::memory_order_acquire);
+        if(write - this->cachedReadIndex >= this->capacity) {
+          return false; // Buffer is really full
+        }
+      }
+
+      // If the copy constructor throws, the write index is never advanced, so the slot
+      // remains free and the consumer never sees it.
+      new(getItemAddress(write)) TElement(element);
+      this->writeIndex.store(write + 1, std::memory_order_release);
+
+      return true;
+    }
+
+    /// <summary>Tries to take an element from the ring buffer</summary>
+    /// <param name="element">Will receive the element taken from the ring buffer</param>
+    /// <returns>
+    ///   True if an element was taken from the ring buffer, false if it was empty
+    /// </returns>
+    /// <remarks>
+    ///   Must only be called by the consuming thread.
+    /// </remarks>
+    public: bool TryTake(TElement &element) override {
+      std::size_t read = this->readIndex.load(std::memory_order_relaxed);
+      if(read == this->cachedWriteIndex) {
+        this->cachedWriteIndex = this->writeIndex.load(std::memory_order_acquire);
+        if(read == this->cachedWriteIndex) {
+          return false; // Buffer is really empty
+        }
+      }
+
+      // Even if the move assignment throws, we consider the element gone. Otherwise,
+      // a single bad element would block the buffer forever.
+      TElement *item = getItemAddress(read);
+      ON_SCOPE_EXIT {
+        item->~TElement();
+        this->readIndex.store(read + 1, std::memory_order_release);
+      };
+      element = std::move(*item);
+
+      return true;
+    }
+
+    /// <summary>Tries to append many elements to the ring buffer at once</summary>
+    /// <param name="elements">Elements that will be appended to the ring buffer</param>
+    /// <param name="count">Number of elements the caller wishes to append</param>
+    /// <returns>
+    ///   The number of elements that were appended, which is less than the requested
+    ///   number if the ring buffer did not have enough free space
+    /// </returns>
+    /// <remarks>
+    ///   Must only be called by the producing thread. If a copy constructor throws,
+    ///   the elements before it are appended and the exception is passed on.
+    /// </remarks>
+    public: std::size_t TryAppendMany(const TElement *elements, std::size_t count) {
+      std::size_t write = this->writeIndex.load(std::memory_order_relaxed);
+      if(this->capacity - (write - this->cachedReadIndex) < count) {
+        this->cachedReadIndex = this->readIndex.load(std::memory_order_acquire);
+        std::size_t freeCount = this->capacity - (write - this->cachedReadIndex);
+        if(freeCount < count) {
+          count = freeCount;
+        }
+      }
+
+      if constexpr(std::is_trivially_copyable<TElement>::value) {
+        std::size_t firstSegmentCount = getSegmentCount(write, count);
+        std::memcpy(getItemAddress(write), elements, firstSegmentCount * sizeof(TElement));
+        std::memcpy(
+          getItemAddress(write + firstSegmentCount),
+          elements + firstSegmentCount,
+          (count - firstSegmentCount) * sizeof(TElement)
+        );
+        this->writeIndex.store(write + count, std::memory_order_release);
+      } else {
+        std::size_t index = 0;
+        ON_SCOPE_EXIT { // publishes the elements before a throwing copy constructor, too
+          this->writeIndex.store(write + index, std::memory_order_release);
+        };
+        while(index < count) {
+          new(getItemAddress(write + index)) TElement(elements[index]);
+          ++index;
+        }
+      }
+
+      return count;
+    }
+
+    /// <summary>Tries to take many elements from the ring buffer at once</summary>
+    /// <param name="elements">Will receive the elements taken from the ring buffer</param>
+    /// <param name="count">Number of elements the caller wishes to take</param>
+    /// <returns>
+    ///   The number of elements that were taken, which is less than the requested
+    ///   number if the ring buffer did not hold enough elements
+    /// </returns>
+    /// <remarks>
+    ///   Must only be called by the consuming thread. If a move assignment throws,
+    ///   the element being moved is considered gone, just like in <see cref="TryTake" />,
+    ///   and the elements behind it remain in the ring buffer.
+    /// </remarks>
+    public: std::size_t TryTakeMany(TElement *elements, std::size_t count) {
+      std::size_t read = this->readIndex.load(std::memory_order_relaxed);
+      if(this->cachedWriteIndex - read < count) {
+        this->cachedWriteIndex = this->writeIndex.load(std::memory_order_acquire);
+        std::size_t availableCount = this->cachedWriteIndex - read;
+        if(availableCount < count) {
+          count = availableCount;
+        }
+      }
+
+      if constexpr(
+        std::is_trivially_copyable<TElement>::value &&
+        std::is_trivially_destructible<TElement>::value
+      ) {
+        std::size_t firstSegmentCount = getSegmentCount(read, count);
+        std::memcpy(elements, getItemAddress(read), firstSegmentCount * sizeof(TElement));
+        std::memcpy(
+          elements + firstSegmentCount,
+          getItemAddress(read + firstSegmentCount),
+          (count - firstSegmentCount) * sizeof(TElement)
+        );
+        this->readIndex.store(read + count, std::memory_order_release);
+      } else {
+        std::size_t index = 0;
+        ON_SCOPE_EXIT {
+          this->readIndex.store(read + index, std::memory_order_release);
+        };
+        while(index < count) {
+          TElement *item = getItemAddress(read + index);
+          ON_SCOPE_EXIT {
+            item->~TElement();
+            ++index;
+          };
+          elements[index] = std::move(*item);
+        }
+      }
+
+      return count;
+    }
+
+    /// <summary>Counts the number of elements currently in the ring buffer</summary>
+    /// <returns>
+    ///   The approximate number of elements that had been in the ring buffer during the call
+    /// </returns>
+    public: std::size_t Count() const override {
+      std::size_t read = this->readIndex.load(std::memory_order_acquire);
+      std::size_t write = this->writeIndex.load(std::memory_order_acquire);
+      std::size_t count = write - read;
+      return (count < this->capacity) ? count : this->capacity;
+    }
+
+    /// <summary>Checks if the ring buffer is empty</summary>
+    /// <returns>True if the ring buffer had been empty during the call</returns>
+    public: bool IsEmpty() const override {
+      return (
+        this->readIndex.load(std::memory_order_acquire) ==
+        this->writeIndex.load(std::memory_order_acquire)
+      );
+    }
+
+    /// <summary>Returns the maximum number of elements the ring buffer can hold</summary>
+    /// <returns>The number of elements the ring buffer can hold at most</returns>
+    public: std::size_t GetCapacity() const { return this->capacity; }
+
+    /// <summary>Calculates the memory address of the item at the specified index</summary>
+    /// <param name="index">Unwrapped index of the item whose address will be calculated</param>
+    /// <returns>The memory address of the item at the specified index</returns>
+    private: TElement *getItemAddress(std::size_t index) const {
+      return std::launder(
+        reinterpret_cast<TElement *>(this->itemMemory.get()) + (index & (this->capacity - 1))
+      );
+    }
+
+    /// <summary>Counts how many items fit between an index and the end of the memory</summary>
+    /// <param name="index">Unwrapped index of the first item</param>
+    /// <param name="count">Total number of items that will be accessed</param>
+    /// <returns>The number of items that can be accessed before wrapping around</returns>
+    private: std::size_t getSegmentCount(std::size_t index, std::size_t count) const {
+      std::size_t untilEnd = this->capacity - (index & (this->capacity - 1));
+      return (count < untilEnd) ? count : untilEnd;
+    }
+
+    /// <summary>Number of items the ring buffer can hold, always a power of two</summary>
+    private: const std::size_t capacity;
+    /// <summary>Memory block that holds the items currently stored in the buffer</summary>
+    private: std::unique_ptr<std::uint8_t[]> itemMemory;
+
+    /// <summary>Index from which the consumer will take the next element</summary>
+    private: alignas(NUCLEX_SUPPORT_CACHE_LINE_SIZE) std::atomic<std::size_t> readIndex;
+    /// <summary>Last write index the consumer saw, only touched by the consumer</summary>
+    private: std::size_t cachedWriteIndex;
+    /// <summary>Index at which the producer will store the next element</summary>
+    private: alignas(NUCLEX_SUPPORT_CACHE_LINE_SIZE) std::atomic<std::size_t> writeIndex;
+    /// <summary>Last read index the producer saw, only touched by the producer</summary>
+    private: std::size_t cachedReadIndex;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
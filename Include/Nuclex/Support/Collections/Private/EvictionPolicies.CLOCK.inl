@@ -0,0 +1,138 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#if !defined(NUCLEX_SUPPORT_COLLECTIONS_EVICTIONPOLICIES_H)
+#error This header must be included via EvictionPolicies.h
+#endif
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Approximates LRU with a single reference bit per slot</summary>
+  /// <typeparam name="TSlotIndex">Unsigned integer type used to link slots</typeparam>
+  /// <remarks>
+  ///   <para>
+  ///     Slots sit in a circular list that is swept by a clock hand when an item needs
+  ///     to be evicted. An access merely sets the slot's reference bit (and only writes
+  ///     it if it wasn't set already), so cache hits do not relink anything and reads
+  ///     of popular items do not dirty any shared cache lines.
+  ///   </para>
+  ///   <para>
+  ///     When the hand finds a slot with its reference bit set, it clears the bit and
+  ///     moves on, giving the slot a second chance. The first slot found without its
+  ///     reference bit set is evicted.
+  ///   </para>
+  /// </remarks>
+  template<typename TSlotIndex = std::size_t>
+  class ClockEvictionPolicy {
+
+    /// <summary>Integer type the policy uses to refer to slots</summary>
+    public: typedef TSlotIndex SlotIndexType;
+
+    /// <summary>Whether the policy needs a hash of each key that is inserted</summary>
+    public: constexpr static bool UsesKeyHash = false;
+
+    /// <summary>Initializes a new CLOCK policy for the specified number of slots</summary>
+    /// <param name="slotCount">Number of slots the policy will manage</param>
+    public: explicit ClockEvictionPolicy(std::size_t slotCount) :
+      links(slotCount),
+      ring(),
+      referenced(new bool[slotCount]) {}
+
+    /// <summary>Checks whether the policy is tracking the specified slot</summary>
+    /// <param name="slotIndex">Index of the slot that will be checked</param>
+    /// <returns>True if the slot is occupied, false otherwise</returns>
+    public: bool Contains(std::size_t slotIndex) const {
+      return this->links.IsLinked(slotIndex);
+    }
+
+    /// <summary>Asks the CPU to fetch the tracking data of a slot into its cache</summary>
+    /// <param name="slotIndex">Index of the slot that will be looked up soon</param>
+    public: void Prefetch(std::size_t slotIndex) const {
+      this->links.Prefetch(slotIndex);
+      NUCLEX_SUPPORT_PREFETCH(this->referenced.get() + slotIndex);
+    }
+
+    /// <summary>Starts tracking a newly occupied slot</summary>
+    /// <param name="slotIndex">Index of the slot that has been occupied</param>
+    public: void Insert(std::size_t slotIndex, std::size_t /* keyHash */) {
+      this->referenced[slotIndex] = false;
+      this->links.PushNewest(this->ring, slotIndex); // right behind the clock hand
+    }
+
+    /// <summary>Records an access to an occupied slot</summary>
+    /// <param name="slotIndex">Index of the slot that has been accessed</param>
+    public: void Touch(std::size_t slotIndex) {
+      if(!this->referenced[slotIndex]) {
+        this->referenced[slotIndex] = true;
+      }
+    }
+
+    /// <summary>Stops tracking a slot whose item has been removed</summary>
+    /// <param name="slotIndex">Index of the slot that has been freed</param>
+    public: void Remove(std::size_t slotIndex) {
+      this->links.Unlink(this->ring, slotIndex);
+    }
+
+    /// <summary>Picks a slot to evict and stops tracking it</summary>
+    /// <returns>The index of the slot whose item should be evicted</returns>
+    public: std::size_t Evict() {
+      assert((this->ring.Count > 0) && u8"Policy must be tracking at least one slot");
+
+      // The oldest end of the queue is where the clock hand points. Passing over a slot
+      // means moving it to the newest end, which is the same as advancing the hand.
+      for(;;) {
+        std::size_t slotIndex = this->ring.Oldest;
+        if(this->referenced[slotIndex]) {
+          this->referenced[slotIndex] = false;
+          this->links.MoveToNewest(this->ring, slotIndex);
+        } else {
+          this->links.Unlink(this->ring, slotIndex);
+          return slotIndex;
+        }
+      }
+    }
+
+    /// <summary>Stops tracking all slots</summary>
+    public: void Clear() {
+      this->links.Clear(this->ring);
+    }
+
+    /// <summary>Invokes a callback on all tracked slots, starting at the clock hand</summary>
+    /// <typeparam name="TCallback">Type of callback that will be invoked</typeparam>
+    /// <param name="callback">Callback that will receive the index of each slot</param>
+    /// <remarks>The callback may remove the slot it is visiting, but no other slots</remarks>
+    public: template<typename TCallback>
+    void ForEach(TCallback &&callback) const {
+      this->links.ForEach(this->ring, callback);
+    }
+
+    /// <summary>Links the slots into the ring swept by the clock hand</summary>
+    private: Private::SlotLinks<TSlotIndex> links;
+    /// <summary>Slots in the order the clock hand will visit them</summary>
+    private: Private::SlotQueue<TSlotIndex> ring;
+    /// <summary>Reference bit of each slot, set when the slot is accessed</summary>
+    private: std::unique_ptr<bool[]> referenced;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
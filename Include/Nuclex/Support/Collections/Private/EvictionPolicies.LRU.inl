@@ -0,0 +1,114 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#if !defined(NUCLEX_SUPPORT_COLLECTIONS_EVICTIONPOLICIES_H)
+#error This header must be included via EvictionPolicies.h
+#endif
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Evicts the slot that has not been accessed for the longest time</summary>
+  /// <typeparam name="TSlotIndex">Unsigned integer type used to link slots</typeparam>
+  /// <remarks>
+  ///   Classic least recently used policy. Every access moves the slot to the front of
+  ///   a doubly linked list, so reads modify the list and touch the links of up to three
+  ///   slots. It is a good default for workloads with strong recency, but a single scan
+  ///   over more items than the cache holds will flush out everything else.
+  /// </remarks>
+  template<typename TSlotIndex = std::size_t>
+  class LruEvictionPolicy {
+
+    /// <summary>Integer type the policy uses to refer to slots</summary>
+    public: typedef TSlotIndex SlotIndexType;
+
+    /// <summary>Whether the policy needs a hash of each key that is inserted</summary>
+    public: constexpr static bool UsesKeyHash = false;
+
+    /// <summary>Initializes a new LRU policy for the specified number of slots</summary>
+    /// <param name="slotCount">Number of slots the policy will manage</param>
+    public: explicit LruEvictionPolicy(std::size_t slotCount) :
+      links(slotCount),
+      queue() {}
+
+    /// <summary>Checks whether the policy is tracking the specified slot</summary>
+    /// <param name="slotIndex">Index of the slot that will be checked</param>
+    /// <returns>True if the slot is occupied, false otherwise</returns>
+    public: bool Contains(std::size_t slotIndex) const {
+      return this->links.IsLinked(slotIndex);
+    }
+
+    /// <summary>Asks the CPU to fetch the tracking data of a slot into its cache</summary>
+    /// <param name="slotIndex">Index of the slot that will be looked up soon</param>
+    public: void Prefetch(std::size_t slotIndex) const {
+      this->links.Prefetch(slotIndex);
+    }
+
+    /// <summary>Starts tracking a newly occupied slot</summary>
+    /// <param name="slotIndex">Index of the slot that has been occupied</param>
+    public: void Insert(std::size_t slotIndex, std::size_t /* keyHash */) {
+      this->links.PushNewest(this->queue, slotIndex);
+    }
+
+    /// <summary>Records an access to an occupied slot</summary>
+    /// <param name="slotIndex">Index of the slot that has been accessed</param>
+    public: void Touch(std::size_t slotIndex) {
+      this->links.MoveToNewest(this->queue, slotIndex);
+    }
+
+    /// <summary>Stops tracking a slot whose item has been removed</summary>
+    /// <param name="slotIndex">Index of the slot that has been freed</param>
+    public: void Remove(std::size_t slotIndex) {
+      this->links.Unlink(this->queue, slotIndex);
+    }
+
+    /// <summary>Picks a slot to evict and stops tracking it</summary>
+    /// <returns>The index of the slot whose item should be evicted</returns>
+    public: std::size_t Evict() {
+      assert((this->queue.Count > 0) && u8"Policy must be tracking at least one slot");
+      std::size_t slotIndex = this->queue.Oldest;
+      this->links.Unlink(this->queue, slotIndex);
+      return slotIndex;
+    }
+
+    /// <summary>Stops tracking all slots</summary>
+    public: void Clear() {
+      this->links.Clear(this->queue);
+    }
+
+    /// <summary>Invokes a callback on all tracked slots, next eviction candidates first</summary>
+    /// <typeparam name="TCallback">Type of callback that will be invoked</typeparam>
+    /// <param name="callback">Callback that will receive the index of each slot</param>
+    /// <remarks>The callback may remove the slot it is visiting, but no other slots</remarks>
+    public: template<typename TCallback>
+    void ForEach(TCallback &&callback) const {
+      this->links.ForEach(this->queue, callback);
+    }
+
+    /// <summary>Links the slots in order of their last access</summary>
+    private: Private::SlotLinks<TSlotIndex> links;
+    /// <summary>Slots ordered from least to most recently used</summary>
+    private: Private::SlotQueue<TSlotIndex> queue;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
@@ -0,0 +1,191 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#if !defined(NUCLEX_SUPPORT_COLLECTIONS_EVICTIONPOLICIES_H)
+#error This header must be included via EvictionPolicies.h
+#endif
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Filters out one-hit wonders with a small FIFO in front of a main FIFO</summary>
+  /// <typeparam name="TSlotIndex">Unsigned integer type used to link slots</typeparam>
+  /// <remarks>
+  ///   <para>
+  ///     Implements S3-FIFO by Yang et al. New items enter a small FIFO queue holding
+  ///     about 10% of the cache. When an item reaches the end of that queue, it is moved
+  ///     into the main FIFO queue if it was accessed in the meantime, otherwise it is
+  ///     evicted and its key is remembered in a ghost history. Keys that return while
+  ///     still remembered go straight into the main queue.
+  ///   </para>
+  ///   <para>
+  ///     Items in the main queue that were accessed get reinserted (with their access
+  ///     count decremented) rather than evicted. Accesses only increment a small
+  ///     saturating counter, so like CLOCK, hits never relink anything.
+  ///   </para>
+  /// </remarks>
+  template<typename TSlotIndex = std::size_t>
+  class S3FifoEvictionPolicy {
+
+    /// <summary>Integer type the policy uses to refer to slots</summary>
+    public: typedef TSlotIndex SlotIndexType;
+
+    /// <summary>Whether the policy needs a hash of each key that is inserted</summary>
+    public: constexpr static bool UsesKeyHash = true;
+
+    /// <summary>Initializes a new S3-FIFO policy for the specified number of slots</summary>
+    /// <param name="slotCount">Number of slots the policy will manage</param>
+    public: explicit S3FifoEvictionPolicy(std::size_t slotCount) :
+      links(slotCount),
+      smallQueue(),
+      mainQueue(),
+      smallCapacity(slotCount >= 10 ? (slotCount / 10) : 1),
+      ghosts(slotCount),
+      states(new std::uint8_t[slotCount]),
+      fingerprints(new std::uint32_t[slotCount]) {}
+
+    /// <summary>Checks whether the policy is tracking the specified slot</summary>
+    /// <param name="slotIndex">Index of the slot that will be checked</param>
+    /// <returns>True if the slot is occupied, false otherwise</returns>
+    public: bool Contains(std::size_t slotIndex) const {
+      return this->links.IsLinked(slotIndex);
+    }
+
+    /// <summary>Asks the CPU to fetch the tracking data of a slot into its cache</summary>
+    /// <param name="slotIndex">Index of the slot that will be looked up soon</param>
+    public: void Prefetch(std::size_t slotIndex) const {
+      this->links.Prefetch(slotIndex);
+      NUCLEX_SUPPORT_PREFETCH(this->states.get() + slotIndex);
+    }
+
+    /// <summary>Starts tracking a newly occupied slot</summary>
+    /// <param name="slotIndex">Index of the slot that has been occupied</param>
+    /// <param name="keyHash">Hash of the key stored in the slot</param>
+    public: void Insert(std::size_t slotIndex, std::size_t keyHash) {
+      std::uint32_t fingerprint = Private::GetKeyFingerprint(keyHash);
+      this->fingerprints[slotIndex] = fingerprint;
+
+      if(this->ghosts.TryTake(fingerprint)) {
+        this->states[slotIndex] = MainQueueFlag;
+        this->links.PushNewest(this->mainQueue, slotIndex);
+      } else {
+        this->states[slotIndex] = 0;
+        this->links.PushNewest(this->smallQueue, slotIndex);
+      }
+    }
+
+    /// <summary>Records an access to an occupied slot</summary>
+    /// <param name="slotIndex">Index of the slot that has been accessed</param>
+    public: void Touch(std::size_t slotIndex) {
+      std::uint8_t state = this->states[slotIndex];
+      if((state & FrequencyMask) < FrequencyMask) {
+        this->states[slotIndex] = state + 1;
+      }
+    }
+
+    /// <summary>Stops tracking a slot whose item has been removed</summary>
+    /// <param name="slotIndex">Index of the slot that has been freed</param>
+    public: void Remove(std::size_t slotIndex) {
+      if((this->states[slotIndex] & MainQueueFlag) != 0) {
+        this->links.Unlink(this->mainQueue, slotIndex);
+      } else {
+        this->links.Unlink(this->smallQueue, slotIndex);
+      }
+    }
+
+    /// <summary>Picks a slot to evict and stops tracking it</summary>
+    /// <returns>The index of the slot whose item should be evicted</returns>
+    public: std::size_t Evict() {
+      assert(
+        ((this->smallQueue.Count + this->mainQueue.Count) > 0) &&
+        u8"Policy must be tracking at least one slot"
+      );
+
+      // Each pass either evicts an item, moves an item from the small queue into
+      // the main queue or decrements an item's access count, so this terminates.
+      for(;;) {
+        bool evictFromSmall = (this->smallQueue.Count > 0) && (
+          (this->smallQueue.Count >= this->smallCapacity) || (this->mainQueue.Count == 0)
+        );
+        if(evictFromSmall) {
+          std::size_t slotIndex = this->smallQueue.Oldest;
+          this->links.Unlink(this->smallQueue, slotIndex);
+          if((this->states[slotIndex] & FrequencyMask) != 0) {
+            this->states[slotIndex] = MainQueueFlag;
+            this->links.PushNewest(this->mainQueue, slotIndex);
+          } else {
+            this->ghosts.Add(this->fingerprints[slotIndex]);
+            return slotIndex;
+          }
+        } else {
+          std::size_t slotIndex = this->mainQueue.Oldest;
+          if((this->states[slotIndex] & FrequencyMask) != 0) {
+            --this->states[slotIndex];
+            this->links.MoveToNewest(this->mainQueue, slotIndex);
+          } else {
+            this->links.Unlink(this->mainQueue, slotIndex);
+            return slotIndex;
+          }
+        }
+      }
+    }
+
+    /// <summary>Stops tracking all slots</summary>
+    public: void Clear() {
+      this->links.Clear(this->smallQueue);
+      this->links.Clear(this->mainQueue);
+      this->ghosts.Clear();
+    }
+
+    /// <summary>Invokes a callback on all tracked slots, next eviction candidates first</summary>
+    /// <typeparam name="TCallback">Type of callback that will be invoked</typeparam>
+    /// <param name="callback">Callback that will receive the index of each slot</param>
+    /// <remarks>The callback may remove the slot it is visiting, but no other slots</remarks>
+    public: template<typename TCallback>
+    void ForEach(TCallback &&callback) const {
+      this->links.ForEach(this->smallQueue, callback);
+      this->links.ForEach(this->mainQueue, callback);
+    }
+
+    /// <summary>Bits of the slot state that hold the saturating access count</summary>
+    private: constexpr static std::uint8_t FrequencyMask = 3;
+    /// <summary>Bit of the slot state that is set if the slot is in the main queue</summary>
+    private: constexpr static std::uint8_t MainQueueFlag = 4;
+
+    /// <summary>Links the slots into the small and main queues</summary>
+    private: Private::SlotLinks<TSlotIndex> links;
+    /// <summary>FIFO queue newly inserted items are placed in</summary>
+    private: Private::SlotQueue<TSlotIndex> smallQueue;
+    /// <summary>FIFO queue for items that have been accessed while in the small queue</summary>
+    private: Private::SlotQueue<TSlotIndex> mainQueue;
+    /// <summary>Number of items the small queue may hold before it yields items</summary>
+    private: std::size_t smallCapacity;
+    /// <summary>Keys that were recently evicted from the small queue</summary>
+    private: Private::GhostHistory ghosts;
+    /// <summary>Access count and queue membership of each slot</summary>
+    private: std::unique_ptr<std::uint8_t[]> states;
+    /// <summary>Fingerprint of the key in each slot, added to the ghosts on eviction</summary>
+    private: std::unique_ptr<std::uint32_t[]> fingerprints;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
@@ -0,0 +1,334 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#if !defined(NUCLEX_SUPPORT_COLLECTIONS_EVICTIONPOLICIES_H)
+#error This header must be included via EvictionPolicies.h
+#endif
+
+namespace Nuclex::Support::Collections::Private {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Head and tail of a queue formed by linking slots through their indices</summary>
+  /// <typeparam name="TSlotIndex">Integer type used to refer to slots</typeparam>
+  template<typename TSlotIndex>
+  struct SlotQueue {
+
+    /// <summary>Initializes a new, empty slot queue</summary>
+    public: SlotQueue() :
+      Newest(static_cast<TSlotIndex>(-1)),
+      Oldest(static_cast<TSlotIndex>(-1)),
+      Count(0) {}
+
+    /// <summary>Index of the slot that was most recently added to the queue</summary>
+    public: TSlotIndex Newest;
+    /// <summary>Index of the slot that has been in the queue for the longest time</summary>
+    public: TSlotIndex Oldest;
+    /// <summary>Number of slots currently in the queue</summary>
+    public: std::size_t Count;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Doubly linked lists formed by slot indices stored in a single array</summary>
+  /// <typeparam name="TSlotIndex">Integer type used to refer to slots</typeparam>
+  /// <remarks>
+  ///   <para>
+  ///     Each slot can be in at most one queue at any time, so all queues of a policy
+  ///     can share a single link array. The queues themselves are just head/tail pairs
+  ///     stored by the policy.
+  ///   </para>
+  ///   <para>
+  ///     The largest value of the slot index type marks the end of a queue and the next
+  ///     smaller value marks a slot that is not linked into any queue, so the number of
+  ///     addressable slots is two less than the range of the slot index type.
+  ///   </para>
+  /// </remarks>
+  template<typename TSlotIndex>
+  class SlotLinks {
+
+    static_assert(
+      std::is_unsigned<TSlotIndex>::value && !std::is_same<TSlotIndex, bool>::value,
+      u8"Slot index type must be an unsigned integer"
+    );
+
+    /// <summary>Slot index that indicates the end of a queue</summary>
+    public: constexpr static TSlotIndex NoSlot = static_cast<TSlotIndex>(-1);
+    /// <summary>Link value that indicates the slot is not part of any queue</summary>
+    public: constexpr static TSlotIndex Unlinked = static_cast<TSlotIndex>(-2);
+
+    /// <summary>Initializes the links for the specified number of slots</summary>
+    /// <param name="slotCount">Number of slots that can be linked into queues</param>
+    public: SlotLinks(std::size_t slotCount) :
+      links(new Link[requireAddressableSlotCount(slotCount)]) {
+      for(std::size_t index = 0; index < slotCount; ++index) {
+        this->links[index].Older = Unlinked;
+      }
+    }
+
+    /// <summary>Checks whether the specified slot is linked into a queue</summary>
+    /// <param name="slotIndex">Index of the slot that will be checked</param>
+    /// <returns>True if the slot is part of a queue, false otherwise</returns>
+    public: bool IsLinked(std::size_t slotIndex) const {
+      return (this->links[slotIndex].Older != Unlinked);
+    }
+
+    /// <summary>Asks the CPU to fetch the links of a slot into its cache</summary>
+    /// <param name="slotIndex">Index of the slot whose links will be fetched</param>
+    public: void Prefetch(std::size_t slotIndex) const {
+      NUCLEX_SUPPORT_PREFETCH(this->links.get() + slotIndex);
+    }
+
+    /// <summary>Looks up the slot that was added to the queue after a slot</summary>
+    /// <param name="slotIndex">Slot whose newer neighbour will be returned</param>
+    /// <returns>The index of the newer slot or <see cref="NoSlot" /></returns>
+    public: TSlotIndex GetNewer(std::size_t slotIndex) const {
+      return this->links[slotIndex].Newer;
+    }
+
+    /// <summary>Adds a slot to a queue as its newest element</summary>
+    /// <param name="queue">Queue the slot will be added to</param>
+    /// <param name="slotIndex">Index of the slot that will be added</param>
+    public: void PushNewest(SlotQueue<TSlotIndex> &queue, std::size_t slotIndex) {
+      Link &link = this->links[slotIndex];
+      link.Older = queue.Newest;
+      link.Newer = NoSlot;
+
+      if(queue.Newest == NoSlot) {
+        queue.Oldest = static_cast<TSlotIndex>(slotIndex);
+      } else {
+        this->links[queue.Newest].Newer = static_cast<TSlotIndex>(slotIndex);
+      }
+      queue.Newest = static_cast<TSlotIndex>(slotIndex);
+      ++queue.Count;
+    }
+
+    /// <summary>Removes a slot from the queue it is linked into</summary>
+    /// <param name="queue">Queue the slot is currently linked into</param>
+    /// <param name="slotIndex">Index of the slot that will be removed</param>
+    public: void Unlink(SlotQueue<TSlotIndex> &queue, std::size_t slotIndex) {
+      Link &link = this->links[slotIndex];
+
+      if(link.Older == NoSlot) {
+        queue.Oldest = link.Newer;
+      } else {
+        this->links[link.Older].Newer = link.Newer;
+      }
+      if(link.Newer == NoSlot) {
+        queue.Newest = link.Older;
+      } else {
+        this->links[link.Newer].Older = link.Older;
+      }
+
+      link.Older = Unlinked;
+      --queue.Count;
+    }
+
+    /// <summary>Moves a slot to the newest end of the queue it is linked into</summary>
+    /// <param name="queue">Queue the slot is linked into</param>
+    /// <param name="slotIndex">Index of the slot that will be moved</param>
+    public: void MoveToNewest(SlotQueue<TSlotIndex> &queue, std::size_t slotIndex) {
+      if(queue.Newest != static_cast<TSlotIndex>(slotIndex)) {
+        Unlink(queue, slotIndex);
+        PushNewest(queue, slotIndex);
+      }
+    }
+
+    /// <summary>Unlinks all slots from a queue</summary>
+    /// <param name="queue">Queue that will be emptied</param>
+    public: void Clear(SlotQueue<TSlotIndex> &queue) {
+      TSlotIndex current = queue.Oldest;
+      while(current != NoSlot) {
+        TSlotIndex next = this->links[current].Newer;
+        this->links[current].Older = Unlinked;
+        current = next;
+      }
+      queue = SlotQueue<TSlotIndex>();
+    }
+
+    /// <summary>Invokes a callback on each slot in a queue, oldest first</summary>
+    /// <typeparam name="TCallback">Type of callback that will be invoked</typeparam>
+    /// <param name="queue">Queue whose slots will be visited</param>
+    /// <param name="callback">Callback that will be invoked for each slot</param>
+    /// <remarks>
+    ///   The callback may remove the slot it is visiting, but no other slots
+    /// </remarks>
+    public: template<typename TCallback>
+    void ForEach(const SlotQueue<TSlotIndex> &queue, TCallback &callback) const {
+      TSlotIndex current = queue.Oldest;
+      while(current != NoSlot) {
+        TSlotIndex next = this->links[current].Newer;
+        callback(static_cast<std::size_t>(current));
+        current = next;
+      }
+    }
+
+    /// <summary>Verifies that the slot count can be addressed by the slot index type</summary>
+    /// <param name="slotCount">Slot count that will be checked</param>
+    /// <returns>The unchanged slot count</returns>
+    private: static std::size_t requireAddressableSlotCount(std::size_t slotCount) {
+      if(slotCount > static_cast<std::size_t>(Unlinked)) {
+        throw std::invalid_argument(
+          reinterpret_cast<const char *>(u8"Slot count exceeds what the slot index type allows")
+        );
+      }
+      return slotCount;
+    }
+
+    #pragma region struct Link
+
+    /// <summary>Links of a single slot to its neighbours in a queue</summary>
+    private: struct Link {
+
+      /// <summary>Index of the slot added before this one, or a marker value</summary>
+      public: TSlotIndex Older;
+      /// <summary>Index of the slot added after this one</summary>
+      public: TSlotIndex Newer;
+
+    };
+
+    #pragma endregion // struct Link
+
+    /// <summary>Links of all slots</summary>
+    private: std::unique_ptr<Link[]> links;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Reduces a key hash to a well-mixed 32 bit fingerprint</summary>
+  /// <param name="hash">Hash of the key that will be reduced</param>
+  /// <returns>A 32 bit fingerprint of the key</returns>
+  inline std::uint32_t GetKeyFingerprint(std::size_t hash) {
+    std::uint64_t mixed = static_cast<std::uint64_t>(hash);
+    mixed ^= (mixed >> 33);
+    mixed *= 0xFF51AFD7ED558CCDull;
+    mixed ^= (mixed >> 33);
+    mixed *= 0xC4CEB9FE1A85EC53ull;
+    mixed ^= (mixed >> 33);
+    return static_cast<std::uint32_t>(mixed);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Remembers the fingerprints of recently evicted keys</summary>
+  /// <remarks>
+  ///   <para>
+  ///     Policies like 2Q and S3-FIFO track keys that have been evicted recently
+  ///     (so-called ghosts) and give a key that returns while it is still remembered
+  ///     a place in their main queue right away.
+  ///   </para>
+  ///   <para>
+  ///     This history is a 4-way set associative table of fingerprints stamped with
+  ///     the time at which they were added. An entry counts as remembered for as long as
+  ///     fewer than <c>capacity</c> other fingerprints have been added since. If all four
+  ///     entries of a set are taken, the oldest one is replaced, which only makes
+  ///     the history forget a little early.
+  ///   </para>
+  /// </remarks>
+  class GhostHistory {
+
+    /// <summary>Initializes a new ghost history</summary>
+    /// <param name="capacity">Number of recent fingerprints that will be remembered</param>
+    public: GhostHistory(std::size_t capacity) :
+      capacity(static_cast<std::uint32_t>(capacity < 1 ? 1 : capacity)),
+      setMask(0),
+      time(0),
+      entries() {
+      std::size_t setCount = static_cast<std::size_t>(
+        BitTricks::GetUpperPowerOfTwo(
+          (static_cast<std::uint64_t>(this->capacity) * 2 + WayCount - 1) / WayCount
+        )
+      );
+      this->setMask = setCount - 1;
+      this->entries.reset(new std::uint64_t[setCount * WayCount]);
+      Clear();
+    }
+
+    /// <summary>Remembers the specified fingerprint</summary>
+    /// <param name="fingerprint">Fingerprint of the evicted key</param>
+    public: void Add(std::uint32_t fingerprint) {
+      ++this->time;
+
+      // Pick the entry that has been in the set for the longest time. Empty entries
+      // have a time stamp of zero, which makes them look old enough to be picked, too.
+      std::uint64_t *set = getSet(fingerprint);
+      std::size_t oldestWay = 0;
+      std::uint32_t oldestAge = 0;
+      for(std::size_t way = 0; way < WayCount; ++way) {
+        std::uint32_t age = this->time - static_cast<std::uint32_t>(set[way]);
+        if(age > oldestAge) {
+          oldestAge = age;
+          oldestWay = way;
+        }
+      }
+
+      set[oldestWay] = (static_cast<std::uint64_t>(fingerprint) << 32) | this->time;
+    }
+
+    /// <summary>Checks whether a fingerprint is remembered and forgets it if so</summary>
+    /// <param name="fingerprint">Fingerprint that will be looked up</param>
+    /// <returns>True if the fingerprint was remembered, false otherwise</returns>
+    public: bool TryTake(std::uint32_t fingerprint) {
+      std::uint64_t *set = getSet(fingerprint);
+      for(std::size_t way = 0; way < WayCount; ++way) {
+        std::uint64_t &entry = set[way];
+        if(entry == 0) {
+          continue;
+        }
+        if(static_cast<std::uint32_t>(entry >> 32) == fingerprint) {
+          std::uint32_t age = this->time - static_cast<std::uint32_t>(entry);
+          entry = 0;
+          return (age < this->capacity);
+        }
+      }
+
+      return false;
+    }
+
+    /// <summary>Forgets all remembered fingerprints</summary>
+    public: void Clear() {
+      std::fill_n(this->entries.get(), (this->setMask + 1) * WayCount, std::uint64_t(0));
+    }
+
+    /// <summary>Looks up the set of entries a fingerprint is stored in</summary>
+    /// <param name="fingerprint">Fingerprint whose set will be returned</param>
+    /// <returns>The first of the entries that can hold the fingerprint</returns>
+    private: std::uint64_t *getSet(std::uint32_t fingerprint) {
+      return this->entries.get() + (fingerprint & this->setMask) * WayCount;
+    }
+
+    /// <summary>Number of entries in each set of the table</summary>
+    private: constexpr static std::size_t WayCount = 4;
+
+    /// <summary>Number of fingerprints that will be remembered</summary>
+    private: std::uint32_t capacity;
+    /// <summary>Number of sets in the table minus one, used to mask indices</summary>
+    private: std::size_t setMask;
+    /// <summary>Increases with each fingerprint added, used to stamp entries</summary>
+    private: std::uint32_t time;
+    /// <summary>Fingerprints in the upper 32 bits, time stamps in the lower 32 bits</summary>
+    private: std::unique_ptr<std::uint64_t[]> entries;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections::Private
@@ -0,0 +1,171 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#if !defined(NUCLEX_SUPPORT_COLLECTIONS_EVICTIONPOLICIES_H)
+#error This header must be included via EvictionPolicies.h
+#endif
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Keeps new items on probation in a FIFO before they can enter an LRU</summary>
+  /// <typeparam name="TSlotIndex">Unsigned integer type used to link slots</typeparam>
+  /// <remarks>
+  ///   <para>
+  ///     Implements the full 2Q algorithm by Johnson and Shasha. New items enter a FIFO
+  ///     queue (A1in) that holds about a quarter of the cache. Hits on those items do
+  ///     nothing. When an item drops out of the FIFO, its key is remembered in a ghost
+  ///     history (A1out) and if that key is inserted again while still remembered, it
+  ///     goes straight into the main LRU queue (Am).
+  ///   </para>
+  ///   <para>
+  ///     Items that are only seen once, such as those touched by a scan, therefore only
+  ///     ever compete for the FIFO and cannot flush out the main queue.
+  ///   </para>
+  /// </remarks>
+  template<typename TSlotIndex = std::size_t>
+  class TwoQueueEvictionPolicy {
+
+    /// <summary>Integer type the policy uses to refer to slots</summary>
+    public: typedef TSlotIndex SlotIndexType;
+
+    /// <summary>Whether the policy needs a hash of each key that is inserted</summary>
+    public: constexpr static bool UsesKeyHash = true;
+
+    /// <summary>Initializes a new 2Q policy for the specified number of slots</summary>
+    /// <param name="slotCount">Number of slots the policy will manage</param>
+    public: explicit TwoQueueEvictionPolicy(std::size_t slotCount) :
+      links(slotCount),
+      incomingQueue(),
+      mainQueue(),
+      incomingCapacity(slotCount >= 4 ? (slotCount / 4) : 1),
+      ghosts(slotCount / 2),
+      isInMainQueue(new bool[slotCount]),
+      fingerprints(new std::uint32_t[slotCount]) {}
+
+    /// <summary>Checks whether the policy is tracking the specified slot</summary>
+    /// <param name="slotIndex">Index of the slot that will be checked</param>
+    /// <returns>True if the slot is occupied, false otherwise</returns>
+    public: bool Contains(std::size_t slotIndex) const {
+      return this->links.IsLinked(slotIndex);
+    }
+
+    /// <summary>Asks the CPU to fetch the tracking data of a slot into its cache</summary>
+    /// <param name="slotIndex">Index of the slot that will be looked up soon</param>
+    public: void Prefetch(std::size_t slotIndex) const {
+      this->links.Prefetch(slotIndex);
+      NUCLEX_SUPPORT_PREFETCH(this->isInMainQueue.get() + slotIndex);
+    }
+
+    /// <summary>Starts tracking a newly occupied slot</summary>
+    /// <param name="slotIndex">Index of the slot that has been occupied</param>
+    /// <param name="keyHash">Hash of the key stored in the slot</param>
+    public: void Insert(std::size_t slotIndex, std::size_t keyHash) {
+      std::uint32_t fingerprint = Private::GetKeyFingerprint(keyHash);
+      this->fingerprints[slotIndex] = fingerprint;
+
+      bool wasRecentlyEvicted = this->ghosts.TryTake(fingerprint);
+      this->isInMainQueue[slotIndex] = wasRecentlyEvicted;
+      if(wasRecentlyEvicted) {
+        this->links.PushNewest(this->mainQueue, slotIndex);
+      } else {
+        this->links.PushNewest(this->incomingQueue, slotIndex);
+      }
+    }
+
+    /// <summary>Records an access to an occupied slot</summary>
+    /// <param name="slotIndex">Index of the slot that has been accessed</param>
+    public: void Touch(std::size_t slotIndex) {
+      if(this->isInMainQueue[slotIndex]) {
+        this->links.MoveToNewest(this->mainQueue, slotIndex);
+      }
+    }
+
+    /// <summary>Stops tracking a slot whose item has been removed</summary>
+    /// <param name="slotIndex">Index of the slot that has been freed</param>
+    public: void Remove(std::size_t slotIndex) {
+      if(this->isInMainQueue[slotIndex]) {
+        this->links.Unlink(this->mainQueue, slotIndex);
+      } else {
+        this->links.Unlink(this->incomingQueue, slotIndex);
+      }
+    }
+
+    /// <summary>Picks a slot to evict and stops tracking it</summary>
+    /// <returns>The index of the slot whose item should be evicted</returns>
+    public: std::size_t Evict() {
+      assert(
+        ((this->incomingQueue.Count + this->mainQueue.Count) > 0) &&
+        u8"Policy must be tracking at least one slot"
+      );
+
+      bool evictFromIncoming = (
+        (this->incomingQueue.Count > this->incomingCapacity) ||
+        (this->mainQueue.Count == 0)
+      );
+      if(evictFromIncoming) {
+        std::size_t slotIndex = this->incomingQueue.Oldest;
+        this->links.Unlink(this->incomingQueue, slotIndex);
+        this->ghosts.Add(this->fingerprints[slotIndex]);
+        return slotIndex;
+      } else {
+        std::size_t slotIndex = this->mainQueue.Oldest;
+        this->links.Unlink(this->mainQueue, slotIndex);
+        return slotIndex;
+      }
+    }
+
+    /// <summary>Stops tracking all slots</summary>
+    public: void Clear() {
+      this->links.Clear(this->incomingQueue);
+      this->links.Clear(this->mainQueue);
+      this->ghosts.Clear();
+    }
+
+    /// <summary>Invokes a callback on all tracked slots, next eviction candidates first</summary>
+    /// <typeparam name="TCallback">Type of callback that will be invoked</typeparam>
+    /// <param name="callback">Callback that will receive the index of each slot</param>
+    /// <remarks>The callback may remove the slot it is visiting, but no other slots</remarks>
+    public: template<typename TCallback>
+    void ForEach(TCallback &&callback) const {
+      this->links.ForEach(this->incomingQueue, callback);
+      this->links.ForEach(this->mainQueue, callback);
+    }
+
+    /// <summary>Links the slots into the incoming and main queues</summary>
+    private: Private::SlotLinks<TSlotIndex> links;
+    /// <summary>FIFO queue newly inserted items are placed in (A1in)</summary>
+    private: Private::SlotQueue<TSlotIndex> incomingQueue;
+    /// <summary>LRU queue for items that have proven to be reused (Am)</summary>
+    private: Private::SlotQueue<TSlotIndex> mainQueue;
+    /// <summary>Number of items the incoming queue may hold before it yields items</summary>
+    private: std::size_t incomingCapacity;
+    /// <summary>Keys that were recently evicted from the incoming queue (A1out)</summary>
+    private: Private::GhostHistory ghosts;
+    /// <summary>Whether each slot is in the main queue rather than the incoming queue</summary>
+    private: std::unique_ptr<bool[]> isInMainQueue;
+    /// <summary>Fingerprint of the key in each slot, added to the ghosts on eviction</summary>
+    private: std::unique_ptr<std::uint32_t[]> fingerprints;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
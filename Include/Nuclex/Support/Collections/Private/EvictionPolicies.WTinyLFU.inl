@@ -0,0 +1,245 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#if !defined(NUCLEX_SUPPORT_COLLECTIONS_EVICTIONPOLICIES_H)
+#error This header must be included via EvictionPolicies.h
+#endif
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Admits items into the main cache only if they are used more frequently</summary>
+  /// <typeparam name="TSlotIndex">Unsigned integer type used to link slots</typeparam>
+  /// <remarks>
+  ///   <para>
+  ///     Implements W-TinyLFU by Einziger, Friedman and Manes. New items enter a small
+  ///     LRU window holding about 1% of the cache. Items leaving the window join the
+  ///     probation segment of a segmented LRU, where a second hit promotes them into
+  ///     the protected segment (which takes up 80% of the main cache).
+  ///   </para>
+  ///   <para>
+  ///     When an item must be evicted, the newest item in the probation segment (the
+  ///     candidate that just left the window) competes against the oldest one (the
+  ///     victim the segmented LRU would pick). A <see cref="CountMinSketch" /> estimates
+  ///     how often each of them was accessed recently and only if the candidate is more
+  ///     popular than the victim does the victim get evicted in its place. This makes
+  ///     the policy very resistant to scans and one-off accesses.
+  ///   </para>
+  /// </remarks>
+  template<typename TSlotIndex = std::size_t>
+  class WindowTinyLfuEvictionPolicy {
+
+    /// <summary>Integer type the policy uses to refer to slots</summary>
+    public: typedef TSlotIndex SlotIndexType;
+
+    /// <summary>Whether the policy needs a hash of each key that is inserted</summary>
+    public: constexpr static bool UsesKeyHash = true;
+
+    /// <summary>Initializes a new W-TinyLFU policy for the specified number of slots</summary>
+    /// <param name="slotCount">Number of slots the policy will manage</param>
+    public: explicit WindowTinyLfuEvictionPolicy(std::size_t slotCount) :
+      links(slotCount),
+      windowQueue(),
+      probationQueue(),
+      protectedQueue(),
+      windowCapacity(slotCount >= 100 ? (slotCount / 100) : 1),
+      protectedCapacity(0),
+      sketch(slotCount),
+      segments(new std::uint8_t[slotCount]),
+      keyHashes(new std::size_t[slotCount]) {
+      std::size_t mainCapacity = (
+        (slotCount > this->windowCapacity) ? (slotCount - this->windowCapacity) : 0
+      );
+      this->protectedCapacity = mainCapacity * 4 / 5;
+    }
+
+    /// <summary>Checks whether the policy is tracking the specified slot</summary>
+    /// <param name="slotIndex">Index of the slot that will be checked</param>
+    /// <returns>True if the slot is occupied, false otherwise</returns>
+    public: bool Contains(std::size_t slotIndex) const {
+      return this->links.IsLinked(slotIndex);
+    }
+
+    /// <summary>Asks the CPU to fetch the tracking data of a slot into its cache</summary>
+    /// <param name="slotIndex">Index of the slot that will be looked up soon</param>
+    public: void Prefetch(std::size_t slotIndex) const {
+      this->links.Prefetch(slotIndex);
+      NUCLEX_SUPPORT_PREFETCH(this->segments.get() + slotIndex);
+      NUCLEX_SUPPORT_PREFETCH(this->keyHashes.get() + slotIndex);
+    }
+
+    /// <summary>Starts tracking a newly occupied slot</summary>
+    /// <param name="slotIndex">Index of the slot that has been occupied</param>
+    /// <param name="keyHash">Hash of the key stored in the slot</param>
+    public: void Insert(std::size_t slotIndex, std::size_t keyHash) {
+      this->sketch.Increment(keyHash);
+      this->keyHashes[slotIndex] = keyHash;
+
+      this->segments[slotIndex] = WindowSegment;
+      this->links.PushNewest(this->windowQueue, slotIndex);
+
+      // Items falling out of the window become the newest items on probation,
+      // where Evict() will pit them against the oldest item on probation
+      if(this->windowQueue.Count > this->windowCapacity) {
+        std::size_t demotedSlotIndex = this->windowQueue.Oldest;
+        this->links.Unlink(this->windowQueue, demotedSlotIndex);
+        this->segments[demotedSlotIndex] = ProbationSegment;
+        this->links.PushNewest(this->probationQueue, demotedSlotIndex);
+      }
+    }
+
+    /// <summary>Records an access to an occupied slot</summary>
+    /// <param name="slotIndex">Index of the slot that has been accessed</param>
+    public: void Touch(std::size_t slotIndex) {
+      this->sketch.Increment(this->keyHashes[slotIndex]);
+
+      switch(this->segments[slotIndex]) {
+        case WindowSegment: {
+          this->links.MoveToNewest(this->windowQueue, slotIndex);
+          break;
+        }
+        case ProbationSegment: {
+          this->links.Unlink(this->probationQueue, slotIndex);
+          this->segments[slotIndex] = ProtectedSegment;
+          this->links.PushNewest(this->protectedQueue, slotIndex);
+
+          if(this->protectedQueue.Count > this->protectedCapacity) {
+            std::size_t demotedSlotIndex = this->protectedQueue.Oldest;
+            this->links.Unlink(this->protectedQueue, demotedSlotIndex);
+            this->segments[demotedSlotIndex] = ProbationSegment;
+            this->links.PushNewest(this->probationQueue, demotedSlotIndex);
+          }
+          break;
+        }
+        default: {
+          this->links.MoveToNewest(this->protectedQueue, slotIndex);
+          break;
+        }
+      }
+    }
+
+    /// <summary>Stops tracking a slot whose item has been removed</summary>
+    /// <param name="slotIndex">Index of the slot that has been freed</param>
+    public: void Remove(std::size_t slotIndex) {
+      this->links.Unlink(getQueue(this->segments[slotIndex]), slotIndex);
+    }
+
+    /// <summary>Picks a slot to evict and stops tracking it</summary>
+    /// <returns>The index of the slot whose item should be evicted</returns>
+    public: std::size_t Evict() {
+      assert(
+        (
+          (this->windowQueue.Count + this->probationQueue.Count + this->protectedQueue.Count) > 0
+        ) && u8"Policy must be tracking at least one slot"
+      );
+
+      std::size_t slotIndex;
+      if(this->probationQueue.Count > 0) {
+        slotIndex = this->probationQueue.Oldest;
+
+        // The newest item on probation is the one that most recently left the window.
+        // It only gets to stay if it has been accessed more often than the oldest one.
+        std::size_t candidateSlotIndex = this->probationQueue.Newest;
+        if(candidateSlotIndex != slotIndex) {
+          std::uint8_t candidateFrequency = this->sketch.Estimate(
+            this->keyHashes[candidateSlotIndex]
+          );
+          std::uint8_t victimFrequency = this->sketch.Estimate(this->keyHashes[slotIndex]);
+          if(candidateFrequency <= victimFrequency) {
+            slotIndex = candidateSlotIndex;
+          }
+        }
+
+        this->links.Unlink(this->probationQueue, slotIndex);
+      } else if(this->protectedQueue.Count > 0) {
+        slotIndex = this->protectedQueue.Oldest;
+        this->links.Unlink(this->protectedQueue, slotIndex);
+      } else {
+        slotIndex = this->windowQueue.Oldest;
+        this->links.Unlink(this->windowQueue, slotIndex);
+      }
+
+      return slotIndex;
+    }
+
+    /// <summary>Stops tracking all slots</summary>
+    /// <remarks>
+    ///   The frequency sketch is kept since it describes the access pattern rather than
+    ///   the current contents of the cache
+    /// </remarks>
+    public: void Clear() {
+      this->links.Clear(this->windowQueue);
+      this->links.Clear(this->probationQueue);
+      this->links.Clear(this->protectedQueue);
+    }
+
+    /// <summary>Invokes a callback on all tracked slots, likely eviction candidates first</summary>
+    /// <typeparam name="TCallback">Type of callback that will be invoked</typeparam>
+    /// <param name="callback">Callback that will receive the index of each slot</param>
+    /// <remarks>The callback may remove the slot it is visiting, but no other slots</remarks>
+    public: template<typename TCallback>
+    void ForEach(TCallback &&callback) const {
+      this->links.ForEach(this->probationQueue, callback);
+      this->links.ForEach(this->protectedQueue, callback);
+      this->links.ForEach(this->windowQueue, callback);
+    }
+
+    /// <summary>Looks up the queue that holds the slots of a segment</summary>
+    /// <param name="segment">Segment whose queue will be returned</param>
+    /// <returns>The queue holding the slots of the specified segment</returns>
+    private: Private::SlotQueue<TSlotIndex> &getQueue(std::uint8_t segment) {
+      switch(segment) {
+        case WindowSegment: { return this->windowQueue; }
+        case ProbationSegment: { return this->probationQueue; }
+        default: { return this->protectedQueue; }
+      }
+    }
+
+    /// <summary>Segment of the cache holding the most recently inserted items</summary>
+    private: constexpr static std::uint8_t WindowSegment = 0;
+    /// <summary>Segment of the main cache holding items accessed only once there</summary>
+    private: constexpr static std::uint8_t ProbationSegment = 1;
+    /// <summary>Segment of the main cache holding items that were accessed again</summary>
+    private: constexpr static std::uint8_t ProtectedSegment = 2;
+
+    /// <summary>Links the slots into the window, probation and protected queues</summary>
+    private: Private::SlotLinks<TSlotIndex> links;
+    /// <summary>LRU queue newly inserted items are placed in</summary>
+    private: Private::SlotQueue<TSlotIndex> windowQueue;
+    /// <summary>LRU queue of items that were admitted to the main cache</summary>
+    private: Private::SlotQueue<TSlotIndex> probationQueue;
+    /// <summary>LRU queue of items in the main cache that were accessed again</summary>
+    private: Private::SlotQueue<TSlotIndex> protectedQueue;
+    /// <summary>Number of items the window may hold before it yields items</summary>
+    private: std::size_t windowCapacity;
+    /// <summary>Number of items the protected segment may hold</summary>
+    private: std::size_t protectedCapacity;
+    /// <summary>Estimates how frequently keys have been accessed recently</summary>
+    private: CountMinSketch sketch;
+    /// <summary>Segment each slot currently belongs to</summary>
+    private: std::unique_ptr<std::uint8_t[]> segments;
+    /// <summary>Hash of the key in each slot, used to query the sketch</summary>
+    private: std::unique_ptr<std::size_t[]> keyHashes;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
@@ -0,0 +1,126 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#if !defined(NUCLEX_SUPPORT_COLLECTIONS_RINGQUEUE_H) && \
+    !defined(NUCLEX_SUPPORT_COLLECTIONS_SHIFTQUEUE_H)
+#error This header must be included via RingQueue.h or ShiftQueue.h
+#endif
+
+#ifndef NUCLEX_SUPPORT_COLLECTIONS_PRIVATE_QUEUEITEMMEMORY_INL
+#define NUCLEX_SUPPORT_COLLECTIONS_PRIVATE_QUEUEITEMMEMORY_INL
+
+namespace Nuclex::Support::Collections::Private {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Memory block holding the items of a queue, obtained from an allocator</summary>
+  /// <typeparam name="TItem">Type of items the memory block is meant for</typeparam>
+  /// <typeparam name="TAllocator">Allocator that provides the memory block</typeparam>
+  /// <remarks>
+  ///   This takes the place of a std::unique_ptr&lt;std::uint8_t[]&gt;, but remembers how
+  ///   many items it was allocated for, since standard allocators need to know that
+  ///   when the memory is given back. No items are constructed or destroyed in it,
+  ///   that is up to the owning queue.
+  /// </remarks>
+  template<typename TItem, typename TAllocator>
+  class QueueItemMemory {
+
+    /// <summary>Whether the allocator can resize an existing memory block</summary>
+    /// <remarks>
+    ///   Memory is only ever resized for trivially copyable items because the allocator
+    ///   may move the block to a different address without running any constructors.
+    /// </remarks>
+    public: static const constexpr bool CanReallocate = (
+      std::is_trivially_copyable<TItem>::value &&
+      requires(TAllocator &allocator, TItem *items, std::size_t count) {
+        { allocator.reallocate(items, count, count) } -> std::same_as<TItem *>;
+      }
+    );
+
+    /// <summary>Initializes a new memory block</summary>
+    /// <param name="capacity">Number of items the memory block can hold</param>
+    /// <param name="allocator">Allocator that will provide the memory</param>
+    public: explicit QueueItemMemory(std::size_t capacity, const TAllocator &allocator) :
+      allocator(allocator),
+      items(std::allocator_traits<TAllocator>::allocate(this->allocator, capacity)),
+      capacity(capacity) {}
+
+    /// <summary>Takes over the memory block from another instance</summary>
+    /// <param name="other">Other instance whose memory block will be taken over</param>
+    public: QueueItemMemory(QueueItemMemory &&other) noexcept :
+      allocator(other.allocator),
+      items(other.items),
+      capacity(other.capacity) {
+      other.items = nullptr;
+      other.capacity = 0;
+    }
+
+    /// <summary>Gives the memory block back to the allocator</summary>
+    public: ~QueueItemMemory() {
+      if(this->items != nullptr) {
+        std::allocator_traits<TAllocator>::deallocate(this->allocator, this->items, this->capacity);
+      }
+    }
+
+    /// <summary>Returns the address of the memory block</summary>
+    /// <returns>The memory block's address or a null pointer if it was taken over</returns>
+    public: std::uint8_t *get() const noexcept {
+      return reinterpret_cast<std::uint8_t *>(this->items);
+    }
+
+    /// <summary>Returns the allocator that provided the memory block</summary>
+    /// <returns>The allocator that provided the memory block</returns>
+    public: const TAllocator &GetAllocator() const noexcept {
+      return this->allocator;
+    }
+
+    /// <summary>Exchanges the memory blocks of two instances</summary>
+    /// <param name="other">Other instance the memory block will be exchanged with</param>
+    public: void swap(QueueItemMemory &other) noexcept {
+      using std::swap;
+      swap(this->allocator, other.allocator);
+      swap(this->items, other.items);
+      swap(this->capacity, other.capacity);
+    }
+
+    /// <summary>Changes the number of items the memory block can hold</summary>
+    /// <param name="newCapacity">Number of items the memory block should hold</param>
+    /// <remarks>
+    ///   Only available if <see cref="CanReallocate" /> is true. The contents of the
+    ///   memory block are kept, but the block may end up at a different address.
+    /// </remarks>
+    public: void Reallocate(std::size_t newCapacity) requires(CanReallocate) {
+      this->items = this->allocator.reallocate(this->items, this->capacity, newCapacity);
+      this->capacity = newCapacity;
+    }
+
+    /// <summary>Allocator the memory block was obtained from</summary>
+    private: TAllocator allocator;
+    /// <summary>Address of the memory block</summary>
+    private: TItem *items;
+    /// <summary>Number of items the memory block was allocated for</summary>
+    private: std::size_t capacity;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections::Private
+
+#endif // NUCLEX_SUPPORT_COLLECTIONS_PRIVATE_QUEUEITEMMEMORY_INL
@@ -25,10 +25,15 @@ limitations under the License.
 
 #include <cstddef> // for std::size_t
 #include <cstdint> // for std::uint8_t
-#include <memory> // for std::unique_ptr
+#include <memory> // for std::allocator, std::allocator_traits
+#include <concepts> // for std::same_as
 #include <type_traits> // for std::enable_if<>
 #include <cstring> // for std::memcpy()
 #include <cassert> // for assert()
+#include <span> // for std::span
+#include <utility> // for std::pair, std::move()
+
+#include "Nuclex/Support/Collections/Private/QueueItemMemory.inl"
 
 namespace Nuclex::Support::Collections {
 
@@ -47,19 +52,35 @@ namespace Nuclex::Support::Collections {
   ///     ring buffer size (i.e. the capacity can grow, but is assumed to settle quickly)
   ///     and 2) it provides efficient batch operations.
   ///   </para>
+  ///   <para>
+  ///     Items can also be accessed in place: <see cref="Peek" /> and <see cref="Skip" />
+  ///     let a consumer work directly on the buffer's memory and <see cref="BeginWrite" />
+  ///     and <see cref="CommitWrite" /> let a producer fill it, so data can be parsed out
+  ///     of the ring without being copied into an intermediate buffer first.
+  ///   </para>
+  ///   <para>
+  ///     The memory holding the items is obtained from <typeparamref name="TAllocator" />.
+  ///     With <see cref="HugePageAllocator" />, large queues are backed by huge pages and,
+  ///     if the items are trivially copyable, grow by resizing their memory block in
+  ///     place (via mremap() on Linux) rather than copying all items to a new one.
+  ///   </para>
   /// </remarks>
-  template<typename TItem>
+  template<typename TItem, typename TAllocator = std::allocator<TItem>>
   class RingQueue {
 
+    /// <summary>Memory block the items are stored in</summary>
+    private: typedef Private::QueueItemMemory<TItem, TAllocator> ItemMemory;
+
     /// <summary>Constant used to indicate an invalid index</summary>
     private: static const std::size_t InvalidIndex = static_cast<std::size_t>(-1);
 
     /// <summary>Initializes a new ring buffer</summary>
     /// <param name="capacity">Storage space in the ring buffer at the beginning</param>
-    public: explicit RingQueue(std::size_t capacity = 256) :
-      itemMemory(
-        new std::uint8_t[sizeof(TItem[2]) * BitTricks::GetUpperPowerOfTwo(capacity) / 2]
-      ),
+    /// <param name="allocator">Allocator that will provide the ring buffer's memory</param>
+    public: explicit RingQueue(
+      std::size_t capacity = 256, const TAllocator &allocator = TAllocator()
+    ) :
+      itemMemory(BitTricks::GetUpperPowerOfTwo(capacity), allocator),
       capacity(BitTricks::GetUpperPowerOfTwo(capacity)),
       startIndex(InvalidIndex),
       endIndex(InvalidIndex) {}
@@ -67,7 +88,12 @@ namespace Nuclex::Support::Collections {
     /// <summary>Initializes a ring buffer as a copy of another ring buffer</summary>
     /// <param name="other">Other ring buffer that will be copied</param>
     public: RingQueue(const RingQueue &other) :
-      itemMemory(new std::uint8_t[sizeof(TItem[2]) * other.capacity / 2]),
+      itemMemory(
+        other.capacity,
+        std::allocator_traits<TAllocator>::select_on_container_copy_construction(
+          other.itemMemory.GetAllocator()
+        )
+      ),
       capacity(other.capacity),
       startIndex(InvalidIndex),
       endIndex(InvalidIndex) {
@@ -94,7 +120,6 @@ namespace Nuclex::Support::Collections {
       capacity(other.capacity),
       startIndex(other.startIndex),
       endIndex(other.endIndex) {
-      other.itemMemory = nullptr;
 #if !defined(NDEBUG)
       other.startIndex = InvalidIndex;
 #endif
@@ -102,7 +127,7 @@ namespace Nuclex::Support::Collections {
 
     /// <summary>Destroys the ring buffer and all items in it</summary>
     public: ~RingQueue() {
-      if(this->itemMemory != nullptr) { // Can be NULL if container donated its guts
+      if(this->itemMemory.get() != nullptr) { // Can be NULL if container donated its guts
 
         // If the buffer contains items, they, too, need to be destroyed
         if(this->startIndex != InvalidIndex) {
@@ -168,9 +193,7 @@ namespace Nuclex::Support::Collections {
       if(this->startIndex == InvalidIndex) {
         if(count > this->capacity) [[unlikely]] {
           std::size_t newCapacity = BitTricks::GetUpperPowerOfTwo(count);
-          std::unique_ptr<std::uint8_t[]> newItemMemory(
-            new std::uint8_t[sizeof(TItem[2]) * capacity / 2]
-          );
+          ItemMemory newItemMemory(newCapacity, this->itemMemory.GetAllocator());
           this->itemMemory.swap(newItemMemory);
           this->capacity = newCapacity;
         }
@@ -201,6 +224,235 @@ namespace Nuclex::Support::Collections {
       }
     }
 
+    /// <summary>Provides direct read access to the items stored in the buffer</summary>
+    /// <returns>
+    ///   Two spans that, in order, contain all items from oldest to newest. If the items
+    ///   have wrapped around the end of the buffer, the second span holds the wrapped part,
+    ///   otherwise it is empty.
+    /// </returns>
+    /// <remarks>
+    ///   The spans remain valid until the next call to any non-const method.
+    /// </remarks>
+    public: std::pair<std::span<const TItem>, std::span<const TItem>> Peek() const {
+      const TItem *items = reinterpret_cast<const TItem *>(this->itemMemory.get());
+      if(this->startIndex == InvalidIndex) {
+        return { std::span<const TItem>(), std::span<const TItem>() };
+      } else if(this->startIndex < this->endIndex) {
+        return {
+          std::span<const TItem>(items + this->startIndex, this->endIndex - this->startIndex),
+          std::span<const TItem>()
+        };
+      } else {
+        return {
+          std::span<const TItem>(items + this->startIndex, this->capacity - this->startIndex),
+          std::span<const TItem>(items, this->endIndex)
+        };
+      }
+    }
+
+    /// <summary>Removes items from the beginning of the ring buffer without reading them</summary>
+    /// <param name="count">Number of items that will be removed</param>
+    public: void Skip(std::size_t count) {
+      assert(
+        (count <= Count()) &&
+        u8"Amount of data skipped must be less or equal to the amount of data in the buffer"
+      );
+      if(count == 0) {
+        return;
+      }
+
+      TItem *items = reinterpret_cast<TItem *>(this->itemMemory.get());
+      if(this->startIndex < this->endIndex) { // Items linear
+        destroyItems(items + this->startIndex, count);
+        this->startIndex += count;
+        if(this->startIndex == this->endIndex) {
+          this->startIndex = InvalidIndex;
+#if !defined(NDEBUG)
+          this->endIndex = InvalidIndex;
+#endif
+        }
+      } else { // Items wrapped around
+        std::size_t segmentItemCount = this->capacity - this->startIndex;
+        if(count < segmentItemCount) {
+          destroyItems(items + this->startIndex, count);
+          this->startIndex += count;
+        } else {
+          destroyItems(items + this->startIndex, segmentItemCount);
+          count -= segmentItemCount;
+          destroyItems(items, count);
+          if(count == this->endIndex) {
+            this->startIndex = InvalidIndex;
+#if !defined(NDEBUG)
+            this->endIndex = InvalidIndex;
+#endif
+          } else {
+            this->startIndex = count;
+          }
+        }
+      }
+    }
+
+    /// <summary>Provides memory in which the specified number of items can be written</summary>
+    /// <param name="count">Number of items the caller wishes to write</param>
+    /// <returns>
+    ///   Two spans of uninitialized memory that together hold exactly the requested
+    ///   number of items. The second span is only non-empty if the free space wraps
+    ///   around the end of the buffer.
+    /// </returns>
+    /// <remarks>
+    ///   <para>
+    ///     The ring buffer grows if it cannot fit the requested number of items. After
+    ///     writing, call <see cref="CommitWrite" /> with the number of items that were
+    ///     actually written before calling any other non-const method.
+    ///   </para>
+    ///   <para>
+    ///     Warning! The memory is uninitialized. Items must be constructed into it via
+    ///     placement new, not assigned (unless they're std::is_trivially_copyable,
+    ///     in which case, std::memcpy() away).
+    ///   </para>
+    /// </remarks>
+    public: std::pair<std::span<TItem>, std::span<TItem>> BeginWrite(std::size_t count) {
+      std::size_t itemCount = Count();
+      if(this->capacity - itemCount < count) {
+        reallocate(itemCount + count);
+      }
+
+      TItem *items = reinterpret_cast<TItem *>(this->itemMemory.get());
+      if(this->startIndex == InvalidIndex) {
+        return { std::span<TItem>(items, count), std::span<TItem>() };
+      } else if(this->startIndex < this->endIndex) {
+        std::size_t segmentItemCount = this->capacity - this->endIndex;
+        if(count <= segmentItemCount) {
+          return { std::span<TItem>(items + this->endIndex, count), std::span<TItem>() };
+        } else {
+          return {
+            std::span<TItem>(items + this->endIndex, segmentItemCount),
+            std::span<TItem>(items, count - segmentItemCount)
+          };
+        }
+      } else {
+        return { std::span<TItem>(items + this->endIndex, count), std::span<TItem>() };
+      }
+    }
+
+    /// <summary>Appends items written via <see cref="BeginWrite" /> to the buffer</summary>
+    /// <param name="count">
+    ///   Number of items that have been constructed in the memory provided by
+    ///   <see cref="BeginWrite" />, must not exceed the number of items requested
+    /// </param>
+    /// <remarks>
+    ///   The items are expected to fill the spans returned by <see cref="BeginWrite" />
+    ///   in order, starting with the first span.
+    /// </remarks>
+    public: void CommitWrite(std::size_t count) {
+      assert(
+        (count <= this->capacity - Count()) &&
+        u8"Committed items must fit into the memory provided by BeginWrite()"
+      );
+      if(count == 0) {
+        return;
+      }
+
+      if(this->startIndex == InvalidIndex) {
+        this->startIndex = 0;
+        this->endIndex = count;
+      } else if(this->startIndex < this->endIndex) {
+        std::size_t segmentItemCount = this->capacity - this->endIndex;
+        if(count <= segmentItemCount) {
+          this->endIndex += count;
+        } else {
+          this->endIndex = count - segmentItemCount;
+        }
+      } else {
+        this->endIndex += count;
+      }
+    }
+
+    /// <summary>Destroys the specified number of items</summary>
+    /// <param name="items">Address of the first item that will be destroyed</param>
+    /// <param name="count">Number of items that will be destroyed</param>
+    private: static void destroyItems(TItem *items, std::size_t count) {
+      if constexpr(!std::is_trivially_destructible<TItem>::value) {
+        while(count > 0) {
+          items->~TItem();
+          ++items;
+          --count;
+        }
+      } else {
+        (void)items;
+        (void)count;
+      }
+    }
+
+    /// <summary>Moves all items into a larger memory block, oldest item first</summary>
+    /// <param name="requiredItemCount">Number of items the buffer needs to hold</param>
+    /// <remarks>
+    ///   Afterwards, the items are stored linearly (but if the allocator could grow
+    ///   the memory block in place, not necessarily starting at index zero). If a move
+    ///   constructor throws, the buffer keeps its old memory and items.
+    /// </remarks>
+    private: void reallocate(std::size_t requiredItemCount) {
+      std::size_t newCapacity = BitTricks::GetUpperPowerOfTwo(requiredItemCount);
+
+      // If the allocator can resize the memory block, the items stay where they are.
+      // Only the items that wrapped around to the beginning need to be moved, into
+      // the newly gained space right behind the old end of the memory block.
+      if constexpr(ItemMemory::CanReallocate) {
+        std::size_t oldCapacity = this->capacity;
+        this->itemMemory.Reallocate(newCapacity);
+        this->capacity = newCapacity;
+
+        if((this->startIndex != InvalidIndex) && (this->endIndex <= this->startIndex)) {
+          TItem *items = reinterpret_cast<TItem *>(this->itemMemory.get());
+          std::memcpy(items + oldCapacity, items, this->endIndex * sizeof(TItem));
+          this->endIndex += oldCapacity;
+        }
+
+        return;
+      }
+
+      ItemMemory newItemMemory(newCapacity, this->itemMemory.GetAllocator());
+
+      std::pair<std::span<const TItem>, std::span<const TItem>> segments = Peek();
+      std::size_t itemCount = segments.first.size() + segments.second.size();
+
+      TItem *targetItems = reinterpret_cast<TItem *>(newItemMemory.get());
+      if constexpr(std::is_trivially_copyable<TItem>::value) {
+        std::memcpy(targetItems, segments.first.data(), segments.first.size() * sizeof(TItem));
+        std::memcpy(
+          targetItems + segments.first.size(),
+          segments.second.data(),
+          segments.second.size() * sizeof(TItem)
+        );
+      } else {
+        std::size_t movedItemCount = 0;
+        try {
+          for(const TItem &item : segments.first) {
+            new(targetItems + movedItemCount) TItem(std::move(const_cast<TItem &>(item)));
+            ++movedItemCount;
+          }
+          for(const TItem &item : segments.second) {
+            new(targetItems + movedItemCount) TItem(std::move(const_cast<TItem &>(item)));
+            ++movedItemCount;
+          }
+        }
+        catch(...) {
+          destroyItems(targetItems, movedItemCount);
+          throw;
+        }
+
+        destroyItems(const_cast<TItem *>(segments.first.data()), segments.first.size());
+        destroyItems(const_cast<TItem *>(segments.second.data()), segments.second.size());
+      }
+
+      this->itemMemory.swap(newItemMemory);
+      this->capacity = newCapacity;
+      if(itemCount > 0) {
+        this->startIndex = 0;
+        this->endIndex = itemCount;
+      }
+    }
+
     /// <summary>Emplaces the specified items into an empty ring buffer</summary>
     /// <param name="sourceItems">Items that will be emplaced into the buffer</param>
     /// <param name="itemCount">Number of items that will be emplaced</param>
@@ -311,11 +563,8 @@ namespace Nuclex::Support::Collections {
         std::memcpy(targetItems, sourceItems, itemCount * sizeof(TItem));
         this->endIndex += itemCount;
       } else { // New data doesn't fit, ring buffer needs to be extended
-        std::size_t totalItemCount = this->capacity - remainingItemCount + itemCount;
-        TItem *targetItems = reallocateWhenWrapped(totalItemCount);
-        std::memcpy(targetItems, sourceItems, itemCount);
-        this->startIndex = 0;
-        this->endIndex = totalItemCount;
+        reallocate(this->capacity - remainingItemCount + itemCount);
+        emplaceInLinear(sourceItems, itemCount); // reallocate() leaves the items linear
       }
     }
 
@@ -438,11 +687,8 @@ namespace Nuclex::Support::Collections {
           targetItems = reinterpret_cast<TItem *>(this->itemMemory.get());
           std::memcpy(targetItems, sourceItems, this->endIndex * sizeof(TItem));
         } else { // New data doesn't fit, ring buffer needs to be extended
-          std::size_t totalItemCount = this->endIndex - this->startIndex + itemCount;
-          TItem *targetItems = reallocateWhenLinear(totalItemCount);
-          std::memcpy(targetItems, sourceItems, itemCount);
-          this->startIndex = 0;
-          this->endIndex = totalItemCount;
+          reallocate(this->endIndex - this->startIndex + itemCount);
+          emplaceInLinear(sourceItems, itemCount); // Now guaranteed to fit
         }
       }
     }
@@ -461,9 +707,7 @@ namespace Nuclex::Support::Collections {
       std::size_t newCapacity = BitTricks::GetUpperPowerOfTwo(requiredItemCount);
 
       // Allocate new memory for the enlarged buffer
-      std::unique_ptr<std::uint8_t[]> swappedItemMemory(
-        new std::uint8_t[sizeof(TItem[2]) * newCapacity / 2]
-      );
+      ItemMemory swappedItemMemory(newCapacity, this->itemMemory.GetAllocator());
       TItem *targetItems = reinterpret_cast<TItem *>(this->itemMemory.get());
 
       this->capacity = newCapacity;
@@ -540,49 +784,6 @@ namespace Nuclex::Support::Collections {
       return targetItems;
     }
 
-    /// <summary>Reallocates the ring buffer's memory to fit the required items</summary>
-    /// <param name="requiredItemCount">Number of items the buffer needs to hold</param>
-    /// <returns>The address at which the next item can be written</returns>
-    /// <remarks>
-    ///   Careful: this method does not update the startIndex and endIndex variables,
-    ///   as this operation is always followed by writing additional items into the buffer.
-    /// </remarks>
-    private: template<typename T = TItem>
-    typename std::enable_if<
-      std::is_trivially_destructible<T>::value && std::is_trivially_copyable<T>::value, TItem *
-    >::type reallocateWhenWrapped(std::size_t requiredItemCount) {
-      std::size_t newCapacity = BitTricks::GetUpperPowerOfTwo(requiredItemCount);
-
-      // Allocate new memory for the enlarged buffer
-      std::unique_ptr<std::uint8_t[]> newItemMemory(
-        new std::uint8_t[sizeof(TItem[2]) * newCapacity / 2]
-      );
-      TItem *targetItems = reinterpret_cast<TItem *>(newItemMemory.get());
-
-      // Copy the older segment of the existing items into the new buffer
-      {
-        TItem *existingItems = reinterpret_cast<TItem *>(this->itemMemory.get());
-        existingItems += this->endIndex;
-
-        std::size_t count = this->capacity - this->startIndex;
-        std::memcpy(targetItems, existingItems, count);
-        targetItems += count;
-      }
-
-      // Copy the newer segment of the existing items into the new buffer
-      {
-        TItem *existingItems = reinterpret_cast<TItem *>(this->itemMemory.get());
-        std::memcpy(targetItems, existingItems, this->endIndex);
-        targetItems += this->endIndex;
-      }
-
-      // Apply the changes. Note that we do not update startIndex and endIndex here.
-      this->itemMemory.swap(newItemMemory);
-      this->capacity = newCapacity;
-
-      return targetItems;
-    }
-
     /// <summary>Reallocates the ring buffer's memory to fit the required items</summary>
     /// <param name="requiredItemCount">Number of items the buffer needs to hold</param>
     /// <returns>The address at which the next item can be written</returns>
@@ -597,9 +798,7 @@ namespace Nuclex::Support::Collections {
       std::size_t newCapacity = BitTricks::GetUpperPowerOfTwo(requiredItemCount);
 
       // Allocate new memory for the enlarged buffer
-      std::unique_ptr<std::uint8_t[]> swappedItemMemory(
-        new std::uint8_t[sizeof(TItem[2]) * newCapacity / 2]
-      );
+      ItemMemory swappedItemMemory(newCapacity, this->itemMemory.GetAllocator());
       swappedItemMemory.swap(this->itemMemory);
       this->capacity = newCapacity;
 
@@ -637,42 +836,6 @@ namespace Nuclex::Support::Collections {
       return targetItems;
     }
 
-    /// <summary>Reallocates the ring buffer's memory to fit the required items</summary>
-    /// <param name="requiredItemCount">Number of items the buffer needs to hold</param>
-    /// <returns>The address at which the next item can be written</returns>
-    /// <remarks>
-    ///   Careful: this method does not update the startIndex and endIndex variables,
-    ///   as this operation is always followed by writing additional items into the buffer.
-    /// </remarks>
-    private: template<typename T = TItem>
-    typename std::enable_if<
-      std::is_trivially_destructible<T>::value && std::is_trivially_copyable<T>::value, TItem *
-    >::type reallocateWhenLinear(std::size_t requiredItemCount) {
-      std::size_t newCapacity = BitTricks::GetUpperPowerOfTwo(requiredItemCount);
-
-      // Allocate new memory for the enlarged buffer
-      std::unique_ptr<std::uint8_t[]> newItemMemory(
-        new std::uint8_t[sizeof(TItem[2]) * newCapacity / 2]
-      );
-      TItem *targetItems = reinterpret_cast<TItem *>(newItemMemory.get());
-
-      // Copy the older segment of the existing items into the new buffer
-      {
-        TItem *existingItems = reinterpret_cast<TItem *>(this->itemMemory.get());
-        existingItems += this->startIndex;
-
-        std::size_t count = this->endIndex - this->startIndex;
-        std::memcpy(targetItems, existingItems, count);
-        targetItems += count;
-      }
-
-      // Apply the changes. Note that we do not update startIndex and endIndex here.
-      this->itemMemory.swap(newItemMemory);
-      this->capacity = newCapacity;
-
-      return targetItems;
-    }
-
     /// <summary>Removes items from the beginning of the ring buffer</summary>
     /// <param name="targetItems">Buffer in which the dequeued items will be stored</param>
     /// <param name="itemCount">Number of items that will be dequeued</param>
@@ -901,7 +1064,7 @@ namespace Nuclex::Support::Collections {
     }
 
     /// <summary>Holds the items stored in the ring buffer</summary>
-    private: std::unique_ptr<std::uint8_t[]> itemMemory;
+    private: ItemMemory itemMemory;
     /// <summary>Number of items the ring buffer can currently hold</summary>
     private: std::size_t capacity;
     /// <summary>Index of the first item in the ring buffer</summary>
@@ -23,9 +23,18 @@ limitations under the License.
 #include "Nuclex/Support/Config.h"
 
 #include "Nuclex/Support/Collections/Cache.h" // for Cache
+#include "Nuclex/Support/Collections/EvictionPolicies.h" // for LruEvictionPolicy
+#include "Nuclex/Support/Collections/TimerWheel.h" // for TimerWheel
 #include "Nuclex/Support/Errors/KeyNotFoundError.h" // for KeyNotFoundError
+#include "Nuclex/Support/ScopeGuard.h" // for ON_SCOPE_EXIT_TRANSACTION
 
 #include <cstddef> // for std::byte
+#include <cstdint> // for std::uintptr_t, std::uint64_t
+#include <memory> // for std::unique_ptr
+#include <chrono> // for std::chrono::steady_clock, std::chrono::milliseconds
+#include <utility> // for std::move(), std::forward()
+#include <span> // for std::span
+#include <cassert> // for assert()
 
 namespace Nuclex::Support::Collections {
 
@@ -34,6 +43,9 @@ namespace Nuclex::Support::Collections {
   /// <summary>Caches items that can be addressed through a linear, zero-based index</summary>
   /// <typeparam name="TKey">Type of the key the cache uses, must be an integer</typeparam>
   /// <typeparam name="TValue">Type of values that are stored in the cache</typeparam>
+  /// <typeparam name="TEvictionPolicy">
+  ///   Policy that decides which items get evicted, see EvictionPolicies.h
+  /// </typeparam>
   /// <remarks>
   ///   <para>
   ///     This type of cache is ideal if you have a fixed number of items (for example,
@@ -42,14 +54,30 @@ namespace Nuclex::Support::Collections {
   ///   </para>
   ///   <para>
   ///     It keeps these items in a linear array (wherein &quot;slots&quot; can be either
-  ///     occupied or empty, just like <see cref="std.vector" />, but also maintains
-  ///     a doubly-linked MRU list between those items, preventing memory fragmentation from
-  ///     micro allocations, enabling cache-friendly searches through linear memory whilst
-  ///     offering cheap MRU functionality like evict, bring to top, get oldest).
+  ///     occupied or empty, just like <see cref="std.vector" />), preventing memory
+  ///     fragmentation from micro allocations and enabling cache-friendly searches through
+  ///     linear memory. Which item is evicted first is decided by the eviction policy,
+  ///     which tracks the slots through their indices. The default is plain LRU, but
+  ///     CLOCK, 2Q, S3-FIFO and W-TinyLFU are available, too.
+  ///   </para>
+  ///   <para>
+  ///     The policy also determines the bookkeeping overhead per slot. If you know your
+  ///     cache will never hold more than 4 billion (or 65534) slots, specify std::uint32_t
+  ///     (or std::uint16_t) as the policy's slot index type, i.e.
+  ///     <c>LruEvictionPolicy&lt;std::uint16_t&gt;</c>, to shrink the links accordingly.
+  ///   </para>
+  ///   <para>
+  ///     Items can be given a time to live, optionally renewed whenever they are accessed.
+  ///     Expired items are never returned by lookups. Their deadlines are kept in the same
+  ///     timer wheel <see cref="KeyedArrayCache" /> uses and they are removed by inserts,
+  ///     takes and <see cref="EvictExpired" />. Lookups are const and only skip over expired
+  ///     items, which keep counting towards <see cref="Count" /> until they are removed.
   ///   </para>
   /// </remarks>
-  template<typename TKey, typename TValue>
-  class SequentialSlotCache : public Cache<TKey, TValue> {
+  template<
+    typename TKey, typename TValue, typename TEvictionPolicy = LruEvictionPolicy<>
+  >
+  class SequentialSlotCache final : public Cache<TKey, TValue> {
 
     /// <summary>Initializes a new slot cache with the specified number of slots</summary>
     /// <param name="slotCount">Number of slots the cache will provide</param>
@@ -67,6 +95,26 @@ namespace Nuclex::Support::Collections {
     /// </returns>
     public: bool Insert(const TKey &key, const TValue &value) override;
 
+    /// <summary>Moves a value into the map</summary>
+    /// <param name="key">Key under which the value can be looked up later</param>
+    /// <param name="value">Value that will be moved into the map under its key</param>
+    /// <returns>
+    ///   True if the key did not exist before and was inserted,
+    ///   false if the key already existed and its value was replaced.
+    /// </returns>
+    public: bool Insert(const TKey &key, TValue &&value) override;
+
+    /// <summary>Constructs a value directly inside the cache's slot</summary>
+    /// <typeparam name="TArguments">Types of the arguments for the value's constructor</typeparam>
+    /// <param name="key">Key under which the value can be looked up later</param>
+    /// <param name="arguments">Arguments that will be passed to the value's constructor</param>
+    /// <returns>
+    ///   True if the key did not exist before and was inserted,
+    ///   false if the key already existed and its value was replaced.
+    /// </returns>
+    public: template<typename... TArguments>
+    bool Emplace(const TKey &key, TArguments &&... arguments);
+
     /// <summary>Stores a value in the map if it doesn't exist yet</summary>
     /// <param name="key">Key under which the value can be looked up later</param>
     /// <param name="value">Value that will be stored under its key in the map</param>
@@ -76,6 +124,24 @@ namespace Nuclex::Support::Collections {
     /// </returns>
     public: bool TryInsert(const TKey &key, const TValue &value) override;
 
+    /// <summary>Stores many values in the map at once</summary>
+    /// <param name="keys">Keys under which the values can be looked up later</param>
+    /// <param name="values">
+    ///   Values that will be stored under their keys, must have the same length as
+    ///   <paramref name="keys" />
+    /// </param>
+    /// <returns>The number of keys that did not exist before and were inserted</returns>
+    public: std::size_t InsertMany(std::span<const TKey> keys, std::span<const TValue> values);
+
+    /// <summary>Moves a value into the map if it doesn't exist yet</summary>
+    /// <param name="key">Key under which the value can be looked up later</param>
+    /// <param name="value">Value that will be moved into the map under its key</param>
+    /// <returns>
+    ///   True if the key did not exist before and was inserted,
+    ///   false if the key already existed and left unchanged
+    /// </returns>
+    public: bool TryInsert(const TKey &key, TValue &&value) override;
+
     /// <summary>Returns the value of the specified element in the map</summary>
     /// <param name="key">Key of the element that will be looked up</param>
     public: const TValue &Get(const TKey &key) const override;
@@ -88,6 +154,30 @@ namespace Nuclex::Support::Collections {
     /// </returns>
     public: bool TryGet(const TKey &key, TValue &value) const override;
 
+    /// <summary>Looks up an element in the map without copying its value</summary>
+    /// <param name="key">Key of the element that will be looked up</param>
+    /// <returns>
+    ///   A pointer to the element's value or a null pointer if the key didn't exist
+    /// </returns>
+    public: const TValue *TryGetPointer(const TKey &key) const override;
+
+    /// <summary>Looks up many elements in the map at once</summary>
+    /// <param name="keys">Keys of the elements that will be looked up</param>
+    /// <param name="values">
+    ///   Receives a pointer to each element's value or a null pointer if the key didn't
+    ///   exist, must have the same length as <paramref name="keys" />
+    /// </param>
+    /// <returns>The number of keys that were found</returns>
+    /// <remarks>
+    ///   The eviction policy's tracking data for all keys is prefetched before any of
+    ///   them is checked, so their cache misses overlap. Recency is updated in one pass
+    ///   after all lookups are done. Expired items are reported as missing.
+    ///   The pointers remain valid until the map is modified.
+    /// </remarks>
+    public: std::size_t TryGetMany(
+      std::span<const TKey> keys, std::span<const TValue *> values
+    ) const;
+
     /// <summary>Tries to take an element from the map (removing it)</summary>
     /// <param name="key">Key of the element that will be taken from the map</param>
     /// <param name="value">Will receive the value taken from the map</param>
@@ -129,179 +219,290 @@ namespace Nuclex::Support::Collections {
     /// <returns>True if the map had been empty during the call</returns>
     public: bool IsEmpty() const override;
 
+    /// <summary>Sets how long items remain in the cache before they expire</summary>
+    /// <param name="timeToLive">
+    ///   Time after which items expire, zero to let items live until they are evicted
+    /// </param>
+    /// <param name="renewOnAccess">
+    ///   Whether looking up an item restarts its time to live (expire-after-access)
+    ///   rather than counting from when it was inserted (expire-after-write)
+    /// </param>
+    /// <remarks>
+    ///   Items already in the cache are given the new time to live starting now.
+    ///   Time is tracked with millisecond resolution.
+    /// </remarks>
+    public: void SetTimeToLive(std::chrono::milliseconds timeToLive, bool renewOnAccess = false);
+
+    /// <summary>Removes all items whose time to live has run out</summary>
+    /// <returns>The number of items that were removed</returns>
+    public: std::size_t EvictExpired() {
+      return EvictExpired(std::chrono::steady_clock::now());
+    }
+
+    /// <summary>Removes all items that have expired by the specified time</summary>
+    /// <param name="now">Time that will be considered the current time</param>
+    /// <returns>The number of items that were removed</returns>
+    public: std::size_t EvictExpired(std::chrono::steady_clock::time_point now);
+
     //private: Cache(const Cache &) = delete;
     //private: Cache &operator =(const Cache &) = delete;
 
-    #pragma region struct SlotState
+    /// <summary>Calculates the hash the eviction policy is given for a key</summary>
+    /// <param name="key">Key whose hash will be calculated</param>
+    /// <returns>The key hash if the policy uses it, otherwise zero</returns>
+    private: static std::size_t getPolicyHash(const TKey &key) {
+      if constexpr(TEvictionPolicy::UsesKeyHash) {
+        return static_cast<std::size_t>(key);
+      } else {
+        (void)key;
+        return 0;
+      }
+    }
 
-    /// <summary>Status of a slot, including its place in the MRU list</summary>
+    /// <summary>Constructs a value in a slot if the slot is still empty</summary>
+    /// <typeparam name="TArguments">Types of the arguments for the value's constructor</typeparam>
+    /// <param name="key">Key under which the value can be looked up later</param>
+    /// <param name="arguments">Arguments that will be passed to the value's constructor</param>
+    /// <returns>True if the value was constructed, false if the slot was occupied</returns>
+    private: template<typename... TArguments>
+    bool tryEmplace(const TKey &key, TArguments &&... arguments);
+
+    /// <summary>Checks whether a slot holds an item that hasn't expired</summary>
+    /// <param name="slotIndex">Index of the slot that will be checked</param>
+    /// <param name="now">Tick that will be considered the current time</param>
+    /// <returns>True if the slot is occupied by an item that is still alive</returns>
     /// <remarks>
-    ///   The slot index is not stored separately as it can easily be obtained via pointer
-    ///   arithmetic (since the states are all stored in a single linear array)
+    ///   If items are renewed on access, the time to live of a live item is restarted.
     /// </remarks>
-    private: struct SlotState {
-
-      /// <summary>Whether this slot is occupied or empty</summary>
-      public: bool IsOccupied;
-      /// <summary>Link to the previous element in the MRU doubly linked list</summary>
-      public: SlotState *LessRecentlyUsed;
-      /// <summary>Link to the next element in the MRU doubly linked list</summary>
-      public: SlotState *MoreRecentlyUsed;
-
-    };
+    private: bool containsLive(std::size_t slotIndex, std::uint64_t now) const {
+      if(!this->policy.Contains(slotIndex)) {
+        return false;
+      }
+      if(this->expirations) {
+        if(this->expirations->GetDeadline(slotIndex) <= now) {
+          return false; // expired items are left for the non-const methods to remove
+        }
+        if(this->renewOnAccess) {
+          this->expirations->Schedule(slotIndex, now + this->timeToLiveTicks);
+        }
+      }
 
-    #pragma endregion // struct SlotState
+      return true;
+    }
 
-    /// <summary>
-    ///   Moves the specified slot state to the top of the most recently used list
-    /// </summary>
-    /// <param name="slotState">Slot that will become the most recently used</param>
-    private: void makeMostRecentlyUsed(SlotState &slotState) const; // <- in mutable state
+    /// <summary>Looks up the current tick if items can expire</summary>
+    /// <returns>The current tick or zero if items don't expire</returns>
+    private: std::uint64_t getCurrentTick() const {
+      return this->expirations ? toTick(std::chrono::steady_clock::now()) : 0;
+    }
 
-    /// <summary>Integrates the specified slot state into the most recently used list</summary>
-    /// <param name="slotState">Slot state that will be integratedf into the MRU list</param>
-    private: void linkMostRecentlyUsed(SlotState &slotState) const; // <- in mutable state
+    /// <summary>Converts a point in time into the ticks used for expiration</summary>
+    /// <param name="time">Point in time that will be converted</param>
+    /// <returns>The number of milliseconds since the steady clock's epoch</returns>
+    private: static std::uint64_t toTick(std::chrono::steady_clock::time_point time) {
+      return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count()
+      );
+    }
 
-    /// <summary>Removes the specified slot state from the most recently used list</summary>
-    /// <param name="slotState">Slot state that will be removed from the MRU list</param>
-    private: void unlinkMostRecentlyUsed(SlotState &slotState) const; // <- in mutable state
+    /// <summary>Removes all items whose deadline has passed, if items can expire</summary>
+    /// <returns>The number of items that were removed</returns>
+    private: std::size_t evictExpired() {
+      if(!this->expirations) {
+        return 0;
+      }
+      return evictExpired(toTick(std::chrono::steady_clock::now()));
+    }
 
-    /// <summary>
-    ///   Calculates the amount of memory needed for buffer holding both the slot states
-    ///   and the values that can be stored in the cache
-    /// </summary>
-    /// <param name="slotCount">Number of slots for which the memory is calculated</param>
-    /// <returns>The required memory to store slots and values with alignment</returns>
-    private: constexpr static std::size_t getRequiredMemory(std::size_t slotCount) {
-      return (
-        (sizeof(SlotState[2]) * slotCount / 2) +
-        (sizeof(TValue[2]) * slotCount / 2) +
-        (alignof(SlotState) - 1) + // for initial alignment padding if needed
-        (
-          alignof(TValue) > alignof(SlotState) ?
-            (alignof(TValue) - alignof(SlotState)) : 0
-        )
-      );
+    /// <summary>Removes all items whose deadline is at or before the specified tick</summary>
+    /// <param name="tick">Tick up to which items will be expired</param>
+    /// <returns>The number of items that were removed</returns>
+    private: std::size_t evictExpired(std::uint64_t tick);
+
+    /// <summary>Destroys the value in an occupied slot and marks the slot as free</summary>
+    /// <param name="slotIndex">Index of the slot that will be freed</param>
+    /// <remarks>The eviction policy must already have stopped tracking the slot</remarks>
+    private: void freeSlot(std::size_t slotIndex) {
+      if(this->expirations) {
+        this->expirations->Cancel(slotIndex);
+      }
+      this->values[slotIndex].~TValue();
+      --this->count;
     }
 
+    /// <summary>Number of slots the cache provides</summary>
+    private: std::size_t slotCount;
     /// <summary>Number of slots currently filled in the cache</summary>
     private: std::size_t count;
-    /// <summary>Memory allocated to store the slot states and values</summary>
+    /// <summary>Memory allocated to store the values</summary>
     private: std::byte *memory;
     /// <summary>Values stored in each of the slots</summary>
     private: TValue *values;
-    /// <summary>Keeps track of the state of each individual slot</summary>
-    private: mutable SlotState *states;
-    /// <summary>Pointer to the state of the most recently used slot</summary>
-    private: mutable SlotState *mostRecentlyUsed;
-    /// <summary>Pointer to the state of the least recently used slot</summary>
-    private: mutable SlotState *leastRecentlyUsed;
+    /// <summary>Tracks which slots are occupied and decides which to evict</summary>
+    private: mutable TEvictionPolicy policy;
+    /// <summary>Deadlines of the items, only created once a time to live is set</summary>
+    /// <remarks>
+    ///   Const lookups may push deadlines back, but expired slots are only freed
+    ///   by the methods that are allowed to modify the cache.
+    /// </remarks>
+    private: std::unique_ptr<TimerWheel> expirations;
+    /// <summary>Milliseconds items live for, only meaningful with expirations</summary>
+    private: std::uint64_t timeToLiveTicks;
+    /// <summary>Whether the time to live restarts each time an item is accessed</summary>
+    private: bool renewOnAccess;
 
   };
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  SequentialSlotCache<TKey, TValue>::SequentialSlotCache(std::size_t slotCount) :
+  template<typename TKey, typename TValue, typename TEvictionPolicy>
+  SequentialSlotCache<TKey, TValue, TEvictionPolicy>::SequentialSlotCache(
+    std::size_t slotCount
+  ) :
+    slotCount(slotCount),
     count(0),
-    memory(new std::byte[getRequiredMemory(slotCount)]),
+    memory(nullptr),
     values(),
-    states(),
-    mostRecentlyUsed(nullptr),
-    leastRecentlyUsed(nullptr) {
+    policy(slotCount),
+    expirations(),
+    timeToLiveTicks(0),
+    renewOnAccess(false) {
 
-    // Calculate the aligned memory address where slot states will be stored
+    // Allocate memory for the values with enough padding to align them properly
+    this->memory = new std::byte[(sizeof(TValue[2]) * slotCount / 2) + (alignof(TValue) - 1)];
     {
       std::size_t misalignment = (
-        reinterpret_cast<std::uintptr_t>(this->memory) % alignof(SlotState)
-      );
-      if(misalignment > 0) {
-        this->states = reinterpret_cast<SlotState *>(
-          this->memory + alignof(SlotState) - misalignment
-        );
-      } else {
-        this->states = reinterpret_cast<SlotState *>(this->memory);
-      }
-    }
-
-    // Place the values directly behind the slot state array, with alignment padding
-    // if the end of the slot state array doesn't meet the value's alignment needs.
-    {
-      std::uintptr_t valueMemory = (
-        reinterpret_cast<std::uintptr_t>(this->states) +
-        (sizeof(SlotState[2]) * slotCount / 2)
+        reinterpret_cast<std::uintptr_t>(this->memory) % alignof(TValue)
       );
-      std::size_t misalignment = valueMemory % alignof(TValue);
-
       if(misalignment > 0) {
         this->values = reinterpret_cast<TValue *>(
-          valueMemory + alignof(TValue) - misalignment
+          this->memory + alignof(TValue) - misalignment
         );
       } else {
-        this->values = reinterpret_cast<TValue *>(valueMemory);
+        this->values = reinterpret_cast<TValue *>(this->memory);
       }
     }
-
-    // Initialize all IsOccupied values to false so we don't accidentally try to destroy
-    // values that weren't present (but where the uninitialized memory in which we built
-    // the slot state array happened to have the appropriate bits set to make IsOccupied true).
-    for(std::size_t index = 0; index < slotCount; ++index) {
-      this->states[index].IsOccupied = false;
-    }
   }
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  SequentialSlotCache<TKey, TValue>::~SequentialSlotCache() {
+  template<typename TKey, typename TValue, typename TEvictionPolicy>
+  SequentialSlotCache<TKey, TValue, TEvictionPolicy>::~SequentialSlotCache() {
     Clear();
     delete[] this->memory;
   }
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  bool SequentialSlotCache<TKey, TValue>::Insert(const TKey &key, const TValue &value) {
-    SlotState &state = this->states[key];
-    if(state.IsOccupied) {
-      TValue *address = this->values + key;
+  template<typename TKey, typename TValue, typename TEvictionPolicy>
+  bool SequentialSlotCache<TKey, TValue, TEvictionPolicy>::Insert(
+    const TKey &key, const TValue &value
+  ) {
+    return Emplace(key, value);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename TEvictionPolicy>
+  bool SequentialSlotCache<TKey, TValue, TEvictionPolicy>::Insert(
+    const TKey &key, TValue &&value
+  ) {
+    return Emplace(key, std::move(value));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename TEvictionPolicy>
+  template<typename... TArguments>
+  bool SequentialSlotCache<TKey, TValue, TEvictionPolicy>::Emplace(
+    const TKey &key, TArguments &&... arguments
+  ) {
+    // An expired item still sitting in the slot must not count as existing
+    std::uint64_t now = 0;
+    if(this->expirations) {
+      now = toTick(std::chrono::steady_clock::now());
+      evictExpired(now);
+    }
+
+    std::size_t slotIndex = static_cast<std::size_t>(key);
+    if(this->policy.Contains(slotIndex)) {
+      TValue *address = this->values + slotIndex;
       address->~TValue();
-      new(address) TValue(value);
-      makeMostRecentlyUsed(state);
+
+      // If the new value's constructor throws, the slot has to be given up
+      auto abandonSlotScope = ON_SCOPE_EXIT_TRANSACTION {
+        this->policy.Remove(slotIndex);
+        if(this->expirations) {
+          this->expirations->Cancel(slotIndex);
+        }
+        --this->count;
+      };
+      new(address) TValue(std::forward<TArguments>(arguments)...);
+      abandonSlotScope.Commit();
+
+      this->policy.Touch(slotIndex);
+      if(this->expirations) {
+        this->expirations->Schedule(slotIndex, now + this->timeToLiveTicks);
+      }
       return false;
     } else {
-      new(this->values + key) TValue(value);
-      state.IsOccupied = true;
-      ++this->count;
-      linkMostRecentlyUsed(state);
-      return true;
+      return tryEmplace(key, std::forward<TArguments>(arguments)...);
     }
   }
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  bool SequentialSlotCache<TKey, TValue>::TryInsert(const TKey &key, const TValue &value) {
-    SlotState &state = this->states[key];
-    if(state.IsOccupied) {
-      return false;
-    } else {
-      new(this->values + key) TValue(value);
-      state.IsOccupied = true;
-      ++this->count;
-      linkMostRecentlyUsed(state);
-      return true;
+  template<typename TKey, typename TValue, typename TEvictionPolicy>
+  std::size_t SequentialSlotCache<TKey, TValue, TEvictionPolicy>::InsertMany(
+    std::span<const TKey> keys, std::span<const TValue> values
+  ) {
+    assert((keys.size() == values.size()) && u8"Each key must have a value");
+
+    std::size_t itemCount = keys.size();
+    for(std::size_t index = 0; index < itemCount; ++index) {
+      std::size_t slotIndex = static_cast<std::size_t>(keys[index]);
+      this->policy.Prefetch(slotIndex);
+      NUCLEX_SUPPORT_PREFETCH(this->values + slotIndex);
     }
+
+    std::size_t insertedCount = 0;
+    for(std::size_t index = 0; index < itemCount; ++index) {
+      if(Emplace(keys[index], values[index])) {
+        ++insertedCount;
+      }
+    }
+
+    return insertedCount;
   }
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  const TValue &SequentialSlotCache<TKey, TValue>::Get(const TKey &key) const {
-    SlotState &state = this->states[key];
-    if(state.IsOccupied) {
-      makeMostRecentlyUsed(state);
-      return this->values[key];
+  template<typename TKey, typename TValue, typename TEvictionPolicy>
+  bool SequentialSlotCache<TKey, TValue, TEvictionPolicy>::TryInsert(
+    const TKey &key, const TValue &value
+  ) {
+    return tryEmplace(key, value);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename TEvictionPolicy>
+  bool SequentialSlotCache<TKey, TValue, TEvictionPolicy>::TryInsert(
+    const TKey &key, TValue &&value
+  ) {
+    return tryEmplace(key, std::move(value));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename TEvictionPolicy>
+  const TValue &SequentialSlotCache<TKey, TValue, TEvictionPolicy>::Get(
+    const TKey &key
+  ) const {
+    std::size_t slotIndex = static_cast<std::size_t>(key);
+    if(containsLive(slotIndex, getCurrentTick())) {
+      this->policy.Touch(slotIndex);
+      return this->values[slotIndex];
     } else {
       throw Errors::KeyNotFoundError(
         reinterpret_cast<const char *>(u8"Requested cache slot is empty")
@@ -311,12 +512,14 @@ namespace Nuclex::Support::Collections {
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  bool SequentialSlotCache<TKey, TValue>::TryGet(const TKey &key, TValue &value) const {
-    SlotState &state = this->states[key];
-    if(state.IsOccupied) {
-      makeMostRecentlyUsed(state);
-      value = this->values[key];
+  template<typename TKey, typename TValue, typename TEvictionPolicy>
+  bool SequentialSlotCache<TKey, TValue, TEvictionPolicy>::TryGet(
+    const TKey &key, TValue &value
+  ) const {
+    std::size_t slotIndex = static_cast<std::size_t>(key);
+    if(containsLive(slotIndex, getCurrentTick())) {
+      this->policy.Touch(slotIndex);
+      value = this->values[slotIndex];
       return true;
     } else {
       return false;
@@ -325,16 +528,69 @@ namespace Nuclex::Support::Collections {
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  bool SequentialSlotCache<TKey, TValue>::TryTake(const TKey &key, TValue &value) {
-    SlotState &state = this->states[key];
-    if(state.IsOccupied) {
-      TValue *address = this->values + key;
-      value = std::move(*address);
-      address->~TValue();
-      state.IsOccupied = false;
-      unlinkMostRecentlyUsed(state);
-      --this->count;
+  template<typename TKey, typename TValue, typename TEvictionPolicy>
+  const TValue *SequentialSlotCache<TKey, TValue, TEvictionPolicy>::TryGetPointer(
+    const TKey &key
+  ) const {
+    std::size_t slotIndex = static_cast<std::size_t>(key);
+    if(containsLive(slotIndex, getCurrentTick())) {
+      this->policy.Touch(slotIndex);
+      return this->values + slotIndex;
+    } else {
+      return nullptr;
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename TEvictionPolicy>
+  std::size_t SequentialSlotCache<TKey, TValue, TEvictionPolicy>::TryGetMany(
+    std::span<const TKey> keys, std::span<const TValue *> values
+  ) const {
+    assert((keys.size() == values.size()) && u8"Each key must have a value pointer");
+
+    // Only the policy is consulted here, the values are left to the caller
+    std::size_t itemCount = keys.size();
+    for(std::size_t index = 0; index < itemCount; ++index) {
+      this->policy.Prefetch(static_cast<std::size_t>(keys[index]));
+    }
+
+    // Judge all items by the same time so the batch gives consistent results
+    std::uint64_t now = getCurrentTick();
+
+    std::size_t foundCount = 0;
+    for(std::size_t index = 0; index < itemCount; ++index) {
+      std::size_t slotIndex = static_cast<std::size_t>(keys[index]);
+      if(containsLive(slotIndex, now)) {
+        values[index] = this->values + slotIndex;
+        ++foundCount;
+      } else {
+        values[index] = nullptr;
+      }
+    }
+
+    for(std::size_t index = 0; index < itemCount; ++index) {
+      if(values[index] != nullptr) {
+        this->policy.Touch(static_cast<std::size_t>(keys[index]));
+      }
+    }
+
+    return foundCount;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename TEvictionPolicy>
+  bool SequentialSlotCache<TKey, TValue, TEvictionPolicy>::TryTake(
+    const TKey &key, TValue &value
+  ) {
+    evictExpired();
+
+    std::size_t slotIndex = static_cast<std::size_t>(key);
+    if(this->policy.Contains(slotIndex)) {
+      value = std::move(this->values[slotIndex]);
+      this->policy.Remove(slotIndex);
+      freeSlot(slotIndex);
       return true;
     } else {
       return false;
@@ -343,15 +599,12 @@ namespace Nuclex::Support::Collections {
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  bool SequentialSlotCache<TKey, TValue>::TryRemove(const TKey &key) {
-    SlotState &state = this->states[key];
-    if(state.IsOccupied) {
-      TValue *address = this->values + key;
-      address->~TValue();
-      state.IsOccupied = false;
-      unlinkMostRecentlyUsed(state);
-      --this->count;
+  template<typename TKey, typename TValue, typename TEvictionPolicy>
+  bool SequentialSlotCache<TKey, TValue, TEvictionPolicy>::TryRemove(const TKey &key) {
+    std::size_t slotIndex = static_cast<std::size_t>(key);
+    if(this->policy.Contains(slotIndex)) {
+      this->policy.Remove(slotIndex);
+      freeSlot(slotIndex);
       return true;
     } else {
       return false;
@@ -360,136 +613,148 @@ namespace Nuclex::Support::Collections {
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  void SequentialSlotCache<TKey, TValue>::Clear() {
-    SlotState *current = this->mostRecentlyUsed;
-    while(current != nullptr) {
-      std::ptrdiff_t index = current - this->states;
-
-      this->values[index].~TValue();
-      current->IsOccupied = false;
+  template<typename TKey, typename TValue, typename TEvictionPolicy>
+  void SequentialSlotCache<TKey, TValue, TEvictionPolicy>::Clear() {
+    TValue *values = this->values;
+    this->policy.ForEach(
+      [values](std::size_t slotIndex) { values[slotIndex].~TValue(); }
+    );
 
-      current = current->LessRecentlyUsed;
+    this->policy.Clear();
+    if(this->expirations) {
+      this->expirations->Clear();
     }
 
     this->count = 0;
-    this->leastRecentlyUsed = this->mostRecentlyUsed = nullptr;
   }
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  void SequentialSlotCache<TKey, TValue>::EvictDownTo(std::size_t itemCount) {
-    SlotState *current = this->leastRecentlyUsed;
-    while(current != nullptr) {
-      if(itemCount >= this->count) {
-        break;
-      }
-
-      std::ptrdiff_t index = current - this->states;
-      this->values[index].~TValue();
-      current->IsOccupied = false;
-      --this->count;
-
-      current = current->MoreRecentlyUsed;
-    }
-
-    if(current == nullptr) {
-      this->leastRecentlyUsed = this->mostRecentlyUsed = nullptr;
-    } else {
-      current->LessRecentlyUsed = nullptr;
-      this->leastRecentlyUsed = current;
+  template<typename TKey, typename TValue, typename TEvictionPolicy>
+  void SequentialSlotCache<TKey, TValue, TEvictionPolicy>::EvictDownTo(
+    std::size_t itemCount
+  ) {
+    while(this->count > itemCount) {
+      freeSlot(this->policy.Evict());
     }
   }
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  void SequentialSlotCache<TKey, TValue>::EvictWhere(
+  template<typename TKey, typename TValue, typename TEvictionPolicy>
+  void SequentialSlotCache<TKey, TValue, TEvictionPolicy>::EvictWhere(
     const Events::Delegate<bool(const TValue &)> &policyCallback
   ) {
-    SlotState *current = this->leastRecentlyUsed;
-    while(current != nullptr) {
-      std::ptrdiff_t index = current - this->states;
-
-      bool evict = policyCallback(this->values[index]);
-      if(evict) {
-        unlinkMostRecentlyUsed(*current);
-        this->values[index].~TValue();
-        current->IsOccupied = false;
-        --this->count;
+    this->policy.ForEach(
+      [this, &policyCallback](std::size_t slotIndex) {
+        bool evict = policyCallback(this->values[slotIndex]);
+        if(evict) {
+          this->policy.Remove(slotIndex);
+          freeSlot(slotIndex);
+        }
       }
-
-      current = current->MoreRecentlyUsed;
-    }
+    );
   }
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  std::size_t SequentialSlotCache<TKey, TValue>::Count() const {
+  template<typename TKey, typename TValue, typename TEvictionPolicy>
+  std::size_t SequentialSlotCache<TKey, TValue, TEvictionPolicy>::Count() const {
     return this->count;
   }
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  bool SequentialSlotCache<TKey, TValue>::IsEmpty() const {
+  template<typename TKey, typename TValue, typename TEvictionPolicy>
+  bool SequentialSlotCache<TKey, TValue, TEvictionPolicy>::IsEmpty() const {
     return (this->count == 0);
   }
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  void SequentialSlotCache<TKey, TValue>::makeMostRecentlyUsed(SlotState &slotState) const {
+  template<typename TKey, typename TValue, typename TEvictionPolicy>
+  template<typename... TArguments>
+  bool SequentialSlotCache<TKey, TValue, TEvictionPolicy>::tryEmplace(
+    const TKey &key, TArguments &&... arguments
+  ) {
+    std::uint64_t now = 0;
+    if(this->expirations) {
+      now = toTick(std::chrono::steady_clock::now());
+      evictExpired(now);
+    }
 
-    // Only do something if the slot in question isn't already the most recent used one
-    if(slotState.MoreRecentlyUsed != nullptr) {
-      slotState.MoreRecentlyUsed->LessRecentlyUsed = slotState.LessRecentlyUsed;
-      if(slotState.LessRecentlyUsed == nullptr) {
-        this->leastRecentlyUsed = slotState.MoreRecentlyUsed;
-      } else {
-        slotState.LessRecentlyUsed->MoreRecentlyUsed = slotState.MoreRecentlyUsed;
+    std::size_t slotIndex = static_cast<std::size_t>(key);
+    if(this->policy.Contains(slotIndex)) {
+      return false;
+    } else {
+      new(this->values + slotIndex) TValue(std::forward<TArguments>(arguments)...);
+      ++this->count;
+      this->policy.Insert(slotIndex, getPolicyHash(key));
+      if(this->expirations) {
+        this->expirations->Schedule(slotIndex, now + this->timeToLiveTicks);
       }
+      return true;
+    }
+  }
 
-      slotState.LessRecentlyUsed = this->mostRecentlyUsed;
-      slotState.MoreRecentlyUsed = nullptr;
-      this->mostRecentlyUsed->MoreRecentlyUsed = &slotState;
-      this->mostRecentlyUsed = &slotState;
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TKey, typename TValue, typename TEvictionPolicy>
+  void SequentialSlotCache<TKey, TValue, TEvictionPolicy>::SetTimeToLive(
+    std::chrono::milliseconds timeToLive, bool renewOnAccess /* = false */
+  ) {
+    if(timeToLive.count() <= 0) {
+      this->expirations.reset();
+      this->timeToLiveTicks = 0;
+      this->renewOnAccess = false;
+      return;
     }
 
+    std::uint64_t now = toTick(std::chrono::steady_clock::now());
+    if(!this->expirations) {
+      this->expirations.reset(new TimerWheel(this->slotCount, now));
+    }
+
+    this->timeToLiveTicks = static_cast<std::uint64_t>(timeToLive.count());
+    this->renewOnAccess = renewOnAccess;
+
+    this->policy.ForEach(
+      [this, now](std::size_t slotIndex) {
+        this->expirations->Schedule(slotIndex, now + this->timeToLiveTicks);
+      }
+    );
   }
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  void SequentialSlotCache<TKey, TValue>::linkMostRecentlyUsed(SlotState &slotState) const {
-    if(this->mostRecentlyUsed == nullptr) {
-      slotState.LessRecentlyUsed = slotState.MoreRecentlyUsed = nullptr;
-      this->leastRecentlyUsed = this->mostRecentlyUsed = &slotState;
-    } else {
-      slotState.LessRecentlyUsed = this->mostRecentlyUsed;
-      slotState.MoreRecentlyUsed = nullptr;
-      this->mostRecentlyUsed->MoreRecentlyUsed = &slotState;
-      this->mostRecentlyUsed = &slotState;
+  template<typename TKey, typename TValue, typename TEvictionPolicy>
+  std::size_t SequentialSlotCache<TKey, TValue, TEvictionPolicy>::EvictExpired(
+    std::chrono::steady_clock::time_point now
+  ) {
+    if(!this->expirations) {
+      return 0;
     }
+
+    return evictExpired(toTick(now));
   }
 
   // ------------------------------------------------------------------------------------------- //
 
-  template<typename TKey, typename TValue>
-  void SequentialSlotCache<TKey, TValue>::unlinkMostRecentlyUsed(SlotState &slotState) const {
-    if(slotState.LessRecentlyUsed == nullptr) {
-      this->leastRecentlyUsed = slotState.MoreRecentlyUsed;
-    } else {
-      slotState.LessRecentlyUsed->MoreRecentlyUsed = slotState.MoreRecentlyUsed;
-    }
-    
-    if(slotState.MoreRecentlyUsed == nullptr) {
-      this->mostRecentlyUsed = slotState.LessRecentlyUsed;
-    } else {
-      slotState.MoreRecentlyUsed->LessRecentlyUsed = slotState.LessRecentlyUsed;
-    }
+  template<typename TKey, typename TValue, typename TEvictionPolicy>
+  std::size_t SequentialSlotCache<TKey, TValue, TEvictionPolicy>::evictExpired(
+    std::uint64_t tick
+  ) {
+    std::size_t evictedCount = 0;
+    this->expirations->Advance(
+      tick,
+      [this, &evictedCount](std::size_t slotIndex) {
+        this->policy.Remove(slotIndex);
+        freeSlot(slotIndex);
+        ++evictedCount;
+      }
+    );
+
+    return evictedCount;
   }
 
   // ------------------------------------------------------------------------------------------- //
@@ -26,10 +26,14 @@ limitations under the License.
 
 #include <cstddef> // for std::size_t
 #include <cstdint> // for std::uint8_t
-#include <memory> // for std::unique_ptr
+#include <memory> // for std::allocator, std::allocator_traits
+#include <concepts> // for std::same_as
 #include <cassert> // for assert()
 #include <cstring> // for std::memcpy()
 #include <type_traits> // for std::enable_if<>
+#include <utility> // for std::swap()
+
+#include "Nuclex/Support/Collections/Private/QueueItemMemory.inl"
 
 namespace Nuclex::Support::Collections {
 
@@ -67,16 +71,26 @@ namespace Nuclex::Support::Collections {
   ///     state and not leak memory, but operations may end up applied partially,
   ///     i.e. a read may fail and return nothing, yet kill half your buffer contents.
   ///   </para>
+  ///   <para>
+  ///     The memory holding the items is obtained from <typeparamref name="TAllocator" />.
+  ///     With <see cref="HugePageAllocator" />, large queues are backed by huge pages and,
+  ///     if the items are trivially copyable, grow by resizing their memory block in
+  ///     place (via mremap() on Linux) rather than copying all items to a new one.
+  ///   </para>
   /// </remarks>
-  template<typename TItem>
+  template<typename TItem, typename TAllocator = std::allocator<TItem>>
   class ShiftQueue {
 
+    /// <summary>Memory block the items are stored in</summary>
+    private: typedef Private::QueueItemMemory<TItem, TAllocator> ItemMemory;
+
     /// <summary>Initializes a new shift queue</summary>
     /// <param name="capacity">Storage space in the shift queue at the beginning</param>
-    public: explicit ShiftQueue(std::size_t capacity = 256) :
-      itemMemory(
-        new std::uint8_t[sizeof(TItem[2]) * BitTricks::GetUpperPowerOfTwo(capacity) / 2]
-      ),
+    /// <param name="allocator">Allocator that will provide the shift queue's memory</param>
+    public: explicit ShiftQueue(
+      std::size_t capacity = 256, const TAllocator &allocator = TAllocator()
+    ) :
+      itemMemory(BitTricks::GetUpperPowerOfTwo(capacity), allocator),
       capacity(BitTricks::GetUpperPowerOfTwo(capacity)),
       startIndex(0),
       endIndex(0) {}
@@ -84,7 +98,12 @@ namespace Nuclex::Support::Collections {
     /// <summary>Initializes a shift queue as a copy of another shift queue</summary>
     /// <param name="other">Other shift queue that will be copied</param>
     public: ShiftQueue(const ShiftQueue &other) :
-      itemMemory(new std::uint8_t[sizeof(TItem[2]) * other.capacity / 2]),
+      itemMemory(
+        other.capacity,
+        std::allocator_traits<TAllocator>::select_on_container_copy_construction(
+          other.itemMemory.GetAllocator()
+        )
+      ),
       capacity(other.capacity),
       startIndex(0),
       endIndex(0) {
@@ -246,11 +265,14 @@ namespace Nuclex::Support::Collections {
           TItem *items = reinterpret_cast<TItem *>(this->itemMemory.get()) + this->startIndex;
           shiftItems(items, usedItemCount);
         } else { // No buffer resize needed, just shift the items back
-          this->capacity = BitTricks::GetUpperPowerOfTwo(this->startIndex + totalItemCount);
-          {
-            std::unique_ptr<std::uint8_t[]> newItemMemory(
-              new std::uint8_t[sizeof(TItem[2]) * this->capacity / 2]
-            );
+          std::size_t newCapacity = BitTricks::GetUpperPowerOfTwo(this->startIndex + totalItemCount);
+          if constexpr(ItemMemory::CanReallocate) {
+            this->itemMemory.Reallocate(newCapacity); // Grows behind the items, no shift
+            this->capacity = newCapacity;
+          } else {
+            this->capacity = newCapacity;
+
+            ItemMemory newItemMemory(this->capacity, this->itemMemory.GetAllocator());
             newItemMemory.swap(this->itemMemory);
 
             TItem *items = reinterpret_cast<TItem *>(newItemMemory.get()) + this->startIndex;
@@ -267,11 +289,14 @@ namespace Nuclex::Support::Collections {
         if(freeItemCount >= itemCount) [[likely]] {
           // Enough space available, no action needed
         } else {
-          this->capacity = BitTricks::GetUpperPowerOfTwo((usedItemCount + itemCount) * 2);
-          {
-            std::unique_ptr<std::uint8_t[]> newItemMemory(
-              new std::uint8_t[sizeof(TItem[2]) * this->capacity / 2]
-            );
+          std::size_t newCapacity = BitTricks::GetUpperPowerOfTwo((usedItemCount + itemCount) * 2);
+          if constexpr(ItemMemory::CanReallocate) {
+            this->itemMemory.Reallocate(newCapacity); // Grows behind the items, no shift
+            this->capacity = newCapacity;
+          } else {
+            this->capacity = newCapacity;
+
+            ItemMemory newItemMemory(this->capacity, this->itemMemory.GetAllocator());
             newItemMemory.swap(this->itemMemory);
 
             TItem *items = reinterpret_cast<TItem *>(newItemMemory.get()) + this->startIndex;
@@ -398,7 +423,9 @@ namespace Nuclex::Support::Collections {
     >::type extractItems(
       TItem *targetItems, std::size_t itemCount
     ) {
-      TItem *sourceItems = reinterpret_cast<TItem *>(this->itemMemory.get());
+      TItem *sourceItems = (
+        reinterpret_cast<TItem *>(this->itemMemory.get()) + this->startIndex
+      );
       std::memcpy(targetItems, sourceItems, itemCount * sizeof(TItem));
       this->startIndex += itemCount;
     }
@@ -514,7 +541,7 @@ namespace Nuclex::Support::Collections {
     }
 
     /// <summary>Holds the items stored in the shift queue</summary>
-    private: std::unique_ptr<std::uint8_t[]> itemMemory;
+    private: ItemMemory itemMemory;
     /// <summary>Number of items the shift queue can currently hold</summary>
     private: std::size_t capacity;
     /// <summary>Index of the first item in the shift queue</summary>
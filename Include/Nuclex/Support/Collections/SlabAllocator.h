@@ -0,0 +1,142 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_SUPPORT_COLLECTIONS_SLABALLOCATOR_H
+#define NUCLEX_SUPPORT_COLLECTIONS_SLABALLOCATOR_H
+
+#include "Nuclex/Support/Config.h"
+
+#include <cstddef> // for std::size_t
+#include <new> // for std::bad_array_new_length, std::align_val_t
+#include <limits> // for std::numeric_limits
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Hands out small memory blocks from preallocated slabs</summary>
+  /// <remarks>
+  ///   <para>
+  ///     These are the untyped allocation functions behind <see cref="SlabAllocator" />.
+  ///     Block sizes are rounded up to the next power of two from 16 up to
+  ///     <see cref="MaximumBlockSize" /> bytes. Each of these size classes carves its
+  ///     blocks from 64 KiB slabs, larger blocks are passed through to operator new.
+  ///   </para>
+  ///   <para>
+  ///     Every thread keeps up to two magazines (small stacks of free blocks) per size
+  ///     class, so allocating and freeing normally takes neither a lock nor an atomic
+  ///     operation. Only when a thread's magazines run empty or full does it trade
+  ///     a magazine with the shared depot, which is protected by a mutex. Blocks can be
+  ///     freed by any thread, not just the one that allocated them.
+  ///   </para>
+  ///   <para>
+  ///     Slabs are never given back to the operating system. Memory freed into the slab
+  ///     allocator stays available for blocks of the same size class, which is what
+  ///     you want for recurring per-frame allocations, but not for one-off bursts.
+  ///   </para>
+  /// </remarks>
+  class NUCLEX_SUPPORT_TYPE SlabMemory {
+
+    /// <summary>Largest block size that is served from the slabs</summary>
+    public: static const constexpr std::size_t MaximumBlockSize = 1024;
+
+    /// <summary>Alignment all blocks handed out by the slab allocator have</summary>
+    public: static const constexpr std::size_t BlockAlignment = 16;
+
+    /// <summary>Allocates a block of memory</summary>
+    /// <param name="byteCount">Number of bytes that will be allocated</param>
+    /// <returns>The address of the newly allocated memory block</returns>
+    public: NUCLEX_SUPPORT_API static void *Allocate(std::size_t byteCount);
+
+    /// <summary>Frees a memory block</summary>
+    /// <param name="memory">Memory block that will be freed</param>
+    /// <param name="byteCount">Size the memory block was allocated with</param>
+    public: NUCLEX_SUPPORT_API static void Free(void *memory, std::size_t byteCount) noexcept;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Standard allocator that serves small allocations from slabs</summary>
+  /// <typeparam name="T">Type of items the allocator will allocate memory for</typeparam>
+  /// <remarks>
+  ///   <para>
+  ///     Node-based containers such as std::list or std::map, and anything else that
+  ///     allocates and frees many small blocks, can use this allocator to avoid going
+  ///     through the general-purpose heap for every node.
+  ///   </para>
+  ///   <para>
+  ///     Types requiring a stricter alignment than <see cref="SlabMemory.BlockAlignment" />
+  ///     are passed through to the aligned operator new.
+  ///   </para>
+  /// </remarks>
+  template<typename T>
+  class SlabAllocator {
+
+    /// <summary>Type of values the allocator allocates memory for</summary>
+    public: typedef T value_type;
+
+    /// <summary>Initializes a new slab allocator</summary>
+    public: SlabAllocator() noexcept = default;
+
+    /// <summary>Initializes a slab allocator as a copy of another allocator</summary>
+    public: template<typename TOther>
+    SlabAllocator(const SlabAllocator<TOther> &) noexcept {}
+
+    /// <summary>Allocates memory for the specified number of items</summary>
+    /// <param name="count">Number of items memory will be allocated for</param>
+    /// <returns>The address of the allocated memory</returns>
+    public: T *allocate(std::size_t count) {
+      if(count > std::numeric_limits<std::size_t>::max() / sizeof(T)) [[unlikely]] {
+        throw std::bad_array_new_length();
+      }
+      if constexpr(alignof(T) > SlabMemory::BlockAlignment) {
+        return static_cast<T *>(
+          ::operator new(count * sizeof(T), std::align_val_t(alignof(T)))
+        );
+      } else {
+        return static_cast<T *>(SlabMemory::Allocate(count * sizeof(T)));
+      }
+    }
+
+    /// <summary>Frees memory that was allocated by the allocator</summary>
+    /// <param name="items">Memory that will be freed</param>
+    /// <param name="count">Number of items the memory was allocated for</param>
+    public: void deallocate(T *items, std::size_t count) noexcept {
+      if constexpr(alignof(T) > SlabMemory::BlockAlignment) {
+        ::operator delete(items, std::align_val_t(alignof(T)));
+        (void)count;
+      } else {
+        SlabMemory::Free(items, count * sizeof(T));
+      }
+    }
+
+    /// <summary>Checks whether two allocators can free each other's memory</summary>
+    /// <param name="other">Other allocator that will be compared</param>
+    /// <returns>Always true, any instance can free memory allocated by another</returns>
+    public: template<typename TOther>
+    bool operator ==(const SlabAllocator<TOther> &) const noexcept { return true; }
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
+
+#endif // NUCLEX_SUPPORT_COLLECTIONS_SLABALLOCATOR_H
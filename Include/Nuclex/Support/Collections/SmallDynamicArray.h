@@ -0,0 +1,381 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_SUPPORT_COLLECTIONS_SMALLDYNAMICARRAY_H
+#define NUCLEX_SUPPORT_COLLECTIONS_SMALLDYNAMICARRAY_H
+
+#include "Nuclex/Support/Config.h"
+#include "Nuclex/Support/Collections/IndexedCollection.h"
+
+#include <cstddef> // for std::size_t, std::byte
+#include <memory> // for std::allocator, std::uninitialized_copy_n()
+#include <new> // for placement new
+#include <type_traits> // for std::is_trivially_destructible
+#include <utility> // for std::move(), std::move_if_noexcept()
+#include <algorithm> // for std::move(), std::move_backward()
+#include <stdexcept> // for std::out_of_range
+#include <cassert> // for assert()
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>
+  ///   Dynamic array that stores its first few items inside itself rather than on the heap
+  /// </summary>
+  /// <typeparam name="TValue">Type of the items stored in the array</typeparam>
+  /// <typeparam name="InlineCapacity">Number of items that can be stored inline</typeparam>
+  /// <remarks>
+  ///   <para>
+  ///     Works like <see cref="DynamicArray" />, but up to <typeparamref name="InlineCapacity" />
+  ///     items are kept in a buffer that is part of the array object itself. Only when
+  ///     more items are added does the array move its items into a heap-allocated block.
+  ///     For collections that usually hold only a handful of items and are created and
+  ///     destroyed frequently, this avoids a heap allocation per collection.
+  ///   </para>
+  ///   <para>
+  ///     Once the array has moved to the heap, it stays there (even if items are removed)
+  ///     until it is destroyed. Clear() keeps the heap block, too, so an array that is
+  ///     reused will not allocate again.
+  ///   </para>
+  ///   <para>
+  ///     The inline buffer makes the array object larger by InlineCapacity items, so pick
+  ///     a capacity that covers the common case rather than the worst case. Like
+  ///     <see cref="DynamicArray" />, the class is final so direct calls can be inlined.
+  ///   </para>
+  /// </remarks>
+  template<typename TValue, std::size_t InlineCapacity = 8>
+  class SmallDynamicArray final : public IndexedCollection<TValue> {
+    static_assert(InlineCapacity > 0, "Inline capacity must be at least one item");
+
+    public: using IndexedCollection<TValue>::InvalidIndex;
+
+    /// <summary>Initializes a new small dynamic array</summary>
+    public: explicit SmallDynamicArray() :
+      items(inlineItems()),
+      count(0),
+      capacity(InlineCapacity) {}
+
+    /// <summary>Initializes a small dynamic array as a copy of another one</summary>
+    /// <param name="other">Other array whose items will be copied</param>
+    public: SmallDynamicArray(const SmallDynamicArray &other) :
+      SmallDynamicArray() {
+      Reserve(other.count);
+      std::uninitialized_copy_n(other.items, other.count, this->items);
+      this->count = other.count;
+    }
+
+    /// <summary>Initializes a small dynamic array taking over another one</summary>
+    /// <param name="other">Other array whose items will be taken over</param>
+    public: SmallDynamicArray(SmallDynamicArray &&other) :
+      SmallDynamicArray() {
+      takeOver(other);
+    }
+
+    /// <summary>Frees all memory used by the collection</summary>
+    public: virtual ~SmallDynamicArray() {
+      destroyItems(this->items, this->count);
+      if(this->items != inlineItems()) {
+        std::allocator<TValue>().deallocate(this->items, this->capacity);
+      }
+    }
+
+    /// <summary>Ensures the array can hold the specified number of items</summary>
+    /// <param name="capacity">Capacity for which memory will be reserved</param>
+    public: void Reserve(std::size_t capacity) {
+      if(capacity > this->capacity) {
+        relocate(capacity);
+      }
+    }
+
+    /// <summary>Returns the number of items the array can hold without growing</summary>
+    /// <returns>The number of items the array can currently hold</returns>
+    public: std::size_t GetCapacity() const {
+      return this->capacity;
+    }
+
+    /// <summary>Checks whether the items are still stored inside the array itself</summary>
+    /// <returns>True if no heap memory has been allocated by the array</returns>
+    public: bool IsInline() const {
+      return (this->items == inlineItems());
+    }
+
+    /// <summary>Determines the index of the specified item in the collection</summary>
+    /// <param name="value">Item whose index will be determined</param>
+    /// <returns>The index of the specified item</returns>
+    public: std::size_t GetIndexOf(const TValue &value) const override {
+      for(std::size_t index = 0; index < this->count; ++index) {
+        if(this->items[index] == value) {
+          return index;
+        }
+      }
+
+      return InvalidIndex;
+    }
+
+    /// <summary>Retrieves the item at the specified index</summary>
+    /// <param name="index">Index of the item that will be retrieved</param>
+    /// <returns>The item at the specified index</returns>
+    public: const TValue &GetAt(std::size_t index) const override {
+      requireValidIndex(index);
+      return this->items[index];
+    }
+
+    /// <summary>Accesses the item at the specified index</summary>
+    /// <param name="index">Index of the item that will be accessed</param>
+    /// <returns>The item at the specified index</returns>
+    public: TValue &GetAt(std::size_t index) override {
+      requireValidIndex(index);
+      return this->items[index];
+    }
+
+    /// <summary>Assigns the specified item to the specified index</summary>
+    /// <param name="index">Index at which the item will be stored</param>
+    /// <param name="value">Item that will be stored at the specified index</param>
+    public: void SetAt(std::size_t index, const TValue &value) override {
+      requireValidIndex(index);
+      this->items[index] = value;
+    }
+
+    /// <summary>Inserts the specified item at a specified index</summary>
+    /// <param name="index">Index at which the item will be inserted</param>
+    /// <param name="value">Item that will be inserted into the collection</param>
+    public: void InsertAt(std::size_t index, const TValue &value) override {
+      assert((index <= this->count) && u8"Insertion index must be within the array");
+
+      // The value may be one of our own items, so copy it before anything moves
+      TValue newItem(value);
+      if(this->count == this->capacity) {
+        relocate(this->capacity * 2);
+      }
+
+      if(index == this->count) {
+        new(this->items + index) TValue(std::move(newItem));
+        ++this->count;
+      } else {
+        TValue *end = this->items + this->count;
+        new(end) TValue(std::move(*(end - 1)));
+        ++this->count; // Item moved into the free slot is alive and must be counted
+        std::move_backward(this->items + index, end - 1, end);
+        this->items[index] = std::move(newItem);
+      }
+    }
+
+    /// <summary>Removes the item at the specified index from the collection</summary>
+    /// <param name="index">Index at which the item will be removed</param>
+    public: void RemoveAt(std::size_t index) override {
+      assert((index < this->count) && u8"Removal index must be within the array");
+
+      std::move(this->items + index + 1, this->items + this->count, this->items + index);
+      --this->count;
+      this->items[this->count].~TValue();
+    }
+
+    /// <summary>Adds the specified item to the collection</summary>
+    /// <param name="item">Item that will be added to the collection</param>
+    public: void Add(const TValue &item) override {
+      if(this->count == this->capacity) [[unlikely]] {
+        TValue newItem(item); // The item may be one of our own, so copy it before growing
+        relocate(this->capacity * 2);
+        new(this->items + this->count) TValue(std::move(newItem));
+      } else {
+        new(this->items + this->count) TValue(item);
+      }
+
+      ++this->count;
+    }
+
+    /// <summary>Removes the specified item from the collection</summary>
+    /// <param name="item">Item that will be removed from the collection</param>
+    /// <returns>True if the item existed in the collection and was removed</returns>
+    public: bool Remove(const TValue &item) override {
+      std::size_t index = GetIndexOf(item);
+      if(index == InvalidIndex) {
+        return false;
+      }
+
+      RemoveAt(index);
+      return true;
+    }
+
+    /// <summary>Removes all items from the collection</summary>
+    public: void Clear() override {
+      destroyItems(this->items, this->count);
+      this->count = 0;
+    }
+
+    /// <summary>Checks if the collection contains the specified item</summary>
+    /// <param name="item">Item the collection will be checked for</param>
+    /// <returns>True if the collection contain the specified item, false otherwise</returns>
+    public: bool Contains(const TValue &item) const override {
+      return (GetIndexOf(item) != InvalidIndex);
+    }
+
+    /// <summary>Counts the number of items in the collection</summary>
+    /// <returns>The number of items the collection contains</returns>
+    public: std::size_t Count() const override {
+      return this->count;
+    }
+
+    /// <summary>Checks if the collection is empty</summary>
+    /// <returns>True if the collection is empty</returns>
+    public: bool IsEmpty() const override {
+      return (this->count == 0);
+    }
+
+    /// <summary>Replaces the contents of the array with copies of another's items</summary>
+    /// <param name="other">Other array whose items will be copied</param>
+    /// <returns>The array itself</returns>
+    public: SmallDynamicArray &operator =(const SmallDynamicArray &other) {
+      if(this != &other) {
+        Clear();
+        Reserve(other.count);
+        std::uninitialized_copy_n(other.items, other.count, this->items);
+        this->count = other.count;
+      }
+
+      return *this;
+    }
+
+    /// <summary>Replaces the contents of the array with another array's items</summary>
+    /// <param name="other">Other array whose items will be taken over</param>
+    /// <returns>The array itself</returns>
+    public: SmallDynamicArray &operator =(SmallDynamicArray &&other) {
+      if(this != &other) {
+        Clear();
+        if(this->items != inlineItems()) {
+          std::allocator<TValue>().deallocate(this->items, this->capacity);
+          this->items = inlineItems();
+          this->capacity = InlineCapacity;
+        }
+        takeOver(other);
+      }
+
+      return *this;
+    }
+
+    /// <summary>Throws an exception if the specified index is out of range</summary>
+    /// <param name="index">Index that will be checked</param>
+    private: void requireValidIndex(std::size_t index) const {
+      if(index >= this->count) [[unlikely]] {
+        throw std::out_of_range(
+          reinterpret_cast<const char *>(u8"Index is outside of the array's bounds")
+        );
+      }
+    }
+
+    /// <summary>Takes over the items of another, empty or freshly constructed array</summary>
+    /// <param name="other">Other array whose items will be taken over</param>
+    /// <remarks>
+    ///   Items on the heap are taken over by grabbing the other array's memory block,
+    ///   inline items have to be moved one by one. The other array is left empty.
+    /// </remarks>
+    private: void takeOver(SmallDynamicArray &other) {
+      assert(this->IsInline() && (this->count == 0) && u8"Array must be empty and inline");
+
+      if(other.items == other.inlineItems()) {
+        std::uninitialized_move_n(other.items, other.count, this->items);
+        this->count = other.count;
+        other.Clear();
+      } else {
+        this->items = other.items;
+        this->count = other.count;
+        this->capacity = other.capacity;
+        other.items = other.inlineItems();
+        other.count = 0;
+        other.capacity = InlineCapacity;
+      }
+    }
+
+    /// <summary>Moves all items into a newly allocated heap memory block</summary>
+    /// <param name="newCapacity">Number of items the new memory block can hold</param>
+    /// <remarks>
+    ///   Items are only moved if their move constructor cannot throw, otherwise they are
+    ///   copied. If that fails, the array is left unchanged.
+    /// </remarks>
+    private: void relocate(std::size_t newCapacity) {
+      std::allocator<TValue> allocator;
+      TValue *newItems = allocator.allocate(newCapacity);
+
+      std::size_t relocatedItemCount = 0;
+      try {
+        while(relocatedItemCount < this->count) {
+          new(newItems + relocatedItemCount) TValue(
+            std::move_if_noexcept(this->items[relocatedItemCount])
+          );
+          ++relocatedItemCount;
+        }
+      }
+      catch(...) {
+        destroyItems(newItems, relocatedItemCount);
+        allocator.deallocate(newItems, newCapacity);
+        throw;
+      }
+
+      destroyItems(this->items, this->count);
+      if(this->items != inlineItems()) {
+        allocator.deallocate(this->items, this->capacity);
+      }
+
+      this->items = newItems;
+      this->capacity = newCapacity;
+    }
+
+    /// <summary>Calls the destructors of the specified items</summary>
+    /// <param name="items">First of the items that will be destroyed</param>
+    /// <param name="count">Number of items that will be destroyed</param>
+    private: static void destroyItems(TValue *items, std::size_t count) {
+      if constexpr(!std::is_trivially_destructible<TValue>::value) {
+        for(std::size_t index = 0; index < count; ++index) {
+          items[index].~TValue();
+        }
+      } else {
+        (void)items;
+        (void)count;
+      }
+    }
+
+    /// <summary>Returns the address of the inline item buffer</summary>
+    /// <returns>The address at which the inline items are stored</returns>
+    private: TValue *inlineItems() {
+      return reinterpret_cast<TValue *>(this->inlineItemMemory);
+    }
+
+    /// <summary>Returns the address of the inline item buffer</summary>
+    /// <returns>The address at which the inline items are stored</returns>
+    private: const TValue *inlineItems() const {
+      return reinterpret_cast<const TValue *>(this->inlineItemMemory);
+    }
+
+    /// <summary>Points either to the inline buffer or to a heap memory block</summary>
+    private: TValue *items;
+    /// <summary>Number of items currently stored in the array</summary>
+    private: std::size_t count;
+    /// <summary>Number of items that fit into the memory block in use</summary>
+    private: std::size_t capacity;
+    /// <summary>Memory for the items stored inside of the array itself</summary>
+    private: alignas(TValue) std::byte inlineItemMemory[sizeof(TValue) * InlineCapacity];
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
+
+#endif // NUCLEX_SUPPORT_COLLECTIONS_SMALLDYNAMICARRAY_H
@@ -0,0 +1,261 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_SUPPORT_COLLECTIONS_TIMERWHEEL_H
+#define NUCLEX_SUPPORT_COLLECTIONS_TIMERWHEEL_H
+
+#include "Nuclex/Support/Config.h"
+
+#include <cstddef> // for std::size_t
+#include <cstdint> // for std::uint64_t, std::uint32_t
+#include <memory> // for std::unique_ptr
+#include <bit> // for std::bit_width()
+#include <cassert> // for assert()
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Tracks deadlines for a fixed number of slots and reports when they pass</summary>
+  /// <remarks>
+  ///   <para>
+  ///     This is a hierarchical timing wheel: each level has 64 buckets, the lowest level
+  ///     covering one tick per bucket and each higher level covering 64 times the span of
+  ///     the level below it. A slot is placed in the bucket matching the highest part of
+  ///     its deadline that differs from the current time.
+  ///   </para>
+  ///   <para>
+  ///     When time is advanced, only the buckets the clock has moved across are visited.
+  ///     Slots whose deadline has passed are reported, all others move down into a finer
+  ///     level. Scheduling, cancelling and expiring a slot thus cost O(1) no matter how
+  ///     many slots are being tracked, and a slot is moved down at most once per level.
+  ///   </para>
+  ///   <para>
+  ///     The wheel does not care what a tick is. The caches use milliseconds.
+  ///   </para>
+  /// </remarks>
+  class NUCLEX_SUPPORT_TYPE TimerWheel {
+
+    /// <summary>Initializes a new timer wheel</summary>
+    /// <param name="slotCount">Number of slots whose deadlines can be tracked</param>
+    /// <param name="currentTick">Time at which the timer wheel starts</param>
+    public: NUCLEX_SUPPORT_API TimerWheel(std::size_t slotCount, std::uint64_t currentTick);
+
+    /// <summary>Frees all memory used by the timer wheel</summary>
+    public: NUCLEX_SUPPORT_API ~TimerWheel();
+
+    /// <summary>Retrieves the time up to which the timer wheel has been advanced</summary>
+    /// <returns>The current time of the timer wheel</returns>
+    public: std::uint64_t GetCurrentTick() const { return this->currentTick; }
+
+    /// <summary>Sets or changes the deadline of a slot</summary>
+    /// <param name="slotIndex">Index of the slot whose deadline will be set</param>
+    /// <param name="deadlineTick">Time at which the slot will expire</param>
+    /// <remarks>
+    ///   Deadlines that have already passed are reported by the next call to
+    ///   <see cref="Advance" /> that moves the time forward.
+    /// </remarks>
+    public: void Schedule(std::size_t slotIndex, std::uint64_t deadlineTick);
+
+    /// <summary>Stops tracking the deadline of a slot</summary>
+    /// <param name="slotIndex">Index of the slot whose deadline will be cancelled</param>
+    /// <remarks>Does nothing if the slot had no deadline</remarks>
+    public: void Cancel(std::size_t slotIndex);
+
+    /// <summary>Checks whether a deadline is tracked for the specified slot</summary>
+    /// <param name="slotIndex">Index of the slot that will be checked</param>
+    /// <returns>True if the slot has a deadline</returns>
+    public: bool IsScheduled(std::size_t slotIndex) const {
+      return (this->links[slotIndex].Next != Unscheduled);
+    }
+
+    /// <summary>Looks up the deadline of a scheduled slot</summary>
+    /// <param name="slotIndex">Index of the slot whose deadline will be looked up</param>
+    /// <returns>The time at which the slot will expire</returns>
+    public: std::uint64_t GetDeadline(std::size_t slotIndex) const {
+      return this->deadlines[slotIndex];
+    }
+
+    /// <summary>Moves the time forward and reports all slots whose deadline passed</summary>
+    /// <typeparam name="TCallback">Callable that receives the index of an expired slot</typeparam>
+    /// <param name="tick">Time to which the timer wheel will be advanced</param>
+    /// <param name="expired">Callback invoked for each slot whose deadline has passed</param>
+    /// <remarks>
+    ///   Expired slots are no longer scheduled when the callback is invoked, so the callback
+    ///   can free or reschedule them. Times earlier than the current time are ignored.
+    /// </remarks>
+    public: template<typename TCallback>
+    void Advance(std::uint64_t tick, TCallback &&expired);
+
+    /// <summary>Cancels the deadlines of all slots</summary>
+    public: NUCLEX_SUPPORT_API void Clear();
+
+    /// <summary>Inserts a slot into the bucket matching its deadline</summary>
+    /// <param name="slotIndex">Index of the slot that will be placed</param>
+    private: void place(std::size_t slotIndex);
+
+    /// <summary>Removes a scheduled slot from the bucket it is in</summary>
+    /// <param name="slotIndex">Index of the slot that will be removed</param>
+    private: void unlink(std::size_t slotIndex);
+
+    /// <summary>Number of bits of the time each level of the wheel covers</summary>
+    private: constexpr static unsigned int BitsPerLevel = 6;
+    /// <summary>Number of buckets in each level of the wheel</summary>
+    private: constexpr static std::size_t BucketsPerLevel = std::size_t(1) << BitsPerLevel;
+    /// <summary>Number of levels needed to cover a full 64 bit time range</summary>
+    private: constexpr static std::size_t LevelCount = (64 + BitsPerLevel - 1) / BitsPerLevel;
+    /// <summary>Marks a slot whose deadline is not being tracked</summary>
+    private: constexpr static std::uint32_t Unscheduled = std::uint32_t(-1);
+
+    #pragma region struct Link
+
+    /// <summary>Links a slot or bucket head to its neighbours in a bucket's list</summary>
+    private: struct Link {
+
+      /// <summary>Slot or bucket head following this one in the circular list</summary>
+      public: std::uint32_t Next;
+      /// <summary>Slot or bucket head preceding this one in the circular list</summary>
+      public: std::uint32_t Previous;
+
+    };
+
+    #pragma endregion // struct Link
+
+    /// <summary>Number of slots whose deadlines can be tracked</summary>
+    private: std::size_t slotCount;
+    /// <summary>Time up to which the timer wheel has been advanced</summary>
+    private: std::uint64_t currentTick;
+    /// <summary>Links of all slots followed by the heads of all buckets</summary>
+    private: std::unique_ptr<Link[]> links;
+    /// <summary>Deadline of each slot, only meaningful while the slot is scheduled</summary>
+    private: std::unique_ptr<std::uint64_t[]> deadlines;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline void TimerWheel::Schedule(std::size_t slotIndex, std::uint64_t deadlineTick) {
+    if(IsScheduled(slotIndex)) {
+      unlink(slotIndex);
+    }
+
+    this->deadlines[slotIndex] = deadlineTick;
+    place(slotIndex);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline void TimerWheel::Cancel(std::size_t slotIndex) {
+    if(IsScheduled(slotIndex)) {
+      unlink(slotIndex);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  template<typename TCallback>
+  void TimerWheel::Advance(std::uint64_t tick, TCallback &&expired) {
+    if(tick <= this->currentTick) {
+      return;
+    }
+
+    std::uint64_t previousTick = this->currentTick;
+    this->currentTick = tick;
+
+    // Each level only needs to be visited if the clock moved across one of its buckets.
+    // Once a level's bucket is unchanged, all coarser levels are unchanged, too.
+    for(std::size_t level = 0; level < LevelCount; ++level) {
+      unsigned int shift = static_cast<unsigned int>(level) * BitsPerLevel;
+      std::uint64_t previousBucket = previousTick >> shift;
+      std::uint64_t currentBucket = tick >> shift;
+      if(currentBucket == previousBucket) {
+        break;
+      }
+
+      std::uint64_t bucketCount = currentBucket - previousBucket;
+      if(bucketCount > BucketsPerLevel) {
+        bucketCount = BucketsPerLevel;
+      }
+
+      // Every slot in a bucket the clock moved across has either expired or
+      // belongs in a finer level now, so each bucket is emptied completely.
+      for(std::uint64_t step = 1; step <= bucketCount; ++step) {
+        std::size_t head = (
+          this->slotCount +
+          level * BucketsPerLevel +
+          static_cast<std::size_t>((previousBucket + step) & (BucketsPerLevel - 1))
+        );
+        while(this->links[head].Next != head) {
+          std::size_t slotIndex = this->links[head].Next;
+          unlink(slotIndex);
+          if(this->deadlines[slotIndex] <= tick) {
+            expired(slotIndex);
+          } else {
+            place(slotIndex);
+          }
+        }
+      }
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline void TimerWheel::place(std::size_t slotIndex) {
+    std::uint64_t deadline = this->deadlines[slotIndex];
+    if(deadline <= this->currentTick) {
+      deadline = this->currentTick + 1; // overdue, report on the next advance
+    }
+
+    // The level is decided by the highest bit in which deadline and current time differ
+    unsigned int highestDifferentBit = static_cast<unsigned int>(
+      std::bit_width(deadline ^ this->currentTick) - 1
+    );
+    std::size_t level = highestDifferentBit / BitsPerLevel;
+    std::size_t head = (
+      this->slotCount +
+      level * BucketsPerLevel +
+      static_cast<std::size_t>(
+        (deadline >> (level * BitsPerLevel)) & (BucketsPerLevel - 1)
+      )
+    );
+
+    // Append the slot at the end of the bucket's circular list
+    std::uint32_t tail = this->links[head].Previous;
+    this->links[slotIndex].Next = static_cast<std::uint32_t>(head);
+    this->links[slotIndex].Previous = tail;
+    this->links[tail].Next = static_cast<std::uint32_t>(slotIndex);
+    this->links[head].Previous = static_cast<std::uint32_t>(slotIndex);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  inline void TimerWheel::unlink(std::size_t slotIndex) {
+    assert(IsScheduled(slotIndex) && u8"Only scheduled slots can be unlinked");
+
+    Link &link = this->links[slotIndex];
+    this->links[link.Previous].Next = link.Next;
+    this->links[link.Next].Previous = link.Previous;
+    link.Next = Unscheduled;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
+
+#endif // NUCLEX_SUPPORT_COLLECTIONS_TIMERWHEEL_H
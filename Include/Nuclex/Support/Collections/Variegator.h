@@ -20,14 +20,14 @@ limitations under the License.
 #ifndef NUCLEX_SUPPORT_COLLECTIONS_VARIEGATOR_H
 #define NUCLEX_SUPPORT_COLLECTIONS_VARIEGATOR_H
 
-#if 0 // It's broken, will fix it or remove it at an indeterminate point
+#include "Nuclex/Support/Config.h"
 
 #include <cstddef> // for std::size_t
 #include <random> // for std::default_random_engine, std::uniform_int_distribution
-
 #include <vector> // for std::vector
-#include <unordered_set> // for std::unordered_set
-#include <unordered_map> // for std::unordered_map
+#include <algorithm> // for std::lower_bound()
+#include <iterator> // for std::advance()
+#include <stdexcept> // for std::runtime_error
 
 namespace Nuclex::Support::Collections {
 
@@ -36,7 +36,6 @@ namespace Nuclex::Support::Collections {
   /// <summary>Randomly selects between different options, trying to avoid repetition</summary>
   /// <typeparam name="TKey">Type of keys through which values can be looked up</typeparam>
   /// <typeparam name="TValue">Type of values provided by the variegator</typeparam>
-  /// <typeparam name="TValueAllocator">Allocator used to reserve memory for values</typeparam>
   /// <remarks>
   ///   <para>
   ///     This class is useful wherever randomness is involved in a game: picking random
@@ -56,8 +55,17 @@ namespace Nuclex::Support::Collections {
   ///     Other NPCs requesting dialogue lines for the same situation would receive different
   ///     random commentary for as long as long as available data allows.
   ///   </para>
+  ///   <para>
+  ///     Keys are kept in a sorted array (so they need an operator &lt;) and the values of
+  ///     each key sit next to each other in a second array. Each value slot remembers when
+  ///     it was last handed out, which lets <see cref="Get" /> skip recently used values
+  ///     without any allocations and in time proportional to the number of candidates.
+  ///     Inserting is comparatively slow, the variegator is meant to be filled once and
+  ///     then queried many times. Values are returned by reference so that looking them
+  ///     up doesn't copy them, the references stay valid until the next Insert() or Clear().
+  ///   </para>
   /// </remarks>
-  template<typename TKey, typename TValue, typename TValueAllocator = std::allocator<TValue>>
+  template<typename TKey, typename TValue>
   class Variegator {
 
     /// <summary>Initializes a new variegator</summary>
@@ -65,16 +73,13 @@ namespace Nuclex::Support::Collections {
     ///   How far into the past the variegator will look to avoid repetition
     /// </param>
     public: Variegator(std::size_t historyLength = 64) :
+      keys(),
+      rangeEndIndices(),
+      values(),
+      lastUses(),
+      randomNumberGenerator(),
       historyLength(historyLength),
-      historyFull(false),
-      historyTailIndex(0),
-      history(this->valueAllocator.allocate(historyLength)) {}
-
-    /// <summary>Destroys the variegator and reclaims all memory</summary>
-    public: ~Variegator() {
-      freeHistory();
-      this->valueAllocator.deallocate(this->history, this->historyLength);
-    }
+      useCount(0) {}
 
     /// <summary>Removes all entries from the variegator</summary>
     /// <remarks>
@@ -83,11 +88,11 @@ namespace Nuclex::Support::Collections {
     ///   reclaim memory.
     /// </remarks>
     public: void Clear() {
+      this->keys.clear();
+      this->rangeEndIndices.clear();
       this->values.clear();
-
-      freeHistory();
-      this->historyFull = false;
-      this->historyTailIndex = 0;
+      this->lastUses.clear();
+      this->useCount = 0;
     }
 
     /// <summary>Checks whether the variegator is empty</summary>
@@ -113,50 +118,56 @@ namespace Nuclex::Support::Collections {
     /// <param name="key">Key of the value that will be inserted</param>
     /// <param name="value">Value that will be inserted under the provided key</param>
     public: void Insert(const TKey &key, const TValue &value) {
-      this->values.insert(ValueMap::value_type(key, value));
+      typename std::vector<TKey>::iterator keyIterator = std::lower_bound(
+        this->keys.begin(), this->keys.end(), key
+      );
+      std::size_t keyIndex = keyIterator - this->keys.begin();
+
+      // If the key is new, add an empty value range for it
+      if((keyIterator == this->keys.end()) || (key < *keyIterator)) {
+        std::size_t rangeStartIndex = getRangeStartIndex(keyIndex);
+        this->keys.insert(keyIterator, key);
+        this->rangeEndIndices.insert(
+          this->rangeEndIndices.begin() + keyIndex, rangeStartIndex
+        );
+      }
+
+      // Append the value to the key's range, shifting the ranges of all later keys
+      std::size_t valueIndex = this->rangeEndIndices[keyIndex];
+      this->values.insert(this->values.begin() + valueIndex, value);
+      this->lastUses.insert(this->lastUses.begin() + valueIndex, NeverUsed);
+
+      std::size_t keyCount = this->keys.size();
+      for(std::size_t index = keyIndex; index < keyCount; ++index) {
+        ++this->rangeEndIndices[index];
+      }
     }
 
     /// <summary>Retrieves a random value associated with the specified key</summary>
     /// <param name="key">For for which a value will be looked up</param>
     /// <returns>A random value associated with the specified key</returns>
-    public: TValue Get(const TKey &key) const {
+    public: const TValue &Get(const TKey &key) const {
       return Get(&key, std::size_t(1));
     }
 
     /// <summary>Retrieves a random value associated with one of the specified keys</summary>
     /// <param name="first">First key in a list of keys that will be considered</param>
     /// <param name="count">Number of keys following the first key in the list</param>
+    /// <returns>A random value associated with one of the specified keys</returns>
     /// <remarks>
     ///   In many cases, you have generic situations (such as 'detected-player-stealing',
     ///   'observed-hostile-action') and specified situations (such as
     ///   'detected-player-stealing-from-beggar', 'observed-hostile-action-on-cop')
     ///   where a values from both pools should be considered. This method allows you
     ///   to specify any number of keys, creating a greater set of values the variegator
-    ///   can pick between.
+    ///   can pick between. The list of keys is walked twice.
     /// </remarks>
-    public: template<typename TInputIterator> TValue Get(
-      TInputIterator first, std::size_t count = 1
+    public: template<typename TForwardIterator> const TValue &Get(
+      TForwardIterator first, std::size_t count = 1
     ) const {
-      std::unordered_set<TValue> candidates;
-
-      while(count > 0) {
-        std::pair<ValueMap::const_iterator, ValueMap::const_iterator> valueRange =
-          this->values.equal_range(*first);
-
-        // Add all candidate values into our set. Could do this via std::copy() with
-        // std::inserter(), but it yields the same amount of code and adds a header dependency
-        while(valueRange.first != valueRange.second) {
-          candidates.insert(valueRange.first->second);
-          ++valueRange.first;
-        }
-
-        ++first;
-        --count;
-      }
-
-      TValue result = destructivePickCandidateValue(candidates);
-      addRecentlyUsedValue(result);
-      return result;
+      TForwardIterator onePastLast = first;
+      std::advance(onePastLast, count);
+      return Get(first, onePastLast);
     }
 
     /// <summary>Retrieves a random value associated with one of the specified keys</summary>
@@ -164,177 +175,143 @@ namespace Nuclex::Support::Collections {
     /// <param name="onePastLast">
     ///   Iterator past the last in the list of keys that will be considered
     /// </param>
+    /// <returns>A random value associated with one of the specified keys</returns>
     /// <remarks>
     ///   In many cases, you have generic situations (such as 'detected-player-stealing',
     ///   'observed-hostile-action') and specific situations (such as
     ///   'detected-player-stealing-from-beggar', 'observed-hostile-action-on-cop')
     ///   where a values from both pools should be considered. This method allows you
     ///   to specify any number of keys, creating a greater set of values the variegator
-    ///   can pick between.
+    ///   can pick between. The list of keys is walked twice.
     /// </remarks>
-    public: template<typename TInputIterator> TValue Get(
-      TInputIterator first, TInputIterator onePastLast
+    public: template<typename TForwardIterator> const TValue &Get(
+      TForwardIterator first, TForwardIterator onePastLast
     ) const {
-      std::unordered_set<TValue> candidates;
-
-      while(first != onePastLast) {
-        std::pair<ValueMap::const_iterator, ValueMap::const_iterator> valueRange =
-          this->values.equal_range(*first);
-
-        // Add all candidate values into our set. Could do this via std::copy() with
-        // std::inserter(), but it yields the same amount of code and adds a header dependency
-        while(valueRange.first != valueRange.second) {
-          candidates.insert(valueRange.first->second);
-          ++valueRange.first;
+      ++this->useCount;
+
+      // Count the candidates that have not been handed out recently. Should all of
+      // them have been used recently, remember the one used longest ago instead.
+      std::size_t freshCount = 0;
+      std::size_t stalestIndex = NoCandidate;
+      for(TForwardIterator key = first; key != onePastLast; ++key) {
+        std::size_t endIndex;
+        for(std::size_t index = findRange(*key, endIndex); index < endIndex; ++index) {
+          if(isRecentlyUsed(index)) {
+            if(
+              (stalestIndex == NoCandidate) ||
+              (this->lastUses[index] < this->lastUses[stalestIndex])
+            ) {
+              stalestIndex = index;
+            }
+          } else {
+            ++freshCount;
+          }
         }
-
-        ++first;
       }
 
-      TValue result = destructivePickCandidateValue(candidates);
-      addRecentlyUsedValue(result);
-      return result;
-    }
-
-    /// <summary>Picks amongst the values in a set</summary>
-    /// <param name="candidates">
-    ///   Set containing the candidats values to consider. Will be destroyed.
-    /// </param>
-    /// <returns>The least recently used candidate value or a random one</returns>
-    private: TValue destructivePickCandidateValue(std::unordered_set<TValue> &candidates) const {
-      //removeRuleDeviatingValues(candidates);
-      removeRecentlyUsedValues(candidates);
-
-      switch(candidates.size()) {
-        case 0: {
+      std::size_t pickedIndex;
+      if(freshCount == 0) {
+        if(stalestIndex == NoCandidate) {
+          --this->useCount;
           throw std::runtime_error(
             reinterpret_cast<const char *>(u8"No values mapped to specified key")
           );
         }
-        case 1: {
-          return *candidates.begin();
-        }
-        default: {
-          std::uniform_int_distribution<std::size_t> distributor(0, candidates.size() - 1);
-          std::size_t index = distributor(this->randomNumberGenerator);
-
-          std::unordered_set<TValue>::const_iterator iterator = candidates.begin();
-          while(index > 0) {
-            ++iterator;
-            --index;
-          }
-
-          return *iterator;
-        }
-      }
-    }
-
-    /// <summary>Adds a recently used value to the history</summary>
-    /// <param name="value">Value that will be added to the history</param>
-    private: void addRecentlyUsedValue(const TValue &value) const {
-      if(this->historyTailIndex == this->historyLength) {
-        this->historyFull = true;
-        this->history[0] = value;
-        this->historyTailIndex = 1;
-      } else if(this->historyFull) {
-        this->history[this->historyTailIndex] = value;
-        ++this->historyTailIndex;
+        pickedIndex = stalestIndex;
       } else {
-        this->valueAllocator.construct(this->history + this->historyTailIndex, value);
-        ++this->historyTailIndex;
+        std::uniform_int_distribution<std::size_t> distributor(0, freshCount - 1);
+        pickedIndex = findFreshCandidate(
+          first, onePastLast, distributor(this->randomNumberGenerator)
+        );
       }
-    }
 
-    /// <summary>Removes all values that are in the recent use list from a set</summary>
-    /// <param name="candidates">Set from which recently used values are removed</param>
-    /// <remarks>
-    ///   Stops removing values when there's only 1 value left in the set
-    /// </remarks>
-    private: void removeRecentlyUsedValues(std::unordered_set<TValue> &candidates) const {
-      if(candidates.size() <= 1) {
-        return;
-      }
+      this->lastUses[pickedIndex] = this->useCount;
+      return this->values[pickedIndex];
+    }
 
-      if(this->historyFull) { // History buffer has wrapped around
-        std::size_t index = this->historyTailIndex;
-        while(index > 0) {
-          --index;
-          if(candidates.erase(this->history[index])) {
-            if(candidates.size() <= 1) {
-              return;
-            }
-          }
-        }
-        index = this->historyLength;
-        while(index > this->historyTailIndex) {
-          --index;
-          if(candidates.erase(this->history[index])) {
-            if(candidates.size() <= 1) {
-              return;
-            }
-          }
-        }
-      } else { // History buffer was not full yet
-        std::size_t index = this->historyTailIndex;
-        while(index > 0) {
-          --index;
-          if(candidates.erase(this->history[index])) {
-            if(candidates.size() <= 1) {
-              return;
+    /// <summary>Locates the n-th candidate that has not been used recently</summary>
+    /// <param name="first">First key in a list of keys that will be considered</param>
+    /// <param name="onePastLast">
+    ///   Iterator past the last in the list of keys that will be considered
+    /// </param>
+    /// <param name="freshIndex">Number of fresh candidates to skip</param>
+    /// <returns>The index of the value slot holding the candidate</returns>
+    private: template<typename TForwardIterator> std::size_t findFreshCandidate(
+      TForwardIterator first, TForwardIterator onePastLast, std::size_t freshIndex
+    ) const {
+      for(TForwardIterator key = first; key != onePastLast; ++key) {
+        std::size_t endIndex;
+        for(std::size_t index = findRange(*key, endIndex); index < endIndex; ++index) {
+          if(!isRecentlyUsed(index)) {
+            if(freshIndex == 0) {
+              return index;
             }
+            --freshIndex;
           }
         }
       }
+
+      return NoCandidate; // Unreachable if the candidates were counted correctly
     }
 
-    /// <summary>Frees all memory used by the individual history entries</summary>
+    /// <summary>Looks up the range of value slots belonging to a key</summary>
+    /// <param name="key">Key whose values will be looked up</param>
+    /// <param name="endIndex">Receives the index one past the key's last value</param>
+    /// <returns>The index of the first value belonging to the key</returns>
     /// <remarks>
-    ///   The history array itself is kept alive and the tail index + full flag will
-    ///   not be reset.
+    ///   If the key doesn't exist, an empty range is returned.
     /// </remarks>
-    private: void freeHistory() {
-      if(this->historyFull) { // History buffer has wrapped around
-        std::size_t index = this->historyTailIndex;
-        while(index > 0) {
-          --index;
-          this->valueAllocator.destroy(this->history + index);
-        }
-        index = this->historyLength;
-        while(index > this->historyTailIndex) {
-          --index;
-          this->valueAllocator.destroy(this->history + index);
-        }
-      } else { // History buffer was not full yet
-        std::size_t index = this->historyTailIndex;
-        while(index > 0) {
-          --index;
-          this->valueAllocator.destroy(this->history + index);
-        }
+    private: std::size_t findRange(const TKey &key, std::size_t &endIndex) const {
+      typename std::vector<TKey>::const_iterator keyIterator = std::lower_bound(
+        this->keys.begin(), this->keys.end(), key
+      );
+      if((keyIterator == this->keys.end()) || (key < *keyIterator)) {
+        endIndex = 0;
+        return 0;
       }
+
+      std::size_t keyIndex = keyIterator - this->keys.begin();
+      endIndex = this->rangeEndIndices[keyIndex];
+      return getRangeStartIndex(keyIndex);
     }
 
-    private: Variegator(const Variegator &);
-    private: Variegator &operator =(const Variegator &);
+    /// <summary>Returns the index of the first value belonging to a key</summary>
+    /// <param name="keyIndex">Index of the key in the sorted key array</param>
+    /// <returns>The index of the first value slot of the key</returns>
+    private: std::size_t getRangeStartIndex(std::size_t keyIndex) const {
+      return (keyIndex == 0) ? 0 : this->rangeEndIndices[keyIndex - 1];
+    }
 
-    /// <summary>Map by which potential values can be looked up via their key</summary>
-    private: typedef std::unordered_multimap<TKey, TValue> ValueMap;
+    /// <summary>Checks whether a value was handed out within the history length</summary>
+    /// <param name="valueIndex">Index of the value slot that will be checked</param>
+    /// <returns>True if the value was handed out recently</returns>
+    private: bool isRecentlyUsed(std::size_t valueIndex) const {
+      std::size_t lastUse = this->lastUses[valueIndex];
+      return (
+        (lastUse != NeverUsed) && (this->useCount - lastUse <= this->historyLength)
+      );
+    }
 
-    /// <summary>Stores the entries the variegator can select from by their keys</summary>
-    private: ValueMap values;
+    /// <summary>Use stamp of value slots that have never been handed out</summary>
+    private: static constexpr std::size_t NeverUsed = 0;
+    /// <summary>Candidate index indicating that no candidate was found</summary>
+    private: static constexpr std::size_t NoCandidate = std::size_t(-1);
+
+    /// <summary>Sorted keys by which values can be looked up</summary>
+    private: std::vector<TKey> keys;
+    /// <summary>Index one past the last value of the key at the same index</summary>
+    private: std::vector<std::size_t> rangeEndIndices;
+    /// <summary>Values of all keys, grouped by key in the same order as the keys</summary>
+    private: std::vector<TValue> values;
+    /// <summary>Use count at which the value in the same slot was last handed out</summary>
+    private: mutable std::vector<std::size_t> lastUses;
 
     /// <summary>Random number generator that will be used to pick random values</summary>
     private: mutable std::default_random_engine randomNumberGenerator;
-    /// <summary>Used to allocate values in the recently used list</summary>
-    private: mutable TValueAllocator valueAllocator;
-    /// <summary>Number of entries in the recently used list</summary>
+    /// <summary>Number of values handed out before a value may be repeated</summary>
     private: std::size_t historyLength;
-
-    /// <summary>Array containing the most recently provided values</summary>
-    private: mutable TValue *history;
-    /// <summary>Index of the tail in the recently used value array</summary>
-    private: mutable std::size_t historyTailIndex;
-    /// <summary>Whether the recently used value history is at capacity</summary>
-    private: mutable bool historyFull;
+    /// <summary>Number of values handed out so far, used to stamp value slots</summary>
+    private: mutable std::size_t useCount;
 
   };
 
@@ -342,6 +319,4 @@ namespace Nuclex::Support::Collections {
 
 } // namespace Nuclex::Support::Collections
 
-#endif // it's broken
-
 #endif // NUCLEX_SUPPORT_COLLECTIONS_VARIEGATOR_H
@@ -141,6 +141,40 @@ limitations under the License.
 
 // --------------------------------------------------------------------------------------------- //
 
+// Size of a CPU cache line. Used to keep variables that are modified by different
+// threads apart so the CPU cores don't keep stealing the cache line from each other.
+// 64 bytes fits all current x86 CPUs and nearly all ARM CPUs.
+#define NUCLEX_SUPPORT_CACHE_LINE_SIZE 64
+
+// --------------------------------------------------------------------------------------------- //
+
+// Vector instruction sets that can be used on the targeted architecture.
+// SSE2 is part of the x86-64 baseline and NEON is mandatory on 64-bit ARM. AVX2 is only
+// used if the compiler was told to target it (-mavx2, -march=haswell or /arch:AVX2).
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+  #define NUCLEX_SUPPORT_SSE2_AVAILABLE 1
+  #if defined(__AVX2__)
+    #define NUCLEX_SUPPORT_AVX2_AVAILABLE 1
+  #endif
+#elif (defined(__ARM_NEON) && defined(__aarch64__)) || defined(_M_ARM64)
+  #define NUCLEX_SUPPORT_NEON_AVAILABLE 1
+#endif
+
+// --------------------------------------------------------------------------------------------- //
+
+// Hints the CPU to start loading the cache line holding an address. Used by batch operations
+// to overlap the cache misses of many lookups instead of suffering them one after another.
+#if defined(_MSC_VER) && defined(_M_ARM64)
+  #define NUCLEX_SUPPORT_PREFETCH(address) __prefetch(address)
+#elif defined(_MSC_VER)
+  #define NUCLEX_SUPPORT_PREFETCH(address) \
+    _mm_prefetch(reinterpret_cast<const char *>(address), _MM_HINT_T0)
+#else
+  #define NUCLEX_SUPPORT_PREFETCH(address) __builtin_prefetch(address)
+#endif
+
+// --------------------------------------------------------------------------------------------- //
+
 #if defined(_MSC_VER)
   #define NUCLEX_SUPPORT_CPU_YIELD _mm_pause()
 #elif defined(__arm__)
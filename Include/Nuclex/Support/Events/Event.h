@@ -22,6 +22,7 @@ limitations under the License.
 
 #include "Nuclex/Support/Config.h"
 #include "Nuclex/Support/Events/Delegate.h"
+#include "Nuclex/Support/Collections/SlabAllocator.h"
 
 #include <algorithm> // for std::copy_n()
 #include <vector> // for std::vector
@@ -128,7 +129,8 @@ namespace Nuclex::Support::Events {
     ///   the number of subscriber slots that are baked into the event, enabling it to handle
     ///   a small number of subscribers without allocating heap memory. Each slot takes the size
     ///   of a delegate, 8 bytes on a 32 bit system or 16 bytes on a 64 bit system. If more
-    ///   subscribers enlist, the event is forced to allocate memory on the heap.
+    ///   subscribers enlist, the event is forced to allocate memory, which it takes
+    ///   from the <see cref="Collections.SlabMemory" /> rather than the general heap.
     /// </remarks>
     private: const static std::size_t BuiltInSubscriberCount = 2;
 
@@ -156,7 +158,10 @@ namespace Nuclex::Support::Events {
     /// <summary>Frees all memory used by the event</summary>
     public: ~Event() {
       if(this->subscriberCount > BuiltInSubscriberCount) {
-        delete []this->heapMemory.Buffer;
+        Collections::SlabMemory::Free(
+          this->heapMemory.Buffer,
+          sizeof(DelegateType[2]) * this->heapMemory.ReservedSubscriberCount / 2
+        );
       }
     }
 
@@ -304,9 +309,9 @@ namespace Nuclex::Support::Events {
     /// </remarks>
     private: void convertFromStackToHeapAllocation() {
       const static std::size_t initialCapacity = BuiltInSubscriberCount * 8;
-      std::uint8_t *initialBuffer = new std::uint8_t[
-        sizeof(DelegateType[2]) * initialCapacity / 2
-      ]; // CHECK: Do we risk alignment issues here?
+      std::uint8_t *initialBuffer = static_cast<std::uint8_t *>(
+        Collections::SlabMemory::Allocate(sizeof(DelegateType[2]) * initialCapacity / 2)
+      );
 
       std::copy_n(
         this->stackMemory,
@@ -320,10 +325,11 @@ namespace Nuclex::Support::Events {
 
     /// <summary>Increases the size of the heap-allocated list of event subscribers</summary>
     private: void growHeapAllocatedList() {
-      std::size_t newCapacity = this->heapMemory.ReservedSubscriberCount * 2;
-      std::uint8_t *newBuffer = new std::uint8_t[
-        sizeof(DelegateType[2]) * newCapacity / 2
-      ]; // CHECK: Do we risk alignment issues here?
+      std::size_t oldCapacity = this->heapMemory.ReservedSubscriberCount;
+      std::size_t newCapacity = oldCapacity * 2;
+      std::uint8_t *newBuffer = static_cast<std::uint8_t *>(
+        Collections::SlabMemory::Allocate(sizeof(DelegateType[2]) * newCapacity / 2)
+      );
 
       std::copy_n(
         this->heapMemory.Buffer,
@@ -333,7 +339,7 @@ namespace Nuclex::Support::Events {
 
       std::swap(this->heapMemory.Buffer, newBuffer);
       this->heapMemory.ReservedSubscriberCount = newCapacity;
-      delete []newBuffer;
+      Collections::SlabMemory::Free(newBuffer, sizeof(DelegateType[2]) * oldCapacity / 2);
     }
 
     /// <summary>Moves the event's subscriber list back into its own stack storage</summary>
@@ -345,6 +351,7 @@ namespace Nuclex::Support::Events {
     /// </remarks>
     private: void convertFromHeapToStackAllocation() {
       std::uint8_t *oldBuffer = this->heapMemory.Buffer;
+      std::size_t oldCapacity = this->heapMemory.ReservedSubscriberCount;
 
       std::copy_n(
         oldBuffer,
@@ -352,7 +359,7 @@ namespace Nuclex::Support::Events {
         this->stackMemory
       );
 
-      delete []oldBuffer;
+      Collections::SlabMemory::Free(oldBuffer, sizeof(DelegateType[2]) * oldCapacity / 2);
     }
 
     /// <summary>Information about subscribers if the list is moved to the heap</summary>
@@ -0,0 +1,83 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Collections/CountMinSketch.h"
+#include "Nuclex/Support/BitTricks.h" // for BitTricks::GetUpperPowerOfTwo()
+
+#include <algorithm> // for std::fill_n()
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  CountMinSketch::CountMinSketch(std::size_t expectedItemCount) :
+    columnMask(0),
+    wordsPerRow(0),
+    sampleSize(0),
+    incrementCount(0),
+    counters() {
+
+    // Use at least one full word per row and round up to a power of two
+    // so that counter indices can be formed by masking the hash
+    std::size_t columnCount = static_cast<std::size_t>(
+      BitTricks::GetUpperPowerOfTwo(static_cast<std::uint64_t>(expectedItemCount))
+    );
+    if(columnCount < CountersPerWord) {
+      columnCount = CountersPerWord;
+    }
+
+    this->columnMask = columnCount - 1;
+    this->wordsPerRow = columnCount / CountersPerWord;
+    this->sampleSize = columnCount * 10;
+    this->counters.reset(new std::uint64_t[this->wordsPerRow * RowCount]);
+
+    Clear();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  CountMinSketch::~CountMinSketch() = default;
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void CountMinSketch::Clear() {
+    std::fill_n(this->counters.get(), this->wordsPerRow * RowCount, std::uint64_t(0));
+    this->incrementCount = 0;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void CountMinSketch::age() {
+    std::size_t wordCount = this->wordsPerRow * RowCount;
+
+    // Shifting the whole word moves each counter's lowest bit into the highest bit
+    // of its neighbour, so mask those out to halve all 16 counters in one go
+    for(std::size_t index = 0; index < wordCount; ++index) {
+      this->counters[index] = (this->counters[index] >> 1) & 0x7777777777777777ull;
+    }
+
+    this->incrementCount /= 2;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
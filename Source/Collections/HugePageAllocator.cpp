@@ -0,0 +1,353 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Collections/HugePageAllocator.h"
+
+#if defined(NUCLEX_SUPPORT_LINUX)
+#include <sys/mman.h> // for ::mmap(), ::mremap(), ::madvise(), ::munmap()
+#elif defined(NUCLEX_SUPPORT_WINDOWS)
+#include "../Interop/WindowsApi.h" // for ::VirtualAlloc(), ::VirtualFree()
+#endif
+
+#include <cstdint> // for std::uintptr_t
+#include <cstring> // for std::memcpy()
+#include <new> // for std::align_val_t
+#include <algorithm> // for std::min()
+#include <cassert> // for assert()
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Checks whether a block of the specified size gets its own pages</summary>
+  /// <param name="byteCount">Size of the memory block that will be checked</param>
+  /// <returns>True if the block is mapped, false if it is allocated from the heap</returns>
+  bool isMapped(std::size_t byteCount) {
+    return (byteCount >= Nuclex::Support::Collections::HugePageMemory::HugePageSize);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Rounds a size up to the next multiple of the huge page size</summary>
+  /// <param name="byteCount">Size that will be rounded up</param>
+  /// <returns>The rounded size</returns>
+  std::size_t roundUpToHugePageSize(std::size_t byteCount) {
+    const std::size_t hugePageSize = Nuclex::Support::Collections::HugePageMemory::HugePageSize;
+    return (byteCount + hugePageSize - 1) & ~(hugePageSize - 1);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Allocates a block that is too small for huge pages from the heap</summary>
+  /// <param name="byteCount">Number of bytes that will be allocated</param>
+  /// <param name="alignment">Alignment the block needs, a power of two</param>
+  /// <returns>The address of the allocated memory block</returns>
+  void *allocateFromHeap(std::size_t byteCount, std::size_t alignment) {
+    if(alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+      return ::operator new(byteCount, std::align_val_t(alignment));
+    } else {
+      return ::operator new(byteCount);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Frees a memory block that was allocated from the heap</summary>
+  /// <param name="memory">Memory block that will be freed</param>
+  /// <param name="alignment">Alignment the block was allocated with</param>
+  void freeToHeap(void *memory, std::size_t alignment) noexcept {
+    if(alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+      ::operator delete(memory, std::align_val_t(alignment));
+    } else {
+      ::operator delete(memory);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+#if defined(NUCLEX_SUPPORT_LINUX)
+
+  /// <summary>Maps an anonymous memory range starting at a huge page boundary</summary>
+  /// <param name="byteCount">Size of the range, a multiple of the huge page size</param>
+  /// <param name="protection">Access the memory range will allow</param>
+  /// <returns>The address of the mapped range or a null pointer if mapping failed</returns>
+  void *mapAlignedRange(std::size_t byteCount, int protection) {
+    using Nuclex::Support::Collections::HugePageMemory;
+
+    // The kernel only guarantees normal page alignment, so map one huge page more
+    // than needed and cut an aligned range out of the middle.
+    std::size_t mappedByteCount = byteCount + HugePageMemory::HugePageSize;
+    void *memory = ::mmap(
+      nullptr, mappedByteCount, protection, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0
+    );
+    if(memory == MAP_FAILED) [[unlikely]] {
+      return nullptr;
+    }
+
+    std::uintptr_t start = reinterpret_cast<std::uintptr_t>(memory);
+    std::uintptr_t alignedStart = (
+      (start + HugePageMemory::HugePageSize - 1) & ~(HugePageMemory::HugePageSize - 1)
+    );
+    if(alignedStart > start) {
+      ::munmap(memory, alignedStart - start);
+    }
+    std::uintptr_t end = start + mappedByteCount;
+    std::uintptr_t alignedEnd = alignedStart + byteCount;
+    if(end > alignedEnd) {
+      ::munmap(reinterpret_cast<void *>(alignedEnd), end - alignedEnd);
+    }
+
+    return reinterpret_cast<void *>(alignedStart);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Maps memory for a block, using huge pages if possible</summary>
+  /// <param name="byteCount">Size of the block, a multiple of the huge page size</param>
+  /// <param name="mode">Which kind of huge pages should be used</param>
+  /// <returns>The address of the mapped memory</returns>
+  void *mapHugePages(std::size_t byteCount, Nuclex::Support::Collections::HugePageMode mode) {
+    using Nuclex::Support::Collections::HugePageMemory;
+    using Nuclex::Support::Collections::HugePageMode;
+
+    // Reserved huge pages only exist if the administrator has set some aside,
+    // if none are left, the mapping fails and we fall through to transparent ones.
+    if(mode == HugePageMode::Reserved) {
+      int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+#if defined(MAP_HUGE_SHIFT)
+      flags |= (21 << MAP_HUGE_SHIFT); // Ask for 2 MiB pages even if the default is 1 GiB
+#endif
+      void *memory = ::mmap(nullptr, byteCount, PROT_READ | PROT_WRITE, flags, -1, 0);
+      if(memory != MAP_FAILED) {
+        return memory;
+      }
+    }
+
+    // The kernel can only back 2 MiB-aligned ranges with transparent huge pages
+    void *memory = mapAlignedRange(byteCount, PROT_READ | PROT_WRITE);
+    if(memory == nullptr) [[unlikely]] {
+      throw std::bad_alloc();
+    }
+
+    // This only fails if transparent huge pages are unavailable. The memory is still
+    // perfectly usable then, just with normal pages, so the result is ignored.
+    ::madvise(memory, byteCount, MADV_HUGEPAGE);
+
+    return memory;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Tries to resize a mapped block without copying its contents</summary>
+  /// <param name="memory">Mapped memory block that will be resized</param>
+  /// <param name="oldByteCount">Current size of the block, a multiple of the page size</param>
+  /// <param name="newByteCount">Desired size of the block, a multiple of the page size</param>
+  /// <returns>The block's new address or a null pointer if it could not be resized</returns>
+  void *tryRemapHugePages(void *memory, std::size_t oldByteCount, std::size_t newByteCount) {
+
+    // Shrinking always works in place and growing does if the address space behind
+    // the block is free. New pages join the mapping, which has the huge page advice.
+    void *newMemory = ::mremap(memory, oldByteCount, newByteCount, 0);
+    if(newMemory != MAP_FAILED) {
+      return newMemory;
+    }
+
+    // Otherwise the block has to move. Left to pick the address on its own, mremap()
+    // would only align the block to a normal page, so reserve an aligned range first
+    // and have the block moved on top of it.
+    void *target = mapAlignedRange(newByteCount, PROT_NONE);
+    if(target == nullptr) {
+      return nullptr;
+    }
+
+    newMemory = ::mremap(
+      memory, oldByteCount, newByteCount, MREMAP_MAYMOVE | MREMAP_FIXED, target
+    );
+    if(newMemory == MAP_FAILED) {
+      ::munmap(target, newByteCount);
+      return nullptr; // Older kernels can not remap reserved huge pages, for example
+    }
+
+    return newMemory;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Unmaps a memory block</summary>
+  /// <param name="memory">Mapped memory block that will be unmapped</param>
+  /// <param name="byteCount">Size of the block, a multiple of the huge page size</param>
+  void unmapHugePages(void *memory, std::size_t byteCount) noexcept {
+    int result = ::munmap(memory, byteCount);
+    NUCLEX_SUPPORT_NDEBUG_UNUSED(result);
+    assert((result == 0) && u8"Memory block is unmapped successfully");
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+#elif defined(NUCLEX_SUPPORT_WINDOWS)
+
+  /// <summary>Maps memory for a block, using huge pages if possible</summary>
+  /// <param name="byteCount">Size of the block, a multiple of the huge page size</param>
+  /// <param name="mode">Which kind of huge pages should be used</param>
+  /// <returns>The address of the mapped memory</returns>
+  void *mapHugePages(std::size_t byteCount, Nuclex::Support::Collections::HugePageMode mode) {
+
+    // Large pages need the SeLockMemoryPrivilege, without it VirtualAlloc() fails
+    // and we fall through to normal pages
+    if(mode == Nuclex::Support::Collections::HugePageMode::Reserved) {
+      std::size_t largePageSize = static_cast<std::size_t>(::GetLargePageMinimum());
+      if(largePageSize != 0) {
+        void *memory = ::VirtualAlloc(
+          nullptr,
+          (byteCount + largePageSize - 1) / largePageSize * largePageSize,
+          MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES,
+          PAGE_READWRITE
+        );
+        if(memory != nullptr) {
+          return memory;
+        }
+      }
+    }
+
+    void *memory = ::VirtualAlloc(nullptr, byteCount, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if(memory == nullptr) [[unlikely]] {
+      throw std::bad_alloc();
+    }
+
+    return memory;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Tries to resize a mapped block without copying its contents</summary>
+  /// <param name="memory">Mapped memory block that will be resized</param>
+  /// <param name="oldByteCount">Current size of the block, a multiple of the page size</param>
+  /// <param name="newByteCount">Desired size of the block, a multiple of the page size</param>
+  /// <returns>The block's new address or a null pointer if it could not be resized</returns>
+  void *tryRemapHugePages(void *, std::size_t, std::size_t) {
+    return nullptr; // Windows has no equivalent to mremap()
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Unmaps a memory block</summary>
+  /// <param name="memory">Mapped memory block that will be unmapped</param>
+  /// <param name="byteCount">Size of the block, a multiple of the huge page size</param>
+  void unmapHugePages(void *memory, std::size_t) noexcept {
+    BOOL result = ::VirtualFree(memory, 0, MEM_RELEASE);
+    NUCLEX_SUPPORT_NDEBUG_UNUSED(result);
+    assert((result != FALSE) && u8"Memory block is released successfully");
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+#else
+
+  /// <summary>Maps memory for a block, using huge pages if possible</summary>
+  /// <param name="byteCount">Size of the block, a multiple of the huge page size</param>
+  /// <returns>The address of the mapped memory</returns>
+  void *mapHugePages(std::size_t byteCount, Nuclex::Support::Collections::HugePageMode) {
+    using Nuclex::Support::Collections::HugePageMemory;
+
+    // No known way to request huge pages here, but at least align like other platforms
+    return ::operator new(byteCount, std::align_val_t(HugePageMemory::HugePageSize));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Tries to resize a mapped block without copying its contents</summary>
+  /// <returns>Always a null pointer, resizing is not supported</returns>
+  void *tryRemapHugePages(void *, std::size_t, std::size_t) {
+    return nullptr;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Unmaps a memory block</summary>
+  /// <param name="memory">Mapped memory block that will be unmapped</param>
+  void unmapHugePages(void *memory, std::size_t) noexcept {
+    using Nuclex::Support::Collections::HugePageMemory;
+    ::operator delete(memory, std::align_val_t(HugePageMemory::HugePageSize));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+#endif
+
+} // anonymous namespace
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void *HugePageMemory::Allocate(
+    std::size_t byteCount, HugePageMode mode, std::size_t alignment /* = DefaultAlignment */
+  ) {
+    if(isMapped(byteCount)) {
+      return mapHugePages(roundUpToHugePageSize(byteCount), mode);
+    } else {
+      return allocateFromHeap(byteCount, alignment);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void *HugePageMemory::Reallocate(
+    void *memory,
+    std::size_t oldByteCount,
+    std::size_t newByteCount,
+    HugePageMode mode,
+    std::size_t alignment /* = DefaultAlignment */
+  ) {
+    if(isMapped(oldByteCount) && isMapped(newByteCount)) {
+      std::size_t oldMappedByteCount = roundUpToHugePageSize(oldByteCount);
+      std::size_t newMappedByteCount = roundUpToHugePageSize(newByteCount);
+      if(oldMappedByteCount == newMappedByteCount) {
+        return memory;
+      }
+
+      void *newMemory = tryRemapHugePages(memory, oldMappedByteCount, newMappedByteCount);
+      if(newMemory != nullptr) {
+        return newMemory;
+      }
+    }
+
+    // Either one of the sizes is served from the heap or the platform could not
+    // resize the mapping, so fall back to allocating a new block and copying
+    void *newMemory = Allocate(newByteCount, mode, alignment);
+    std::memcpy(newMemory, memory, std::min(oldByteCount, newByteCount));
+    Free(memory, oldByteCount, alignment);
+
+    return newMemory;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void HugePageMemory::Free(
+    void *memory, std::size_t byteCount, std::size_t alignment /* = DefaultAlignment */
+  ) noexcept {
+    if(isMapped(byteCount)) {
+      unmapHugePages(memory, roundUpToHugePageSize(byteCount));
+    } else {
+      freeToHeap(memory, alignment);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
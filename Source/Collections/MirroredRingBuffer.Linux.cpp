@@ -0,0 +1,118 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Collections/MirroredRingBuffer.h"
+
+#if defined(NUCLEX_SUPPORT_LINUX)
+
+#include "../Interop/PosixApi.h" // for PosixApi::ThrowExceptionForSystemError()
+#include "Nuclex/Support/ScopeGuard.h" // for ON_SCOPE_EXIT
+
+#include <cassert> // for assert()
+
+#include <sys/mman.h> // for ::memfd_create(), ::mmap(), ::munmap()
+#include <unistd.h> // for ::sysconf(), ::ftruncate(), ::close()
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::size_t MirroredRingBuffer::roundUpToMappableSize(std::size_t capacity) {
+    static const std::size_t pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    if(capacity == 0) {
+      return pageSize;
+    }
+
+    return (capacity + pageSize - 1) / pageSize * pageSize;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::byte *MirroredRingBuffer::mapMirroredMemory(std::size_t size) {
+
+    // An anonymous in-memory file provides the pages that will be mapped twice
+    int fileDescriptor = ::memfd_create("Nuclex MirroredRingBuffer", MFD_CLOEXEC);
+    if(fileDescriptor == -1) [[unlikely]] {
+      int errorNumber = errno;
+      Nuclex::Support::Interop::PosixApi::ThrowExceptionForSystemError(
+        u8"Could not create anonymous memory file for mirrored ring buffer", errorNumber
+      );
+    }
+    ON_SCOPE_EXIT {
+      int result = ::close(fileDescriptor);
+      NUCLEX_SUPPORT_NDEBUG_UNUSED(result);
+      assert((result == 0) && u8"Anonymous memory file is closed successfully");
+    };
+
+    int result = ::ftruncate(fileDescriptor, static_cast<::off_t>(size));
+    if(result == -1) [[unlikely]] {
+      int errorNumber = errno;
+      Nuclex::Support::Interop::PosixApi::ThrowExceptionForSystemError(
+        u8"Could not resize anonymous memory file for mirrored ring buffer", errorNumber
+      );
+    }
+
+    // Reserve an address range for both mappings, then map the file over each half.
+    // MAP_FIXED replaces the reservation atomically, so no other thread can sneak
+    // its own mapping into the range in between.
+    void *reservation = ::mmap(
+      nullptr, size * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0
+    );
+    if(reservation == MAP_FAILED) [[unlikely]] {
+      int errorNumber = errno;
+      Nuclex::Support::Interop::PosixApi::ThrowExceptionForSystemError(
+        u8"Could not reserve address space for mirrored ring buffer", errorNumber
+      );
+    }
+
+    std::byte *memory = static_cast<std::byte *>(reservation);
+    for(std::size_t half = 0; half < 2; ++half) {
+      void *mapping = ::mmap(
+        memory + half * size, size,
+        PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED,
+        fileDescriptor, 0
+      );
+      if(mapping == MAP_FAILED) [[unlikely]] {
+        int errorNumber = errno;
+        ::munmap(reservation, size * 2);
+        Nuclex::Support::Interop::PosixApi::ThrowExceptionForSystemError(
+          u8"Could not map memory for mirrored ring buffer", errorNumber
+        );
+      }
+    }
+
+    return memory;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void MirroredRingBuffer::unmapMirroredMemory(std::byte *memory, std::size_t size) noexcept {
+    int result = ::munmap(memory, size * 2);
+    NUCLEX_SUPPORT_NDEBUG_UNUSED(result);
+    assert((result == 0) && u8"Mirrored ring buffer memory is unmapped successfully");
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
+
+#endif // defined(NUCLEX_SUPPORT_LINUX)
@@ -0,0 +1,134 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Collections/MirroredRingBuffer.h"
+
+#if defined(NUCLEX_SUPPORT_WINDOWS)
+
+#include "../Interop/WindowsApi.h" // for ::CreateFileMappingW(), ::MapViewOfFileEx() and more
+#include "Nuclex/Support/ScopeGuard.h" // for ON_SCOPE_EXIT
+
+#include <cassert> // for assert()
+#include <cstdint> // for std::uint64_t
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::size_t MirroredRingBuffer::roundUpToMappableSize(std::size_t capacity) {
+    static const std::size_t granularity = []() {
+      ::SYSTEM_INFO systemInfo;
+      ::GetSystemInfo(&systemInfo);
+      return static_cast<std::size_t>(systemInfo.dwAllocationGranularity);
+    }();
+    if(capacity == 0) {
+      return granularity;
+    }
+
+    return (capacity + granularity - 1) / granularity * granularity;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  std::byte *MirroredRingBuffer::mapMirroredMemory(std::size_t size) {
+
+    // A pagefile-backed file mapping provides the pages that will be mapped twice
+    std::uint64_t size64 = static_cast<std::uint64_t>(size);
+    HANDLE fileMapping = ::CreateFileMappingW(
+      INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+      static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64), nullptr
+    );
+    if(fileMapping == nullptr) [[unlikely]] {
+      DWORD errorCode = ::GetLastError();
+      Nuclex::Support::Interop::WindowsApi::ThrowExceptionForSystemError(
+        u8"Could not create file mapping for mirrored ring buffer", errorCode
+      );
+    }
+    ON_SCOPE_EXIT {
+      BOOL result = ::CloseHandle(fileMapping);
+      NUCLEX_SUPPORT_NDEBUG_UNUSED(result);
+      assert((result != FALSE) && u8"File mapping is closed successfully");
+    };
+
+    // Without VirtualAlloc2() (Windows 10 1803+, only in onecore.lib), there is no way
+    // to map over a reservation, so find a free address range by reserving and releasing
+    // it, then map both views into it. Another thread may grab part of the range in
+    // between, in which case we simply try again.
+    const std::size_t MaximumAttemptCount = 16;
+    DWORD lastErrorCode = ERROR_SUCCESS;
+    for(std::size_t attempt = 0; attempt < MaximumAttemptCount; ++attempt) {
+      void *reservation = ::VirtualAlloc(nullptr, size * 2, MEM_RESERVE, PAGE_NOACCESS);
+      if(reservation == nullptr) [[unlikely]] {
+        DWORD errorCode = ::GetLastError();
+        Nuclex::Support::Interop::WindowsApi::ThrowExceptionForSystemError(
+          u8"Could not reserve address space for mirrored ring buffer", errorCode
+        );
+      }
+
+      BOOL result = ::VirtualFree(reservation, 0, MEM_RELEASE);
+      NUCLEX_SUPPORT_NDEBUG_UNUSED(result);
+      assert((result != FALSE) && u8"Address space reservation is released successfully");
+
+      std::byte *memory = static_cast<std::byte *>(reservation);
+      void *firstView = ::MapViewOfFileEx(
+        fileMapping, FILE_MAP_ALL_ACCESS, 0, 0, size, memory
+      );
+      if(firstView == nullptr) {
+        lastErrorCode = ::GetLastError();
+        continue;
+      }
+
+      void *secondView = ::MapViewOfFileEx(
+        fileMapping, FILE_MAP_ALL_ACCESS, 0, 0, size, memory + size
+      );
+      if(secondView == nullptr) {
+        lastErrorCode = ::GetLastError();
+        result = ::UnmapViewOfFile(firstView);
+        assert((result != FALSE) && u8"File mapping view is unmapped successfully");
+        continue;
+      }
+
+      return memory;
+    }
+
+    Nuclex::Support::Interop::WindowsApi::ThrowExceptionForSystemError(
+      u8"Could not map memory for mirrored ring buffer", lastErrorCode
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void MirroredRingBuffer::unmapMirroredMemory(std::byte *memory, std::size_t size) noexcept {
+    BOOL result = ::UnmapViewOfFile(memory + size);
+    NUCLEX_SUPPORT_NDEBUG_UNUSED(result);
+    assert((result != FALSE) && u8"Mirrored view of ring buffer memory is unmapped successfully");
+
+    result = ::UnmapViewOfFile(memory);
+    NUCLEX_SUPPORT_NDEBUG_UNUSED(result);
+    assert((result != FALSE) && u8"Ring buffer memory is unmapped successfully");
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
+
+#endif // defined(NUCLEX_SUPPORT_WINDOWS)
@@ -0,0 +1,90 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Collections/MirroredRingBuffer.h"
+
+#if defined(NUCLEX_SUPPORT_LINUX) || defined(NUCLEX_SUPPORT_WINDOWS)
+
+#include <cstring> // for std::memcpy()
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  MirroredRingBuffer::MirroredRingBuffer(std::size_t capacity) :
+    memory(nullptr),
+    capacity(roundUpToMappableSize(capacity)),
+    startIndex(0),
+    count(0) {
+    this->memory = mapMirroredMemory(this->capacity);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  MirroredRingBuffer::MirroredRingBuffer(MirroredRingBuffer &&other) noexcept :
+    memory(other.memory),
+    capacity(other.capacity),
+    startIndex(other.startIndex),
+    count(other.count) {
+    other.memory = nullptr;
+    other.capacity = 0;
+    other.startIndex = 0;
+    other.count = 0;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  MirroredRingBuffer::~MirroredRingBuffer() {
+    if(this->memory != nullptr) { // Can be NULL if container donated its guts
+      unmapMirroredMemory(this->memory, this->capacity);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void MirroredRingBuffer::reallocate(std::size_t requiredCapacity) {
+    std::size_t newCapacity = this->capacity * 2;
+    if(newCapacity < requiredCapacity) {
+      newCapacity = requiredCapacity;
+    }
+    newCapacity = roundUpToMappableSize(newCapacity);
+
+    // The old contents are contiguous thanks to the mirroring, so a single copy
+    // moves them into the new memory block, where they start at index zero again.
+    std::byte *newMemory = mapMirroredMemory(newCapacity);
+    if(this->count > 0) {
+      std::memcpy(newMemory, this->memory + this->startIndex, this->count);
+    }
+    if(this->memory != nullptr) {
+      unmapMirroredMemory(this->memory, this->capacity);
+    }
+
+    this->memory = newMemory;
+    this->capacity = newCapacity;
+    this->startIndex = 0;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
+
+#endif // defined(NUCLEX_SUPPORT_LINUX) || defined(NUCLEX_SUPPORT_WINDOWS)
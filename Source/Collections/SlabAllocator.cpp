@@ -0,0 +1,448 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Collections/SlabAllocator.h"
+#include "Nuclex/Support/BitTricks.h"
+
+#include <cstdint> // for std::uint8_t, std::uint32_t
+#include <mutex> // for std::mutex, std::lock_guard
+#include <utility> // for std::swap()
+#include <cassert> // for assert()
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Size of the blocks in the smallest size class</summary>
+  const std::size_t MinimumBlockSize = 16;
+
+  /// <summary>Number of size classes from the minimum to the maximum block size</summary>
+  const std::size_t SizeClassCount = 7;
+
+  /// <summary>Number of free blocks a magazine can hold</summary>
+  const std::size_t MagazineCapacity = 32;
+
+  /// <summary>Size of the memory chunks blocks are carved from</summary>
+  const std::size_t SlabSize = 64 * 1024;
+
+  /// <summary>Bytes at the start of each slab used to chain the slabs together</summary>
+  const std::size_t SlabHeaderSize = Nuclex::Support::Collections::SlabMemory::BlockAlignment;
+
+  static_assert(
+    (MinimumBlockSize << (SizeClassCount - 1)) ==
+    Nuclex::Support::Collections::SlabMemory::MaximumBlockSize,
+    "Size classes must cover all block sizes up to the maximum block size"
+  );
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Determines the size class a block of the specified size falls into</summary>
+  /// <param name="byteCount">Requested size of the block</param>
+  /// <returns>The index of the size class serving blocks of that size</returns>
+  std::size_t getSizeClass(std::size_t byteCount) {
+    if(byteCount <= MinimumBlockSize) {
+      return 0;
+    }
+
+    using Nuclex::Support::BitTricks;
+    // Size class 0 holds blocks of 16 bytes, which is 2 to the power of 4
+    return BitTricks::GetLogBase2(static_cast<std::uint32_t>(byteCount - 1)) + 1 - 4;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Small stack of free blocks belonging to one size class</summary>
+  struct Magazine {
+
+    /// <summary>Next magazine when the magazine is stored in the depot</summary>
+    public: Magazine *Next;
+    /// <summary>Number of free blocks currently stored in the magazine</summary>
+    public: std::size_t Count;
+    /// <summary>Addresses of the free blocks</summary>
+    public: void *Blocks[MagazineCapacity];
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Shared store of magazines and slabs for one size class</summary>
+  /// <remarks>
+  ///   Threads only come here when their own magazines have run empty or full,
+  ///   so the mutex is taken once per <see cref="MagazineCapacity" /> operations at most.
+  /// </remarks>
+  class SizeClassDepot {
+
+    /// <summary>Initializes a new, empty depot</summary>
+    public: SizeClassDepot() :
+      mutex(),
+      blockSize(0),
+      fullMagazines(nullptr),
+      emptyMagazines(nullptr),
+      looseBlocks(nullptr),
+      slabs(nullptr),
+      slabCursor(nullptr),
+      slabEnd(nullptr) {}
+
+    /// <summary>Sets the size of the blocks the depot hands out</summary>
+    /// <param name="blockSize">Size of the blocks in bytes</param>
+    public: void SetBlockSize(std::size_t blockSize) {
+      this->blockSize = blockSize;
+    }
+
+    /// <summary>Provides a magazine holding free blocks</summary>
+    /// <param name="emptyMagazine">
+    ///   Empty magazine the caller hands in or a null pointer if the caller has none
+    /// </param>
+    /// <returns>A magazine holding at least one free block</returns>
+    /// <remarks>
+    ///   If this throws, the caller keeps ownership of the magazine it handed in.
+    /// </remarks>
+    public: Magazine *TradeForFullMagazine(Magazine *emptyMagazine) {
+      std::lock_guard<std::mutex> depotScope(this->mutex);
+
+      if(this->fullMagazines != nullptr) {
+        Magazine *fullMagazine = this->fullMagazines;
+        this->fullMagazines = fullMagazine->Next;
+        if(emptyMagazine != nullptr) {
+          pushMagazine(this->emptyMagazines, emptyMagazine);
+        }
+        return fullMagazine;
+      }
+
+      // No full magazines in the depot, fill one from loose blocks and the slabs
+      Magazine *magazine = emptyMagazine;
+      if(magazine == nullptr) {
+        magazine = this->emptyMagazines;
+        if(magazine == nullptr) {
+          magazine = new Magazine();
+        } else {
+          this->emptyMagazines = magazine->Next;
+        }
+        magazine->Count = 0;
+      }
+
+      try {
+        fill(*magazine);
+      }
+      catch(...) {
+        if(magazine != emptyMagazine) {
+          pushMagazine(this->emptyMagazines, magazine);
+        }
+        throw;
+      }
+
+      return magazine;
+    }
+
+    /// <summary>Takes a magazine full of blocks and provides an empty one</summary>
+    /// <param name="fullMagazine">
+    ///   Full magazine the caller hands in or a null pointer if the caller has none
+    /// </param>
+    /// <returns>An empty magazine or a null pointer if none could be allocated</returns>
+    /// <remarks>
+    ///   If a null pointer is returned, the caller keeps ownership of the magazine
+    ///   it handed in.
+    /// </remarks>
+    public: Magazine *TradeForEmptyMagazine(Magazine *fullMagazine) noexcept {
+      std::lock_guard<std::mutex> depotScope(this->mutex);
+
+      Magazine *emptyMagazine = this->emptyMagazines;
+      if(emptyMagazine == nullptr) {
+        emptyMagazine = new(std::nothrow) Magazine();
+        if(emptyMagazine == nullptr) {
+          return nullptr;
+        }
+      } else {
+        this->emptyMagazines = emptyMagazine->Next;
+      }
+
+      if(fullMagazine != nullptr) {
+        pushMagazine(this->fullMagazines, fullMagazine);
+      }
+
+      emptyMagazine->Count = 0;
+      return emptyMagazine;
+    }
+
+    /// <summary>Stores a magazine in the depot when a thread no longer needs it</summary>
+    /// <param name="magazine">Magazine that will be stored in the depot</param>
+    public: void ReturnMagazine(Magazine *magazine) noexcept {
+      std::lock_guard<std::mutex> depotScope(this->mutex);
+      if(magazine->Count == 0) {
+        pushMagazine(this->emptyMagazines, magazine);
+      } else {
+        pushMagazine(this->fullMagazines, magazine);
+      }
+    }
+
+    /// <summary>Hands out a single block without going through a magazine</summary>
+    /// <returns>The address of the block</returns>
+    public: void *AllocateLooseBlock() {
+      std::lock_guard<std::mutex> depotScope(this->mutex);
+
+      if(this->looseBlocks != nullptr) {
+        void *block = this->looseBlocks;
+        this->looseBlocks = *reinterpret_cast<void **>(block);
+        return block;
+      }
+
+      if(this->fullMagazines != nullptr) {
+        Magazine *magazine = this->fullMagazines;
+        void *block = magazine->Blocks[--magazine->Count];
+        if(magazine->Count == 0) {
+          this->fullMagazines = magazine->Next;
+          pushMagazine(this->emptyMagazines, magazine);
+        }
+        return block;
+      }
+
+      if(this->slabCursor == this->slabEnd) {
+        allocateSlab();
+      }
+      void *block = this->slabCursor;
+      this->slabCursor += this->blockSize;
+      return block;
+    }
+
+    /// <summary>Takes back a single block without going through a magazine</summary>
+    /// <param name="block">Block that will be taken back</param>
+    public: void FreeLooseBlock(void *block) noexcept {
+      std::lock_guard<std::mutex> depotScope(this->mutex);
+      *reinterpret_cast<void **>(block) = this->looseBlocks;
+      this->looseBlocks = block;
+    }
+
+    /// <summary>Fills a magazine with loose blocks and blocks carved from the slabs</summary>
+    /// <param name="magazine">Magazine that will be filled</param>
+    /// <remarks>
+    ///   A new slab is only allocated if the magazine would otherwise stay empty,
+    ///   so the magazine may come back partially filled.
+    /// </remarks>
+    private: void fill(Magazine &magazine) {
+      while(magazine.Count < MagazineCapacity) {
+        if(this->looseBlocks != nullptr) {
+          void *block = this->looseBlocks;
+          this->looseBlocks = *reinterpret_cast<void **>(block);
+          magazine.Blocks[magazine.Count++] = block;
+        } else {
+          if(this->slabCursor == this->slabEnd) {
+            if(magazine.Count > 0) {
+              break;
+            }
+            allocateSlab();
+          }
+          magazine.Blocks[magazine.Count++] = this->slabCursor;
+          this->slabCursor += this->blockSize;
+        }
+      }
+    }
+
+    /// <summary>Allocates a new slab to carve blocks from</summary>
+    private: void allocateSlab() {
+      using Nuclex::Support::Collections::SlabMemory;
+
+      std::uint8_t *slab = static_cast<std::uint8_t *>(
+        ::operator new(SlabSize, std::align_val_t(SlabMemory::BlockAlignment))
+      );
+
+      // Slabs are kept in a list so that they stay reachable, they're never freed
+      *reinterpret_cast<std::uint8_t **>(slab) = this->slabs;
+      this->slabs = slab;
+
+      std::size_t blockCount = (SlabSize - SlabHeaderSize) / this->blockSize;
+      this->slabCursor = slab + SlabHeaderSize;
+      this->slabEnd = this->slabCursor + blockCount * this->blockSize;
+    }
+
+    /// <summary>Puts a magazine onto a list of magazines</summary>
+    /// <param name="list">List the magazine will be put on</param>
+    /// <param name="magazine">Magazine that will be put onto the list</param>
+    private: static void pushMagazine(Magazine *&list, Magazine *magazine) noexcept {
+      magazine->Next = list;
+      list = magazine;
+    }
+
+    /// <summary>Must be held while accessing any of the depot's fields</summary>
+    private: std::mutex mutex;
+    /// <summary>Size of the blocks handed out by the depot</summary>
+    private: std::size_t blockSize;
+    /// <summary>Magazines holding free blocks, waiting to be picked up</summary>
+    private: Magazine *fullMagazines;
+    /// <summary>Magazines without any blocks, waiting to be picked up</summary>
+    private: Magazine *emptyMagazines;
+    /// <summary>Free blocks that were returned without a magazine</summary>
+    private: void *looseBlocks;
+    /// <summary>Most recently allocated slab, the start of a chain of slabs</summary>
+    private: std::uint8_t *slabs;
+    /// <summary>Address of the next block that will be carved from the current slab</summary>
+    private: std::uint8_t *slabCursor;
+    /// <summary>End of the carvable area in the current slab</summary>
+    private: std::uint8_t *slabEnd;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Returns the depots of all size classes</summary>
+  /// <returns>An array holding one depot for each size class</returns>
+  /// <remarks>
+  ///   The depots are intentionally never destroyed: threads may still free blocks
+  ///   while static objects are being destroyed at process exit.
+  /// </remarks>
+  SizeClassDepot *getDepots() {
+    static SizeClassDepot *depots = []() {
+      SizeClassDepot *newDepots = new SizeClassDepot[SizeClassCount];
+      for(std::size_t index = 0; index < SizeClassCount; ++index) {
+        newDepots[index].SetBlockSize(MinimumBlockSize << index);
+      }
+      return newDepots;
+    }();
+    return depots;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Whether the calling thread's magazine cache has been destroyed</summary>
+  /// <remarks>
+  ///   Other thread-local objects may still allocate or free blocks in their destructors
+  ///   after the cache is gone. Those calls go straight to the depots.
+  /// </remarks>
+  thread_local bool threadCacheDestroyed = false;
+
+  /// <summary>Magazines owned by one thread</summary>
+  class ThreadCache {
+
+    /// <summary>Gives all magazines of the thread back to the depots</summary>
+    public: ~ThreadCache() {
+      threadCacheDestroyed = true;
+
+      SizeClassDepot *depots = getDepots();
+      for(std::size_t index = 0; index < SizeClassCount; ++index) {
+        if(this->Loaded[index] != nullptr) {
+          depots[index].ReturnMagazine(this->Loaded[index]);
+        }
+        if(this->Previous[index] != nullptr) {
+          depots[index].ReturnMagazine(this->Previous[index]);
+        }
+      }
+    }
+
+    /// <summary>Magazine blocks are taken from and returned to first</summary>
+    public: Magazine *Loaded[SizeClassCount] = {};
+    /// <summary>Backup magazine, always either full or empty</summary>
+    /// <remarks>
+    ///   Having a second magazine prevents a thread that alternates between
+    ///   allocating and freeing right at the edge of a magazine from visiting
+    ///   the depot on every call.
+    /// </remarks>
+    public: Magazine *Previous[SizeClassCount] = {};
+
+  };
+
+  /// <summary>Magazines of the calling thread</summary>
+  thread_local ThreadCache threadCache;
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void *SlabMemory::Allocate(std::size_t byteCount) {
+    if(byteCount > MaximumBlockSize) [[unlikely]] {
+      return ::operator new(byteCount);
+    }
+
+    std::size_t sizeClass = getSizeClass(byteCount);
+    if(threadCacheDestroyed) [[unlikely]] {
+      return getDepots()[sizeClass].AllocateLooseBlock();
+    }
+
+    ThreadCache &cache = threadCache;
+    Magazine *loaded = cache.Loaded[sizeClass];
+    if((loaded != nullptr) && (loaded->Count > 0)) [[likely]] {
+      return loaded->Blocks[--loaded->Count];
+    }
+
+    Magazine *previous = cache.Previous[sizeClass];
+    if((previous != nullptr) && (previous->Count > 0)) {
+      std::swap(cache.Loaded[sizeClass], cache.Previous[sizeClass]);
+      return previous->Blocks[--previous->Count];
+    }
+
+    // Both magazines are empty (or don't exist yet), trade one for a full magazine
+    loaded = getDepots()[sizeClass].TradeForFullMagazine(loaded);
+    cache.Loaded[sizeClass] = loaded;
+    return loaded->Blocks[--loaded->Count];
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void SlabMemory::Free(void *memory, std::size_t byteCount) noexcept {
+    if(memory == nullptr) [[unlikely]] {
+      return;
+    }
+    if(byteCount > MaximumBlockSize) [[unlikely]] {
+      ::operator delete(memory);
+      return;
+    }
+
+    std::size_t sizeClass = getSizeClass(byteCount);
+    if(threadCacheDestroyed) [[unlikely]] {
+      getDepots()[sizeClass].FreeLooseBlock(memory);
+      return;
+    }
+
+    ThreadCache &cache = threadCache;
+    Magazine *loaded = cache.Loaded[sizeClass];
+    Magazine *previous = cache.Previous[sizeClass];
+    if(loaded != nullptr) [[likely]] {
+      if(loaded->Count < MagazineCapacity) [[likely]] {
+        loaded->Blocks[loaded->Count++] = memory;
+        return;
+      }
+      if((previous != nullptr) && (previous->Count == 0)) {
+        std::swap(cache.Loaded[sizeClass], cache.Previous[sizeClass]);
+        previous->Blocks[previous->Count++] = memory;
+        return;
+      }
+    }
+
+    // Both magazines are full (or don't exist yet), hand the backup magazine
+    // to the depot and continue with an empty one
+    SizeClassDepot &depot = getDepots()[sizeClass];
+    Magazine *emptyMagazine = depot.TradeForEmptyMagazine(previous);
+    if(emptyMagazine == nullptr) [[unlikely]] {
+      depot.FreeLooseBlock(memory); // Out of memory for a new magazine
+      return;
+    }
+
+    cache.Previous[sizeClass] = loaded;
+    cache.Loaded[sizeClass] = emptyMagazine;
+    emptyMagazine->Blocks[emptyMagazine->Count++] = memory;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
@@ -0,0 +1,73 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Collections/TimerWheel.h"
+
+#include <stdexcept> // for std::invalid_argument
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TimerWheel::TimerWheel(std::size_t slotCount, std::uint64_t currentTick) :
+    slotCount(slotCount),
+    currentTick(currentTick),
+    links(),
+    deadlines() {
+
+    // Slots and bucket heads are linked by 32 bit indices, with one value
+    // reserved to mark unscheduled slots
+    if(slotCount + LevelCount * BucketsPerLevel >= std::size_t(Unscheduled)) {
+      throw std::invalid_argument(
+        reinterpret_cast<const char *>(u8"Slot count exceeds what the timer wheel can track")
+      );
+    }
+
+    this->links.reset(new Link[slotCount + LevelCount * BucketsPerLevel]);
+    this->deadlines.reset(new std::uint64_t[slotCount]);
+
+    Clear();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TimerWheel::~TimerWheel() = default;
+
+  // ------------------------------------------------------------------------------------------- //
+
+  void TimerWheel::Clear() {
+    for(std::size_t index = 0; index < this->slotCount; ++index) {
+      this->links[index].Next = Unscheduled;
+    }
+
+    // Empty buckets are heads whose circular list points back to themselves
+    std::size_t headCount = LevelCount * BucketsPerLevel;
+    for(std::size_t index = 0; index < headCount; ++index) {
+      std::uint32_t head = static_cast<std::uint32_t>(this->slotCount + index);
+      this->links[head].Next = head;
+      this->links[head].Previous = head;
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
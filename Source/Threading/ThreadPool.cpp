@@ -29,12 +29,15 @@ limitations under the License.
 #include "Nuclex/Support/Threading/Gate.h" // for Gate
 #include "Nuclex/Support/Threading/Semaphore.h" // for Semaphore
 #include "Nuclex/Support/Text/StringConverter.h" // for StringConverter
+#include "Nuclex/Support/Collections/ConcurrentSegmentedQueue.h" // for ConcurrentSegmentedQueue
 
 #include "ThreadPoolTaskPool.h" // thread pool settings + task pool
+#include "ThreadPoolWorkStealingDeque.h" // for ThreadPoolWorkStealingDeque
 
 #include <cassert> // for assert()
 #include <atomic> // for std::atomic
 #include <thread> // for std::thread
+#include <memory> // for std::unique_ptr
 
 #if defined(NUCLEX_SUPPORT_LINUX)
 #include "../Interop/PosixTimeApi.h" // error handling helpers, time helpers
@@ -117,6 +120,32 @@ namespace Nuclex::Support::Threading {
     /// <summary>Fast-forwards through all tasks, destroying them</summary>
     private: void cancelAllTasks();
 
+    /// <summary>Takes the next task the calling worker thread should execute</summary>
+    /// <param name="threadIndex">Index of the worker thread looking for a task</param>
+    /// <param name="submittedTask">Receives the task if one was found</param>
+    /// <returns>True if a task was found, false if there was nothing to do</returns>
+    /// <remarks>
+    ///   The worker first looks in its own deque, then in the shared queue and
+    ///   finally tries to steal the oldest task from any other worker's deque.
+    /// </remarks>
+    private: bool tryTakeTask(std::size_t threadIndex, SubmittedTask *&submittedTask);
+
+    /// <summary>Tries to steal a task from any worker thread's deque</summary>
+    /// <param name="firstVictimIndex">Index of the first worker that will be robbed</param>
+    /// <param name="submittedTask">Receives the task if one was stolen</param>
+    /// <returns>True if a task was stolen, false if all deques were empty</returns>
+    private: bool tryStealTask(std::size_t firstVictimIndex, SubmittedTask *&submittedTask);
+
+    /// <summary>Thread pool the calling thread is a worker thread of, if any</summary>
+    /// <remarks>
+    ///   <see cref="ThreadPoolConfig::IsThreadPoolThread" /> is true for the workers of
+    ///   any thread pool, so this is needed to tell whether the deque of the calling
+    ///   thread belongs to the thread pool a task is being scheduled in.
+    /// </remarks>
+    public: thread_local static const PlatformDependentImplementation *CurrentThreadPool;
+    /// <summary>Index of the thread slot the calling worker thread occupies</summary>
+    public: thread_local static std::size_t CurrentThreadIndex;
+
     /// <summary>Minimum number of threads to always keep running</summary>
     public: std::size_t MinimumThreadCount;
     /// <summary>Maximum number of threads to create under high load</summary>
@@ -132,7 +161,7 @@ namespace Nuclex::Support::Threading {
     /// <summary>Incremented by the last thread exiting when IsShuttingDown is true</summary>
     public: Gate LightsOut;
     /// <summary>Tasks that have been scheduled for execution in the thread pool</summary>
-    public: moodycamel::ConcurrentQueue<SubmittedTask *> ScheduledTasks;
+    public: Collections::ConcurrentSegmentedQueue<SubmittedTask *> ScheduledTasks;
     /// <summary>Submitted tasks for re-use</summary>
     public: ThreadPoolTaskPool<
       SubmittedTask, offsetof(SubmittedTask, Payload)
@@ -144,11 +173,28 @@ namespace Nuclex::Support::Threading {
     public: std::atomic<std::int8_t> *ThreadStatus;
     /// <summary>Running threads, capacity is always ProcessorCount * 2</summary>
     public: std::thread *Threads;
+    /// <summary>Tasks scheduled by each worker thread, indexed like the threads</summary>
+    /// <remarks>
+    ///   Only allocated if <see cref="ThreadPoolConfig::UseWorkStealing" /> is enabled.
+    ///   Deques belong to thread slots rather than threads, so when a slot is reused,
+    ///   the new thread takes over the deque (which is always empty at that point
+    ///   because a worker only exits after finding nothing to do for a while).
+    /// </remarks>
+    public: std::unique_ptr<ThreadPoolWorkStealingDeque<SubmittedTask *>[]> LocalTasks;
 
   };
 
   // ------------------------------------------------------------------------------------------- //
 
+  thread_local const ThreadPool::PlatformDependentImplementation *
+  ThreadPool::PlatformDependentImplementation::CurrentThreadPool = nullptr;
+
+  // ------------------------------------------------------------------------------------------- //
+
+  thread_local std::size_t ThreadPool::PlatformDependentImplementation::CurrentThreadIndex = 0;
+
+  // ------------------------------------------------------------------------------------------- //
+
   ThreadPool::PlatformDependentImplementation *
   ThreadPool::PlatformDependentImplementation::CreateInstance(
     std::size_t minimumThreadCount, std::size_t maximumThreadCount
@@ -229,7 +275,14 @@ namespace Nuclex::Support::Threading {
 
     // Before shutting down, the worker threads should have called cancelAllTasks(),
     // destroying all scheduled tasks without invoking their callbacks.
-    assert(instance->ScheduledTasks.size_approx() == 0);
+    assert(instance->ScheduledTasks.IsEmpty());
+#if !defined(NDEBUG)
+    if constexpr(ThreadPoolConfig::UseWorkStealing) {
+      for(std::size_t index = 0; index < instance->MaximumThreadCount; ++index) {
+        assert(instance->LocalTasks[index].IsEmpty());
+      }
+    }
+#endif
 
     // Leave the rest up to the normal destructor, then reclaim the memory
     instance->~PlatformDependentImplementation();
@@ -252,7 +305,16 @@ namespace Nuclex::Support::Threading {
     ScheduledTasks(),
     SubmittedTaskPool(),
     ThreadStatus(nullptr),
-    Threads(nullptr) {}
+    Threads(nullptr),
+    LocalTasks() {
+
+    if constexpr(ThreadPoolConfig::UseWorkStealing) {
+      this->LocalTasks.reset(
+        new ThreadPoolWorkStealingDeque<SubmittedTask *>[maximumThreadCount]
+      );
+    }
+
+  }
 
   // ------------------------------------------------------------------------------------------- //
 
@@ -335,6 +397,8 @@ namespace Nuclex::Support::Threading {
 
   void ThreadPool::PlatformDependentImplementation::runThreadWorkLoop(std::size_t threadIndex) {
     ThreadPoolConfig::IsThreadPoolThread = true;
+    CurrentThreadPool = this;
+    CurrentThreadIndex = threadIndex;
 
     // Mark the thread as running
     this->ThreadStatus[threadIndex].store(2, std::memory_order_release);
@@ -401,7 +465,7 @@ namespace Nuclex::Support::Threading {
       // Execute a task and return the submitted task container to the pool
       {
         SubmittedTask *submittedTask;
-        bool wasDequeued = this->ScheduledTasks.try_dequeue(submittedTask);
+        bool wasDequeued = tryTakeTask(threadIndex, submittedTask);
         if(wasDequeued) {
           ON_SCOPE_EXIT {
             this->TaskCount.fetch_sub(1, std::memory_order_release);
@@ -421,7 +485,12 @@ namespace Nuclex::Support::Threading {
   void ThreadPool::PlatformDependentImplementation::cancelAllTasks() {
     for(;;) {
       SubmittedTask *submittedTask;
-      bool wasDequeued = this->ScheduledTasks.try_dequeue(submittedTask);
+      bool wasDequeued = this->ScheduledTasks.TryTake(submittedTask);
+      if(!wasDequeued) {
+        if constexpr(ThreadPoolConfig::UseWorkStealing) {
+          wasDequeued = tryStealTask(0, submittedTask);
+        }
+      }
       if(wasDequeued) {
         submittedTask->Task->~Task();
         this->SubmittedTaskPool.DeleteTask(submittedTask);
@@ -433,6 +502,59 @@ namespace Nuclex::Support::Threading {
 
   // ------------------------------------------------------------------------------------------- //
 
+  bool ThreadPool::PlatformDependentImplementation::tryTakeTask(
+    std::size_t threadIndex, SubmittedTask *&submittedTask
+  ) {
+    if constexpr(ThreadPoolConfig::UseWorkStealing) {
+
+      // Our own newest task first, its data is most likely still in our cache
+      if(this->LocalTasks[threadIndex].TryTake(submittedTask)) {
+        return true;
+      }
+
+      // Then tasks scheduled from outside the thread pool, in the order they came in
+      if(this->ScheduledTasks.TryTake(submittedTask)) {
+        return true;
+      }
+
+      // Then the oldest task of another worker, starting with our neighbour so that
+      // not all idle workers pile onto the deque of the first thread
+      return tryStealTask(threadIndex + 1, submittedTask);
+
+    } else {
+      return this->ScheduledTasks.TryTake(submittedTask);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  bool ThreadPool::PlatformDependentImplementation::tryStealTask(
+    std::size_t firstVictimIndex, SubmittedTask *&submittedTask
+  ) {
+    for(;;) {
+      bool wasContended = false;
+
+      for(std::size_t offset = 0; offset < this->MaximumThreadCount; ++offset) {
+        std::size_t victimIndex = (firstVictimIndex + offset) % this->MaximumThreadCount;
+
+        StealResult result = this->LocalTasks[victimIndex].TrySteal(submittedTask);
+        if(result == StealResult::Success) {
+          return true;
+        } else if(result == StealResult::Contended) {
+          wasContended = true;
+        }
+      }
+
+      // If we lost a race for a task, that deque may well hold more tasks, so only
+      // give up once we have seen all deques empty
+      if(!wasContended) {
+        return false;
+      }
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
   std::size_t ThreadPool::GetDefaultMinimumThreadCount() {
 #if defined(NUCLEX_SUPPORT_LINUX)
     return ThreadPoolConfig::GuessDefaultMinimumThreadCount(
@@ -534,8 +656,31 @@ namespace Nuclex::Support::Threading {
 
     submittedTask->Task = task;
 
+    // If the task is scheduled by one of our own worker threads, put it in that
+    // worker's deque. The worker will get to it as soon as it is done with its current
+    // task and idle workers can steal it before then.
+    if constexpr(ThreadPoolConfig::UseWorkStealing) {
+      bool isOwnWorkerThread = (
+        ThreadPoolConfig::IsThreadPoolThread &&
+        (PlatformDependentImplementation::CurrentThreadPool == this->implementation)
+      );
+      if(isOwnWorkerThread) {
+        auto deleteTaskScope = ON_SCOPE_EXIT_TRANSACTION {
+          submittedTask->Task->~Task();
+          this->implementation->SubmittedTaskPool.DeleteTask(submittedTask);
+        };
+        std::size_t threadIndex = PlatformDependentImplementation::CurrentThreadIndex;
+        this->implementation->LocalTasks[threadIndex].Push(submittedTask);
+        deleteTaskScope.Commit();
+
+        this->implementation->TaskCount.fetch_add(1, std::memory_order_release);
+        this->implementation->TaskSemaphore.Post();
+        return;
+      }
+    }
+
     // Task is ready, schedule it for execution by a worker thread
-    bool wasEnqueued = this->implementation->ScheduledTasks.enqueue(submittedTask);
+    bool wasEnqueued = this->implementation->ScheduledTasks.TryAppend(submittedTask);
     if(wasEnqueued) [[likely]] {
       this->implementation->TaskCount.fetch_add(1, std::memory_order_release);
     } else {
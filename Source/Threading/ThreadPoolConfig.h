@@ -98,6 +98,26 @@ namespace Nuclex::Support::Threading {
     /// </remarks>
     public: static const constexpr std::size_t IdleShutDownHeartBeats = 10;
 
+    /// <summary>Whether worker threads keep the tasks they schedule in their own deque</summary>
+    /// <remarks>
+    ///   <para>
+    ///     With work stealing enabled, tasks scheduled from a thread pool thread do not go
+    ///     into the shared queue but onto a deque owned by the scheduling worker. The worker
+    ///     takes its newest tasks first, which keeps the data of recursively split work hot
+    ///     in its cache, while idle workers steal the oldest tasks from the other end.
+    ///   </para>
+    ///   <para>
+    ///     Tasks scheduled from any other thread still go into the shared queue.
+    ///   </para>
+    ///   <para>
+    ///     This value is only used by the Linux implementation of the thread pool
+    ///   </para>
+    /// </remarks>
+    public: static const constexpr bool UseWorkStealing = true;
+
+    /// <summary>Number of tasks each worker's deque can hold before it has to grow</summary>
+    public: static const constexpr std::size_t WorkStealingDequeCapacity = 64;
+
     /// <summary>Guesses a good default for the number of threads to keep alive</summary>
     /// <param name="processorCount">Number of processors (CPU cores) in the system</param>
     /// <returns>The default value for the thread pool's minimum thread count</returns>
@@ -0,0 +1,252 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+#ifndef NUCLEX_SUPPORT_THREADING_THREADPOOLWORKSTEALINGDEQUE_H
+#define NUCLEX_SUPPORT_THREADING_THREADPOOLWORKSTEALINGDEQUE_H
+
+#include "Nuclex/Support/Config.h"
+#include "ThreadPoolConfig.h"
+
+#include <cstddef> // for std::size_t, std::ptrdiff_t
+#include <atomic> // for std::atomic
+#include <memory> // for std::unique_ptr
+#include <type_traits> // for std::is_trivially_copyable
+
+namespace Nuclex::Support::Threading {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Outcome of an attempt to steal an element from a work stealing deque</summary>
+  enum class StealResult {
+
+    /// <summary>An element was stolen</summary>
+    Success,
+    /// <summary>The deque was empty</summary>
+    Empty,
+    /// <summary>Another thread took the element first, the deque may not be empty</summary>
+    Contended
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Deque owned by one worker thread that other threads can steal from</summary>
+  /// <typeparam name="TElement">Type of elements stored in the deque, usually pointers</typeparam>
+  /// <remarks>
+  ///   <para>
+  ///     This is the Chase-Lev deque, using the memory orderings worked out by Lê, Pop,
+  ///     Cohen and Zappa Nardelli. The owning thread pushes and takes elements at
+  ///     the bottom end without any atomic read-modify-write operation, except when
+  ///     taking the very last element. Other threads steal from the top end with
+  ///     a single compare-and-swap.
+  ///   </para>
+  ///   <para>
+  ///     When the owner runs out of space, the deque's ring buffer is replaced by
+  ///     one twice as large. Thieves may still be reading from the old buffer at
+  ///     that point, so replaced buffers are kept until the deque is destroyed.
+  ///   </para>
+  ///   <para>
+  ///     <see cref="Push" /> and <see cref="TryTake" /> must only ever be called by
+  ///     the owning thread. <see cref="TrySteal" /> can be called by any thread.
+  ///   </para>
+  /// </remarks>
+  template<typename TElement>
+  class alignas(NUCLEX_SUPPORT_CACHE_LINE_SIZE) ThreadPoolWorkStealingDeque {
+
+    static_assert(
+      std::is_trivially_copyable<TElement>::value,
+      u8"Work stealing deque elements must be trivially copyable"
+    );
+
+    #pragma region struct Buffer
+
+    /// <summary>Ring buffer holding the elements of the deque</summary>
+    private: struct Buffer {
+
+      /// <summary>Initializes a new ring buffer</summary>
+      /// <param name="capacity">Number of elements, must be a power of two</param>
+      public: explicit Buffer(std::size_t capacity) :
+        Capacity(static_cast<std::ptrdiff_t>(capacity)),
+        Elements(new std::atomic<TElement>[capacity]),
+        Previous() {}
+
+      /// <summary>Reads the element stored for the specified index</summary>
+      /// <param name="index">Index of the element that will be read</param>
+      /// <returns>The element stored for the specified index</returns>
+      public: TElement Get(std::ptrdiff_t index) const {
+        return this->Elements[index & (this->Capacity - 1)].load(std::memory_order_relaxed);
+      }
+
+      /// <summary>Stores an element for the specified index</summary>
+      /// <param name="index">Index under which the element will be stored</param>
+      /// <param name="element">Element that will be stored</param>
+      public: void Put(std::ptrdiff_t index, TElement element) {
+        this->Elements[index & (this->Capacity - 1)].store(element, std::memory_order_relaxed);
+      }
+
+      /// <summary>Number of elements the ring buffer can hold</summary>
+      public: std::ptrdiff_t Capacity;
+      /// <summary>Elements, atomic because thieves may read a slot the owner writes</summary>
+      public: std::unique_ptr<std::atomic<TElement>[]> Elements;
+      /// <summary>Smaller buffer this one replaced, kept alive for late thieves</summary>
+      public: std::unique_ptr<Buffer> Previous;
+
+    };
+
+    #pragma endregion // struct Buffer
+
+    /// <summary>Initializes a new work stealing deque</summary>
+    /// <param name="capacity">
+    ///   Number of elements the deque can hold before it has to grow, must be a power of two
+    /// </param>
+    public: explicit ThreadPoolWorkStealingDeque(
+      std::size_t capacity = ThreadPoolConfig::WorkStealingDequeCapacity
+    ) :
+      top(0),
+      bottom(0),
+      buffer(new Buffer(capacity)) {}
+
+    /// <summary>Frees all memory used by the deque</summary>
+    /// <remarks>
+    ///   Elements still in the deque are simply forgotten, if they are pointers to
+    ///   something that needs freeing, the owner has to take them out beforehand.
+    /// </remarks>
+    public: ~ThreadPoolWorkStealingDeque() {
+      delete this->buffer.load(std::memory_order_relaxed);
+    }
+
+    /// <summary>Adds an element at the owner's end of the deque</summary>
+    /// <param name="element">Element that will be added</param>
+    /// <remarks>
+    ///   Must only be called by the thread owning the deque. If the deque has to grow
+    ///   and memory cannot be allocated, the deque is left unchanged.
+    /// </remarks>
+    public: void Push(TElement element) {
+      std::ptrdiff_t bottomIndex = this->bottom.load(std::memory_order_relaxed);
+      std::ptrdiff_t topIndex = this->top.load(std::memory_order_acquire);
+      Buffer *currentBuffer = this->buffer.load(std::memory_order_relaxed);
+      if(bottomIndex - topIndex >= currentBuffer->Capacity) [[unlikely]] {
+        currentBuffer = grow(currentBuffer, topIndex, bottomIndex);
+      }
+
+      currentBuffer->Put(bottomIndex, element);
+      this->bottom.store(bottomIndex + 1, std::memory_order_release);
+    }
+
+    /// <summary>Takes the most recently added element from the owner's end</summary>
+    /// <param name="element">Receives the element if one could be taken</param>
+    /// <returns>True if an element was taken, false if the deque was empty</returns>
+    /// <remarks>
+    ///   Must only be called by the thread owning the deque.
+    /// </remarks>
+    public: bool TryTake(TElement &element) {
+      std::ptrdiff_t bottomIndex = this->bottom.load(std::memory_order_relaxed) - 1;
+      Buffer *currentBuffer = this->buffer.load(std::memory_order_relaxed);
+
+      // Claim the bottom element before looking at the top, so a thief that reads
+      // the top after us will see that the element is no longer available
+      this->bottom.store(bottomIndex, std::memory_order_seq_cst);
+      std::ptrdiff_t topIndex = this->top.load(std::memory_order_seq_cst);
+
+      if(topIndex > bottomIndex) { // Deque was empty
+        this->bottom.store(bottomIndex + 1, std::memory_order_relaxed);
+        return false;
+      }
+
+      element = currentBuffer->Get(bottomIndex);
+      if(topIndex < bottomIndex) { // More than one element left, no thief can interfere
+        return true;
+      }
+
+      // This was the last element, so we have to race any thieves for it
+      bool wasTaken = this->top.compare_exchange_strong(
+        topIndex, topIndex + 1, std::memory_order_seq_cst, std::memory_order_relaxed
+      );
+      this->bottom.store(bottomIndex + 1, std::memory_order_relaxed);
+      return wasTaken;
+    }
+
+    /// <summary>Steals the oldest element from the deque</summary>
+    /// <param name="element">Receives the element if one could be stolen</param>
+    /// <returns>Whether an element was stolen or why not</returns>
+    /// <remarks>
+    ///   Can be called by any thread.
+    /// </remarks>
+    public: StealResult TrySteal(TElement &element) {
+      std::ptrdiff_t topIndex = this->top.load(std::memory_order_seq_cst);
+      std::ptrdiff_t bottomIndex = this->bottom.load(std::memory_order_seq_cst);
+      if(topIndex >= bottomIndex) {
+        return StealResult::Empty;
+      }
+
+      Buffer *currentBuffer = this->buffer.load(std::memory_order_acquire);
+      TElement stolenElement = currentBuffer->Get(topIndex);
+      bool wasStolen = this->top.compare_exchange_strong(
+        topIndex, topIndex + 1, std::memory_order_seq_cst, std::memory_order_relaxed
+      );
+      if(!wasStolen) {
+        return StealResult::Contended;
+      }
+
+      element = stolenElement;
+      return StealResult::Success;
+    }
+
+    /// <summary>Checks whether the deque is empty</summary>
+    /// <returns>True if the deque was empty at the time of the call</returns>
+    public: bool IsEmpty() const {
+      std::ptrdiff_t topIndex = this->top.load(std::memory_order_seq_cst);
+      std::ptrdiff_t bottomIndex = this->bottom.load(std::memory_order_seq_cst);
+      return (topIndex >= bottomIndex);
+    }
+
+    /// <summary>Replaces the ring buffer with one twice as large</summary>
+    /// <param name="currentBuffer">Ring buffer currently in use</param>
+    /// <param name="topIndex">Index of the oldest element in the deque</param>
+    /// <param name="bottomIndex">Index one past the newest element in the deque</param>
+    /// <returns>The new ring buffer</returns>
+    private: Buffer *grow(
+      Buffer *currentBuffer, std::ptrdiff_t topIndex, std::ptrdiff_t bottomIndex
+    ) {
+      std::unique_ptr<Buffer> newBuffer(
+        new Buffer(static_cast<std::size_t>(currentBuffer->Capacity) * 2)
+      );
+      for(std::ptrdiff_t index = topIndex; index < bottomIndex; ++index) {
+        newBuffer->Put(index, currentBuffer->Get(index));
+      }
+
+      newBuffer->Previous.reset(currentBuffer);
+      this->buffer.store(newBuffer.get(), std::memory_order_release);
+      return newBuffer.release();
+    }
+
+    /// <summary>Index of the oldest element, advanced by thieves</summary>
+    private: alignas(NUCLEX_SUPPORT_CACHE_LINE_SIZE) std::atomic<std::ptrdiff_t> top;
+    /// <summary>Index one past the newest element, only changed by the owner</summary>
+    private: alignas(NUCLEX_SUPPORT_CACHE_LINE_SIZE) std::atomic<std::ptrdiff_t> bottom;
+    /// <summary>Ring buffer currently holding the elements</summary>
+    private: std::atomic<Buffer *> buffer;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Threading
+
+#endif // NUCLEX_SUPPORT_THREADING_THREADPOOLWORKSTEALINGDEQUE_H
@@ -0,0 +1,201 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Collections/ConcurrentHashMap.h"
+
+#include <gtest/gtest.h>
+
+#include <string> // for std::string, std::u8string
+#include <thread> // for std::thread
+#include <vector> // for std::vector
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentHashMapTest, InstancesCanBeCreated) {
+    EXPECT_NO_THROW(
+      (ConcurrentHashMap<int, int>())
+    );
+    EXPECT_NO_THROW(
+      (ConcurrentHashMap<std::u8string, std::u8string>(16, 4))
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentHashMapTest, NewInstanceIsEmpty) {
+    ConcurrentHashMap<int, int> test;
+    EXPECT_TRUE(test.IsEmpty());
+    EXPECT_EQ(test.Count(), 0U);
+
+    int value = 0;
+    EXPECT_FALSE(test.TryGet(123, value));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentHashMapTest, ItemsCanBeInsertedAndLookedUp) {
+    ConcurrentHashMap<int, int> test;
+    EXPECT_TRUE(test.TryInsert(1, 10));
+    EXPECT_TRUE(test.TryInsert(2, 20));
+    EXPECT_FALSE(test.TryInsert(1, 30));
+    EXPECT_EQ(test.Count(), 2U);
+
+    int value = 0;
+    EXPECT_TRUE(test.TryGet(1, value));
+    EXPECT_EQ(value, 10);
+    EXPECT_TRUE(test.TryGet(2, value));
+    EXPECT_EQ(value, 20);
+    EXPECT_TRUE(test.Contains(2));
+    EXPECT_FALSE(test.Contains(3));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentHashMapTest, ItemsCanBeTakenAndRemoved) {
+    ConcurrentHashMap<std::u8string, std::u8string> test(16, 2);
+    EXPECT_TRUE(test.TryInsert(u8"Hello", u8"World"));
+    EXPECT_TRUE(test.TryInsert(u8"Foo", u8"Bar"));
+
+    std::u8string value;
+    EXPECT_TRUE(test.TryTake(u8"Hello", value));
+    EXPECT_EQ(value, u8"World");
+    EXPECT_FALSE(test.TryTake(u8"Hello", value));
+
+    EXPECT_TRUE(test.TryRemove(u8"Foo"));
+    EXPECT_FALSE(test.TryRemove(u8"Foo"));
+    EXPECT_TRUE(test.IsEmpty());
+
+    // Deleted slots must be reusable
+    EXPECT_TRUE(test.TryInsert(u8"Hello", u8"Again"));
+    EXPECT_TRUE(test.TryGet(u8"Hello", value));
+    EXPECT_EQ(value, u8"Again");
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentHashMapTest, MapGrowsBeyondInitialCapacity) {
+    ConcurrentHashMap<int, std::string> test(8, 2);
+    for(int index = 0; index < 1000; ++index) {
+      EXPECT_TRUE(test.TryInsert(index, std::to_string(index)));
+    }
+    EXPECT_EQ(test.Count(), 1000U);
+
+    std::string value;
+    for(int index = 0; index < 1000; ++index) {
+      ASSERT_TRUE(test.TryGet(index, value));
+      EXPECT_EQ(value, std::to_string(index));
+    }
+
+    // Churn through removals and inserts so deleted slots pile up and get cleaned out
+    for(int index = 0; index < 1000; index += 2) {
+      EXPECT_TRUE(test.TryRemove(index));
+      EXPECT_TRUE(test.TryInsert(index + 1000, std::to_string(index + 1000)));
+    }
+    EXPECT_EQ(test.Count(), 1000U);
+    EXPECT_FALSE(test.Contains(0));
+    EXPECT_TRUE(test.Contains(1));
+    EXPECT_TRUE(test.Contains(1998));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentHashMapTest, ChurnOfTriviallyCopyableEntriesWorksInPlace) {
+    ConcurrentHashMap<int, int> test(16, 1);
+    ASSERT_TRUE((ConcurrentHashMap<int, int>::UsesOptimisticReads));
+
+    // A sliding window of live keys, so the stripe's table keeps filling up with
+    // deleted slots that have to be cleaned out without the table growing
+    for(int index = 0; index < 10000; ++index) {
+      EXPECT_TRUE(test.TryInsert(index, index * 2));
+      if(index >= 8) {
+        EXPECT_TRUE(test.TryRemove(index - 8));
+      }
+    }
+    EXPECT_EQ(test.Count(), 8U);
+
+    int value = 0;
+    for(int index = 9992; index < 10000; ++index) {
+      ASSERT_TRUE(test.TryGet(index, value));
+      EXPECT_EQ(value, index * 2);
+    }
+    EXPECT_FALSE(test.Contains(9991));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentHashMapTest, ReadersSeeConsistentValuesWhileWritersModifyMap) {
+    ConcurrentHashMap<std::size_t, std::size_t> test(16, 4);
+    const std::size_t keyCount = 5000;
+
+    std::atomic<bool> writersDone(false);
+    std::atomic<std::size_t> inconsistentReadCount(0);
+
+    std::vector<std::thread> threads;
+    for(std::size_t writerIndex = 0; writerIndex < 2; ++writerIndex) {
+      threads.emplace_back(
+        [&test, writerIndex, keyCount]() {
+          for(std::size_t key = writerIndex; key < keyCount; key += 2) {
+            EXPECT_TRUE(test.TryInsert(key, key * 3));
+            if((key % 7) == 0) {
+              EXPECT_TRUE(test.TryRemove(key));
+            }
+          }
+        }
+      );
+    }
+    for(std::size_t readerIndex = 0; readerIndex < 2; ++readerIndex) {
+      threads.emplace_back(
+        [&test, &writersDone, &inconsistentReadCount, keyCount]() {
+          std::size_t value = 0;
+          while(!writersDone.load(std::memory_order_relaxed)) {
+            for(std::size_t key = 0; key < keyCount; key += 13) {
+              if(test.TryGet(key, value) && (value != key * 3)) {
+                inconsistentReadCount.fetch_add(1, std::memory_order_relaxed);
+              }
+            }
+          }
+        }
+      );
+    }
+
+    threads[0].join();
+    threads[1].join();
+    writersDone.store(true, std::memory_order_relaxed);
+    threads[2].join();
+    threads[3].join();
+
+    EXPECT_EQ(inconsistentReadCount.load(), 0U);
+
+    std::size_t expectedCount = 0;
+    for(std::size_t key = 0; key < keyCount; ++key) {
+      if((key % 7) != 0) {
+        ++expectedCount;
+      }
+    }
+    EXPECT_EQ(test.Count(), expectedCount);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
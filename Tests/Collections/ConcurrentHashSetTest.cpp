@@ -0,0 +1,214 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Collections/ConcurrentHashSet.h"
+
+#include <gtest/gtest.h>
+
+#include <thread> // for std::thread
+#include <vector> // for std::vector
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Terrible hash function that makes all keys collide</summary>
+  struct CollidingHash {
+
+    /// <summary>Calculates the hash of the specified key</summary>
+    /// <returns>The same hash, no matter which key is specified</returns>
+    public: std::size_t operator()(int) const { return 42; }
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentHashSetTest, InstancesCanBeCreated) {
+    EXPECT_NO_THROW(
+      ConcurrentHashSet<int> test(100);
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentHashSetTest, CapacityIsAtLeastWhatWasRequested) {
+    ConcurrentHashSet<int> test(1000);
+    EXPECT_GE(test.GetCapacity(), 1000U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentHashSetTest, KeysCanBeInsertedAndRemoved) {
+    ConcurrentHashSet<int> test(100);
+    EXPECT_TRUE(test.IsEmpty());
+
+    EXPECT_TRUE(test.TryInsert(1));
+    EXPECT_TRUE(test.TryInsert(2));
+    EXPECT_FALSE(test.TryInsert(1));
+    EXPECT_EQ(test.Count(), 2U);
+    EXPECT_TRUE(test.Contains(1));
+    EXPECT_FALSE(test.Contains(3));
+
+    EXPECT_TRUE(test.TryRemove(1));
+    EXPECT_FALSE(test.TryRemove(1));
+    EXPECT_FALSE(test.Contains(1));
+    EXPECT_EQ(test.Count(), 1U);
+
+    EXPECT_TRUE(test.TryInsert(1));
+    EXPECT_TRUE(test.Contains(1));
+    EXPECT_EQ(test.Count(), 2U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentHashSetTest, CollidingKeysSpillIntoFurtherGroups) {
+    ConcurrentHashSet<int, CollidingHash> test(100);
+    for(int index = 0; index < 50; ++index) {
+      EXPECT_TRUE(test.TryInsert(index));
+    }
+    for(int index = 0; index < 50; ++index) {
+      EXPECT_TRUE(test.Contains(index));
+    }
+    EXPECT_FALSE(test.Contains(50));
+    EXPECT_TRUE(test.TryRemove(20));
+    EXPECT_FALSE(test.Contains(20));
+    EXPECT_TRUE(test.Contains(49));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentHashSetTest, SetGrowsWhenFull) {
+    ConcurrentHashSet<int> test(20);
+    std::size_t initialCapacity = test.GetCapacity();
+
+    for(int index = 0; index < 1000; ++index) {
+      EXPECT_TRUE(test.TryInsert(index));
+    }
+    EXPECT_EQ(test.Count(), 1000U);
+    EXPECT_GT(test.GetCapacity(), initialCapacity);
+
+    for(int index = 0; index < 1000; ++index) {
+      EXPECT_TRUE(test.Contains(index));
+      EXPECT_FALSE(test.TryInsert(index));
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentHashSetTest, RemovedSlotsAreReclaimed) {
+    ConcurrentHashSet<int> test(20);
+    std::size_t initialCapacity = test.GetCapacity();
+
+    // Far more distinct keys go through the set than it has slots, but only a few
+    // are present at any time, so the set should clean up rather than grow
+    for(int index = 0; index < 10000; ++index) {
+      EXPECT_TRUE(test.TryInsert(index));
+      if(index >= 4) {
+        EXPECT_TRUE(test.TryRemove(index - 4));
+      }
+    }
+    EXPECT_EQ(test.Count(), 4U);
+    EXPECT_EQ(test.GetCapacity(), initialCapacity);
+
+    EXPECT_FALSE(test.Contains(9995));
+    EXPECT_TRUE(test.Contains(9996));
+    EXPECT_TRUE(test.Contains(9999));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentHashSetTest, ConcurrentInsertsOfSameKeysSucceedExactlyOnce) {
+    const std::size_t threadCount = 4;
+    const std::size_t keyCount = 20000;
+
+    ConcurrentHashSet<std::size_t> test(keyCount);
+    std::atomic<std::size_t> successfulInsertCount(0);
+
+    std::vector<std::thread> threads;
+    for(std::size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex) {
+      threads.emplace_back(
+        [&test, &successfulInsertCount, keyCount]() {
+          std::size_t insertedCount = 0;
+          for(std::size_t key = 0; key < keyCount; ++key) {
+            if(test.TryInsert(key)) {
+              ++insertedCount;
+            }
+          }
+          successfulInsertCount.fetch_add(insertedCount, std::memory_order_relaxed);
+        }
+      );
+    }
+    for(std::size_t index = 0; index < threads.size(); ++index) {
+      threads[index].join();
+    }
+
+    EXPECT_EQ(successfulInsertCount.load(), keyCount);
+    EXPECT_EQ(test.Count(), keyCount);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentHashSetTest, ConcurrentChurnKeepsKeysConsistent) {
+    const std::size_t threadCount = 4;
+    const std::size_t keysPerThread = 20000;
+
+    ConcurrentHashSet<std::size_t> test(64);
+    std::atomic<std::size_t> failureCount(0);
+
+    // Each thread works on its own keys, so every operation has a known outcome
+    // even while other threads force the set to be rebuilt and grown
+    std::vector<std::thread> threads;
+    for(std::size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex) {
+      threads.emplace_back(
+        [&test, &failureCount, threadIndex, keysPerThread]() {
+          std::size_t firstKey = threadIndex * keysPerThread;
+          for(std::size_t index = 0; index < keysPerThread; ++index) {
+            std::size_t key = firstKey + index;
+            if(!test.TryInsert(key) || !test.Contains(key)) {
+              failureCount.fetch_add(1, std::memory_order_relaxed);
+            }
+            if((index % 4) != 0) {
+              if(!test.TryRemove(key) || test.Contains(key)) {
+                failureCount.fetch_add(1, std::memory_order_relaxed);
+              }
+            }
+          }
+        }
+      );
+    }
+    for(std::size_t index = 0; index < threads.size(); ++index) {
+      threads[index].join();
+    }
+
+    EXPECT_EQ(failureCount.load(), 0U);
+    EXPECT_EQ(test.Count(), threadCount * keysPerThread / 4);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
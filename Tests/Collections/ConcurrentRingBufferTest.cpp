@@ -0,0 +1,399 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Collections/ConcurrentRingBuffer.h"
+
+#include <gtest/gtest.h>
+
+#include <memory> // for std::shared_ptr
+#include <thread> // for std::thread
+#include <vector> // for std::vector
+#include <stdexcept> // for std::runtime_error
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Element whose copy constructor can be made to fail on demand</summary>
+  class FailingCopyItem {
+
+    /// <summary>Initializes a new item with the specified value</summary>
+    /// <param name="value">Value the item will carry</param>
+    public: explicit FailingCopyItem(int value = 0) : Value(value), FailOnCopy(false) {}
+
+    /// <summary>Initializes a copy of an item, throwing if the item says so</summary>
+    /// <param name="other">Item that will be copied</param>
+    public: FailingCopyItem(const FailingCopyItem &other) :
+      Value(other.Value),
+      FailOnCopy(false) {
+      if(other.FailOnCopy) {
+        throw std::runtime_error("Simulated copy constructor failure");
+      }
+    }
+
+    /// <summary>Assigns the value of another item to this one</summary>
+    /// <param name="other">Item whose value will be assigned</param>
+    /// <returns>This item</returns>
+    public: FailingCopyItem &operator =(const FailingCopyItem &other) = default;
+
+    /// <summary>Value carried by the item</summary>
+    public: int Value;
+    /// <summary>Whether copying this item should throw an exception</summary>
+    public: bool FailOnCopy;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Checks that items come out of a ring buffer in the order they went in</summary>
+  /// <typeparam name="TRingBuffer">Type of ring buffer that will be checked</typeparam>
+  template<typename TRingBuffer>
+  void checkItemsComeOutInOrder() {
+    TRingBuffer buffer(8);
+    for(int round = 0; round < 5; ++round) { // go around the ring a few times
+      for(int index = 0; index < 6; ++index) {
+        EXPECT_TRUE(buffer.TryAppend(round * 10 + index));
+      }
+      EXPECT_EQ(buffer.Count(), 6U);
+
+      int value = -1;
+      for(int index = 0; index < 6; ++index) {
+        EXPECT_TRUE(buffer.TryTake(value));
+        EXPECT_EQ(value, round * 10 + index);
+      }
+      EXPECT_TRUE(buffer.IsEmpty());
+      EXPECT_FALSE(buffer.TryTake(value));
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Checks that a ring buffer refuses new items once it is full</summary>
+  /// <typeparam name="TRingBuffer">Type of ring buffer that will be checked</typeparam>
+  template<typename TRingBuffer>
+  void checkAppendFailsWhenFull() {
+    TRingBuffer buffer(4);
+    ASSERT_EQ(buffer.GetCapacity(), 4U);
+    for(int index = 0; index < 4; ++index) {
+      EXPECT_TRUE(buffer.TryAppend(index));
+    }
+    EXPECT_FALSE(buffer.TryAppend(4));
+    EXPECT_EQ(buffer.Count(), 4U);
+
+    int value = -1;
+    EXPECT_TRUE(buffer.TryTake(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(buffer.TryAppend(4));
+    EXPECT_FALSE(buffer.TryAppend(5));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Checks that a ring buffer destroys any items left in it</summary>
+  /// <typeparam name="TRingBuffer">Type of ring buffer that will be checked</typeparam>
+  template<typename TRingBuffer>
+  void checkLeftOverItemsAreDestroyed() {
+    std::shared_ptr<int> tracker = std::make_shared<int>(123);
+    {
+      TRingBuffer buffer(16);
+      for(std::size_t index = 0; index < 10; ++index) {
+        EXPECT_TRUE(buffer.TryAppend(tracker));
+      }
+
+      std::shared_ptr<int> taken;
+      EXPECT_TRUE(buffer.TryTake(taken));
+      EXPECT_TRUE(buffer.TryTake(taken));
+      taken.reset();
+
+      EXPECT_EQ(tracker.use_count(), 9);
+    }
+    EXPECT_EQ(tracker.use_count(), 1);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Moves a bunch of numbers through a ring buffer via multiple threads</summary>
+  /// <typeparam name="TRingBuffer">Type of ring buffer that will be checked</typeparam>
+  /// <param name="producerCount">Number of threads that will append numbers</param>
+  /// <param name="consumerCount">Number of threads that will take numbers</param>
+  template<typename TRingBuffer>
+  void checkAllItemsArriveAcrossThreads(std::size_t producerCount, std::size_t consumerCount) {
+    const std::size_t itemsPerProducer = 50000;
+    const std::size_t totalItemCount = itemsPerProducer * producerCount;
+
+    TRingBuffer buffer(64); // small so the threads keep hitting the full / empty cases
+    std::atomic<std::size_t> takenItemCount(0);
+    std::atomic<std::size_t> takenItemSum(0);
+
+    std::vector<std::thread> threads;
+    for(std::size_t producerIndex = 0; producerIndex < producerCount; ++producerIndex) {
+      threads.emplace_back(
+        [&buffer, producerIndex, itemsPerProducer]() {
+          for(std::size_t index = 0; index < itemsPerProducer; ++index) {
+            std::size_t value = producerIndex * itemsPerProducer + index + 1;
+            while(!buffer.TryAppend(value)) {
+              std::this_thread::yield();
+            }
+          }
+        }
+      );
+    }
+    for(std::size_t consumerIndex = 0; consumerIndex < consumerCount; ++consumerIndex) {
+      threads.emplace_back(
+        [&buffer, &takenItemCount, &takenItemSum, totalItemCount]() {
+          std::size_t value = 0;
+          while(takenItemCount.load(std::memory_order_relaxed) < totalItemCount) {
+            if(buffer.TryTake(value)) {
+              takenItemSum.fetch_add(value, std::memory_order_relaxed);
+              takenItemCount.fetch_add(1, std::memory_order_relaxed);
+            } else {
+              std::this_thread::yield();
+            }
+          }
+        }
+      );
+    }
+    for(std::size_t index = 0; index < threads.size(); ++index) {
+      threads[index].join();
+    }
+
+    EXPECT_EQ(takenItemCount.load(), totalItemCount);
+    EXPECT_EQ(takenItemSum.load(), totalItemCount * (totalItemCount + 1) / 2);
+    EXPECT_TRUE(buffer.IsEmpty());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentRingBufferTest, InstancesCanBeCreated) {
+    EXPECT_NO_THROW(
+      (ConcurrentRingBuffer<int, ConcurrentAccessBehavior::SingleProducerSingleConsumer>(16))
+    );
+    EXPECT_NO_THROW(
+      (ConcurrentRingBuffer<int, ConcurrentAccessBehavior::MultipleProducersSingleConsumer>(16))
+    );
+    EXPECT_NO_THROW(
+      (ConcurrentRingBuffer<int, ConcurrentAccessBehavior::MultipleProducersMultipleConsumers>(16))
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentRingBufferTest, CapacityIsRoundedUpToPowerOfTwo) {
+    ConcurrentRingBuffer<int> test(100);
+    EXPECT_EQ(test.GetCapacity(), 128U);
+
+    ConcurrentRingBuffer<int> tiny(0);
+    EXPECT_GE(tiny.GetCapacity(), 1U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentRingBufferTest, ItemsComeOutInOrder) {
+    checkItemsComeOutInOrder<
+      ConcurrentRingBuffer<int, ConcurrentAccessBehavior::SingleProducerSingleConsumer>
+    >();
+    checkItemsComeOutInOrder<
+      ConcurrentRingBuffer<int, ConcurrentAccessBehavior::MultipleProducersSingleConsumer>
+    >();
+    checkItemsComeOutInOrder<
+      ConcurrentRingBuffer<int, ConcurrentAccessBehavior::MultipleProducersMultipleConsumers>
+    >();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentRingBufferTest, AppendFailsWhenFull) {
+    checkAppendFailsWhenFull<
+      ConcurrentRingBuffer<int, ConcurrentAccessBehavior::SingleProducerSingleConsumer>
+    >();
+    checkAppendFailsWhenFull<
+      ConcurrentRingBuffer<int, ConcurrentAccessBehavior::MultipleProducersSingleConsumer>
+    >();
+    checkAppendFailsWhenFull<
+      ConcurrentRingBuffer<int, ConcurrentAccessBehavior::MultipleProducersMultipleConsumers>
+    >();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentRingBufferTest, LeftOverItemsAreDestroyed) {
+    typedef std::shared_ptr<int> SharedInt;
+    checkLeftOverItemsAreDestroyed<
+      ConcurrentRingBuffer<SharedInt, ConcurrentAccessBehavior::SingleProducerSingleConsumer>
+    >();
+    checkLeftOverItemsAreDestroyed<
+      ConcurrentRingBuffer<SharedInt, ConcurrentAccessBehavior::MultipleProducersSingleConsumer>
+    >();
+    checkLeftOverItemsAreDestroyed<
+      ConcurrentRingBuffer<SharedInt, ConcurrentAccessBehavior::MultipleProducersMultipleConsumers>
+    >();
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentRingBufferTest, FailedCopyDoesNotBlockBuffer) {
+    ConcurrentRingBuffer<FailingCopyItem> test(4);
+
+    FailingCopyItem good(1), bad(2), alsoGood(3);
+    bad.FailOnCopy = true;
+
+    EXPECT_TRUE(test.TryAppend(good));
+    EXPECT_THROW(test.TryAppend(bad), std::runtime_error);
+    EXPECT_TRUE(test.TryAppend(alsoGood));
+
+    FailingCopyItem taken;
+    EXPECT_TRUE(test.TryTake(taken));
+    EXPECT_EQ(taken.Value, 1);
+    EXPECT_TRUE(test.TryTake(taken));
+    EXPECT_EQ(taken.Value, 3);
+    EXPECT_FALSE(test.TryTake(taken));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentRingBufferTest, SingleProducerSingleConsumerTransfersAllItems) {
+    checkAllItemsArriveAcrossThreads<
+      ConcurrentRingBuffer<std::size_t, ConcurrentAccessBehavior::SingleProducerSingleConsumer>
+    >(1, 1);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentRingBufferTest, MultipleProducersSingleConsumerTransfersAllItems) {
+    checkAllItemsArriveAcrossThreads<
+      ConcurrentRingBuffer<std::size_t, ConcurrentAccessBehavior::MultipleProducersSingleConsumer>
+    >(4, 1);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentRingBufferTest, MultipleProducersMultipleConsumersTransfersAllItems) {
+    checkAllItemsArriveAcrossThreads<
+      ConcurrentRingBuffer<
+        std::size_t, ConcurrentAccessBehavior::MultipleProducersMultipleConsumers
+      >
+    >(4, 4);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentRingBufferTest, ItemsCanBeTransferredInBulk) {
+    ConcurrentRingBuffer<int, ConcurrentAccessBehavior::SingleProducerSingleConsumer> test(8);
+
+    int items[] = { 1, 2, 3, 4, 5, 6 };
+    int taken[8] = { 0 };
+    for(int round = 0; round < 5; ++round) { // go around the ring a few times
+      EXPECT_EQ(test.TryAppendMany(items, 6), 6U);
+      EXPECT_EQ(test.TryTakeMany(taken, 8), 6U);
+      for(std::size_t index = 0; index < 6; ++index) {
+        EXPECT_EQ(taken[index], items[index]);
+      }
+    }
+
+    // Bulk appends stop when the buffer is full
+    EXPECT_EQ(test.TryAppendMany(items, 6), 6U);
+    EXPECT_EQ(test.TryAppendMany(items, 6), 2U);
+    EXPECT_EQ(test.Count(), 8U);
+    EXPECT_EQ(test.TryTakeMany(taken, 3), 3U);
+    EXPECT_EQ(taken[0], 1);
+    EXPECT_EQ(test.TryTakeMany(taken, 8), 5U);
+    EXPECT_EQ(taken[3], 1);
+    EXPECT_EQ(taken[4], 2);
+    EXPECT_TRUE(test.IsEmpty());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentRingBufferTest, NonTrivialItemsCanBeTransferredInBulk) {
+    typedef std::shared_ptr<int> SharedInt;
+    ConcurrentRingBuffer<SharedInt, ConcurrentAccessBehavior::SingleProducerSingleConsumer> test(4);
+
+    SharedInt value = std::make_shared<int>(123);
+    SharedInt items[] = { value, value, value };
+    EXPECT_EQ(test.TryAppendMany(items, 3), 3U);
+    EXPECT_EQ(test.TryAppendMany(items, 3), 1U);
+    EXPECT_EQ(value.use_count(), 8);
+
+    SharedInt taken[4];
+    EXPECT_EQ(test.TryTakeMany(taken, 4), 4U);
+    EXPECT_EQ(value.use_count(), 8); // moved out, not copied
+    EXPECT_EQ(*taken[3], 123);
+    EXPECT_EQ(test.TryTakeMany(taken, 4), 0U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentRingBufferTest, BulkTransfersWorkAcrossThreads) {
+    typedef ConcurrentRingBuffer<
+      std::size_t, ConcurrentAccessBehavior::SingleProducerSingleConsumer
+    > RingBufferType;
+    RingBufferType buffer(64);
+
+    const std::size_t TotalItemCount = 100000;
+    std::thread producer(
+      [&buffer, TotalItemCount]() {
+        std::size_t items[37];
+        std::size_t nextValue = 1;
+        while(nextValue <= TotalItemCount) {
+          std::size_t count = 0;
+          while((count < 37) && (nextValue + count <= TotalItemCount)) {
+            items[count] = nextValue + count;
+            ++count;
+          }
+          std::size_t appended = 0;
+          while(appended < count) {
+            appended += buffer.TryAppendMany(items + appended, count - appended);
+            if(appended < count) {
+              std::this_thread::yield();
+            }
+          }
+          nextValue += count;
+        }
+      }
+    );
+
+    std::size_t expectedValue = 1;
+    std::size_t items[29];
+    while(expectedValue <= TotalItemCount) {
+      std::size_t count = buffer.TryTakeMany(items, 29);
+      if(count == 0) {
+        std::this_thread::yield();
+      }
+      for(std::size_t index = 0; index < count; ++index) {
+        EXPECT_EQ(items[index], expectedValue);
+        ++expectedValue;
+      }
+    }
+    producer.join();
+
+    EXPECT_TRUE(buffer.IsEmpty());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
@@ -0,0 +1,195 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Collections/ConcurrentSegmentedQueue.h"
+
+#include <gtest/gtest.h>
+
+#include <memory> // for std::shared_ptr
+#include <thread> // for std::thread
+#include <vector> // for std::vector
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentSegmentedQueueTest, InstancesCanBeCreated) {
+    EXPECT_NO_THROW(
+      ConcurrentSegmentedQueue<int> test;
+    );
+    EXPECT_NO_THROW(
+      ConcurrentSegmentedQueue<std::shared_ptr<int>> test(16);
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentSegmentedQueueTest, NewInstanceIsEmpty) {
+    ConcurrentSegmentedQueue<int> test;
+    EXPECT_TRUE(test.IsEmpty());
+    EXPECT_EQ(test.Count(), 0U);
+
+    int value = 0;
+    EXPECT_FALSE(test.TryTake(value));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentSegmentedQueueTest, ItemsComeOutInOrderAcrossSegments) {
+    ConcurrentSegmentedQueue<int> test(4);
+
+    for(int round = 0; round < 3; ++round) {
+      for(int index = 0; index < 37; ++index) {
+        EXPECT_TRUE(test.TryAppend(index));
+      }
+      EXPECT_EQ(test.Count(), 37U);
+
+      int value = -1;
+      for(int index = 0; index < 37; ++index) {
+        EXPECT_TRUE(test.TryTake(value));
+        EXPECT_EQ(value, index);
+      }
+      EXPECT_FALSE(test.TryTake(value));
+      EXPECT_TRUE(test.IsEmpty());
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentSegmentedQueueTest, LongBurstsReuseDrainedSegments) {
+    ConcurrentSegmentedQueue<int> test(2);
+
+    // Each burst spans far more segments than any fixed-size recycling pool would
+    // hold, so the later bursts have to be served from the free list
+    for(int round = 0; round < 10; ++round) {
+      for(int index = 0; index < 500; ++index) {
+        EXPECT_TRUE(test.TryAppend(index + round));
+      }
+
+      int value = -1;
+      for(int index = 0; index < 500; ++index) {
+        EXPECT_TRUE(test.TryTake(value));
+        EXPECT_EQ(value, index + round);
+      }
+      EXPECT_TRUE(test.IsEmpty());
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentSegmentedQueueTest, ItemsCanBeAppendedAndTakenInBulk) {
+    ConcurrentSegmentedQueue<int> test(8);
+
+    int items[20];
+    for(int index = 0; index < 20; ++index) {
+      items[index] = index * 3;
+    }
+    EXPECT_EQ(test.TryAppend(items, 20), 20U);
+    EXPECT_EQ(test.Count(), 20U);
+
+    int taken[32];
+    EXPECT_EQ(test.TryTake(taken, 5), 5U);
+    EXPECT_EQ(test.TryTake(taken + 5, 32), 15U);
+    for(int index = 0; index < 20; ++index) {
+      EXPECT_EQ(taken[index], index * 3);
+    }
+
+    EXPECT_EQ(test.TryTake(taken, 32), 0U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentSegmentedQueueTest, LeftOverItemsAreDestroyed) {
+    std::shared_ptr<int> tracker = std::make_shared<int>(123);
+    {
+      ConcurrentSegmentedQueue<std::shared_ptr<int>> test(4);
+      for(std::size_t index = 0; index < 10; ++index) {
+        EXPECT_TRUE(test.TryAppend(tracker));
+      }
+
+      std::shared_ptr<int> taken;
+      EXPECT_TRUE(test.TryTake(taken));
+      EXPECT_TRUE(test.TryTake(taken));
+      EXPECT_TRUE(test.TryTake(taken));
+      taken.reset();
+
+      EXPECT_EQ(tracker.use_count(), 8);
+    }
+    EXPECT_EQ(tracker.use_count(), 1);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentSegmentedQueueTest, MultipleProducersMultipleConsumersTransferAllItems) {
+    const std::size_t producerCount = 4, consumerCount = 4;
+    const std::size_t itemsPerProducer = 50000;
+    const std::size_t totalItemCount = itemsPerProducer * producerCount;
+
+    ConcurrentSegmentedQueue<std::size_t> test(32); // small to exercise segment recycling
+    std::atomic<std::size_t> takenItemCount(0);
+    std::atomic<std::size_t> takenItemSum(0);
+
+    std::vector<std::thread> threads;
+    for(std::size_t producerIndex = 0; producerIndex < producerCount; ++producerIndex) {
+      threads.emplace_back(
+        [&test, producerIndex, itemsPerProducer]() {
+          std::size_t batch[7];
+          for(std::size_t index = 0; index < itemsPerProducer; index += 7) {
+            std::size_t batchSize = std::min<std::size_t>(7, itemsPerProducer - index);
+            for(std::size_t batchIndex = 0; batchIndex < batchSize; ++batchIndex) {
+              batch[batchIndex] = producerIndex * itemsPerProducer + index + batchIndex + 1;
+            }
+            EXPECT_EQ(test.TryAppend(batch, batchSize), batchSize);
+          }
+        }
+      );
+    }
+    for(std::size_t consumerIndex = 0; consumerIndex < consumerCount; ++consumerIndex) {
+      threads.emplace_back(
+        [&test, &takenItemCount, &takenItemSum, consumerIndex, totalItemCount]() {
+          std::size_t batch[5];
+          while(takenItemCount.load(std::memory_order_relaxed) < totalItemCount) {
+            std::size_t takenCount = test.TryTake(batch, (consumerIndex % 2) ? 5 : 1);
+            for(std::size_t index = 0; index < takenCount; ++index) {
+              takenItemSum.fetch_add(batch[index], std::memory_order_relaxed);
+            }
+            if(takenCount == 0) {
+              std::this_thread::yield();
+            } else {
+              takenItemCount.fetch_add(takenCount, std::memory_order_relaxed);
+            }
+          }
+        }
+      );
+    }
+    for(std::size_t index = 0; index < threads.size(); ++index) {
+      threads[index].join();
+    }
+
+    EXPECT_EQ(takenItemCount.load(), totalItemCount);
+    EXPECT_EQ(takenItemSum.load(), totalItemCount * (totalItemCount + 1) / 2);
+    EXPECT_TRUE(test.IsEmpty());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
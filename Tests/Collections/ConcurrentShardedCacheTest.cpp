@@ -0,0 +1,249 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Collections/ConcurrentShardedCache.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic> // for std::atomic
+#include <string> // for std::string, std::u8string
+#include <thread> // for std::thread
+#include <vector> // for std::vector
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentShardedCacheTest, InstancesCanBeCreated) {
+    EXPECT_NO_THROW(
+      (ConcurrentShardedCache<int, int>(100))
+    );
+    EXPECT_NO_THROW(
+      (ConcurrentShardedCache<std::u8string, std::u8string>(16, 4))
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentShardedCacheTest, CapacityIsRoundedToShardCount) {
+    ConcurrentShardedCache<int, int> test(100, 3);
+    EXPECT_EQ(test.GetCapacity(), 100U); // 4 shards of 25 items each
+
+    ConcurrentShardedCache<int, int> test2(10, 4);
+    EXPECT_EQ(test2.GetCapacity(), 12U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentShardedCacheTest, ItemsCanBeInsertedAndRetrieved) {
+    ConcurrentShardedCache<int, int> test(16, 2);
+    EXPECT_TRUE(test.IsEmpty());
+
+    EXPECT_TRUE(test.Insert(1, 10));
+    EXPECT_TRUE(test.TryInsert(2, 20));
+    EXPECT_FALSE(test.TryInsert(1, 30));
+    EXPECT_EQ(test.Count(), 2U);
+
+    int value = 0;
+    EXPECT_TRUE(test.TryGet(1, value));
+    EXPECT_EQ(value, 10);
+
+    EXPECT_FALSE(test.Insert(1, 40));
+    EXPECT_TRUE(test.TryGet(1, value));
+    EXPECT_EQ(value, 40);
+
+    EXPECT_TRUE(test.Contains(2));
+    EXPECT_FALSE(test.Contains(3));
+    EXPECT_FALSE(test.TryGet(3, value));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentShardedCacheTest, ItemsCanBeTakenAndRemoved) {
+    ConcurrentShardedCache<std::u8string, std::u8string> test(16, 2);
+    EXPECT_TRUE(test.Insert(u8"Hello", u8"World"));
+    EXPECT_TRUE(test.Insert(u8"Foo", u8"Bar"));
+
+    std::u8string value;
+    EXPECT_TRUE(test.TryTake(u8"Hello", value));
+    EXPECT_EQ(value, u8"World");
+    EXPECT_FALSE(test.TryTake(u8"Hello", value));
+
+    EXPECT_TRUE(test.TryRemove(u8"Foo"));
+    EXPECT_FALSE(test.TryRemove(u8"Foo"));
+    EXPECT_TRUE(test.IsEmpty());
+
+    EXPECT_TRUE(test.Insert(u8"Hello", u8"Again"));
+    EXPECT_TRUE(test.TryGet(u8"Hello", value));
+    EXPECT_EQ(value, u8"Again");
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentShardedCacheTest, FullShardsEvictItems) {
+    ConcurrentShardedCache<int, std::string> test(64, 4);
+    for(int index = 0; index < 1000; ++index) {
+      test.Insert(index, std::to_string(index));
+      EXPECT_LE(test.Count(), 64U);
+    }
+    EXPECT_EQ(test.Count(), 64U);
+
+    std::size_t foundCount = 0;
+    for(int index = 0; index < 1000; ++index) {
+      std::string value;
+      if(test.TryGet(index, value)) {
+        EXPECT_EQ(value, std::to_string(index));
+        ++foundCount;
+      }
+    }
+    EXPECT_EQ(foundCount, 64U);
+
+    test.Clear();
+    EXPECT_TRUE(test.IsEmpty());
+    EXPECT_FALSE(test.Contains(999));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentShardedCacheTest, DeferredAccessesKeepItemsAlive) {
+    ConcurrentShardedCache<int, int> test(8, 1);
+    for(int index = 0; index < 8; ++index) {
+      test.Insert(index, index);
+    }
+
+    // The lookup is only noted in the shard's access buffer, but the next insertion
+    // applies it before evicting, so item 0 is no longer the least recently used one
+    int value;
+    EXPECT_TRUE(test.TryGet(0, value));
+    test.Insert(100, 100);
+
+    EXPECT_TRUE(test.Contains(0));
+    EXPECT_FALSE(test.Contains(1));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentShardedCacheTest, AccessBufferOverflowIsHarmless) {
+    ConcurrentShardedCache<std::string, int> test(8, 1);
+    for(int index = 0; index < 8; ++index) {
+      test.Insert(std::to_string(index), index);
+    }
+
+    int value;
+    for(int index = 0; index < 1000; ++index) {
+      EXPECT_TRUE(test.TryGet(std::to_string(index % 4), value));
+    }
+    test.Insert("100", 100);
+
+    // Items 0-3 were accessed all the time, so one of the others must have been evicted
+    for(int index = 0; index < 4; ++index) {
+      EXPECT_TRUE(test.Contains(std::to_string(index)));
+    }
+    EXPECT_EQ(test.Count(), 8U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentShardedCacheTest, EvictionPolicyCanBeChosen) {
+    typedef ConcurrentShardedCache<
+      int, int, std::hash<int>, std::equal_to<int>, S3FifoEvictionPolicy<std::uint16_t>
+    > TestCache;
+
+    TestCache test(100, 4);
+    for(int index = 0; index < 1000; ++index) {
+      test.Insert(index, index);
+    }
+    EXPECT_EQ(test.Count(), 100U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentShardedCacheTest, ThreadsCanShareTheCache) {
+    ConcurrentShardedCache<std::size_t, std::size_t> test(256, 8);
+    const std::size_t keyCount = 2000;
+
+    std::atomic<std::size_t> inconsistentReadCount(0);
+
+    std::vector<std::thread> threads;
+    for(std::size_t threadIndex = 0; threadIndex < 4; ++threadIndex) {
+      threads.emplace_back(
+        [&test, &inconsistentReadCount, threadIndex, keyCount]() {
+          std::size_t value = 0;
+          for(std::size_t key = threadIndex; key < keyCount; ++key) {
+            if(test.TryGet(key, value)) {
+              if(value != key * 3) {
+                inconsistentReadCount.fetch_add(1, std::memory_order_relaxed);
+              }
+            } else {
+              test.Insert(key, key * 3);
+            }
+            if((key % 11) == threadIndex) {
+              test.TryRemove(key / 2);
+            }
+          }
+        }
+      );
+    }
+    for(std::thread &thread : threads) {
+      thread.join();
+    }
+
+    EXPECT_EQ(inconsistentReadCount.load(), 0U);
+    EXPECT_LE(test.Count(), 256U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ConcurrentShardedCacheTest, ThreadsCanShareCacheOfComplexTypes) {
+    ConcurrentShardedCache<std::string, std::string> test(64, 4);
+
+    std::atomic<std::size_t> inconsistentReadCount(0);
+
+    std::vector<std::thread> threads;
+    for(std::size_t threadIndex = 0; threadIndex < 4; ++threadIndex) {
+      threads.emplace_back(
+        [&test, &inconsistentReadCount, threadIndex]() {
+          std::string value;
+          for(std::size_t index = 0; index < 2000; ++index) {
+            std::string key = std::to_string((index * 7 + threadIndex) % 200);
+            if(test.TryGet(key, value)) {
+              if(value != key + key) {
+                inconsistentReadCount.fetch_add(1, std::memory_order_relaxed);
+              }
+            } else {
+              test.Insert(key, key + key);
+            }
+          }
+        }
+      );
+    }
+    for(std::thread &thread : threads) {
+      thread.join();
+    }
+
+    EXPECT_EQ(inconsistentReadCount.load(), 0U);
+    EXPECT_LE(test.Count(), 64U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
@@ -0,0 +1,101 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Collections/CountMinSketch.h"
+
+#include <gtest/gtest.h>
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(CountMinSketchTest, InstancesCanBeCreated) {
+    EXPECT_NO_THROW(
+      CountMinSketch test(100);
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(CountMinSketchTest, UnseenItemsAreEstimatedAsZero) {
+    CountMinSketch test(100);
+    EXPECT_EQ(test.Estimate(12345), 0U);
+    EXPECT_EQ(test.Estimate(0), 0U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(CountMinSketchTest, EstimateFollowsIncrements) {
+    CountMinSketch test(100);
+    for(std::size_t index = 0; index < 5; ++index) {
+      test.Increment(12345);
+    }
+    test.Increment(54321);
+
+    EXPECT_GE(test.Estimate(12345), 5U);
+    EXPECT_GE(test.Estimate(54321), 1U);
+    EXPECT_LT(test.Estimate(54321), test.Estimate(12345));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(CountMinSketchTest, CountersSaturate) {
+    CountMinSketch test(100);
+    for(std::size_t index = 0; index < 100; ++index) {
+      test.Increment(12345);
+    }
+
+    EXPECT_EQ(test.Estimate(12345), CountMinSketch::MaximumCount);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(CountMinSketchTest, SketchCanBeCleared) {
+    CountMinSketch test(100);
+    for(std::size_t index = 0; index < 10; ++index) {
+      test.Increment(12345);
+    }
+
+    test.Clear();
+    EXPECT_EQ(test.Estimate(12345), 0U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(CountMinSketchTest, OldOccurrencesLoseWeight) {
+    CountMinSketch test(256);
+
+    // Without aging, this many increments on so few counters would saturate all of them
+    for(std::size_t index = 0; index < 10000; ++index) {
+      test.Increment(index + 1000000);
+      if((index % 10) == 0) {
+        test.Increment(42);
+      }
+    }
+
+    EXPECT_LT(test.Estimate(999), CountMinSketch::MaximumCount);
+    EXPECT_GT(test.Estimate(42), test.Estimate(999));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
@@ -0,0 +1,262 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Collections/EvictionPolicies.h"
+#include "Nuclex/Support/Collections/KeyedArrayCache.h"
+
+#include <gtest/gtest.h>
+
+#include <functional> // for std::hash
+#include <cstdint> // for std::uint8_t
+#include <stdexcept> // for std::invalid_argument
+#include <vector> // for std::vector
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Warms up a cache with a working set, then scans through unrelated keys</summary>
+  /// <typeparam name="TCache">Type of cache that will be tested</typeparam>
+  /// <param name="cache">Cache holding 10 items that will be tested</param>
+  /// <returns>The number of items from the working set still in the cache</returns>
+  template<typename TCache>
+  std::size_t countWorkingSetSurvivingScan(TCache &cache) {
+    for(int round = 0; round < 4; ++round) {
+      for(int key = 0; key < 10; ++key) {
+        int value;
+        if(!cache.TryGet(key, value)) {
+          cache.Insert(key, key);
+        }
+      }
+    }
+
+    for(int key = 1000; key < 1100; ++key) {
+      cache.Insert(key, key);
+    }
+
+    std::size_t survivorCount = 0;
+    for(int key = 0; key < 10; ++key) {
+      int value;
+      if(cache.TryGet(key, value)) {
+        ++survivorCount;
+      }
+    }
+
+    return survivorCount;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(EvictionPoliciesTest, SlotCountMustFitSlotIndexType) {
+    EXPECT_NO_THROW(LruEvictionPolicy<std::uint8_t> test(254));
+    EXPECT_THROW(LruEvictionPolicy<std::uint8_t> test(255), std::invalid_argument);
+    EXPECT_THROW(WindowTinyLfuEvictionPolicy<std::uint8_t> test(255), std::invalid_argument);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(EvictionPoliciesTest, LruEvictsLeastRecentlyUsedSlot) {
+    LruEvictionPolicy<> test(4);
+    for(std::size_t index = 0; index < 4; ++index) {
+      test.Insert(index, 0);
+    }
+    test.Touch(0);
+    test.Touch(2);
+
+    EXPECT_EQ(test.Evict(), 1U);
+    EXPECT_EQ(test.Evict(), 3U);
+    EXPECT_EQ(test.Evict(), 0U);
+    EXPECT_FALSE(test.Contains(0));
+    EXPECT_TRUE(test.Contains(2));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(EvictionPoliciesTest, ClockGivesReferencedSlotsASecondChance) {
+    ClockEvictionPolicy<> test(4);
+    for(std::size_t index = 0; index < 4; ++index) {
+      test.Insert(index, 0);
+    }
+    test.Touch(0);
+    test.Touch(1);
+
+    EXPECT_EQ(test.Evict(), 2U);
+    EXPECT_EQ(test.Evict(), 3U);
+    EXPECT_EQ(test.Evict(), 0U); // the hand has cleared its reference bit by now
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(EvictionPoliciesTest, RemovedSlotsAreNotEvicted) {
+    S3FifoEvictionPolicy<> test(4);
+    for(std::size_t index = 0; index < 4; ++index) {
+      test.Insert(index, index);
+    }
+    test.Remove(0);
+    test.Remove(2);
+
+    EXPECT_FALSE(test.Contains(0));
+    EXPECT_EQ(test.Evict(), 1U);
+    EXPECT_EQ(test.Evict(), 3U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(EvictionPoliciesTest, ForEachVisitsAllSlots) {
+    TwoQueueEvictionPolicy<> test(16);
+    for(std::size_t index = 0; index < 16; index += 2) {
+      test.Insert(index, index);
+    }
+
+    // Remove slots during the enumeration, which is explicitly allowed
+    std::vector<std::size_t> visited;
+    test.ForEach(
+      [&test, &visited](std::size_t slotIndex) {
+        visited.push_back(slotIndex);
+        if(slotIndex >= 8) {
+          test.Remove(slotIndex);
+        }
+      }
+    );
+
+    EXPECT_EQ(visited.size(), 8U);
+    EXPECT_TRUE(test.Contains(6));
+    EXPECT_FALSE(test.Contains(8));
+
+    test.Clear();
+    EXPECT_FALSE(test.Contains(0));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(EvictionPoliciesTest, TwoQueuePromotesReturningKeys) {
+    TwoQueueEvictionPolicy<> test(8);
+    for(std::size_t index = 0; index < 8; ++index) {
+      test.Insert(index, index + 100);
+    }
+
+    // Slot 0 leaves the FIFO queue and its key is remembered as a ghost. When the key
+    // returns, it goes into the main queue and is protected from the FIFO churn.
+    EXPECT_EQ(test.Evict(), 0U);
+    test.Insert(0, 100);
+
+    for(std::size_t index = 1; index < 6; ++index) {
+      EXPECT_EQ(test.Evict(), index);
+    }
+    EXPECT_TRUE(test.Contains(0));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(EvictionPoliciesTest, S3FifoEvictsOneHitWondersFirst) {
+    S3FifoEvictionPolicy<> test(10);
+    for(std::size_t index = 0; index < 10; ++index) {
+      test.Insert(index, index);
+    }
+    for(std::size_t index = 0; index < 5; ++index) {
+      test.Touch(index);
+    }
+
+    for(std::size_t index = 5; index < 10; ++index) {
+      EXPECT_EQ(test.Evict(), index);
+    }
+    for(std::size_t index = 0; index < 5; ++index) {
+      EXPECT_TRUE(test.Contains(index));
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(EvictionPoliciesTest, TinyLfuRejectsInfrequentCandidates) {
+    WindowTinyLfuEvictionPolicy<> test(100);
+    for(std::size_t index = 0; index < 100; ++index) {
+      test.Insert(index, index);
+    }
+    for(std::size_t round = 0; round < 3; ++round) {
+      for(std::size_t index = 0; index < 50; ++index) {
+        test.Touch(index);
+      }
+    }
+
+    // The frequently accessed slots were promoted into the protected segment,
+    // so all evictions have to come from the rarely accessed half
+    for(std::size_t index = 0; index < 40; ++index) {
+      EXPECT_GE(test.Evict(), 50U);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(EvictionPoliciesTest, LruIsFlushedByScans) {
+    KeyedArrayCache<int, int, std::hash<int>, LruEvictionPolicy<>> cache(10);
+    EXPECT_EQ(countWorkingSetSurvivingScan(cache), 0U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(EvictionPoliciesTest, TwoQueueResistsScans) {
+    KeyedArrayCache<int, int, std::hash<int>, TwoQueueEvictionPolicy<>> cache(20);
+
+    // 2Q only promotes keys that return after being evicted from its FIFO queue,
+    // so let the working set be pushed out once and then requested again
+    for(int key = 0; key < 20; ++key) {
+      cache.Insert(key, key);
+    }
+    for(int key = 100; key < 105; ++key) {
+      cache.Insert(key, key);
+    }
+    for(int key = 0; key < 5; ++key) {
+      cache.Insert(key, key);
+    }
+
+    for(int key = 1000; key < 1100; ++key) {
+      cache.Insert(key, key);
+    }
+
+    for(int key = 0; key < 5; ++key) {
+      EXPECT_EQ(cache.Get(key), key);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(EvictionPoliciesTest, S3FifoResistsScans) {
+    KeyedArrayCache<int, int, std::hash<int>, S3FifoEvictionPolicy<>> cache(10);
+    EXPECT_GE(countWorkingSetSurvivingScan(cache), 5U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(EvictionPoliciesTest, TinyLfuResistsScans) {
+    KeyedArrayCache<int, int, std::hash<int>, WindowTinyLfuEvictionPolicy<>> cache(10);
+    EXPECT_GE(countWorkingSetSurvivingScan(cache), 5U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
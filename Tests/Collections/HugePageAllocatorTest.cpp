@@ -0,0 +1,164 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Collections/HugePageAllocator.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint> // for std::uint8_t, std::uint32_t, std::uintptr_t
+#include <vector> // for std::vector
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Item that needs a stricter alignment than operator new provides</summary>
+  struct alignas(256) OverAlignedItem {
+
+    /// <summary>Some payload to give the item a size</summary>
+    public: std::uint8_t Payload[256];
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Checks whether an address is a multiple of the specified alignment</summary>
+  /// <param name="memory">Address that will be checked</param>
+  /// <param name="alignment">Alignment the address should have</param>
+  /// <returns>True if the address has the specified alignment</returns>
+  bool isAligned(const void *memory, std::size_t alignment) {
+    return ((reinterpret_cast<std::uintptr_t>(memory) % alignment) == 0);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(HugePageAllocatorTest, SmallAndLargeBlocksCanBeAllocated) {
+    const std::size_t sizes[] = { 2, 4096, HugePageMemory::HugePageSize, 5'000'000 };
+    for(std::size_t size : sizes) {
+      std::uint8_t *memory = static_cast<std::uint8_t *>(HugePageMemory::Allocate(size));
+      ASSERT_NE(memory, nullptr);
+      memory[0] = 12;
+      memory[size - 1] = 34;
+      EXPECT_EQ(memory[0], 12U);
+      EXPECT_EQ(memory[size - 1], 34U);
+      HugePageMemory::Free(memory, size);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(HugePageAllocatorTest, ReservedModeFallsBackWhenNoPagesAreReserved) {
+    std::size_t size = HugePageMemory::HugePageSize * 2;
+    void *memory = HugePageMemory::Allocate(size, HugePageMode::Reserved);
+    ASSERT_NE(memory, nullptr);
+    static_cast<std::uint8_t *>(memory)[size - 1] = 1;
+    HugePageMemory::Free(memory, size);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(HugePageAllocatorTest, ReallocationKeepsContents) {
+    HugePageAllocator<std::uint32_t> allocator;
+
+    // Grow from a heap block to a mapped one and then to a larger mapped one
+    const std::size_t counts[] = { 1000, 1024 * 1024, 3 * 1024 * 1024 };
+    std::uint32_t *items = allocator.allocate(counts[0]);
+    for(std::size_t index = 0; index < counts[0]; ++index) {
+      items[index] = static_cast<std::uint32_t>(index);
+    }
+    for(std::size_t step = 1; step < 3; ++step) {
+      items = allocator.reallocate(items, counts[step - 1], counts[step]);
+      for(std::size_t index = 0; index < counts[step - 1]; ++index) {
+        ASSERT_EQ(items[index], static_cast<std::uint32_t>(index));
+      }
+      for(std::size_t index = counts[step - 1]; index < counts[step]; ++index) {
+        items[index] = static_cast<std::uint32_t>(index);
+      }
+    }
+
+    allocator.deallocate(items, counts[2]);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(HugePageAllocatorTest, SmallBlocksHonorItemAlignment) {
+    HugePageAllocator<OverAlignedItem> allocator;
+
+    OverAlignedItem *items = allocator.allocate(3);
+    EXPECT_TRUE(isAligned(items, alignof(OverAlignedItem)));
+    items[2].Payload[255] = 1;
+
+    items = allocator.reallocate(items, 3, 7);
+    EXPECT_TRUE(isAligned(items, alignof(OverAlignedItem)));
+    EXPECT_EQ(items[2].Payload[255], 1U);
+    allocator.deallocate(items, 7);
+
+    void *memory = HugePageMemory::Allocate(100, HugePageMode::Transparent, 4096);
+    EXPECT_TRUE(isAligned(memory, 4096));
+    HugePageMemory::Free(memory, 100, 4096);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+#if defined(NUCLEX_SUPPORT_LINUX)
+
+  TEST(HugePageAllocatorTest, GrownBlocksStayOnHugePageBoundaries) {
+    std::size_t size = HugePageMemory::HugePageSize;
+    void *memory = HugePageMemory::Allocate(size);
+
+    // Blocks mapped in between make it likely the growing block has to move
+    std::vector<void *> blockers;
+    for(std::size_t step = 0; step < 4; ++step) {
+      blockers.push_back(HugePageMemory::Allocate(HugePageMemory::HugePageSize));
+      static_cast<std::uint8_t *>(memory)[size - 1] = static_cast<std::uint8_t>(step);
+
+      memory = HugePageMemory::Reallocate(memory, size, size * 2);
+      EXPECT_TRUE(isAligned(memory, HugePageMemory::HugePageSize));
+      EXPECT_EQ(static_cast<std::uint8_t *>(memory)[size - 1], step);
+      size *= 2;
+    }
+
+    HugePageMemory::Free(memory, size);
+    for(void *blocker : blockers) {
+      HugePageMemory::Free(blocker, HugePageMemory::HugePageSize);
+    }
+  }
+
+#endif // defined(NUCLEX_SUPPORT_LINUX)
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(HugePageAllocatorTest, CanBeUsedByStandardContainers) {
+    std::vector<int, HugePageAllocator<int>> test;
+    for(int index = 0; index < 1'000'000; ++index) {
+      test.push_back(index);
+    }
+    EXPECT_EQ(test[999'999], 999'999);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
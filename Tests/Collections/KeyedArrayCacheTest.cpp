@@ -23,6 +23,29 @@ limitations under the License.
 #include "Nuclex/Support/Collections/KeyedArrayCache.h"
 #include <gtest/gtest.h>
 
+#include <functional> // for std::hash
+#include <string> // for std::u8string
+#include <cstdint> // for std::uint16_t, std::uint8_t
+#include <stdexcept> // for std::invalid_argument
+#include <chrono> // for std::chrono::milliseconds
+#include <thread> // for std::this_thread::sleep_for()
+#include <vector> // for std::vector
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Eviction policy that evicts all even values</summary>
+  /// <param name="value">Value that will be checked for eviction</param>
+  /// <returns>True if the value is even and should be evicted</returns>
+  bool isEven(const int &value) {
+    return (value % 2) == 0;
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
 namespace Nuclex { namespace Support { namespace Collections {
 
   // ------------------------------------------------------------------------------------------- //
@@ -165,4 +188,483 @@ namespace Nuclex { namespace Support { namespace Collections {
 
   // ------------------------------------------------------------------------------------------- //
 
+  TEST(KeyedArrayCacheTest, HashedItemsCanBeRetrieved) {
+    KeyedArrayCache<std::size_t, int, std::hash<std::size_t>> test(32);
+
+    for(std::size_t index = 0; index < 32; ++index) {
+      test.Insert(index * 3, static_cast<int>(index));
+    }
+    EXPECT_EQ(test.Count(), 32U);
+
+    for(std::size_t index = 0; index < 32; ++index) {
+      EXPECT_EQ(test.Get(index * 3), static_cast<int>(index));
+    }
+
+    int obtainedValue;
+    EXPECT_FALSE(test.TryGet(1, obtainedValue));
+    EXPECT_THROW(test.Get(2), Errors::KeyNotFoundError);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(KeyedArrayCacheTest, HashedCacheRemovesAllDuplicates) {
+    KeyedArrayCache<std::size_t, int, std::hash<std::size_t>> test(8);
+
+    test.Insert(5, 1);
+    test.Insert(7, 2);
+    test.Insert(5, 3);
+    test.Insert(5, 4);
+    EXPECT_EQ(test.Count(), 4U);
+
+    EXPECT_EQ(test.TryRemove(5), 3U);
+    EXPECT_EQ(test.Count(), 1U);
+
+    int obtainedValue;
+    EXPECT_FALSE(test.TryGet(5, obtainedValue));
+    EXPECT_TRUE(test.TryTake(7, obtainedValue));
+    EXPECT_EQ(obtainedValue, 2);
+    EXPECT_TRUE(test.IsEmpty());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(KeyedArrayCacheTest, HashedCacheStaysConsistentWhenOverwritingItems) {
+    KeyedArrayCache<std::size_t, int, std::hash<std::size_t>> test(16);
+
+    // Keep inserting into a full cache so the least recently used items get replaced
+    for(std::size_t index = 0; index < 1000; ++index) {
+      test.Insert(index, static_cast<int>(index));
+      if((index % 7) == 0) {
+        test.EvictWhere(
+          Events::Delegate<bool(const int &)>::Create<&isEven>()
+        );
+      }
+    }
+
+    // Every item still in the cache must be found through the index after all that
+    // shuffling around of index entries and no stale entries may be returned
+    int obtainedValue;
+    std::size_t foundItemCount = 0;
+    for(std::size_t index = 0; index < 1000; ++index) {
+      if(test.TryGet(index, obtainedValue)) {
+        EXPECT_EQ(obtainedValue, static_cast<int>(index));
+        ++foundItemCount;
+      }
+    }
+    EXPECT_EQ(foundItemCount, test.Count());
+    EXPECT_TRUE(test.TryGet(999, obtainedValue));
+
+    test.EvictDownTo(4);
+    EXPECT_EQ(test.Count(), 4U);
+    test.Clear();
+    EXPECT_FALSE(test.TryGet(999, obtainedValue));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(KeyedArrayCacheTest, NonArithmeticKeysCanBeUsed) {
+    KeyedArrayCache<std::u8string, int> test(4);
+
+    test.Insert(u8"Hello", 1);
+    test.Insert(u8"World", 2);
+
+    EXPECT_EQ(test.Get(u8"Hello"), 1);
+    EXPECT_EQ(test.Get(u8"World"), 2);
+    EXPECT_EQ(test.TryRemove(u8"Hello"), 1U);
+
+    int obtainedValue;
+    EXPECT_FALSE(test.TryGet(u8"Hello", obtainedValue));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(KeyedArrayCacheTest, KeyScanIgnoresEmptySlots) {
+    KeyedArrayCache<std::uint16_t, int> test(100); // not a multiple of any vector size
+
+    for(std::uint16_t index = 0; index < 100; ++index) {
+      test.Insert(index, index * 10);
+    }
+    for(std::uint16_t index = 0; index < 100; index += 2) {
+      EXPECT_EQ(test.TryRemove(index), 1U);
+    }
+    EXPECT_EQ(test.Count(), 50U);
+
+    // Removed keys are still present in the key array, but their slots are empty,
+    // so they must not be found by the scan anymore
+    int obtainedValue;
+    for(std::uint16_t index = 0; index < 100; ++index) {
+      bool wasFound = test.TryGet(index, obtainedValue);
+      EXPECT_EQ(wasFound, (index % 2) == 1);
+      if(wasFound) {
+        EXPECT_EQ(obtainedValue, index * 10);
+      }
+    }
+    EXPECT_FALSE(test.TryGet(100, obtainedValue));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(KeyedArrayCacheTest, FloatingPointKeysCanBeUsed) {
+    KeyedArrayCache<double, int> test(16);
+
+    test.Insert(0.5, 1);
+    test.Insert(-0.0, 2);
+    test.Insert(1e100, 3);
+
+    EXPECT_EQ(test.Get(0.5), 1);
+    EXPECT_EQ(test.Get(0.0), 2); // -0.0 == 0.0, just like with operator ==
+    EXPECT_EQ(test.Get(1e100), 3);
+
+    int obtainedValue;
+    EXPECT_FALSE(test.TryGet(0.25, obtainedValue));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(KeyedArrayCacheTest, CompactSlotIndicesCanBeUsed) {
+    KeyedArrayCache<int, int, std::hash<int>, LruEvictionPolicy<std::uint16_t>> test(64);
+
+    for(int index = 0; index < 200; ++index) {
+      test.Insert(index, index * 2);
+    }
+    EXPECT_EQ(test.Count(), 64U);
+
+    test.Get(140); // Move item 140 back to top of most recently accessed
+    test.EvictDownTo(4);
+
+    int obtainedValue;
+    EXPECT_TRUE(test.TryGet(140, obtainedValue));
+    EXPECT_EQ(obtainedValue, 280);
+    EXPECT_TRUE(test.TryGet(199, obtainedValue));
+    EXPECT_FALSE(test.TryGet(196, obtainedValue));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(KeyedArrayCacheTest, CapacityMustFitSlotIndexType) {
+    typedef KeyedArrayCache<int, int, void, LruEvictionPolicy<std::uint8_t>> TestCache;
+
+    EXPECT_NO_THROW(TestCache test(254));
+    EXPECT_THROW(TestCache test(255), std::invalid_argument);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(KeyedArrayCacheTest, ScanResistantPolicyKeepsReusedItems) {
+    KeyedArrayCache<int, int, std::hash<int>, S3FifoEvictionPolicy<>> test(20);
+
+    // Access a working set of items repeatedly
+    for(int round = 0; round < 3; ++round) {
+      for(int index = 0; index < 10; ++index) {
+        int obtainedValue;
+        if(!test.TryGet(index, obtainedValue)) {
+          test.Insert(index, index);
+        }
+      }
+    }
+
+    // Now scan through a lot more items than the cache can hold
+    for(int index = 1000; index < 1100; ++index) {
+      test.Insert(index, index);
+    }
+
+    EXPECT_EQ(test.Count(), 20U);
+    for(int index = 0; index < 10; ++index) {
+      EXPECT_EQ(test.Get(index), index);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(KeyedArrayCacheTest, EvictionPoliciesWorkWithoutHashIndex) {
+    KeyedArrayCache<int, int, void, TwoQueueEvictionPolicy<>> test(16);
+
+    for(int index = 0; index < 64; ++index) {
+      test.Insert(index, index);
+    }
+    EXPECT_EQ(test.Count(), 16U);
+
+    test.EvictWhere(Events::Delegate<bool(const int &)>::Create<&isEven>());
+
+    std::size_t foundCount = 0;
+    for(int index = 0; index < 64; ++index) {
+      int obtainedValue;
+      if(test.TryGet(index, obtainedValue)) {
+        EXPECT_EQ(obtainedValue, index);
+        EXPECT_NE(obtainedValue % 2, 0);
+        ++foundCount;
+      }
+    }
+    EXPECT_EQ(foundCount, test.Count());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(KeyedArrayCacheTest, CostBudgetIsEnforced) {
+    KeyedArrayCache<int, int> test(16, 100);
+    EXPECT_EQ(test.GetCostBudget(), 100U);
+
+    EXPECT_TRUE(test.Insert(1, 1, 40));
+    EXPECT_TRUE(test.Insert(2, 2, 40));
+    EXPECT_EQ(test.GetTotalCost(), 80U);
+
+    // The least recently used item has to go to make room for the new one
+    EXPECT_EQ(test.Get(1), 1);
+    EXPECT_TRUE(test.Insert(3, 3, 30));
+    EXPECT_EQ(test.Count(), 2U);
+    EXPECT_EQ(test.GetTotalCost(), 70U);
+
+    int value;
+    EXPECT_TRUE(test.TryGet(1, value));
+    EXPECT_FALSE(test.TryGet(2, value));
+
+    // An item that can never fit is rejected without evicting anything
+    EXPECT_FALSE(test.Insert(4, 4, 101));
+    EXPECT_EQ(test.Count(), 2U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(KeyedArrayCacheTest, CostIsReleasedWhenItemsLeave) {
+    KeyedArrayCache<int, int, std::hash<int>> test(16);
+
+    test.Insert(1, 1); // inserted without cost, counts as 1
+    test.Insert(2, 2, 1000);
+    test.Insert(3, 3, 200);
+    test.Insert(4, 4, 30);
+    EXPECT_EQ(test.GetTotalCost(), 1231U);
+
+    int value;
+    EXPECT_TRUE(test.TryTake(3, value));
+    EXPECT_EQ(test.GetTotalCost(), 1031U);
+
+    EXPECT_EQ(test.TryRemove(4), 1U);
+    EXPECT_EQ(test.GetTotalCost(), 1001U);
+
+    test.Clear();
+    EXPECT_EQ(test.GetTotalCost(), 0U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(KeyedArrayCacheTest, CanEvictDownToCost) {
+    KeyedArrayCache<int, int> test(16);
+
+    for(int index = 0; index < 10; ++index) {
+      test.Insert(index, index, 10);
+    }
+    EXPECT_EQ(test.GetTotalCost(), 100U);
+
+    test.EvictDownToCost(45);
+    EXPECT_EQ(test.Count(), 4U);
+    EXPECT_EQ(test.GetTotalCost(), 40U);
+
+    // Lowering the budget evicts right away
+    test.SetCostBudget(20);
+    EXPECT_EQ(test.Count(), 2U);
+
+    int value;
+    EXPECT_TRUE(test.TryGet(8, value));
+    EXPECT_TRUE(test.TryGet(9, value));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(KeyedArrayCacheTest, ExpiredItemsAreNotReturned) {
+    KeyedArrayCache<int, int> test(16);
+    test.SetTimeToLive(std::chrono::milliseconds(20));
+
+    test.Insert(1, 10);
+    EXPECT_EQ(test.Get(1), 10);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+
+    int value;
+    EXPECT_FALSE(test.TryGet(1, value));
+    EXPECT_THROW(test.Get(1), Errors::KeyNotFoundError);
+
+    // Lookups are const and leave the expired item in place for the next modification
+    EXPECT_EQ(test.Count(), 1U);
+    EXPECT_FALSE(test.TryTake(1, value));
+    EXPECT_TRUE(test.IsEmpty());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(KeyedArrayCacheTest, LookupsSkipExpiredDuplicatesOfKey) {
+    KeyedArrayCache<int, int, std::hash<int>> indexed(16);
+    KeyedArrayCache<int, int> scanned(16);
+    indexed.SetTimeToLive(std::chrono::milliseconds(200));
+    scanned.SetTimeToLive(std::chrono::milliseconds(200));
+
+    // The first item expires while its later duplicate is still alive
+    indexed.Insert(1, 10);
+    scanned.Insert(1, 10);
+    std::this_thread::sleep_for(std::chrono::milliseconds(120));
+    indexed.Insert(1, 11);
+    scanned.Insert(1, 11);
+    std::this_thread::sleep_for(std::chrono::milliseconds(140));
+
+    EXPECT_EQ(indexed.Get(1), 11);
+    EXPECT_EQ(scanned.Get(1), 11);
+    EXPECT_EQ(indexed.Count(), 2U);
+    EXPECT_EQ(scanned.Count(), 2U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(KeyedArrayCacheTest, ExpiredItemsCanBeEvicted) {
+    KeyedArrayCache<int, int, std::hash<int>> test(16);
+    test.SetTimeToLive(std::chrono::milliseconds(1000));
+
+    for(int index = 0; index < 10; ++index) {
+      test.Insert(index, index);
+    }
+    EXPECT_EQ(test.EvictExpired(), 0U);
+
+    std::chrono::steady_clock::time_point future = (
+      std::chrono::steady_clock::now() + std::chrono::seconds(10)
+    );
+    EXPECT_EQ(test.EvictExpired(future), 10U);
+    EXPECT_TRUE(test.IsEmpty());
+
+    // Turning off expiration lets items live until they're evicted
+    test.SetTimeToLive(std::chrono::milliseconds(0));
+    test.Insert(1, 1);
+    EXPECT_EQ(test.EvictExpired(future), 0U);
+    EXPECT_EQ(test.Count(), 1U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(KeyedArrayCacheTest, AccessRenewsTimeToLive) {
+    KeyedArrayCache<int, int> test(16);
+    test.SetTimeToLive(std::chrono::milliseconds(200), true);
+
+    test.Insert(1, 10);
+    test.Insert(2, 20);
+
+    // Keep accessing item 1 while item 2 is left alone
+    int value;
+    for(std::size_t index = 0; index < 6; ++index) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      EXPECT_TRUE(test.TryGet(1, value));
+    }
+
+    EXPECT_FALSE(test.TryGet(2, value));
+    EXPECT_TRUE(test.TryGet(1, value));
+    EXPECT_EQ(value, 10);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(KeyedArrayCacheTest, ValuesCanBeMovedIn) {
+    KeyedArrayCache<int, std::vector<int>, std::hash<int>> test(4);
+
+    std::vector<int> value(100, 42);
+    const int *buffer = value.data();
+    test.Insert(1, std::move(value));
+
+    const std::vector<int> *stored = test.TryGetPointer(1);
+    ASSERT_NE(stored, nullptr);
+    EXPECT_EQ(stored->data(), buffer); // buffer was moved, not copied
+    EXPECT_EQ(test.TryGetPointer(2), nullptr);
+
+    // Values rejected for their cost must not be moved from
+    test.SetCostBudget(50);
+    std::vector<int> expensive(10, 1);
+    EXPECT_FALSE(test.Insert(2, std::move(expensive), 100));
+    EXPECT_EQ(expensive.size(), 10U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(KeyedArrayCacheTest, ValuesCanBeEmplaced) {
+    KeyedArrayCache<std::u8string, std::vector<int>> test(2);
+
+    test.Emplace(u8"first", std::size_t(3), 1);
+    test.Emplace(u8"second", std::size_t(4), 2);
+    test.Emplace(u8"third", std::size_t(5), 3);
+    EXPECT_EQ(test.Count(), 2U);
+
+    EXPECT_EQ(test.TryGetPointer(u8"first"), nullptr);
+    const std::vector<int> *stored = test.TryGetPointer(u8"third");
+    ASSERT_NE(stored, nullptr);
+    EXPECT_EQ(stored->size(), 5U);
+    EXPECT_EQ(stored->at(4), 3);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(KeyedArrayCacheTest, ItemsCanBeInsertedInBatches) {
+    KeyedArrayCache<int, int, std::hash<int>> test(4);
+
+    std::vector<int> keys = { 1, 2, 3, 4, 5, 6 };
+    std::vector<int> values = { 10, 20, 30, 40, 50, 60 };
+    EXPECT_EQ(test.InsertMany(keys, values), 6U);
+    EXPECT_EQ(test.Count(), 4U);
+
+    // Items from earlier in the batch had to make room for later ones
+    EXPECT_EQ(test.TryGetPointer(1), nullptr);
+    ASSERT_NE(test.TryGetPointer(6), nullptr);
+    EXPECT_EQ(*test.TryGetPointer(6), 60);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(KeyedArrayCacheTest, ItemsCanBeRetrievedInBatches) {
+    KeyedArrayCache<int, int, std::hash<int>> test(3);
+    test.Insert(1, 10);
+    test.Insert(2, 20);
+    test.Insert(3, 30);
+
+    std::vector<int> keys = { 3, 4, 1 };
+    std::vector<const int *> values(keys.size());
+    EXPECT_EQ(test.TryGetMany(keys, values), 2U);
+    ASSERT_NE(values[0], nullptr);
+    EXPECT_EQ(*values[0], 30);
+    EXPECT_EQ(values[1], nullptr);
+    ASSERT_NE(values[2], nullptr);
+    EXPECT_EQ(*values[2], 10);
+
+    // Keys 3 and 1 were touched by the batch, so key 2 is evicted first
+    test.Insert(5, 50);
+    EXPECT_EQ(test.TryGetPointer(2), nullptr);
+    EXPECT_NE(test.TryGetPointer(1), nullptr);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(KeyedArrayCacheTest, LargeBatchesFindAllItemsWithAndWithoutIndex) {
+    KeyedArrayCache<int, int, std::hash<int>> indexed(64);
+    KeyedArrayCache<std::u8string, int> scanned(64);
+    for(int index = 0; index < 64; ++index) {
+      indexed.Insert(index * 7, index);
+      scanned.Insert(std::u8string(1 + index % 5, char8_t(u8'a' + index % 26)), index);
+    }
+
+    // Every second key is missing, so lookups alternate between hits and misses
+    std::vector<int> keys;
+    for(int index = 0; index < 128; ++index) {
+      keys.push_back(index * 7 / 2 + (index % 2) * 3);
+    }
+    std::vector<const int *> values(keys.size());
+    EXPECT_EQ(indexed.TryGetMany(keys, values), 64U);
+    for(std::size_t index = 0; index < keys.size(); index += 2) {
+      ASSERT_NE(values[index], nullptr);
+      EXPECT_EQ(*values[index], keys[index] / 7);
+    }
+
+    std::vector<std::u8string> names = { u8"a", u8"bb", u8"zzzzz", u8"fff", u8"ccc" };
+    std::vector<const int *> found(names.size());
+    EXPECT_EQ(scanned.TryGetMany(names, found), 4U);
+    EXPECT_EQ(found[2], nullptr);
+    ASSERT_NE(found[3], nullptr);
+    EXPECT_EQ(*found[3], 57);
+    ASSERT_NE(found[4], nullptr);
+    EXPECT_EQ(*found[4], 2);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
 }}} // namespace Nuclex::Support::Collections
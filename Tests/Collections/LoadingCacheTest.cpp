@@ -0,0 +1,350 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Collections/LoadingCache.h"
+
+#if defined(NUCLEX_SUPPORT_LINUX) || defined(NUCLEX_SUPPORT_WINDOWS)
+
+#include <gtest/gtest.h>
+
+#include <atomic> // for std::atomic
+#include <chrono> // for std::chrono::milliseconds
+#include <future> // for std::promise, std::shared_future
+#include <memory> // for std::shared_ptr
+#include <stdexcept> // for std::runtime_error
+#include <string> // for std::string
+#include <thread> // for std::thread
+#include <vector> // for std::vector
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Decides whether a value should be evicted from the cache</summary>
+  /// <param name="value">Value that will be checked</param>
+  /// <returns>True if the value is an odd number</returns>
+  bool isOdd(const int &value) {
+    return ((value & 1) != 0);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(LoadingCacheTest, InstancesCanBeCreated) {
+    Threading::ThreadPool threadPool(1, 2);
+    EXPECT_NO_THROW(
+      (LoadingCache<int, std::string>(threadPool, 16))
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(LoadingCacheTest, MissingItemsAreLoaded) {
+    Threading::ThreadPool threadPool(1, 2);
+    LoadingCache<int, std::string> test(threadPool, 16);
+
+    std::atomic<int> loadCount(0);
+    auto loader = [&loadCount](const int &key) {
+      ++loadCount;
+      return std::to_string(key * 2);
+    };
+
+    std::shared_future<std::string> future = test.GetOrLoad(21, loader);
+    EXPECT_EQ(future.get(), "42");
+    EXPECT_EQ(test.Count(), 1U);
+
+    // Second request should be served from the cache
+    std::shared_future<std::string> future2 = test.GetOrLoad(21, loader);
+    EXPECT_EQ(future2.get(), "42");
+    EXPECT_EQ(loadCount.load(), 1);
+
+    EXPECT_EQ(test.Get(21), "42");
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(LoadingCacheTest, ConcurrentRequestsShareOneLoad) {
+    Threading::ThreadPool threadPool(1, 4);
+    LoadingCache<int, int> test(threadPool, 16);
+
+    std::promise<void> releasePromise;
+    std::shared_future<void> release = releasePromise.get_future().share();
+    std::atomic<int> loadCount(0);
+    auto loader = [&loadCount, release](const int &key) {
+      ++loadCount;
+      release.wait();
+      return key + 1;
+    };
+
+    const std::size_t RequesterCount = 8;
+    std::vector<std::shared_future<int>> futures(RequesterCount);
+    {
+      std::vector<std::thread> requesters;
+      for(std::size_t index = 0; index < RequesterCount; ++index) {
+        requesters.emplace_back(
+          [&test, &futures, &loader, index]() { futures[index] = test.GetOrLoad(1, loader); }
+        );
+      }
+      for(std::thread &requester : requesters) {
+        requester.join();
+      }
+    }
+
+    // All requests have arrived while the load was blocked, now let it finish
+    int value = 0;
+    EXPECT_FALSE(test.TryGet(1, value));
+    releasePromise.set_value();
+
+    for(std::size_t index = 0; index < RequesterCount; ++index) {
+      EXPECT_EQ(futures[index].get(), 2);
+    }
+    EXPECT_EQ(loadCount.load(), 1);
+    EXPECT_TRUE(test.TryGet(1, value));
+    EXPECT_EQ(value, 2);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(LoadingCacheTest, FailedLoadsAreRetried) {
+    Threading::ThreadPool threadPool(1, 2);
+    LoadingCache<int, int> test(threadPool, 16);
+
+    std::atomic<int> loadCount(0);
+    auto loader = [&loadCount](const int &key) {
+      if(++loadCount == 1) {
+        throw std::runtime_error("Simulated load failure");
+      }
+      return key;
+    };
+
+    std::shared_future<int> future = test.GetOrLoad(123, loader);
+    EXPECT_THROW(future.get(), std::runtime_error);
+    EXPECT_TRUE(test.IsEmpty());
+
+    future = test.GetOrLoad(123, loader);
+    EXPECT_EQ(future.get(), 123);
+    EXPECT_EQ(loadCount.load(), 2);
+    EXPECT_EQ(test.Count(), 1U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(LoadingCacheTest, LookupsDuringFailingLoadsDoNotThrow) {
+    Threading::ThreadPool threadPool(1, 2);
+    LoadingCache<int, int> test(threadPool, 16);
+
+    auto loader = [](const int &) -> int {
+      throw std::runtime_error("Simulated load failure");
+    };
+
+    // Keep looking up the key while loads for it keep failing. A lookup that finds
+    // the pending entry just as its load fails must report a miss, not the exception.
+    std::atomic<bool> stop(false);
+    std::atomic<std::size_t> throwCount(0);
+    std::thread poller(
+      [&test, &stop, &throwCount]() {
+        int value = 0;
+        while(!stop.load(std::memory_order_relaxed)) {
+          try {
+            EXPECT_FALSE(test.TryGet(1, value));
+            EXPECT_EQ(test.TryGetPointer(1), nullptr);
+          }
+          catch(const std::exception &) {
+            throwCount.fetch_add(1, std::memory_order_relaxed);
+          }
+        }
+      }
+    );
+
+    for(std::size_t index = 0; index < 500; ++index) {
+      std::shared_future<int> future = test.GetOrLoad(1, loader);
+      EXPECT_THROW(future.get(), std::runtime_error);
+    }
+
+    stop.store(true, std::memory_order_relaxed);
+    poller.join();
+
+    EXPECT_EQ(throwCount.load(), 0U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(LoadingCacheTest, ItemsCanBeInsertedDirectly) {
+    Threading::ThreadPool threadPool(1, 2);
+    LoadingCache<int, int> test(threadPool, 16);
+
+    EXPECT_TRUE(test.Insert(1, 10));
+    EXPECT_FALSE(test.Insert(1, 11));
+    EXPECT_FALSE(test.TryInsert(1, 12));
+    EXPECT_TRUE(test.TryInsert(2, 20));
+
+    int value = 0;
+    EXPECT_TRUE(test.TryGet(1, value));
+    EXPECT_EQ(value, 11);
+
+    // An inserted item is not loaded again
+    std::shared_future<int> future = test.GetOrLoad(
+      2, [](const int &) -> int { throw std::runtime_error("Loader should not run"); }
+    );
+    EXPECT_EQ(future.get(), 20);
+
+    EXPECT_TRUE(test.TryTake(2, value));
+    EXPECT_EQ(value, 20);
+    EXPECT_FALSE(test.TryTake(2, value));
+
+    EXPECT_TRUE(test.TryRemove(1));
+    EXPECT_FALSE(test.TryRemove(1));
+    EXPECT_TRUE(test.IsEmpty());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(LoadingCacheTest, CapacityIsRespected) {
+    Threading::ThreadPool threadPool(1, 2);
+    LoadingCache<int, int> test(threadPool, 4);
+
+    for(int index = 0; index < 10; ++index) {
+      EXPECT_EQ(test.GetOrLoad(index, [](const int &key) { return key * 10; }).get(), index * 10);
+    }
+    EXPECT_EQ(test.Count(), 4U);
+
+    int value = 0;
+    EXPECT_FALSE(test.TryGet(0, value));
+    EXPECT_TRUE(test.TryGet(9, value));
+    EXPECT_EQ(value, 90);
+
+    test.EvictDownTo(2);
+    EXPECT_EQ(test.Count(), 2U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(LoadingCacheTest, EvictWhereSkipsPendingLoads) {
+    Threading::ThreadPool threadPool(1, 2);
+    LoadingCache<int, int> test(threadPool, 16);
+
+    test.Insert(1, 1);
+    test.Insert(2, 2);
+    test.Insert(3, 3);
+
+    std::promise<void> releasePromise;
+    std::shared_future<void> release = releasePromise.get_future().share();
+    std::shared_future<int> pending = test.GetOrLoad(
+      5, [release](const int &key) { release.wait(); return key; }
+    );
+
+    test.EvictWhere(Events::Delegate<bool(const int &)>::Create<&isOdd>());
+    EXPECT_EQ(test.Count(), 2U);
+
+    releasePromise.set_value();
+    EXPECT_EQ(pending.get(), 5);
+
+    int value = 0;
+    EXPECT_TRUE(test.TryGet(2, value));
+    EXPECT_TRUE(test.TryGet(5, value));
+    EXPECT_FALSE(test.TryGet(1, value));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(LoadingCacheTest, ValuesCanBeAccessedWithoutCopying) {
+    Threading::ThreadPool threadPool(1, 2);
+    LoadingCache<int, std::vector<int>> test(threadPool, 16);
+
+    std::vector<int> value(100, 42);
+    const int *buffer = value.data();
+    EXPECT_TRUE(test.Insert(1, std::move(value)));
+
+    std::shared_ptr<const std::vector<int>> stored = test.TryGetPointer(1);
+    ASSERT_NE(stored, nullptr);
+    EXPECT_EQ(stored->data(), buffer);
+    EXPECT_EQ(test.TryGetPointer(2), nullptr);
+
+    std::vector<int> other(10, 1);
+    EXPECT_FALSE(test.TryInsert(1, std::move(other)));
+    EXPECT_EQ(other.size(), 10U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(LoadingCacheTest, LookedUpValuesSurviveRemovalFromCache) {
+    Threading::ThreadPool threadPool(1, 2);
+    LoadingCache<int, std::vector<int>> test(threadPool, 16);
+
+    EXPECT_TRUE(test.Insert(1, std::vector<int>(100, 42)));
+    EXPECT_TRUE(test.Insert(2, std::vector<int>(50, 24)));
+
+    std::shared_ptr<const std::vector<int>> stored = test.TryGetPointer(1);
+    std::vector<int> copied = test.Get(2);
+
+    // Replacing, removing and clearing must not pull the values out from under us
+    EXPECT_FALSE(test.Insert(1, std::vector<int>(1, 1)));
+    EXPECT_TRUE(test.TryRemove(1));
+    test.Clear();
+
+    ASSERT_NE(stored, nullptr);
+    EXPECT_EQ(stored->size(), 100U);
+    EXPECT_EQ(stored->back(), 42);
+    EXPECT_EQ(copied.size(), 50U);
+    EXPECT_EQ(copied.back(), 24);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(LoadingCacheTest, MissingKeyThrowsOnGet) {
+    Threading::ThreadPool threadPool(1, 2);
+    LoadingCache<int, int> test(threadPool, 16);
+
+    EXPECT_THROW(test.Get(1), Errors::KeyNotFoundError);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(LoadingCacheTest, DestructionWaitsForPendingLoads) {
+    Threading::ThreadPool threadPool(1, 2);
+    std::atomic<bool> loadFinished(false);
+    std::shared_future<int> future;
+    {
+      LoadingCache<int, int> test(threadPool, 16);
+      future = test.GetOrLoad(
+        7, [&loadFinished](const int &key) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(20));
+          loadFinished = true;
+          return key;
+        }
+      );
+    }
+
+    EXPECT_TRUE(loadFinished.load());
+    EXPECT_EQ(future.get(), 7);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
+
+#endif // defined(NUCLEX_SUPPORT_LINUX) || defined(NUCLEX_SUPPORT_WINDOWS)
@@ -0,0 +1,145 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Collections/MirroredRingBuffer.h"
+
+#if defined(NUCLEX_SUPPORT_LINUX) || defined(NUCLEX_SUPPORT_WINDOWS)
+
+#include <gtest/gtest.h>
+
+#include <vector> // for std::vector
+#include <algorithm> // for std::equal()
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(MirroredRingBufferTest, InstancesCanBeCreated) {
+    EXPECT_NO_THROW(
+      MirroredRingBuffer test;
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(MirroredRingBufferTest, CapacityIsRoundedUpToPageSize) {
+    MirroredRingBuffer test(1);
+    EXPECT_GE(test.GetCapacity(), 4096U);
+    EXPECT_EQ(test.Count(), 0U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(MirroredRingBufferTest, WrappedDataIsContiguous) {
+    MirroredRingBuffer test(1);
+    std::size_t capacity = test.GetCapacity();
+
+    std::vector<std::byte> items(capacity);
+    for(std::size_t index = 0; index < capacity; ++index) {
+      items[index] = static_cast<std::byte>(index * 7);
+    }
+
+    // Move the start of the data close to the end of the buffer
+    test.Write(items.data(), capacity - 10);
+    test.Skip(capacity - 10);
+
+    // This write wraps around the end of the buffer
+    std::span<std::byte> space = test.BeginWrite(100);
+    ASSERT_EQ(space.size(), 100U);
+    for(std::size_t index = 0; index < 100; ++index) {
+      space[index] = items[index];
+    }
+    test.CommitWrite(100);
+    EXPECT_EQ(test.GetCapacity(), capacity);
+
+    std::span<const std::byte> data = test.Peek();
+    ASSERT_EQ(data.size(), 100U);
+    for(std::size_t index = 0; index < 100; ++index) {
+      EXPECT_EQ(data[index], items[index]);
+    }
+
+    std::vector<std::byte> retrieved(100);
+    test.Read(retrieved.data(), 100);
+    EXPECT_EQ(retrieved, std::vector<std::byte>(items.begin(), items.begin() + 100));
+    EXPECT_EQ(test.Count(), 0U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(MirroredRingBufferTest, WholeBufferCanBeFilledAtAnyOffset) {
+    MirroredRingBuffer test(1);
+    std::size_t capacity = test.GetCapacity();
+
+    std::vector<std::byte> items(capacity);
+    for(std::size_t index = 0; index < capacity; ++index) {
+      items[index] = static_cast<std::byte>(index);
+    }
+
+    test.Write(items.data(), capacity / 2 + 3);
+    test.Skip(capacity / 2 + 3);
+    test.Write(items.data(), capacity);
+    EXPECT_EQ(test.GetCapacity(), capacity);
+
+    std::span<const std::byte> data = test.Peek();
+    ASSERT_EQ(data.size(), capacity);
+    EXPECT_TRUE(std::equal(data.begin(), data.end(), items.begin()));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(MirroredRingBufferTest, BufferGrowsWhenFull) {
+    MirroredRingBuffer test(1);
+    std::size_t capacity = test.GetCapacity();
+
+    std::vector<std::byte> items(capacity * 2);
+    for(std::size_t index = 0; index < capacity * 2; ++index) {
+      items[index] = static_cast<std::byte>(index * 3);
+    }
+
+    test.Write(items.data(), 16);
+    test.Skip(16);
+    test.Write(items.data(), capacity);
+    test.Write(items.data() + capacity, capacity);
+    EXPECT_GE(test.GetCapacity(), capacity * 2);
+    EXPECT_EQ(test.Count(), capacity * 2);
+
+    std::span<const std::byte> data = test.Peek();
+    EXPECT_TRUE(std::equal(data.begin(), data.end(), items.begin()));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(MirroredRingBufferTest, HasMoveConstructor) {
+    MirroredRingBuffer test;
+    std::byte value = std::byte(42);
+    test.Write(&value, 1);
+
+    MirroredRingBuffer moved(std::move(test));
+    ASSERT_EQ(moved.Count(), 1U);
+    EXPECT_EQ(moved.Peek()[0], std::byte(42));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
+
+#endif // defined(NUCLEX_SUPPORT_LINUX) || defined(NUCLEX_SUPPORT_WINDOWS)
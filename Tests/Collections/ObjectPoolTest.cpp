@@ -0,0 +1,131 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Collections/ObjectPool.h"
+#include <gtest/gtest.h>
+
+#include <vector> // for std::vector
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Counts how many instances of itself exist</summary>
+  class CountedObject {
+
+    /// <summary>Initializes a new counted object</summary>
+    public: CountedObject() { ++InstanceCount; }
+    /// <summary>Destroys the counted object</summary>
+    public: ~CountedObject() { --InstanceCount; }
+
+    /// <summary>Number of instances currently alive</summary>
+    public: static int InstanceCount;
+    /// <summary>Some state that should survive being recycled</summary>
+    public: std::vector<int> Values;
+
+  };
+
+  /// <summary>Number of instances currently alive</summary>
+  int CountedObject::InstanceCount = 0;
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ObjectPoolTest, InstancesCanBeCreated) {
+    EXPECT_NO_THROW(
+      ObjectPool<CountedObject> test;
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ObjectPoolTest, EmptyPoolCreatesNewObjects) {
+    ObjectPool<CountedObject> test;
+
+    CountedObject *first = test.Get();
+    CountedObject *second = test.Get();
+    EXPECT_NE(first, second);
+    EXPECT_EQ(CountedObject::InstanceCount, 2);
+
+    ObjectPool<CountedObject>::Delete(first);
+    ObjectPool<CountedObject>::Delete(second);
+    EXPECT_EQ(CountedObject::InstanceCount, 0);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ObjectPoolTest, ReturnedObjectsAreReused) {
+    ObjectPool<CountedObject> test;
+
+    CountedObject *object = test.Get();
+    object->Values.reserve(100);
+    test.Return(object);
+    EXPECT_EQ(test.CountRetainedObjects(), 1U);
+
+    CountedObject *recycled = test.Get();
+    EXPECT_EQ(recycled, object);
+    EXPECT_GE(recycled->Values.capacity(), 100U);
+    EXPECT_EQ(test.CountRetainedObjects(), 0U);
+    EXPECT_EQ(CountedObject::InstanceCount, 1);
+
+    test.Return(recycled);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ObjectPoolTest, PoolKeepsNoMoreObjectsThanItsCapacity) {
+    ObjectPool<CountedObject> test(2);
+    EXPECT_EQ(test.GetCapacity(), 2U);
+
+    CountedObject *objects[] = { test.Get(), test.Get(), test.Get() };
+    for(CountedObject *object : objects) {
+      test.Return(object);
+    }
+
+    EXPECT_EQ(test.CountRetainedObjects(), 2U);
+    EXPECT_EQ(CountedObject::InstanceCount, 2);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ObjectPoolTest, RetainedObjectsAreDestroyedWithPool) {
+    {
+      ObjectPool<CountedObject> test;
+      test.Return(test.Get());
+      test.Return(test.Get());
+      test.Clear();
+      EXPECT_EQ(CountedObject::InstanceCount, 0);
+
+      test.Return(test.Get());
+      EXPECT_EQ(CountedObject::InstanceCount, 1);
+    }
+    EXPECT_EQ(CountedObject::InstanceCount, 0);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
@@ -0,0 +1,251 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Collections/ObservableDynamicArray.h"
+#include <gtest/gtest.h>
+
+#include <vector> // for std::vector
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Records the notifications sent by an observable dynamic array</summary>
+  class NotificationRecorder {
+
+    /// <summary>Initializes a new notification recorder watching an array</summary>
+    /// <param name="array">Array whose notifications will be recorded</param>
+    public: NotificationRecorder(
+      Nuclex::Support::Collections::ObservableDynamicArray<int> &array
+    ) {
+      array.ObservableIndexedCollection<int>::ItemAdded.Subscribe<
+        NotificationRecorder, &NotificationRecorder::itemAdded
+      >(this);
+      array.ObservableIndexedCollection<int>::ItemRemoved.Subscribe<
+        NotificationRecorder, &NotificationRecorder::itemRemoved
+      >(this);
+      array.ItemsAdded.Subscribe<NotificationRecorder, &NotificationRecorder::itemsAdded>(this);
+      array.ItemsRemoved.Subscribe<NotificationRecorder, &NotificationRecorder::itemsRemoved>(
+        this
+      );
+      array.ItemsReplaced.Subscribe<NotificationRecorder, &NotificationRecorder::itemsReplaced>(
+        this
+      );
+      array.ItemsChanged.Subscribe<NotificationRecorder, &NotificationRecorder::itemsChanged>(
+        this
+      );
+    }
+
+    /// <summary>Records a single item having been added to the array</summary>
+    private: void itemAdded(std::size_t, const int &) { ++this->ItemAddedCount; }
+    /// <summary>Records a single item having been removed from the array</summary>
+    private: void itemRemoved(std::size_t, const int &) { ++this->ItemRemovedCount; }
+
+    /// <summary>Records a range of items having been added to the array</summary>
+    /// <param name="index">Index of the first added item</param>
+    /// <param name="count">Number of items that have been added</param>
+    private: void itemsAdded(std::size_t index, std::size_t count) {
+      ++this->ItemsAddedCount;
+      this->LastIndex = index;
+      this->LastAddedCount = count;
+    }
+
+    /// <summary>Records a range of items having been removed from the array</summary>
+    /// <param name="index">Index of the first removed item</param>
+    /// <param name="count">Number of items that have been removed</param>
+    private: void itemsRemoved(std::size_t index, std::size_t count) {
+      ++this->ItemsRemovedCount;
+      this->LastIndex = index;
+      this->LastRemovedCount = count;
+    }
+
+    /// <summary>Records a range of items having been replaced</summary>
+    /// <param name="index">Index at which the replaced range begins</param>
+    /// <param name="removedCount">Number of items in the range before</param>
+    /// <param name="addedCount">Number of items in the range now</param>
+    private: void itemsReplaced(
+      std::size_t index, std::size_t removedCount, std::size_t addedCount
+    ) {
+      ++this->ItemsReplacedCount;
+      this->LastIndex = index;
+      this->LastRemovedCount = removedCount;
+      this->LastAddedCount = addedCount;
+    }
+
+    /// <summary>Records the array having been changed in bulk</summary>
+    private: void itemsChanged() { ++this->ItemsChangedCount; }
+
+    /// <summary>Number of ItemAdded notifications received</summary>
+    public: std::size_t ItemAddedCount = 0;
+    /// <summary>Number of ItemRemoved notifications received</summary>
+    public: std::size_t ItemRemovedCount = 0;
+    /// <summary>Number of ItemsAdded notifications received</summary>
+    public: std::size_t ItemsAddedCount = 0;
+    /// <summary>Number of ItemsRemoved notifications received</summary>
+    public: std::size_t ItemsRemovedCount = 0;
+    /// <summary>Number of ItemsReplaced notifications received</summary>
+    public: std::size_t ItemsReplacedCount = 0;
+    /// <summary>Number of ItemsChanged notifications received</summary>
+    public: std::size_t ItemsChangedCount = 0;
+    /// <summary>Index reported by the most recent ranged notification</summary>
+    public: std::size_t LastIndex = 0;
+    /// <summary>Number of added items reported by the most recent ranged notification</summary>
+    public: std::size_t LastAddedCount = 0;
+    /// <summary>Number of removed items reported by the most recent ranged notification</summary>
+    public: std::size_t LastRemovedCount = 0;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ObservableDynamicArrayTest, SingleItemChangesSendOneNotificationEach) {
+    ObservableDynamicArray<int> test;
+    NotificationRecorder recorder(test);
+
+    test.Add(1);
+    test.Add(3);
+    test.InsertAt(1, 2);
+    EXPECT_TRUE(test.Remove(3));
+    test.RemoveAt(0);
+
+    EXPECT_EQ(recorder.ItemAddedCount, 3U);
+    EXPECT_EQ(recorder.ItemRemovedCount, 2U);
+    EXPECT_EQ(recorder.ItemsChangedCount, 0U);
+    ASSERT_EQ(test.Count(), 1U);
+    EXPECT_EQ(test.GetAt(0), 2);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ObservableDynamicArrayTest, RangeOperationsSendOneNotification) {
+    ObservableDynamicArray<int> test;
+    NotificationRecorder recorder(test);
+
+    std::vector<int> items(1000);
+    for(std::size_t index = 0; index < items.size(); ++index) {
+      items[index] = static_cast<int>(index);
+    }
+
+    test.AddRange(items.data(), items.size());
+    EXPECT_EQ(recorder.ItemsAddedCount, 1U);
+    EXPECT_EQ(recorder.LastIndex, 0U);
+    EXPECT_EQ(recorder.LastAddedCount, 1000U);
+
+    test.InsertRange(10, items.data(), 5);
+    EXPECT_EQ(recorder.ItemsAddedCount, 2U);
+    EXPECT_EQ(recorder.LastIndex, 10U);
+    EXPECT_EQ(recorder.LastAddedCount, 5U);
+    EXPECT_EQ(test.GetAt(10), 0);
+    EXPECT_EQ(test.GetAt(15), 10);
+
+    test.RemoveRange(10, 5);
+    EXPECT_EQ(recorder.ItemsRemovedCount, 1U);
+    EXPECT_EQ(recorder.LastIndex, 10U);
+    EXPECT_EQ(recorder.LastRemovedCount, 5U);
+
+    EXPECT_EQ(recorder.ItemAddedCount, 0U);
+    EXPECT_EQ(recorder.ItemRemovedCount, 0U);
+    EXPECT_EQ(recorder.ItemsChangedCount, 3U);
+    ASSERT_EQ(test.Count(), 1000U);
+    EXPECT_EQ(test.GetAt(999), 999);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ObservableDynamicArrayTest, DeferredNotificationsAreSummarized) {
+    ObservableDynamicArray<int> test;
+    for(int index = 0; index < 10; ++index) {
+      test.Add(index);
+    }
+
+    NotificationRecorder recorder(test);
+    {
+      auto deferral = test.DeferNotifications();
+      test.SetAt(5, 50);
+      test.InsertAt(3, 30);
+      test.RemoveAt(7);
+      test.RemoveAt(7);
+
+      EXPECT_EQ(recorder.ItemAddedCount, 0U);
+      EXPECT_EQ(recorder.ItemRemovedCount, 0U);
+      EXPECT_EQ(recorder.ItemsReplacedCount, 0U);
+    }
+
+    // Indices 3 to 7 of the original contents are now the items at indices 3 to 6
+    EXPECT_EQ(recorder.ItemsReplacedCount, 1U);
+    EXPECT_EQ(recorder.ItemsChangedCount, 1U);
+    EXPECT_EQ(recorder.LastIndex, 3U);
+    EXPECT_EQ(recorder.LastRemovedCount, 5U);
+    EXPECT_EQ(recorder.LastAddedCount, 4U);
+    ASSERT_EQ(test.Count(), 9U);
+    EXPECT_EQ(test.GetAt(3), 30);
+    EXPECT_EQ(test.GetAt(6), 50);
+    EXPECT_EQ(test.GetAt(7), 8);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ObservableDynamicArrayTest, NestedDeferralsSummarizeWhenOutermostEnds) {
+    ObservableDynamicArray<int> test;
+    NotificationRecorder recorder(test);
+    {
+      auto outerDeferral = test.DeferNotifications();
+      for(int index = 0; index < 10000; ++index) {
+        test.Add(index);
+      }
+      {
+        auto innerDeferral = test.DeferNotifications();
+        test.Clear();
+        test.Add(42);
+      }
+      EXPECT_EQ(recorder.ItemsReplacedCount, 0U);
+    }
+
+    EXPECT_EQ(recorder.ItemAddedCount, 0U);
+    EXPECT_EQ(recorder.ItemsReplacedCount, 1U);
+    EXPECT_EQ(recorder.LastIndex, 0U);
+    EXPECT_EQ(recorder.LastRemovedCount, 0U);
+    EXPECT_EQ(recorder.LastAddedCount, 1U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ObservableDynamicArrayTest, DeferralWithoutChangesSendsNothing) {
+    ObservableDynamicArray<int> test;
+    NotificationRecorder recorder(test);
+    {
+      auto deferral = test.DeferNotifications();
+    }
+
+    EXPECT_EQ(recorder.ItemsReplacedCount, 0U);
+    EXPECT_EQ(recorder.ItemsChangedCount, 0U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
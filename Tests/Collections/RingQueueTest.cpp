@@ -21,8 +21,12 @@ limitations under the License.
 #define NUCLEX_SUPPORT_SOURCE 1
 
 #include "Nuclex/Support/Collections/RingQueue.h"
+#include "Nuclex/Support/Collections/HugePageAllocator.h"
 #include "BufferTest.h"
 
+#include <string> // for std::u8string
+#include <vector> // for std::vector
+
 namespace Nuclex::Support::Collections {
 
   // ------------------------------------------------------------------------------------------- //
@@ -367,4 +371,145 @@ namespace Nuclex::Support::Collections {
 
   // ------------------------------------------------------------------------------------------- //
 
+  TEST(RingQueueTest, ItemsCanBePeekedAtAndSkipped) {
+    RingQueue<int> test(16);
+
+    std::vector<int> items(16);
+    for(std::size_t index = 0; index < 16; ++index) {
+      items[index] = static_cast<int>(index);
+    }
+
+    // Move the start index forward, then write enough items to wrap around
+    test.Write(&items[0], 10);
+    test.Skip(8);
+    test.Write(&items[10], 6);
+    EXPECT_EQ(test.Count(), 8U);
+
+    std::pair<std::span<const int>, std::span<const int>> segments = test.Peek();
+    ASSERT_EQ(segments.first.size(), 8U);
+    EXPECT_EQ(segments.second.size(), 0U);
+    EXPECT_EQ(segments.first[0], 8);
+    EXPECT_EQ(segments.first[7], 15);
+
+    test.Write(&items[0], 4);
+    segments = test.Peek();
+    ASSERT_EQ(segments.first.size(), 8U);
+    ASSERT_EQ(segments.second.size(), 4U);
+    EXPECT_EQ(segments.second[0], 0);
+    EXPECT_EQ(segments.second[3], 3);
+
+    // Skipping across the end of the buffer
+    test.Skip(10);
+    segments = test.Peek();
+    ASSERT_EQ(segments.first.size(), 2U);
+    EXPECT_EQ(segments.first[0], 2);
+    EXPECT_EQ(segments.second.size(), 0U);
+
+    test.Skip(2);
+    EXPECT_EQ(test.Count(), 0U);
+    EXPECT_EQ(test.Peek().first.size(), 0U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(RingQueueTest, ItemsCanBeWrittenInPlace) {
+    RingQueue<int> test(16);
+
+    std::vector<int> items(12, 0);
+    test.Write(&items[0], 12);
+    test.Skip(10);
+
+    // Six items fit into the four slots up to the buffer's end and two at its start
+    std::pair<std::span<int>, std::span<int>> space = test.BeginWrite(6);
+    ASSERT_EQ(space.first.size(), 4U);
+    ASSERT_EQ(space.second.size(), 2U);
+    for(std::size_t index = 0; index < 4; ++index) {
+      space.first[index] = static_cast<int>(index + 1);
+    }
+    space.second[0] = 5;
+    space.second[1] = 6;
+    test.CommitWrite(6);
+    EXPECT_EQ(test.Count(), 8U);
+
+    std::vector<int> retrieved(8);
+    test.Read(&retrieved[0], 8);
+    for(std::size_t index = 0; index < 6; ++index) {
+      EXPECT_EQ(retrieved[index + 2], static_cast<int>(index + 1));
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(RingQueueTest, BeginWriteGrowsBufferAsNeeded) {
+    RingQueue<std::u8string> test(4);
+
+    std::u8string items[] = { u8"one", u8"two", u8"three", u8"four" };
+    test.Write(items, 4);
+    test.Skip(2);
+    test.Write(items, 2); // wraps around
+
+    std::pair<std::span<std::u8string>, std::span<std::u8string>> space = test.BeginWrite(3);
+    EXPECT_GE(test.GetCapacity(), 7U);
+    ASSERT_EQ(space.first.size(), 3U);
+    for(std::size_t index = 0; index < 3; ++index) {
+      new(space.first.data() + index) std::u8string(u8"new");
+    }
+    test.CommitWrite(3);
+    EXPECT_EQ(test.Count(), 7U);
+
+    std::pair<std::span<const std::u8string>, std::span<const std::u8string>> segments = (
+      test.Peek()
+    );
+    ASSERT_EQ(segments.first.size(), 7U);
+    EXPECT_EQ(segments.first[0], u8"three");
+    EXPECT_EQ(segments.first[3], u8"two");
+    EXPECT_EQ(segments.first[6], u8"new");
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(RingQueueTest, HugePageQueueKeepsOrderWhenGrowingWrapped) {
+    typedef RingQueue<std::uint32_t, HugePageAllocator<std::uint32_t>> HugeRingQueue;
+    HugeRingQueue test(1024 * 1024, HugePageAllocator<std::uint32_t>());
+
+    // Fill the queue, then make it wrap around before it has to grow
+    const std::size_t ChunkSize = 256 * 1024;
+    std::vector<std::uint32_t> items(ChunkSize);
+    std::uint32_t nextWritten = 0;
+    std::uint32_t nextRead = 0;
+    for(std::size_t chunk = 0; chunk < 4; ++chunk) {
+      for(std::size_t index = 0; index < ChunkSize; ++index) {
+        items[index] = nextWritten++;
+      }
+      test.Write(items.data(), ChunkSize);
+    }
+    test.Read(items.data(), ChunkSize);
+    nextRead += ChunkSize;
+    for(std::size_t index = 0; index < ChunkSize; ++index) {
+      items[index] = nextWritten++;
+    }
+    test.Write(items.data(), ChunkSize);
+
+    // This write no longer fits and forces the queue to grow
+    for(std::size_t chunk = 0; chunk < 2; ++chunk) {
+      for(std::size_t index = 0; index < ChunkSize; ++index) {
+        items[index] = nextWritten++;
+      }
+      test.Write(items.data(), ChunkSize);
+    }
+    EXPECT_GE(test.GetCapacity(), 6U * ChunkSize);
+
+    HugeRingQueue copy(test);
+    while(test.Count() > 0) {
+      test.Read(items.data(), ChunkSize);
+      for(std::size_t index = 0; index < ChunkSize; ++index) {
+        ASSERT_EQ(items[index], nextRead++);
+      }
+    }
+    EXPECT_EQ(nextRead, nextWritten);
+    EXPECT_EQ(copy.Count(), 6U * ChunkSize);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
 } // namespace Nuclex::Support::Collections
@@ -23,6 +23,12 @@ limitations under the License.
 #include "Nuclex/Support/Collections/SequentialSlotCache.h"
 #include <gtest/gtest.h>
 
+#include <cstdint> // for std::uint16_t, std::uint8_t
+#include <stdexcept> // for std::invalid_argument
+#include <chrono> // for std::chrono::milliseconds
+#include <thread> // for std::this_thread::sleep_for()
+#include <vector> // for std::vector
+
 namespace Nuclex { namespace Support { namespace Collections {
 
   // ------------------------------------------------------------------------------------------- //
@@ -183,4 +189,236 @@ namespace Nuclex { namespace Support { namespace Collections {
 
   // ------------------------------------------------------------------------------------------- //
 
+  TEST(SequentialSlotCacheTest, CompactSlotIndicesCanBeUsed) {
+    SequentialSlotCache<std::size_t, int, LruEvictionPolicy<std::uint16_t>> test(1000);
+
+    for(std::size_t index = 0; index < 1000; ++index) {
+      test.Insert(index, static_cast<int>(index));
+    }
+    test.Get(0); // Move item 0 back to top of most recently accessed
+    EXPECT_TRUE(test.TryRemove(500));
+
+    test.EvictDownTo(10);
+    EXPECT_EQ(test.Count(), 10U);
+
+    int obtainedValue;
+    EXPECT_TRUE(test.TryGet(0, obtainedValue));
+    EXPECT_EQ(obtainedValue, 0);
+    EXPECT_FALSE(test.TryGet(989, obtainedValue));
+    for(std::size_t index = 991; index < 1000; ++index) {
+      EXPECT_TRUE(test.TryGet(index, obtainedValue));
+      EXPECT_EQ(obtainedValue, static_cast<int>(index));
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SequentialSlotCacheTest, SlotCountMustFitSlotIndexType) {
+    typedef SequentialSlotCache<std::size_t, int, LruEvictionPolicy<std::uint8_t>> TestCache;
+
+    EXPECT_NO_THROW(TestCache test(254));
+    EXPECT_THROW(TestCache test(255), std::invalid_argument);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SequentialSlotCacheTest, EvictionPolicyCanBeChosen) {
+    SequentialSlotCache<std::size_t, int, ClockEvictionPolicy<>> test(10);
+
+    for(std::size_t index = 0; index < 10; ++index) {
+      test.Insert(index, static_cast<int>(index));
+    }
+
+    // Give slot 0 a second chance, so it survives while the clock hand passes over it
+    int obtainedValue;
+    EXPECT_TRUE(test.TryGet(0, obtainedValue));
+
+    test.EvictDownTo(8);
+    EXPECT_EQ(test.Count(), 8U);
+    EXPECT_TRUE(test.TryGet(0, obtainedValue));
+    EXPECT_FALSE(test.TryGet(1, obtainedValue));
+    EXPECT_FALSE(test.TryGet(2, obtainedValue));
+    EXPECT_TRUE(test.TryGet(3, obtainedValue));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SequentialSlotCacheTest, KeyHashingPoliciesCanBeUsed) {
+    SequentialSlotCache<std::size_t, int, WindowTinyLfuEvictionPolicy<std::uint16_t>> test(100);
+
+    for(std::size_t index = 0; index < 100; ++index) {
+      test.Insert(index, static_cast<int>(index));
+    }
+
+    test.EvictDownTo(50);
+    EXPECT_EQ(test.Count(), 50U);
+
+    std::size_t foundCount = 0;
+    for(std::size_t index = 0; index < 100; ++index) {
+      int obtainedValue;
+      if(test.TryGet(index, obtainedValue)) {
+        EXPECT_EQ(obtainedValue, static_cast<int>(index));
+        ++foundCount;
+      }
+    }
+    EXPECT_EQ(foundCount, 50U);
+
+    test.Clear();
+    EXPECT_TRUE(test.IsEmpty());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SequentialSlotCacheTest, ValuesCanBeMovedIn) {
+    SequentialSlotCache<std::size_t, std::vector<int>> test(8);
+
+    std::vector<int> value(100, 42);
+    const int *buffer = value.data();
+    EXPECT_TRUE(test.Insert(1, std::move(value)));
+
+    const std::vector<int> *stored = test.TryGetPointer(1);
+    ASSERT_NE(stored, nullptr);
+    EXPECT_EQ(stored->data(), buffer); // buffer was moved, not copied
+    EXPECT_EQ(test.TryGetPointer(2), nullptr);
+
+    // A value that isn't inserted must not be moved from
+    std::vector<int> other(10, 1);
+    EXPECT_FALSE(test.TryInsert(1, std::move(other)));
+    EXPECT_EQ(other.size(), 10U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SequentialSlotCacheTest, ValuesCanBeEmplaced) {
+    SequentialSlotCache<std::size_t, std::vector<int>> test(8);
+
+    EXPECT_TRUE(test.Emplace(3, std::size_t(5), 7));
+    EXPECT_FALSE(test.Emplace(3, std::size_t(2), 9));
+    EXPECT_EQ(test.Count(), 1U);
+
+    const std::vector<int> *stored = test.TryGetPointer(3);
+    ASSERT_NE(stored, nullptr);
+    EXPECT_EQ(stored->size(), 2U);
+    EXPECT_EQ(stored->at(0), 9);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SequentialSlotCacheTest, ItemsCanBeInsertedInBatches) {
+    SequentialSlotCache<std::size_t, int> test(16);
+    test.Insert(3, 300);
+
+    std::vector<std::size_t> keys = { 1, 3, 5, 7 };
+    std::vector<int> values = { 100, 301, 500, 700 };
+    EXPECT_EQ(test.InsertMany(keys, values), 3U); // key 3 existed and was replaced
+    EXPECT_EQ(test.Count(), 4U);
+    EXPECT_EQ(test.Get(3), 301);
+    EXPECT_EQ(test.Get(7), 700);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SequentialSlotCacheTest, ItemsCanBeRetrievedInBatches) {
+    SequentialSlotCache<std::size_t, int> test(16);
+    test.Insert(2, 20);
+    test.Insert(4, 40);
+    test.Insert(6, 60);
+
+    std::vector<std::size_t> keys = { 6, 5, 2 };
+    std::vector<const int *> values(keys.size());
+    EXPECT_EQ(test.TryGetMany(keys, values), 2U);
+    ASSERT_NE(values[0], nullptr);
+    EXPECT_EQ(*values[0], 60);
+    EXPECT_EQ(values[1], nullptr);
+    ASSERT_NE(values[2], nullptr);
+    EXPECT_EQ(*values[2], 20);
+
+    // The batch touched keys 6 and 2, so key 4 is now the least recently used one
+    test.EvictDownTo(2);
+    int value = 0;
+    EXPECT_FALSE(test.TryGet(4, value));
+    EXPECT_TRUE(test.TryGet(2, value));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SequentialSlotCacheTest, ExpiredItemsAreNotReturned) {
+    SequentialSlotCache<std::size_t, int> test(16);
+    test.SetTimeToLive(std::chrono::milliseconds(20));
+
+    test.Insert(3, 30);
+    test.Insert(5, 50);
+    EXPECT_EQ(test.Get(3), 30);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+
+    int value;
+    EXPECT_FALSE(test.TryGet(3, value));
+    EXPECT_EQ(test.TryGetPointer(5), nullptr);
+    EXPECT_THROW(test.Get(3), Errors::KeyNotFoundError);
+
+    std::vector<std::size_t> keys = { 3, 5 };
+    std::vector<const int *> values(keys.size());
+    EXPECT_EQ(test.TryGetMany(keys, values), 0U);
+
+    // Expired items linger until the cache is modified, then their slots are free again
+    EXPECT_EQ(test.Count(), 2U);
+    EXPECT_TRUE(test.TryInsert(3, 31));
+    EXPECT_EQ(test.Count(), 1U);
+    EXPECT_EQ(test.Get(3), 31);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SequentialSlotCacheTest, ExpiredItemsCanBeEvicted) {
+    SequentialSlotCache<std::size_t, int> test(16);
+    test.SetTimeToLive(std::chrono::milliseconds(1000));
+
+    for(std::size_t index = 0; index < 10; ++index) {
+      test.Insert(index, static_cast<int>(index));
+    }
+    EXPECT_EQ(test.EvictExpired(), 0U);
+
+    // Removed items must not be reported by the timer wheel later on
+    int value;
+    EXPECT_TRUE(test.TryTake(2, value));
+    EXPECT_TRUE(test.TryRemove(4));
+    test.EvictDownTo(6);
+
+    std::chrono::steady_clock::time_point future = (
+      std::chrono::steady_clock::now() + std::chrono::seconds(10)
+    );
+    EXPECT_EQ(test.EvictExpired(future), 6U);
+    EXPECT_TRUE(test.IsEmpty());
+
+    // Turning off expiration lets items live until they're evicted
+    test.SetTimeToLive(std::chrono::milliseconds(0));
+    test.Insert(1, 1);
+    EXPECT_EQ(test.EvictExpired(future), 0U);
+    EXPECT_EQ(test.Count(), 1U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SequentialSlotCacheTest, AccessRenewsTimeToLive) {
+    SequentialSlotCache<std::size_t, int> test(16);
+    test.SetTimeToLive(std::chrono::milliseconds(200), true);
+
+    test.Insert(1, 10);
+    test.Insert(2, 20);
+
+    // Keep accessing item 1 while item 2 is left alone
+    int value;
+    for(std::size_t index = 0; index < 6; ++index) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      EXPECT_TRUE(test.TryGet(1, value));
+    }
+
+    EXPECT_FALSE(test.TryGet(2, value));
+    EXPECT_TRUE(test.TryGet(1, value));
+    EXPECT_EQ(value, 10);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
 }}} // namespace Nuclex::Support::Collections
@@ -21,8 +21,11 @@ limitations under the License.
 #define NUCLEX_SUPPORT_SOURCE 1
 
 #include "Nuclex/Support/Collections/ShiftQueue.h"
+#include "Nuclex/Support/Collections/HugePageAllocator.h"
 #include "BufferTest.h"
 
+#include <vector> // for std::vector
+
 namespace Nuclex::Support::Collections {
 
   // ------------------------------------------------------------------------------------------- //
@@ -214,4 +217,35 @@ namespace Nuclex::Support::Collections {
 
   // ------------------------------------------------------------------------------------------- //
 
+  TEST(ShiftQueueTest, HugePageQueueKeepsItemsWhenGrowing) {
+    ShiftQueue<std::uint64_t, HugePageAllocator<std::uint64_t>> test(
+      1024, HugePageAllocator<std::uint64_t>(HugePageMode::Reserved)
+    );
+
+    const std::size_t ChunkSize = 128 * 1024;
+    std::vector<std::uint64_t> items(ChunkSize);
+    std::uint64_t nextWritten = 0;
+    std::uint64_t nextRead = 0;
+    for(std::size_t chunk = 0; chunk < 8; ++chunk) {
+      for(std::size_t index = 0; index < ChunkSize; ++index) {
+        items[index] = nextWritten++;
+      }
+      test.Write(items.data(), ChunkSize);
+
+      // Consume half a chunk each round so the queue has to shift and grow
+      test.Read(items.data(), ChunkSize / 2);
+      for(std::size_t index = 0; index < ChunkSize / 2; ++index) {
+        ASSERT_EQ(items[index], nextRead++);
+      }
+    }
+
+    ASSERT_EQ(test.Count(), static_cast<std::size_t>(nextWritten - nextRead));
+    const std::uint64_t *remaining = test.Access();
+    for(std::size_t index = 0; index < test.Count(); ++index) {
+      ASSERT_EQ(remaining[index], nextRead + index);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
 } // namespace Nuclex::Support::Collections
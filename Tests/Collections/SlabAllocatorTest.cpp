@@ -0,0 +1,147 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Collections/SlabAllocator.h"
+#include <gtest/gtest.h>
+
+#include <cstdint> // for std::uintptr_t, std::uint8_t
+#include <cstring> // for std::memset()
+#include <list> // for std::list
+#include <map> // for std::map
+#include <set> // for std::set
+#include <vector> // for std::vector
+#include <thread> // for std::thread
+
+namespace {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  /// <summary>Type that requires a stricter alignment than the slab blocks have</summary>
+  struct alignas(64) OveralignedItem {
+    /// <summary>Some data so the type has a size</summary>
+    public: std::uint8_t Data[64];
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // anonymous namespace
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SlabAllocatorTest, BlocksAreAlignedAndWritable) {
+    for(std::size_t size = 1; size <= SlabMemory::MaximumBlockSize * 2; size += 7) {
+      void *memory = SlabMemory::Allocate(size);
+      EXPECT_EQ(reinterpret_cast<std::uintptr_t>(memory) % SlabMemory::BlockAlignment, 0U);
+      std::memset(memory, 0xAB, size);
+      SlabMemory::Free(memory, size);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SlabAllocatorTest, FreedBlocksAreReused) {
+    void *first = SlabMemory::Allocate(100);
+    SlabMemory::Free(first, 100);
+
+    void *second = SlabMemory::Allocate(120); // Same size class as 100 bytes
+    EXPECT_EQ(first, second);
+    SlabMemory::Free(second, 120);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SlabAllocatorTest, ManyBlocksCanBeAllocatedAtOnce) {
+    std::vector<void *> blocks;
+    std::set<void *> uniqueBlocks;
+    for(std::size_t index = 0; index < 10000; ++index) {
+      void *block = SlabMemory::Allocate(48);
+      std::memset(block, static_cast<int>(index & 0xFF), 48);
+      blocks.push_back(block);
+      uniqueBlocks.insert(block);
+    }
+    EXPECT_EQ(uniqueBlocks.size(), blocks.size());
+
+    for(void *block : blocks) {
+      SlabMemory::Free(block, 48);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SlabAllocatorTest, BlocksCanBeFreedByOtherThreads) {
+    std::vector<void *> blocks(1000);
+    std::thread allocatingThread(
+      [&blocks]() {
+        for(void *&block : blocks) {
+          block = SlabMemory::Allocate(256);
+        }
+      }
+    );
+    allocatingThread.join();
+
+    std::thread freeingThread(
+      [&blocks]() {
+        for(void *block : blocks) {
+          SlabMemory::Free(block, 256);
+        }
+      }
+    );
+    freeingThread.join();
+
+    // Both threads have given their magazines to the depot, so this should pick up
+    // the blocks that were freed by the other thread
+    void *block = SlabMemory::Allocate(256);
+    EXPECT_NE(block, nullptr);
+    SlabMemory::Free(block, 256);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SlabAllocatorTest, ContainersCanUseSlabAllocator) {
+    std::list<int, SlabAllocator<int>> numbers;
+    for(int index = 0; index < 1000; ++index) {
+      numbers.push_back(index);
+    }
+    EXPECT_EQ(numbers.size(), 1000U);
+    EXPECT_EQ(numbers.back(), 999);
+
+    std::map<int, int, std::less<int>, SlabAllocator<std::pair<const int, int>>> squares;
+    for(int index = 0; index < 100; ++index) {
+      squares.emplace(index, index * index);
+    }
+    EXPECT_EQ(squares.at(12), 144);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SlabAllocatorTest, OveralignedTypesAreAlignedCorrectly) {
+    SlabAllocator<OveralignedItem> allocator;
+    OveralignedItem *items = allocator.allocate(3);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(items) % alignof(OveralignedItem), 0U);
+    allocator.deallocate(items, 3);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
@@ -0,0 +1,193 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Collections/SmallDynamicArray.h"
+#include <gtest/gtest.h>
+
+#include <string> // for std::string
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SmallDynamicArrayTest, InstancesCanBeCreated) {
+    EXPECT_NO_THROW(
+      SmallDynamicArray<int> test;
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SmallDynamicArrayTest, ItemsUpToInlineCapacityStayInline) {
+    SmallDynamicArray<int, 4> test;
+    for(int index = 0; index < 4; ++index) {
+      test.Add(index * 10);
+    }
+
+    EXPECT_TRUE(test.IsInline());
+    EXPECT_EQ(test.Count(), 4U);
+    EXPECT_EQ(test.GetCapacity(), 4U);
+    EXPECT_EQ(test.GetAt(3), 30);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SmallDynamicArrayTest, ArraySpillsToHeapWhenInlineCapacityIsExceeded) {
+    SmallDynamicArray<int, 4> test;
+    for(int index = 0; index < 100; ++index) {
+      test.Add(index);
+    }
+
+    EXPECT_FALSE(test.IsInline());
+    ASSERT_EQ(test.Count(), 100U);
+    for(int index = 0; index < 100; ++index) {
+      EXPECT_EQ(test.GetAt(index), index);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SmallDynamicArrayTest, MemoryCanBeAllocatedUpFront) {
+    SmallDynamicArray<int, 4> test;
+    test.Reserve(50);
+    EXPECT_FALSE(test.IsInline());
+    EXPECT_GE(test.GetCapacity(), 50U);
+    EXPECT_TRUE(test.IsEmpty());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SmallDynamicArrayTest, ItemsCanBeInsertedAndRemoved) {
+    SmallDynamicArray<int, 2> test;
+    test.Add(1);
+    test.Add(3);
+    test.InsertAt(1, 2); // Forces the array onto the heap while shifting
+    test.InsertAt(0, 0);
+    test.InsertAt(4, 4);
+
+    ASSERT_EQ(test.Count(), 5U);
+    for(int index = 0; index < 5; ++index) {
+      EXPECT_EQ(test.GetAt(index), index);
+    }
+
+    test.RemoveAt(0);
+    EXPECT_TRUE(test.Remove(3));
+    EXPECT_FALSE(test.Remove(3));
+
+    ASSERT_EQ(test.Count(), 3U);
+    EXPECT_EQ(test.GetAt(0), 1);
+    EXPECT_EQ(test.GetAt(1), 2);
+    EXPECT_EQ(test.GetAt(2), 4);
+    EXPECT_EQ(test.GetIndexOf(4), 2U);
+    EXPECT_EQ(test.GetIndexOf(3), SmallDynamicArray<int>::InvalidIndex);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SmallDynamicArrayTest, AccessingInvalidIndexThrowsException) {
+    SmallDynamicArray<int, 4> test;
+    test.Add(123);
+
+    EXPECT_EQ(test.GetAt(0), 123);
+    EXPECT_THROW(test.GetAt(1), std::out_of_range);
+    EXPECT_THROW(test.SetAt(1, 456), std::out_of_range);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SmallDynamicArrayTest, ArrayCanAddItsOwnItems) {
+    SmallDynamicArray<std::string, 2> test;
+    test.Add("Hello World, this string is too long for small string optimization");
+    test.Add(test.GetAt(0));
+    test.Add(test.GetAt(0)); // Grows the array while the argument lives in it
+    test.InsertAt(0, test.GetAt(2));
+
+    ASSERT_EQ(test.Count(), 4U);
+    for(std::size_t index = 0; index < 4; ++index) {
+      EXPECT_EQ(
+        test.GetAt(index),
+        "Hello World, this string is too long for small string optimization"
+      );
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SmallDynamicArrayTest, InlineArraysCanBeCopiedAndMoved) {
+    SmallDynamicArray<std::string, 4> original;
+    original.Add("First");
+    original.Add("Second");
+
+    SmallDynamicArray<std::string, 4> copy(original);
+    EXPECT_TRUE(copy.IsInline());
+    ASSERT_EQ(copy.Count(), 2U);
+    EXPECT_EQ(copy.GetAt(1), "Second");
+
+    SmallDynamicArray<std::string, 4> moved(std::move(original));
+    EXPECT_TRUE(moved.IsInline());
+    ASSERT_EQ(moved.Count(), 2U);
+    EXPECT_EQ(moved.GetAt(0), "First");
+    EXPECT_TRUE(original.IsEmpty());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SmallDynamicArrayTest, HeapArraysCanBeCopiedAndMoved) {
+    SmallDynamicArray<std::string, 2> original;
+    for(std::size_t index = 0; index < 10; ++index) {
+      original.Add(std::to_string(index));
+    }
+
+    SmallDynamicArray<std::string, 2> copy;
+    copy.Add("Overwritten");
+    copy = original;
+    ASSERT_EQ(copy.Count(), 10U);
+    EXPECT_EQ(copy.GetAt(9), "9");
+
+    SmallDynamicArray<std::string, 2> moved;
+    moved.Add("Overwritten");
+    moved = std::move(original);
+    EXPECT_FALSE(moved.IsInline());
+    ASSERT_EQ(moved.Count(), 10U);
+    EXPECT_EQ(moved.GetAt(0), "0");
+    EXPECT_TRUE(original.IsInline());
+    EXPECT_TRUE(original.IsEmpty());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(SmallDynamicArrayTest, ClearKeepsHeapMemory) {
+    SmallDynamicArray<std::string, 2> test;
+    for(std::size_t index = 0; index < 10; ++index) {
+      test.Add(std::to_string(index));
+    }
+
+    std::size_t capacity = test.GetCapacity();
+    test.Clear();
+    EXPECT_TRUE(test.IsEmpty());
+    EXPECT_FALSE(test.Contains("5"));
+    EXPECT_EQ(test.GetCapacity(), capacity);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
@@ -0,0 +1,161 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Collections/TimerWheel.h"
+
+#include <gtest/gtest.h>
+
+#include <vector> // for std::vector
+#include <cstdint> // for std::uint64_t
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TimerWheelTest, InstancesCanBeCreated) {
+    EXPECT_NO_THROW(
+      TimerWheel test(100, 0);
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TimerWheelTest, SlotsExpireWhenDeadlinePasses) {
+    TimerWheel test(16, 1000);
+    test.Schedule(3, 1005);
+    test.Schedule(7, 1010);
+    EXPECT_TRUE(test.IsScheduled(3));
+    EXPECT_FALSE(test.IsScheduled(4));
+
+    std::vector<std::size_t> expired;
+    auto collect = [&expired](std::size_t slotIndex) { expired.push_back(slotIndex); };
+
+    test.Advance(1004, collect);
+    EXPECT_TRUE(expired.empty());
+
+    test.Advance(1005, collect);
+    ASSERT_EQ(expired.size(), 1U);
+    EXPECT_EQ(expired[0], 3U);
+    EXPECT_FALSE(test.IsScheduled(3));
+
+    test.Advance(2000, collect);
+    ASSERT_EQ(expired.size(), 2U);
+    EXPECT_EQ(expired[1], 7U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TimerWheelTest, CancelledSlotsDoNotExpire) {
+    TimerWheel test(16, 0);
+    test.Schedule(1, 100);
+    test.Schedule(2, 100);
+    test.Cancel(1);
+    test.Cancel(5); // not scheduled, should be harmless
+
+    std::vector<std::size_t> expired;
+    test.Advance(200, [&expired](std::size_t slotIndex) { expired.push_back(slotIndex); });
+    ASSERT_EQ(expired.size(), 1U);
+    EXPECT_EQ(expired[0], 2U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TimerWheelTest, RescheduledSlotsUseNewDeadline) {
+    TimerWheel test(16, 0);
+    test.Schedule(1, 100);
+    test.Schedule(1, 300);
+
+    std::vector<std::size_t> expired;
+    auto collect = [&expired](std::size_t slotIndex) { expired.push_back(slotIndex); };
+
+    test.Advance(200, collect);
+    EXPECT_TRUE(expired.empty());
+    EXPECT_EQ(test.GetDeadline(1), 300U);
+
+    test.Advance(300, collect);
+    EXPECT_EQ(expired.size(), 1U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TimerWheelTest, DistantDeadlinesCascadeDownCorrectly) {
+    const std::size_t SlotCount = 64;
+    TimerWheel test(SlotCount, 12345);
+
+    // Spread deadlines over several levels of the wheel
+    std::vector<std::uint64_t> deadlines(SlotCount);
+    for(std::size_t index = 0; index < SlotCount; ++index) {
+      deadlines[index] = 12345 + (std::uint64_t(1) << (index % 40)) + index;
+      test.Schedule(index, deadlines[index]);
+    }
+
+    // Advance in uneven steps and verify each slot expires exactly when it should
+    std::uint64_t now = 12345;
+    std::size_t expiredCount = 0;
+    for(std::uint64_t step = 3; expiredCount < SlotCount; step = step * 3 + 1) {
+      now += step;
+      test.Advance(
+        now,
+        [&](std::size_t slotIndex) {
+          EXPECT_LE(deadlines[slotIndex], now);
+          ++expiredCount;
+        }
+      );
+      for(std::size_t index = 0; index < SlotCount; ++index) {
+        if(deadlines[index] <= now) {
+          EXPECT_FALSE(test.IsScheduled(index));
+        } else {
+          EXPECT_TRUE(test.IsScheduled(index));
+        }
+      }
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TimerWheelTest, OverdueDeadlinesExpireOnNextAdvance) {
+    TimerWheel test(4, 500);
+    test.Schedule(0, 100);
+
+    std::size_t expiredCount = 0;
+    test.Advance(501, [&expiredCount](std::size_t) { ++expiredCount; });
+    EXPECT_EQ(expiredCount, 1U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(TimerWheelTest, ClearCancelsAllSlots) {
+    TimerWheel test(8, 0);
+    for(std::size_t index = 0; index < 8; ++index) {
+      test.Schedule(index, 10 + index);
+    }
+    test.Clear();
+
+    std::size_t expiredCount = 0;
+    test.Advance(1000, [&expiredCount](std::size_t) { ++expiredCount; });
+    EXPECT_EQ(expiredCount, 0U);
+    EXPECT_FALSE(test.IsScheduled(0));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
@@ -0,0 +1,148 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "Nuclex/Support/Collections/Variegator.h"
+#include <gtest/gtest.h>
+
+#include <string> // for std::string
+#include <set> // for std::set
+#include <stdexcept> // for std::runtime_error
+
+namespace Nuclex::Support::Collections {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(VariegatorTest, InstancesCanBeCreated) {
+    typedef Variegator<int, std::string> IntStringVariegator;
+    EXPECT_NO_THROW(
+      IntStringVariegator test;
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(VariegatorTest, ValuesCanBeInsertedAndCleared) {
+    Variegator<int, std::string> test;
+    EXPECT_TRUE(test.IsEmpty());
+
+    test.Insert(2, "Two");
+    test.Insert(1, "One");
+    test.Insert(2, "Deux");
+    EXPECT_FALSE(test.IsEmpty());
+    EXPECT_EQ(test.GetSize(), 3U);
+
+    test.Clear();
+    EXPECT_TRUE(test.IsEmpty());
+    EXPECT_EQ(test.GetSize(), 0U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(VariegatorTest, ValuesAreLookedUpByTheirKey) {
+    Variegator<int, std::string> test;
+    test.Insert(3, "Three");
+    test.Insert(1, "One");
+    test.Insert(2, "Two");
+
+    EXPECT_EQ(test.Get(1), "One");
+    EXPECT_EQ(test.Get(2), "Two");
+    EXPECT_EQ(test.Get(3), "Three");
+    EXPECT_EQ(test.Get(2), "Two"); // Only candidate, so it's repeated
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(VariegatorTest, GettingUnknownKeyThrowsException) {
+    Variegator<int, std::string> test;
+    EXPECT_THROW(test.Get(1), std::runtime_error);
+
+    test.Insert(1, "One");
+    EXPECT_THROW(test.Get(0), std::runtime_error);
+    EXPECT_THROW(test.Get(2), std::runtime_error);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(VariegatorTest, RecentlyUsedValuesAreNotRepeated) {
+    Variegator<int, int> test(16);
+    for(int value = 0; value < 10; ++value) {
+      test.Insert(1, value);
+      test.Insert(2, value + 100); // Values of other keys must not be mixed in
+    }
+
+    std::set<int> seen;
+    for(int index = 0; index < 10; ++index) {
+      int value = test.Get(1);
+      EXPECT_LT(value, 10);
+      EXPECT_TRUE(seen.insert(value).second);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(VariegatorTest, LeastRecentlyUsedValueIsPickedWhenAllWereUsed) {
+    Variegator<int, int> test(64);
+    test.Insert(1, 10);
+    test.Insert(1, 20);
+    test.Insert(1, 30);
+
+    int first = test.Get(1);
+    int second = test.Get(1);
+    int third = test.Get(1);
+    EXPECT_NE(first, second);
+    EXPECT_NE(second, third);
+    EXPECT_NE(first, third);
+
+    for(int round = 0; round < 3; ++round) {
+      EXPECT_EQ(test.Get(1), first);
+      EXPECT_EQ(test.Get(1), second);
+      EXPECT_EQ(test.Get(1), third);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(VariegatorTest, ValuesOfMultipleKeysCanBeConsidered) {
+    Variegator<std::string, int> test;
+    test.Insert("generic", 1);
+    test.Insert("generic", 2);
+    test.Insert("specific", 3);
+    test.Insert("unrelated", 4);
+
+    const std::string keys[] = { "generic", "specific" };
+
+    std::set<int> seen;
+    for(int index = 0; index < 3; ++index) {
+      seen.insert(test.Get(keys, 2));
+    }
+    EXPECT_EQ(seen, (std::set<int> { 1, 2, 3 }));
+
+    seen.clear();
+    for(int index = 0; index < 3; ++index) {
+      seen.insert(test.Get(std::begin(keys), std::end(keys)));
+    }
+    EXPECT_EQ(seen, (std::set<int> { 1, 2, 3 }));
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Collections
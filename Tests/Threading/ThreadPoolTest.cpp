@@ -29,6 +29,7 @@ limitations under the License.
 #include "Nuclex/Support/Text/StringConverter.h" // StringConverter
 
 #include <memory> // for std::unique_ptr
+#include <atomic> // for std::atomic
 
 #include <gtest/gtest.h>
 
@@ -64,6 +65,47 @@ namespace {
 
   // ------------------------------------------------------------------------------------------- //
 
+  /// <summary>Splits work recursively by scheduling subtasks from inside a task</summary>
+  struct RecursiveSplitter {
+
+    /// <summary>Initializes a new recursive splitter</summary>
+    /// <param name="threadPool">Thread pool the subtasks will be scheduled in</param>
+    /// <param name="leafCount">Number of leaf tasks the splitter will end up with</param>
+    public: RecursiveSplitter(
+      Nuclex::Support::Threading::ThreadPool &threadPool, std::size_t leafCount
+    ) :
+      Pool(threadPool),
+      RemainingLeafCount(leafCount),
+      Finished() {}
+
+    /// <summary>Splits the specified range in two halves or completes a leaf</summary>
+    /// <param name="count">Number of leaves the range covers</param>
+    public: void Split(std::size_t count) {
+      if(count < 2) {
+        std::size_t previousCount = this->RemainingLeafCount.fetch_sub(
+          1, std::memory_order_acq_rel
+        );
+        if(previousCount == 1) {
+          this->Finished.Open();
+        }
+      } else {
+        std::size_t half = count / 2;
+        this->Pool.Schedule(&RecursiveSplitter::Split, this, half);
+        this->Pool.Schedule(&RecursiveSplitter::Split, this, count - half);
+      }
+    }
+
+    /// <summary>Thread pool in which the subtasks are scheduled</summary>
+    public: Nuclex::Support::Threading::ThreadPool &Pool;
+    /// <summary>Number of leaf tasks that have not completed yet</summary>
+    public: std::atomic<std::size_t> RemainingLeafCount;
+    /// <summary>Opened when the last leaf task completes</summary>
+    public: Nuclex::Support::Threading::Gate Finished;
+
+  };
+
+  // ------------------------------------------------------------------------------------------- //
+
 } // anonymous namespace
 
 namespace Nuclex::Support::Threading {
@@ -209,6 +251,39 @@ namespace Nuclex::Support::Threading {
 
   // ------------------------------------------------------------------------------------------- //
 
+  TEST(ThreadPoolTest, TasksCanScheduleSubtasks) {
+    ThreadPool testPool(4, 4);
+
+    // Each task schedules two subtasks from a worker thread until the leaves are
+    // reached, so all but the very first task go through the workers' own deques
+    RecursiveSplitter splitter(testPool, 4096);
+    testPool.Schedule(&RecursiveSplitter::Split, &splitter, std::size_t(4096));
+
+    bool finished = splitter.Finished.WaitFor(std::chrono::seconds(30));
+    EXPECT_TRUE(finished);
+    EXPECT_EQ(splitter.RemainingLeafCount.load(), 0U);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ThreadPoolTest, WorkerThreadCanScheduleTasksInOtherThreadPool) {
+    ThreadPool firstPool(1, 1);
+    ThreadPool secondPool(1, 1);
+
+    // The worker of the first pool must not put this task in its own deque,
+    // otherwise the second pool's worker would never get to see it
+    std::future<std::future<int>> outerFuture = firstPool.Schedule(
+      [&secondPool] { return secondPool.Schedule(&testMethod, 12, 34); }
+    );
+
+    std::future<int> innerFuture = outerFuture.get();
+    std::future_status status = innerFuture.wait_for(std::chrono::seconds(30));
+    ASSERT_EQ(status, std::future_status::ready);
+    EXPECT_EQ(innerFuture.get(), 362);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
 } // namespace Nuclex::Support::Threading
 
 #endif // defined(NUCLEX_SUPPORT_LINUX) || defined(NUCLEX_SUPPORT_WINDOWS)
@@ -0,0 +1,174 @@
+#pragma region Apache License 2.0
+/*
+Nuclex Native Framework
+Copyright (C) 2002-2024 Markus Ewald / Nuclex Development Labs
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*/
+#pragma endregion // Apache License 2.0
+
+// If the library is compiled as a DLL, this ensures symbols are exported
+#define NUCLEX_SUPPORT_SOURCE 1
+
+#include "../Source/Threading/ThreadPoolWorkStealingDeque.h"
+
+#include <atomic> // for std::atomic
+#include <thread> // for std::thread
+#include <vector> // for std::vector
+
+#include <gtest/gtest.h>
+
+namespace Nuclex::Support::Threading {
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ThreadPoolWorkStealingDequeTest, HasDefaultConstructor) {
+    EXPECT_NO_THROW(
+      ThreadPoolWorkStealingDeque<int> deque;
+    );
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ThreadPoolWorkStealingDequeTest, NewDequeIsEmpty) {
+    ThreadPoolWorkStealingDeque<int> deque;
+    EXPECT_TRUE(deque.IsEmpty());
+
+    int element = 0;
+    EXPECT_FALSE(deque.TryTake(element));
+    EXPECT_EQ(deque.TrySteal(element), StealResult::Empty);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ThreadPoolWorkStealingDequeTest, OwnerTakesNewestElementFirst) {
+    ThreadPoolWorkStealingDeque<int> deque;
+    deque.Push(1);
+    deque.Push(2);
+    deque.Push(3);
+
+    int element = 0;
+    ASSERT_TRUE(deque.TryTake(element));
+    EXPECT_EQ(element, 3);
+    ASSERT_TRUE(deque.TryTake(element));
+    EXPECT_EQ(element, 2);
+    ASSERT_TRUE(deque.TryTake(element));
+    EXPECT_EQ(element, 1);
+    EXPECT_FALSE(deque.TryTake(element));
+    EXPECT_TRUE(deque.IsEmpty());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ThreadPoolWorkStealingDequeTest, ThievesStealOldestElementFirst) {
+    ThreadPoolWorkStealingDeque<int> deque;
+    deque.Push(1);
+    deque.Push(2);
+    deque.Push(3);
+
+    int element = 0;
+    ASSERT_EQ(deque.TrySteal(element), StealResult::Success);
+    EXPECT_EQ(element, 1);
+    ASSERT_EQ(deque.TrySteal(element), StealResult::Success);
+    EXPECT_EQ(element, 2);
+    ASSERT_TRUE(deque.TryTake(element));
+    EXPECT_EQ(element, 3);
+    EXPECT_EQ(deque.TrySteal(element), StealResult::Empty);
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ThreadPoolWorkStealingDequeTest, DequeGrowsWhenFull) {
+    ThreadPoolWorkStealingDeque<int> deque(4);
+
+    // Steal a few elements first so the ring buffer wraps around before growing
+    for(int index = 0; index < 3; ++index) {
+      deque.Push(index);
+    }
+    int element = 0;
+    for(int index = 0; index < 3; ++index) {
+      ASSERT_EQ(deque.TrySteal(element), StealResult::Success);
+    }
+
+    for(int index = 0; index < 100; ++index) {
+      deque.Push(index);
+    }
+    for(int index = 0; index < 100; ++index) {
+      ASSERT_EQ(deque.TrySteal(element), StealResult::Success);
+      EXPECT_EQ(element, index);
+    }
+    EXPECT_TRUE(deque.IsEmpty());
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+  TEST(ThreadPoolWorkStealingDequeTest, EveryElementIsTakenExactlyOnce) {
+    const std::size_t ElementCount = 100000;
+    const std::size_t ThiefCount = 3;
+
+    ThreadPoolWorkStealingDeque<std::size_t> deque(16);
+    std::vector<std::atomic<int>> takeCounts(ElementCount);
+    std::atomic<bool> ownerFinished(false);
+
+    // Thieves keep stealing until the owner is done and the deque is empty
+    std::vector<std::thread> thieves;
+    for(std::size_t index = 0; index < ThiefCount; ++index) {
+      thieves.emplace_back(
+        [&deque, &takeCounts, &ownerFinished] {
+          for(;;) {
+            std::size_t element;
+            StealResult result = deque.TrySteal(element);
+            if(result == StealResult::Success) {
+              takeCounts[element].fetch_add(1, std::memory_order_relaxed);
+            } else if(result == StealResult::Empty) {
+              if(ownerFinished.load(std::memory_order_acquire)) {
+                if(deque.IsEmpty()) {
+                  break;
+                }
+              }
+            }
+          }
+        }
+      );
+    }
+
+    // The owner pushes all elements and takes back every third one on its own
+    for(std::size_t index = 0; index < ElementCount; ++index) {
+      deque.Push(index);
+      if((index % 3) == 0) {
+        std::size_t element;
+        if(deque.TryTake(element)) {
+          takeCounts[element].fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    }
+    {
+      std::size_t element;
+      while(deque.TryTake(element)) {
+        takeCounts[element].fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+    ownerFinished.store(true, std::memory_order_release);
+
+    for(std::thread &thief : thieves) {
+      thief.join();
+    }
+
+    for(std::size_t index = 0; index < ElementCount; ++index) {
+      ASSERT_EQ(takeCounts[index].load(), 1);
+    }
+  }
+
+  // ------------------------------------------------------------------------------------------- //
+
+} // namespace Nuclex::Support::Threading